@@ -98,6 +98,21 @@ typedef struct _Css_ws_on {
 
 typedef struct _Css_ws_on *Css_ws_list;
 
+/* cached modelling coordinate bounds of a structure network */
+typedef enum {
+    CSS_BOUNDS_INVALID,
+    CSS_BOUNDS_EMPTY,
+    CSS_BOUNDS_VALID,
+    CSS_BOUNDS_UNBOUNDED
+} Css_bounds_state;
+
+typedef struct {
+    Css_bounds_state state;
+    Plimit3          box;
+    Pfloat           marker_size;
+    Pfloat           marker_scale;
+} Css_bounds;
+
 /* structure state list */
 typedef struct _Css_ssl {
     Pint        struct_id;
@@ -108,6 +123,8 @@ typedef struct _Css_ssl {
     Pint        num_el;
     El_handle   first_el;
     El_handle   last_el;
+    unsigned long edit_stamp;
+    Css_bounds  bounds;
 } Css_ssl;
 
 typedef int (*Css_func)(Css_handle, El_handle, caddr_t, Css_el_op);
@@ -241,9 +258,11 @@ Css_ws_list phg_css_change_struct_idrefs(Css_handle cssh,
                                          Struct_handle orig,
                                          Struct_handle newst);
 Struct_handle phg_css_create_struct(Pint id);
+void phg_css_struct_modified(Struct_handle structp);
 
 /* css_el */
 int phg_css_add_elem(Css_handle cssh, Phg_args_add_el *args);
+int phg_css_adopt_elem(Css_handle cssh, Phg_args_add_el *args);
 El_handle phg_css_set_ep(Css_handle cssh, Phg_args_set_ep_op opcode, Pint data);
 void phg_css_el_delete_list(Css_handle cssh,
                             Phg_args_del_el_op opcode,
@@ -270,6 +289,11 @@ void phg_css_el_search(Css_handle cssh,
                        Pelem_type_list *excl,
                        Phg_ret *ret);
 
+/* css_bnd */
+Css_bounds* phg_css_struct_bounds(Struct_handle structp);
+void phg_css_bounds_invalidate(Struct_handle structp);
+void phg_css_bounds_invalidate_all(Css_handle cssh);
+
 /* css_pr */
 void phg_css_print_struct(Struct_handle structp, int arflag);
 void phg_css_print_eldata(El_handle elptr, int arflag);
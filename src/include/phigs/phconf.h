@@ -40,6 +40,7 @@ extern "C" {
     unsigned int border_width;
     int xpos, ypos;
     float hcsf; /* hard copy scale factor */
+    int hcopy_samples; /* hard copy multisample count, 0 for none */
   } Pophconf;
 
   /* configuration file name */
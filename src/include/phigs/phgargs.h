@@ -183,6 +183,7 @@ typedef struct _Phg_args_open_ws {
    int                x, y;
    Plimit             limits;
    float              hcsf;
+   int                hcopy_samples;
 } Phg_args_open_ws;
 
 typedef struct {
@@ -164,7 +164,9 @@ typedef enum {
    PCAT_EPS,
    PCAT_PDF,
    PCAT_SVG,
-   PCAT_OBJ
+   PCAT_OBJ,
+   PCAT_GLB,
+   PCAT_PLY
 } Pws_cat;
 
 typedef enum {
@@ -248,6 +250,9 @@ typedef enum {
    PELEM_GSE,
    PELEM_ALPHA_CHANNEL,
    PELEM_TEXT3,
+   PELEM_POLYLINE3_SOA,
+   PELEM_POLYMARKER3_SOA,
+   PELEM_FILL_AREA3_SOA,
    PELEM_NUM_EL_TYPES
 } Pelem_type;
 
@@ -1250,6 +1255,13 @@ typedef struct {
 
 typedef Pstring_data Pstring_data3;
 
+/* extension: culling statistics callback */
+typedef void (*Pcull_stats_func)(Pint ws_id, Pint num_tested, Pint num_culled);
+
+/* extension: multi-frame hardcopy callback, pixels as read by OpenGL */
+typedef void (*Phcopy_frame_func)(Pint ws_id, Pint frame, Pint width, Pint height,
+                                  void *buffer);
+
 /*******************************************************************************
  * popen_phigs
  *
@@ -4181,6 +4193,358 @@ Pint pxinq_conf_hcsf(
                      Pint wkid
                      );
 
+/*******************************************************************************
+ * pxset_cull_stats_func
+ *
+ * DESCR:       set function called after each traversal of a workstation
+ *              with the number of structures tested and culled
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxset_cull_stats_func(
+                           Pcull_stats_func func
+                           );
+
+/*******************************************************************************
+ * pxset_conf_hcopy_file
+ *
+ * DESCR:       set the output file name of a hardcopy workstation
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxset_conf_hcopy_file(
+                           Pint wkid,
+                           char *name
+                           );
+
+/*******************************************************************************
+ * pxset_conf_hcopy_samples
+ *
+ * DESCR:       set the multisample count of a hardcopy workstation,
+ *              0 renders single sampled
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxset_conf_hcopy_samples(
+                              Pint wkid,
+                              Pint samples
+                              );
+
+/*******************************************************************************
+ * pxset_hcopy_threads
+ *
+ * DESCR:       set the number of threads encoding TGA and PNG hardcopies
+ *              after pclose_ws, 0 encodes before pclose_ws returns
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxset_hcopy_threads(
+                         Pint num_threads
+                         );
+
+/*******************************************************************************
+ * pxflush_hcopy
+ *
+ * DESCR:       wait until all TGA and PNG hardcopy files are written
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxflush_hcopy(
+                   void
+                   );
+
+/*******************************************************************************
+ * pxset_hcopy_frames
+ *
+ * DESCR:       write a new image file after each redraw of an open TGA or PNG
+ *              workstation, named by a printf pattern with one integer
+ *              conversion for the frame number, e.g. "frame_%04d.png".
+ *              Other conversions than %% make the pattern invalid.
+ *              NULL returns to a single image written by pclose_ws.
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxset_hcopy_frames(
+                        Pint ws_id,
+                        char *pattern
+                        );
+
+/*******************************************************************************
+ * pxset_hcopy_frame_buffer
+ *
+ * DESCR:       read each redraw of an open TGA or PNG workstation into the
+ *              buffer and call func with it. The buffer holds width x height
+ *              pixels with 3 bytes (TGA: BGR, PNG: RGB) or 4 bytes (PNG with
+ *              alpha: RGBA), bottom row first. NULL func turns it off.
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxset_hcopy_frame_buffer(
+                              Pint ws_id,
+                              void *buffer,
+                              size_t size,
+                              Phcopy_frame_func func
+                              );
+
+/*******************************************************************************
+ * pxinq_ws_image_size
+ *
+ * DESCR:       inquire size in pixels of images of a TGA or PNG workstation
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxinq_ws_image_size(
+                         Pint ws_id,
+                         Pint *err_ind,
+                         Pint *width,
+                         Pint *height
+                         );
+
+/*******************************************************************************
+ * pxget_ws_image
+ *
+ * DESCR:       render the posted structures of a TGA or PNG workstation
+ *              directly into buffer as 4 byte RGBA pixels, bottom row first
+ *              unless top_down is set. size is the buffer size in bytes.
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxget_ws_image(
+                    Pint ws_id,
+                    Pint top_down,
+                    size_t size,
+                    Pint *err_ind,
+                    void *buffer
+                    );
+
+/*******************************************************************************
+ * pxget_ws_png
+ *
+ * DESCR:       render the posted structures of a TGA or PNG workstation and
+ *              encode them as PNG in memory. Release png with free.
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxget_ws_png(
+                  Pint ws_id,
+                  Pint *err_ind,
+                  void **png,
+                  size_t *png_size
+                  );
+
+/*******************************************************************************
+ * pxalloc_el_data
+ *
+ * DESCR:       allocate size bytes of element content, laid out as stored in
+ *              the structure, to be handed over to pxadopt_fill_area_set3_data
+ *              or pxadopt_set_of_fill_area_set3_data without a copy
+ * RETURNS:     Pointer to content or NULL
+ * Note: extending the standard
+ */
+void* pxalloc_el_data(
+                      size_t size
+                      );
+
+/*******************************************************************************
+ * pxfree_el_data
+ *
+ * DESCR:       release element content that was not handed over
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxfree_el_data(
+                    void *data
+                    );
+
+/*******************************************************************************
+ * pxalloc_points
+ *
+ * DESCR:       allocate num_points points to be handed over to
+ *              pxadopt_polyline, pxadopt_polymarker or pxadopt_fill_area
+ * RETURNS:     Pointer to points or NULL
+ * Note: extending the standard
+ */
+Ppoint* pxalloc_points(
+                       Pint num_points
+                       );
+
+/*******************************************************************************
+ * pxalloc_points3
+ *
+ * DESCR:       allocate num_points points to be handed over to
+ *              pxadopt_polyline3, pxadopt_polymarker3 or pxadopt_fill_area3
+ * RETURNS:     Pointer to points or NULL
+ * Note: extending the standard
+ */
+Ppoint3* pxalloc_points3(
+                         Pint num_points
+                         );
+
+/*******************************************************************************
+ * pxfree_points
+ *
+ * DESCR:       release points that were not handed over
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxfree_points(
+                   void *points
+                   );
+
+/*******************************************************************************
+ * pxadopt_polyline
+ *
+ * DESCR:       creates a new element - Polyline, like ppolyline but the
+ *              points from pxalloc_points are taken over instead of copied.
+ *              num_points may be less than allocated. The points belong to
+ *              the library afterwards, also when an error is reported.
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxadopt_polyline(
+                      Ppoint_list *point_list
+                      );
+
+/*******************************************************************************
+ * pxadopt_polyline3
+ *
+ * DESCR:       creates a new element - Polyline 3D, taking over the points
+ *              from pxalloc_points3 like pxadopt_polyline
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxadopt_polyline3(
+                       Ppoint_list3 *point_list
+                       );
+
+/*******************************************************************************
+ * pxadopt_polymarker
+ *
+ * DESCR:       creates a new element - Polymarker, taking over the points
+ *              from pxalloc_points like pxadopt_polyline
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxadopt_polymarker(
+                        Ppoint_list *point_list
+                        );
+
+/*******************************************************************************
+ * pxadopt_polymarker3
+ *
+ * DESCR:       creates a new element - Polymarker 3D, taking over the points
+ *              from pxalloc_points3 like pxadopt_polyline
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxadopt_polymarker3(
+                         Ppoint_list3 *point_list
+                         );
+
+/*******************************************************************************
+ * pxadopt_fill_area
+ *
+ * DESCR:       creates a new element - Fill Area, taking over the points
+ *              from pxalloc_points like pxadopt_polyline
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxadopt_fill_area(
+                       Ppoint_list *point_list
+                       );
+
+/*******************************************************************************
+ * pxadopt_fill_area3
+ *
+ * DESCR:       creates a new element - Fill Area 3D, taking over the points
+ *              from pxalloc_points3 like pxadopt_polyline
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxadopt_fill_area3(
+                        Ppoint_list3 *point_list
+                        );
+
+/*******************************************************************************
+ * pxadopt_fill_area_set3_data
+ *
+ * DESCR:       creates a new element - Fill area set with data 3D, taking
+ *              over content from pxalloc_el_data. The content holds, packed
+ *              as Pint and the data types: fflag, eflag, vflag, colr_type,
+ *              facet data, nfa, for eflag PEDGE_VISIBILITY nfa edge lists
+ *              (num_edges, edges), and nfa vertex lists (num_vertices,
+ *              vertices). It belongs to the library afterwards, also when
+ *              an error is reported.
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxadopt_fill_area_set3_data(
+                                 void *data
+                                 );
+
+/*******************************************************************************
+ * pxadopt_set_of_fill_area_set3_data
+ *
+ * DESCR:       creates a new element - Set of fill area set with data 3D,
+ *              taking over content from pxalloc_el_data. The content holds,
+ *              packed: fflag, eflag, vflag, colr_type, num_sets, num_sets
+ *              facet data, for eflag PEDGE_VISIBILITY per set num_lists edge
+ *              lists (num_edges, edges), per set num_lists vertex index
+ *              lists (num_ints, ints), num_vertices and the vertices.
+ *              It belongs to the library afterwards, also on errors.
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxadopt_set_of_fill_area_set3_data(
+                                        void *data
+                                        );
+
+/*******************************************************************************
+ * pxpolyline3_soa
+ *
+ * DESCR:       creates a new element - Polyline 3D, stored with separate x,
+ *              y and z arrays instead of interleaved points. Inquiry returns
+ *              the element as interleaved points.
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxpolyline3_soa(
+                     Pint num_points,
+                     Pfloat *x,
+                     Pfloat *y,
+                     Pfloat *z
+                     );
+
+/*******************************************************************************
+ * pxpolymarker3_soa
+ *
+ * DESCR:       creates a new element - Polymarker 3D with separate x, y and
+ *              z arrays like pxpolyline3_soa
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxpolymarker3_soa(
+                       Pint num_points,
+                       Pfloat *x,
+                       Pfloat *y,
+                       Pfloat *z
+                       );
+
+/*******************************************************************************
+ * pxfill_area3_soa
+ *
+ * DESCR:       creates a new element - Fill area 3D with separate x, y and
+ *              z arrays like pxpolyline3_soa
+ * RETURNS:     N/A
+ * Note: extending the standard
+ */
+void pxfill_area3_soa(
+                      Pint num_points,
+                      Pfloat *x,
+                      Pfloat *y,
+                      Pfloat *z
+                      );
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -63,7 +63,8 @@ typedef enum {
     CSS_EL_CSS_TO_AR,
     CSS_EL_FREE,
     CSS_EL_INQ_CONTENT,
-    CSS_EL_INQ_TYPE_SIZE
+    CSS_EL_INQ_TYPE_SIZE,
+    CSS_EL_ADOPT
 } Css_el_op;
 
 typedef enum {
@@ -138,6 +138,7 @@ typedef struct _Sin_window_table {
    struct _Sin_input_ws *ws;
    Sin_trig_data        trigs[SIN_MAX_TRIG_CODE];
    Dev_data             dev_table[SIN_NUM_DEV_CLASSES][SIN_NUM_DEV_NUMS];
+   unsigned long        num_coalesced;  /* motion events skipped */
 } Sin_window_table;
 
 #define SIN_DEVICE_CANVAS_TABLE( _dev ) \
@@ -278,6 +279,17 @@ void phg_sin_cvs_destroy(
     Sin_input_ws *ws
     );
 
+/*******************************************************************************
+ * phg_sin_cvs_num_coalesced
+ *
+ * DESCR:       Get number of motion events merged into a later one
+ * RETURNS:     Number of events
+ */
+
+unsigned long phg_sin_cvs_num_coalesced(
+    Sin_input_ws *ws
+    );
+
 /*******************************************************************************
  * phg_sin_cvs_create
  *
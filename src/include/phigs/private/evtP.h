@@ -28,10 +28,14 @@
 extern "C" {
 #endif
 
+/* Initial number of hash buckets, must be a power of two */
+#define PHG_SIN_EVT_BUCKETS 64
+
 typedef struct {
    Node    node;
    Display *display;
    Window  window;
+   int     event_type;
    caddr_t cdata;
    void    (*callback)(
               Display *display,
@@ -43,7 +47,10 @@ typedef struct {
 
 typedef struct {
    Pint num_events;
-   List *events;
+   Pint num_buckets;
+   Pint num_entries;
+   Pint dispatching;         /* nesting depth of phg_sin_evt_dispatch */
+   List *buckets;            /* hashed on display, window and event type */
 } Phg_sin_evt_tbl;
 
 /*******************************************************************************
@@ -0,0 +1,249 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************
+* Changes:   Copyright (C) 2022-2023 CERN
+******************************************************************************/
+
+#ifndef _hcopyP_h
+#define _hcopyP_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Maximum number of encoder threads */
+#define HCOPY_MAX_THREADS 16
+
+/* Maximum number of images waiting for an encoder before submit blocks */
+#define HCOPY_MAX_PENDING 8
+
+typedef struct {
+   Pws_cat       category;     /* PCAT_TGA, PCAT_PNG or PCAT_PNGA */
+   int           width;
+   int           height;
+   unsigned char *pixels;      /* rows bottom up, as read by OpenGL */
+   char          filename[512];
+} Hcopy_image;
+
+typedef struct _Hcopy_frames {
+   char              pattern[512]; /* file name pattern, empty for buffer */
+   Pint              frame;        /* number of the next frame */
+   void              *buffer;      /* caller buffer and callback */
+   size_t            size;
+   Phcopy_frame_func func;
+   GLuint            pbo[2];       /* alternating readback buffers */
+   int               pending;      /* pbo holding an unwritten frame or -1 */
+   Pint              pending_frame;
+} Hcopy_frames;
+
+typedef struct {
+   unsigned char *data;        /* allocated with malloc */
+   size_t        size;
+   size_t        max_size;
+} Hcopy_mem;
+
+/* number of encoder threads, 0 encodes in the calling thread */
+extern int phg_hcopy_num_threads;
+
+/* largest hardcopy frame buffer side, 0 for the OpenGL limit */
+extern int phg_hcopy_tile_size;
+
+/*******************************************************************************
+ * phg_hcopy_is_raster
+ *
+ * DESCR:       Check if workstation category is a raster image file
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_hcopy_is_raster(
+   Pws_cat category
+   );
+
+/*******************************************************************************
+ * phg_hcopy_read_begin
+ *
+ * DESCR:       Start reading back the frame buffer into a pixel buffer object
+ * RETURNS:     N/A
+ */
+
+void phg_hcopy_read_begin(
+   Ws *ws,
+   Pws_cat category,
+   int width,
+   int height
+   );
+
+/*******************************************************************************
+ * phg_hcopy_read_end
+ *
+ * DESCR:       Complete frame buffer read back
+ * RETURNS:     Pixel data allocated with malloc or NULL
+ */
+
+unsigned char* phg_hcopy_read_end(
+   Ws *ws,
+   Pws_cat category,
+   int width,
+   int height
+   );
+
+/*******************************************************************************
+ * phg_hcopy_tile_setup
+ *
+ * DESCR:       Choose the frame buffer size of a hardcopy workstation,
+ *              split into tiles if the image exceeds the maximum size
+ * RETURNS:     N/A
+ */
+
+void phg_hcopy_tile_setup(
+   Ws *ws,
+   int *width,
+   int *height
+   );
+
+/*******************************************************************************
+ * phg_hcopy_write_tiled
+ *
+ * DESCR:       Render a tiled workstation tile by tile into an image file
+ * RETURNS:     N/A
+ */
+
+void phg_hcopy_write_tiled(
+   Ws *ws,
+   Pws_cat category,
+   char *filename
+   );
+
+/*******************************************************************************
+ * phg_hcopy_submit
+ *
+ * DESCR:       Encode and write image file, in an encoder thread if enabled.
+ *              The pixel data is owned and freed by the encoder.
+ * RETURNS:     N/A
+ */
+
+void phg_hcopy_submit(
+   Hcopy_image *image
+   );
+
+/*******************************************************************************
+ * phg_hcopy_flush
+ *
+ * DESCR:       Wait until all submitted images are written
+ * RETURNS:     N/A
+ */
+
+void phg_hcopy_flush(
+   void
+   );
+
+/*******************************************************************************
+ * phg_hcopy_frames_file
+ *
+ * DESCR:       Write an image file per redraw, NULL pattern to stop
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_hcopy_frames_file(
+   Ws *ws,
+   char *pattern
+   );
+
+/*******************************************************************************
+ * phg_hcopy_frames_buffer
+ *
+ * DESCR:       Read each redraw into caller buffer, NULL func to stop
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_hcopy_frames_buffer(
+   Ws *ws,
+   void *buffer,
+   size_t size,
+   Phcopy_frame_func func
+   );
+
+/*******************************************************************************
+ * phg_hcopy_frame
+ *
+ * DESCR:       Emit the frame just rendered on a multi-frame hardcopy
+ * RETURNS:     N/A
+ */
+
+void phg_hcopy_frame(
+   Ws *ws
+   );
+
+/*******************************************************************************
+ * phg_hcopy_frames_end
+ *
+ * DESCR:       Write pending frame and stop multi-frame hardcopy
+ * RETURNS:     N/A
+ */
+
+void phg_hcopy_frames_end(
+   Ws *ws
+   );
+
+/*******************************************************************************
+ * phg_hcopy_read_pixels
+ *
+ * DESCR:       Read frame buffer of workstation into caller buffer, a tiled
+ *              workstation is rendered again tile by tile
+ * RETURNS:     N/A
+ */
+
+void phg_hcopy_read_pixels(
+   Ws *ws,
+   int channels,
+   int top_down,
+   void *buffer
+   );
+
+/*******************************************************************************
+ * phg_hcopy_encode_png
+ *
+ * DESCR:       Encode pixels, bottom row first, as PNG in memory
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_hcopy_encode_png(
+   unsigned char *pixels,
+   int width,
+   int height,
+   int channels,
+   Hcopy_mem *mem
+   );
+
+/*******************************************************************************
+ * phg_hcopy_set_threads
+ *
+ * DESCR:       Set number of encoder threads
+ * RETURNS:     N/A
+ */
+
+void phg_hcopy_set_threads(
+   int num_threads
+   );
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* _hcopyP_h */
@@ -123,6 +123,19 @@ void phg_add_el(
    Phg_args_add_el *args
    );
 
+/*******************************************************************************
+ * phg_adopt_el
+ *
+ * DESCR:       Add an element taking over its content and update workstations
+ *              posted to
+ * RETURNS:     N/A
+ */
+
+void phg_adopt_el(
+   Css_handle cssh,
+   Phg_args_add_el *args
+   );
+
 /*******************************************************************************
  * phg_del_el
  *
@@ -73,38 +73,57 @@ typedef struct _Sin_input_event {
    Sin_event_data data;
 } Sin_input_event;
 
-typedef struct {
-   Pint            previous;
-   Pint            next;
-   Sin_input_event event;
-} Sin_q_element;
+/* Ring of events, the queue moves on to a larger ring when one fills up
+ * in growable mode. The producer only writes tail, the consumer only head,
+ * so one thread may fill the queue while another one empties it.
+ */
+typedef struct _Sin_q_ring {
+   struct _Sin_q_ring *next;   /* newer ring, set once this one is full */
+   unsigned           size;    /* number of events, a power of two */
+   unsigned           head;    /* next event to read */
+   unsigned           tail;    /* end of the published events */
+   Sin_input_event    events[1];
+} Sin_q_ring;
 
 typedef struct _Sin_event_queue {
-   Pint          count;
-   Pint          size;
-   Pint          last;
-   Pint          stack_current;
+   Pint          count;         /* published events */
+   Pint          size;          /* capacity unless growable */
+   Pint          pending;       /* events enqueued but not yet committed */
    unsigned      next_simul_id;
    unsigned      cur_simul_id;
    Pint          overflow;
    Pevent        overflow_dev;
    void          (*event_notify_proc)(void);
-   int           free_stack[SIN_Q_SIZE];
-   Sin_q_element events[SIN_Q_SIZE];
+   int           wakeup_fd;     /* eventfd waking a blocked wait or -1 */
+   int           waiting;       /* a wait is blocked on wakeup_fd */
+   Sin_q_ring    *read_ring;    /* oldest ring, used by the consumer */
+   Sin_q_ring    *write_ring;   /* newest ring, used by the producer */
    Err_handle    erh;
 } Sin_event_queue;
 
+/* grow the queue instead of overflowing */
+extern int phg_sin_q_growable;
+
+#define SIN_Q_LOAD( _var) \
+    __atomic_load_n(&(_var), __ATOMIC_ACQUIRE)
+
+#define SIN_Q_STORE( _var, _val) \
+    __atomic_store_n(&(_var), (_val), __ATOMIC_RELEASE)
+
+#define SIN_Q_COUNT( queue) \
+    __atomic_load_n(&(queue)->count, __ATOMIC_SEQ_CST)
+
+#define SIN_Q_SET_WAITING( queue, _flag) \
+    __atomic_store_n(&(queue)->waiting, (_flag), __ATOMIC_SEQ_CST)
+
 #define SIN_Q_FULL( queue) \
-    ((queue)->count >= (queue)->size)
+    (!phg_sin_q_growable && SIN_Q_COUNT(queue) >= (queue)->size)
 
 #define SIN_Q_EMPTY( queue) \
-    ((queue)->count <= 0)
-
-#define SIN_Q_ENOUGH_ROOM( queue, count) \
-    ((queue)->count + (count) <= (queue)->size)
+    (SIN_Q_COUNT(queue) <= 0)
 
 #define SIN_Q_NUM_FREE_EVENTS( queue) \
-    ((queue)->size - (queue)->count)
+    ((queue)->size - SIN_Q_COUNT(queue))
 
 #define SIN_Q_SET_OVERFLOW( _queue, _dev) \
     ((_queue)->overflow = SIN_Q_OVERFLOW_NOT_INQUIRED); \
@@ -118,14 +137,8 @@ typedef struct _Sin_event_queue {
 #define SIN_Q_OVERFLOWED( queue) \
     ((queue)->overflow)
 
-#define SIN_Q_PUSH_FREE_ELEMENT( queue, index) \
-    (queue)->free_stack[++(queue)->stack_current] = (index)
-
-#define SIN_Q_POP_FREE_ELEMENT( queue) \
-    (queue)->free_stack[(queue)->stack_current--]
-
 #define SIN_Q_HEAD_EVENT( _queue ) \
-    (&(_queue)->events[(_queue)->events[(_queue)->last].next].event)
+    phg_sin_q_next_event(_queue)
 
 #define SIN_Q_NEW_SIMUL_ID( _queue ) \
     ((_queue)->next_simul_id++)
@@ -137,11 +150,25 @@ typedef struct _Sin_event_queue {
     (!SIN_Q_EMPTY(_queue) && SIN_Q_HEAD_EVENT(_queue)->simul_id > 0 \
         && (_queue)->cur_simul_id == SIN_Q_HEAD_EVENT(_queue)->simul_id)
 
+/*******************************************************************************
+ * phg_sin_q_reserve
+ *
+ * DESCR:       Make room for a number of events to be enqueued together,
+ *              growing the queue if growable.
+ * RETURNS:     TRUE or FALSE if the queue is full
+ */
+
+int phg_sin_q_reserve(
+    Sin_event_queue *queue,
+    int num
+    );
+
 /*******************************************************************************
  * phg_sin_q_enque_free_event
  *
  * DESCR:       Place a free and empty event on the queue and return a pointer 
- *              to it or NULL if the queue is full.
+ *              to it or NULL if the queue is full. The event is seen by the
+ *              consumer after phg_sin_q_commit_events.
  * RETURNS:     Pointer to event or NULL
  */
 
@@ -149,6 +176,17 @@ Sin_input_event* phg_sin_q_enque_free_event(
     Sin_event_queue *queue
     );
 
+/*******************************************************************************
+ * phg_sin_q_commit_events
+ *
+ * DESCR:       Publish the events filled in since the last reserve
+ * RETURNS:     N/A
+ */
+
+void phg_sin_q_commit_events(
+    Sin_event_queue *queue
+    );
+
 /*******************************************************************************
  * phg_sin_q_next_event
  *
@@ -235,6 +273,28 @@ int phg_sin_q_overflow_event(
     Pevent *event
     );
 
+/*******************************************************************************
+ * phg_sin_q_wakeup
+ *
+ * DESCR:       Wake up a wait blocked on the wakeup descriptor of the queue
+ * RETURNS:     N/A
+ */
+
+void phg_sin_q_wakeup(
+    Sin_event_queue *queue
+    );
+
+/*******************************************************************************
+ * phg_sin_q_clear_wakeup
+ *
+ * DESCR:       Consume pending wakeups of the queue
+ * RETURNS:     N/A
+ */
+
+void phg_sin_q_clear_wakeup(
+    Sin_event_queue *queue
+    );
+
 /*******************************************************************************
  * phg_sin_q_set_event_notify_proc
  *
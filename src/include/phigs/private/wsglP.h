@@ -34,6 +34,18 @@ extern "C" {
 
 /* option to switch usage of shaders on or off */
 extern short int wsgl_use_shaders;
+/* option to rasterize markers as point sprites in the shaders */
+extern short int wsgl_use_marker_sprites;
+/* option to skip structures outside the view volume */
+extern short int wsgl_use_culling;
+/* called with the culling statistics after each traversal */
+extern Pcull_stats_func wsgl_cull_stats_func;
+/* level of detail tolerance in pixels, zero draws exact geometry */
+extern Pfloat wsgl_lod_tolerance;
+/* option to render hardcopies in an EGL context, automatic without DISPLAY */
+extern short int wsgl_use_headless;
+/* option to keep a copy of the last frame to repair window exposures */
+extern short int wsgl_use_scene_copy;
 
 typedef struct {
    Pint x, y;
@@ -71,18 +83,22 @@ typedef struct {
 
 typedef struct {
    Pint       id;
+   Struct_handle structp;
    Pint       offset;
    Pint       hlhsr_id;
    Ws_attr_st ast;
    Nset       cur_nameset;
    uint32_t   nameset_buf[WS_MAX_NAMES_IN_NAMESET / 32];
+   int        filter_valid;      /* verdicts below match cur_nameset */
+   int        filter_draw;       /* passes invisibility or pick filter */
+   int        filter_highl;      /* passes highlighting filter */
    Pview_rep3 view_rep;
    Pmatrix3   local_tran;
    Pmatrix3   global_tran;
    Pint       pick_id;
    Pint       lighting;
    Nset       lightstat;
-   uint32_t   lightstat_buf[1];
+   uint32_t   lightstat_buf[WS_MAX_SHADER_LIGHT_SRC / 32];
 } Ws_struct;
 
 typedef struct {
@@ -97,6 +113,59 @@ typedef struct {
    Pint       int_shad_meth;
 } Ws_dev_st;
 
+/* cached stroke text geometry, one vertex batch per text element */
+#define WS_TEXT_CACHE_HASH_SIZE 256
+#define WS_TEXT_CACHE_MAX       2048
+
+typedef struct {
+   Phg_font    *fnt;
+   Pfloat      char_ht;
+   Pfloat      char_expan;
+   Pfloat      char_space;
+   Pvec        up;
+   Ptext_path  path;
+   Ptext_align align;
+   Ppoint3     pos;
+   Pmatrix3    tran;
+} Ws_text_key;
+
+typedef struct _Ws_text_geom {
+   Ws_text_key           key;
+   char                  *str;
+   Pint                  num_strips;
+   GLint                 *first;
+   GLsizei               *count;
+   Pint                  num_vertices;
+   Ppoint3               *vertices;
+   struct _Ws_text_geom  *next;
+} Ws_text_geom;
+
+/* level of detail data of one element, built the first time it is needed */
+#define WS_LOD_HASH_SIZE     256
+#define WS_LOD_MAX           1024
+#define WS_LOD_LEVELS        8
+#define WS_LOD_MIN_VERTICES  256
+
+typedef struct _Ws_lod {
+   El_handle       el;
+   unsigned long   edit_stamp;
+   Plimit3         box;
+   Pint            num_vertices;
+   Pfloat          *error;                 /* polylines: error when dropped */
+   unsigned char   *keep;                  /* FASD3: level bits kept */
+   Pint            *remap[WS_LOD_LEVELS];  /* SOFAS3: cluster representative */
+   struct _Ws_lod  *next;
+} Ws_lod;
+
+/* active light sources as seen by the fragment shader, std140 layout */
+#define WS_LIGHT_BLOCK_BINDING  0
+
+typedef struct {
+   GLint    num_lights;
+   GLint    pad[3];
+   GLfloat  data[WS_MAX_SHADER_LIGHT_SRC][3][4];  /* colour, position, coef */
+} Wsgl_light_block;
+
 typedef struct _Wsgl {
    Plimit3         cur_win;
    int             win_changed;
@@ -111,41 +180,70 @@ typedef struct _Wsgl {
    Pmatrix3        composite_tran;
    Pmatrix3        model_tran;
    Pmatrix3        pick_tran;
+   GLint           viewport[4];        /* whole workstation viewport */
+   Pint            tile_x, tile_y;     /* origin of the hardcopy tile */
+   Pmatrix3        tile_tran;
    Ws_filter       invis_filter;
    Ws_filter       pick_filter;
    Ws_filter       highl_filter;
    Pint            select_size;
    GLuint          *select_buf;
    Ws_dev_st       dev_st;
+   Hash_table      text_cache;
+   Pint            text_cache_entries;
+   Pint            num_cull_tested;
+   Pint            num_culled;
+   Hash_table      lod_cache;
+   Pint            lod_cache_entries;
+   unsigned char   *lod_keep;
+   unsigned char   lod_bit;
+   Pint            *lod_remap;
+   GLuint          light_buffer;
+   int             light_block_valid;
+   Wsgl_light_block light_block;
+   GLuint          scene_fbuf;         /* copy of the last rendered frame */
+   GLuint          scene_colorbuf;
+   GLsizei         scene_width, scene_height;
+   int             scene_valid;
+   Phg_scratch     soa_scratch;        /* interleaved coordinate arrays */
 } Wsgl;
 
 /* record geometry */
 typedef enum {
     GEOM_LINE,
-    GEOM_FACE
+    GEOM_FACE,
+    GEOM_SEGMENTS                /* disjoint lines, one per vertex pair */
 } GeomType;
 
-typedef struct {
-    GeomType type;
-    int* indices;
-    int* norms;
-    int count;
-} Geometry;
-
-extern Ppoint3 * vertices;
-extern Ppoint3 * normals;
 extern int vertex_count;
 extern int normal_count;
 
-extern Geometry* geometries;
-extern int geom_count;
 extern Ppoint3 current_normal;
+extern Ppoint3 current_colr;
+extern float current_width;
 
 extern int record_geom;
 extern int record_geom_fill;
 extern int normal_valid;
 
-#define MAX_VERTICES 10000
+/* binary mesh export instead of OBJ */
+typedef enum {
+    MESH_NONE,
+    MESH_GLB,
+    MESH_PLY
+} MeshType;
+
+extern int record_mesh;
+
+/* vector hardcopy instead of OBJ */
+typedef enum {
+    VEC_NONE,
+    VEC_SVG,
+    VEC_PDF
+} VecType;
+
+extern int record_vec;
+
 /*******************************************************************************
  * wsgl_set_current_normal(float x, float y, float z)
  *
@@ -154,6 +252,38 @@ extern int normal_valid;
  */
   void wsgl_set_current_normal(float x, float y, float z);
 
+/*******************************************************************************
+ * wsgl_set_current_colr(float r, float g, float b)
+ *
+ * DESCR:       set colour of the following recorded primitives
+ * RETURNS:     N/A
+ */
+  void wsgl_set_current_colr(float r, float g, float b);
+
+/*******************************************************************************
+ * wsgl_set_current_width(float width)
+ *
+ * DESCR:       set line width of the following recorded primitives
+ * RETURNS:     N/A
+ */
+  void wsgl_set_current_width(float width);
+
+/*******************************************************************************
+ * wsgl_begin_obj(const char* filename, const char* title)
+ *
+ * DESCR:       open OBJ file, records are written while rendering
+ * RETURNS:     Non zero or zero on error
+ */
+  int wsgl_begin_obj(const char* filename, const char* title);
+
+/*******************************************************************************
+ * wsgl_obj_is_open()
+ *
+ * DESCR:       check if an OBJ file is being streamed
+ * RETURNS:     TRUE or FALSE
+ */
+  int wsgl_obj_is_open(void);
+
 /*******************************************************************************
  * wsgl_add_vertex(float x, float y, float z)
  *
@@ -178,6 +308,30 @@ extern int normal_valid;
  */
   void wsgl_add_geometry(GeomType type, const int* verts, const int* norms, int count);
 
+/*******************************************************************************
+ * wsgl_rec_vertex(float x, float y, float z)
+ *
+ * DESCR:       add 3d vertex to the primitive being recorded
+ * RETURNS:     N/A
+ */
+  void wsgl_rec_vertex(float x, float y, float z);
+
+/*******************************************************************************
+ * wsgl_rec_normal(float x, float y, float z)
+ *
+ * DESCR:       add normal to the primitive being recorded
+ * RETURNS:     N/A
+ */
+  void wsgl_rec_normal(float x, float y, float z);
+
+/*******************************************************************************
+ * wsgl_rec_geometry(GeomType type)
+ *
+ * DESCR:       add recorded primitive as 3d geometry and start a new one
+ * RETURNS:     N/A
+ */
+  void wsgl_rec_geometry(GeomType type);
+
 /*******************************************************************************
  * wsgl_export_obj(const char* filename, const char* title)
  * DESCR:       export as OBJ file
@@ -193,6 +347,154 @@ extern int normal_valid;
  */
   void wsgl_clear_geometry();
 
+/*******************************************************************************
+ * wsgl_begin_mesh(const char* filename, const char* title, int type)
+ *
+ * DESCR:       start collecting a binary mesh, written on export
+ * RETURNS:     Non zero or zero on error
+ */
+  int wsgl_begin_mesh(const char* filename, const char* title, int type);
+
+/*******************************************************************************
+ * wsgl_mesh_vertex(float x, float y, float z)
+ *
+ * DESCR:       add vertex with current colour to the pending primitive
+ * RETURNS:     N/A
+ */
+  void wsgl_mesh_vertex(float x, float y, float z);
+
+/*******************************************************************************
+ * wsgl_mesh_normal(float x, float y, float z)
+ *
+ * DESCR:       set normal of the last pending vertex
+ * RETURNS:     N/A
+ */
+  void wsgl_mesh_normal(float x, float y, float z);
+
+/*******************************************************************************
+ * wsgl_mesh_geometry(GeomType type)
+ *
+ * DESCR:       add pending primitive to the mesh and start a new one
+ * RETURNS:     N/A
+ */
+  void wsgl_mesh_geometry(GeomType type);
+
+/*******************************************************************************
+ * wsgl_export_mesh()
+ *
+ * DESCR:       write collected mesh as GLB or PLY and stop collecting
+ * RETURNS:     N/A
+ */
+  void wsgl_export_mesh();
+
+/*******************************************************************************
+ * wsgl_clear_mesh()
+ *
+ * DESCR:       drop collected mesh, keep the buffers
+ * RETURNS:     N/A
+ */
+  void wsgl_clear_mesh();
+
+/*******************************************************************************
+ * wsgl_begin_vec(const char* filename, const char* title, int type,
+ *                int width, int height)
+ *
+ * DESCR:       open vector hardcopy, primitives are written while rendering
+ * RETURNS:     Non zero or zero on error
+ */
+  int wsgl_begin_vec(const char* filename, const char* title, int type,
+                     int width, int height);
+
+/*******************************************************************************
+ * wsgl_vec_update(Ws *ws)
+ *
+ * DESCR:       take transforms and depth mode of the traversal state
+ * RETURNS:     N/A
+ */
+  void wsgl_vec_update(Ws *ws);
+
+/*******************************************************************************
+ * wsgl_vec_vertex(float x, float y, float z)
+ *
+ * DESCR:       add vertex to the pending primitive in device coordinates
+ * RETURNS:     N/A
+ */
+  void wsgl_vec_vertex(float x, float y, float z);
+
+/*******************************************************************************
+ * wsgl_vec_dot(float x, float y, float z, float size)
+ *
+ * DESCR:       add square of size pixels around the vertex as primitive
+ * RETURNS:     N/A
+ */
+  void wsgl_vec_dot(float x, float y, float z, float size);
+
+/*******************************************************************************
+ * wsgl_vec_normal(float x, float y, float z)
+ *
+ * DESCR:       add vertex normal to the pending primitive
+ * RETURNS:     N/A
+ */
+  void wsgl_vec_normal(float x, float y, float z);
+
+/*******************************************************************************
+ * wsgl_vec_refl_props(int shading, GLfloat *ambient, GLfloat *diffuse,
+ *                     GLfloat *specular)
+ *
+ * DESCR:       take surface reflectance of the following faces
+ * RETURNS:     N/A
+ */
+  void wsgl_vec_refl_props(int shading, GLfloat *ambient, GLfloat *diffuse,
+                           GLfloat *specular);
+
+/*******************************************************************************
+ * wsgl_vec_geometry(GeomType type)
+ *
+ * DESCR:       add pending primitive to the batch and start a new one
+ * RETURNS:     N/A
+ */
+  void wsgl_vec_geometry(GeomType type);
+
+/*******************************************************************************
+ * wsgl_vec_begin_structure()
+ *
+ * DESCR:       enter a structure of the network being traversed
+ * RETURNS:     N/A
+ */
+  void wsgl_vec_begin_structure();
+
+/*******************************************************************************
+ * wsgl_vec_end_structure()
+ *
+ * DESCR:       leave a structure, the batch is written with the root structure
+ * RETURNS:     N/A
+ */
+  void wsgl_vec_end_structure();
+
+/*******************************************************************************
+ * wsgl_vec_flush()
+ *
+ * DESCR:       write the primitives of the batch, back to front
+ * RETURNS:     N/A
+ */
+  void wsgl_vec_flush();
+
+/*******************************************************************************
+ * wsgl_vec_clear(Ws *ws)
+ *
+ * DESCR:       restart the drawing with the background of the workstation
+ * RETURNS:     N/A
+ */
+  void wsgl_vec_clear(Ws *ws);
+
+/*******************************************************************************
+ * wsgl_export_vec()
+ *
+ * DESCR:       write remaining primitives and close vector hardcopy
+ * RETURNS:     N/A
+ */
+  void wsgl_export_vec();
+
 /*******************************************************************************
  * wsgl_init
  *
@@ -322,6 +624,19 @@ void wsgl_flush(
    Ws *ws
    );
 
+/*******************************************************************************
+ * wsgl_set_tile
+ *
+ * DESCR:       Select the part of a tiled hardcopy rendered next
+ * RETURNS:     N/A
+ */
+
+void wsgl_set_tile(
+   Ws *ws,
+   Pint x,
+   Pint y
+   );
+
 /*******************************************************************************
  * wsgl_begin_rendering
  *
@@ -344,6 +659,17 @@ void wsgl_end_rendering(
    Ws *ws
    );
 
+/*******************************************************************************
+ * wsgl_restore_scene
+ *
+ * DESCR:       Copy the last rendered frame back to the render window
+ * RETURNS:     TRUE or FALSE if the frame must be rendered again
+ */
+
+int wsgl_restore_scene(
+   Ws *ws
+   );
+
 /*******************************************************************************
  * wsgl_begin_structure
  *
@@ -353,7 +679,19 @@ void wsgl_end_rendering(
 
 void wsgl_begin_structure(
    Ws *ws,
-   Pint struct_id
+   Struct_handle structp
+   );
+
+/*******************************************************************************
+ * wsgl_cull_struct
+ *
+ * DESCR:       Test if a structure network is outside the view volume
+ * RETURNS:     TRUE if the structure network can be skipped
+ */
+
+int wsgl_cull_struct(
+   Ws *ws,
+   Struct_handle structp
    );
 
 /*******************************************************************************
@@ -1059,6 +1397,17 @@ void wsgl_text3(
    Ws_attr_st *ast
    );
 
+/*******************************************************************************
+ * wsgl_text_cache_flush
+ *
+ * DESCR:       Discard all cached stroke text geometry
+ * RETURNS:     N/A
+ */
+
+void wsgl_text_cache_flush(
+   Ws *ws
+   );
+
 /*******************************************************************************
  * wsgl_edge_area_set3
  *
@@ -1277,6 +1626,55 @@ void wsgl_anno_text_rel(
    Pmatrix3 wc_to_npc
  );
 
+/*******************************************************************************
+ * wsgl_lod_polyline
+ *
+ * DESCR:       Draw a polyline or polyline 3 element with the level of
+ *              detail matching its current size on the screen
+ * RETURNS:     TRUE if drawn, FALSE if the exact geometry shall be drawn
+ */
+
+int wsgl_lod_polyline(
+   Ws *ws,
+   El_handle el,
+   Ws_attr_st *ast
+   );
+
+/*******************************************************************************
+ * wsgl_lod_begin
+ *
+ * DESCR:       Select the level of detail for the fill of a fill area set 3
+ *              with data or set of fill area set 3 with data element
+ * RETURNS:     N/A
+ */
+
+void wsgl_lod_begin(
+   Ws *ws,
+   El_handle el
+   );
+
+/*******************************************************************************
+ * wsgl_lod_end
+ *
+ * DESCR:       Return to exact geometry after wsgl_lod_begin
+ * RETURNS:     N/A
+ */
+
+void wsgl_lod_end(
+   Ws *ws
+   );
+
+/*******************************************************************************
+ * wsgl_lod_cache_flush
+ *
+ * DESCR:       Discard all level of detail data
+ * RETURNS:     N/A
+ */
+
+void wsgl_lod_cache_flush(
+   Ws *ws
+   );
+
 /*******************************************************************************
  * wsgl_shaders
  *
@@ -28,6 +28,19 @@
 extern "C" {
 #endif
 
+struct _Sin_input_ws;
+
+/* Event handler run on the application thread for the input thread */
+typedef void (*Wsx_input_defer_func)(
+   struct _Sin_input_ws *sin_ws,
+   caddr_t handle,
+   Window window,
+   XEvent *event
+   );
+
+/* process input events in a thread of their own */
+extern int phg_wsx_input_threaded;
+
 /*******************************************************************************
  * phg_wsx_create
  *
@@ -65,6 +78,75 @@ int phg_wsx_setup_tool_nodisp(
    Phg_args_open_ws *args
    );
 
+/*******************************************************************************
+ * phg_wsx_create_fb
+ *
+ * DESCR:       Create offscreen frame buffer in the current context
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_wsx_create_fb(
+   Ws *ws,
+   int width,
+   int height
+   );
+
+/*******************************************************************************
+ * phg_wsx_resolve_fb
+ *
+ * DESCR:       Resolve multisampled frame buffer into the one read back
+ * RETURNS:     N/A
+ */
+
+void phg_wsx_resolve_fb(
+   Ws *ws
+   );
+
+/*******************************************************************************
+ * phg_wsx_use_headless
+ *
+ * DESCR:       Check if hardcopies are rendered without an X server
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_wsx_use_headless(
+   void
+   );
+
+/*******************************************************************************
+ * phg_wsx_setup_tool_headless
+ *
+ * DESCR:       Create own offscreen context and frame buffer for hardcopy
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_wsx_setup_tool_headless(
+   Ws *ws,
+   Phg_args_open_ws *args
+   );
+
+/*******************************************************************************
+ * phg_wsx_make_current_headless
+ *
+ * DESCR:       Make offscreen context current
+ * RETURNS:     N/A
+ */
+
+void phg_wsx_make_current_headless(
+   Ws *ws
+   );
+
+/*******************************************************************************
+ * phg_wsx_release_headless
+ *
+ * DESCR:       Release offscreen context
+ * RETURNS:     N/A
+ */
+
+void phg_wsx_release_headless(
+   Ws *ws
+   );
+
 /*******************************************************************************
  * phg_wsx_cleanup_fb
  *
@@ -203,6 +285,138 @@ int phg_wsx_input_dispatch_next(
    Phg_sin_evt_tbl *evt_tbl
    );
 
+/*******************************************************************************
+ * phg_wsx_input_fds
+ *
+ * DESCR:       Get the connection file descriptors delivering input events
+ *              of the workstation, to wait on when no event is pending
+ * RETURNS:     Number of file descriptors
+ */
+
+int phg_wsx_input_fds(
+   Ws *ws,
+   int *fds,
+   int max_fds
+   );
+
+/*******************************************************************************
+ * phg_wsx_input_lock
+ *
+ * DESCR:       Lock input device state against the input thread
+ * RETURNS:     N/A
+ */
+
+void phg_wsx_input_lock(
+   void
+   );
+
+/*******************************************************************************
+ * phg_wsx_input_unlock
+ *
+ * DESCR:       Unlock input device state
+ * RETURNS:     N/A
+ */
+
+void phg_wsx_input_unlock(
+   void
+   );
+
+/*******************************************************************************
+ * phg_wsx_input_thread_self
+ *
+ * DESCR:       Check if called by the input thread
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_wsx_input_thread_self(
+   void
+   );
+
+/*******************************************************************************
+ * phg_wsx_input_has_deferred
+ *
+ * DESCR:       Check if the input thread handed over events to process
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_wsx_input_has_deferred(
+   void
+   );
+
+/*******************************************************************************
+ * phg_wsx_input_defer
+ *
+ * DESCR:       Hand an event over from the input thread to the application
+ *              thread, for processing that needs the rendering context.
+ *              Called with the input lock held.
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_wsx_input_defer(
+   Wsx_input_defer_func func,
+   struct _Sin_input_ws *sin_ws,
+   caddr_t handle,
+   Window window,
+   XEvent *event
+   );
+
+/*******************************************************************************
+ * phg_wsx_input_drop_deferred
+ *
+ * DESCR:       Drop events handed over for a workstation about to close.
+ *              Called with the input lock held.
+ * RETURNS:     N/A
+ */
+
+void phg_wsx_input_drop_deferred(
+   Ws *ws
+   );
+
+/*******************************************************************************
+ * phg_wsx_input_thread_init
+ *
+ * DESCR:       Enable the input thread, must be called before the first
+ *              display connection is opened
+ * RETURNS:     N/A
+ */
+
+void phg_wsx_input_thread_init(
+   void
+   );
+
+/*******************************************************************************
+ * phg_wsx_input_thread_start
+ *
+ * DESCR:       Start the input thread if enabled and not running yet
+ * RETURNS:     N/A
+ */
+
+void phg_wsx_input_thread_start(
+   void
+   );
+
+/*******************************************************************************
+ * phg_wsx_input_thread_notify
+ *
+ * DESCR:       Make the input thread look at the open workstations again
+ * RETURNS:     N/A
+ */
+
+void phg_wsx_input_thread_notify(
+   void
+   );
+
+/*******************************************************************************
+ * phg_wsx_input_thread_stop
+ *
+ * DESCR:       Stop the input thread and drop events not yet processed
+ * RETURNS:     N/A
+ */
+
+void phg_wsx_input_thread_stop(
+   void
+   );
+
 /*******************************************************************************
  * phg_wstx_create
  *
@@ -87,7 +87,7 @@ int phg_msleep(
 /*******************************************************************************
  * phg_mtime
  *
- * DESCR:       Get current time in milleseconds
+ * DESCR:       Get current time in milleseconds from a monotonic clock
  * RETURNS:     TRUE or FALSE
  */
 
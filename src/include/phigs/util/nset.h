@@ -31,6 +31,10 @@ typedef struct {
    unsigned max_names;
    unsigned num_chunks;
    uint32_t *nameset;
+   unsigned max_sparse;        /* sorted names from max_names and up, */
+                               /* allocated on demand */
+   unsigned num_sparse;
+   Pint     *sparse;
 } Nset;
 
 typedef Nset *Nameset;
@@ -59,6 +63,29 @@ void phg_nset_init(
    uint32_t *buf
    );
 
+/*******************************************************************************
+ * phg_nset_dup_sparse
+ *
+ * DESCR:       Give nameset a private copy of its sparse names, copies of
+ *              the nameset made before keep the old list
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_nset_dup_sparse(
+   Nameset nset
+   );
+
+/*******************************************************************************
+ * phg_nset_free_sparse
+ *
+ * DESCR:       Release storage of sparse names in nameset
+ * RETURNS:     N/A
+ */
+
+void phg_nset_free_sparse(
+   Nameset nset
+   );
+
 /*******************************************************************************
  * phg_nset_destroy
  *
@@ -98,7 +125,7 @@ int phg_nset_name_clear(
  * phg_nset_names_set
  *
  * DESCR:       Set names in nameset from integer list
- * RETURNS:     TRUE of FALSE
+ * RETURNS:     TRUE or FALSE if the names could not be stored
  */
 
 int phg_nset_names_set(
@@ -123,7 +150,7 @@ int phg_nset_names_clear(
 /*******************************************************************************
  * phg_nset_names_set_all
  *
- * DESCR:       Set all names in nameset
+ * DESCR:       Set all names in bit mask part of nameset
  * RETURNS:     N/A
  */
 
@@ -182,7 +209,7 @@ int phg_nset_name_is_set(
  * phg_nset_num_names_get
  *
  * DESCR:       Get number of names in nameset
- * RETURNS:     TRUE of FALSE
+ * RETURNS:     Number of names
  */
 
 int phg_nset_num_names_get(
@@ -0,0 +1,61 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef _pack_h
+#define _pack_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * phg_pack_points
+ *
+ * DESCR:       Interleave separate x and y coordinate arrays into points
+ * RETURNS:     N/A
+ */
+
+void phg_pack_points(
+   Ppoint *dst,
+   Pfloat *x,
+   Pfloat *y,
+   Pint n
+   );
+
+/*******************************************************************************
+ * phg_pack_points3
+ *
+ * DESCR:       Interleave separate x, y and z coordinate arrays into points
+ * RETURNS:     N/A
+ */
+
+void phg_pack_points3(
+   Ppoint3 *dst,
+   Pfloat *x,
+   Pfloat *y,
+   Pfloat *z,
+   Pint n
+   );
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* _pack_h */
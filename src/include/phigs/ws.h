@@ -68,6 +68,7 @@ extern "C" {
 #define NUM_SELECTABLE_STRUCTS  256
 #define WS_MAX_NAMES_IN_NAMESET 1024
 #define WS_MAX_LIGHT_SRC        8
+#define WS_MAX_SHADER_LIGHT_SRC 32
 
 /* hard code display size */
 #define DISPLAY_WIDTH  1024
@@ -243,6 +244,15 @@ typedef struct _Ws {
    Widget       valuator_frame;
    GLXFBConfig  *fbc;
    GLuint       fbuf, depthbuf, colorbuf;
+   GLuint       msaa_fbuf, msaa_colorbuf; /* multisample draw buffer */
+   GLint        hcopy_samples; /* requested samples per pixel, 0 for none */
+   GLint        fb_width, fb_height;
+   GLuint       hcopy_pbo;     /* pixel pack buffer of pending readback */
+   struct _Hcopy_frames *hcopy_frames; /* multi-frame hardcopy or NULL */
+   GLint        hcopy_tile[2]; /* frame buffer size if tiled, else zero */
+   void         *egl_display;  /* EGLDisplay of headless hardcopy */
+   void         *egl_context;  /* EGLContext of headless hardcopy */
+   void         *egl_surface;  /* EGLSurface, none if surfaceless */
    GLint        old_viewport[4];
    GLint        program;
 
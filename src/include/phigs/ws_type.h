@@ -68,6 +68,8 @@ extern "C" {
 #define PWST_HCOPY_TRUE_PDF              8
 #define PWST_HCOPY_TRUE_SVG              9
 #define PWST_HCOPY_TRUE_OBJ              10
+#define PWST_HCOPY_TRUE_GLB              11
+#define PWST_HCOPY_TRUE_PLY              12
 
 /* Default tables */
 #define WST_MIN_PREDEF_LINE_REPS         1
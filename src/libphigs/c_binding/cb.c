@@ -26,6 +26,7 @@
 #include "phg.h"
 #include "private/phgP.h"
 #include "private/cbP.h"
+#include "util/pack.h"
 
 struct _Pstore *phg_cb_store_list = (struct _Pstore *) NULL;
 
@@ -115,6 +116,13 @@ int phg_cb_store_el_size(
     size = sizeof(Ppoint_list3) * (*idata);
     break;
 
+  case PELEM_POLYLINE3_SOA:
+  case PELEM_POLYMARKER3_SOA:
+  case PELEM_FILL_AREA3_SOA:
+    idata = (Pint *) &el_info[1];
+    size = sizeof(Ppoint3) * (*idata);
+    break;
+
   case PELEM_FILL_AREA_SET_DATA:
     /* TODO */
     size = 0;
@@ -163,6 +171,7 @@ void phg_cb_store_el_data(
   Pint *idata;
   Ppoint *pdata;
   Ppoint3 *p3data;
+  Pfloat *fdata;
 
    switch(el_info->elementType) {
    case PELEM_ADD_NAMES_SET:
@@ -188,6 +197,21 @@ void phg_cb_store_el_data(
      ed->point_list3.points = (Ppoint3 *) &idata[1];
      break;
 
+   case PELEM_POLYLINE3_SOA:
+   case PELEM_POLYMARKER3_SOA:
+   case PELEM_FILL_AREA3_SOA:
+     /* Returned as interleaved points like the standard elements */
+     idata = (Pint *) &el_info[1];
+     ed->point_list3.num_points = *idata;
+     ed->point_list3.points = (Ppoint3 *) buf;
+     fdata = (Pfloat *) &idata[1];
+     phg_pack_points3(ed->point_list3.points,
+                      fdata,
+                      &fdata[*idata],
+                      &fdata[2 * (*idata)],
+                      *idata);
+     break;
+
    case PELEM_FILL_AREA_SET:
      idata = (Pint *) &el_info[1];
      ed->point_list_list.num_point_lists = *idata;
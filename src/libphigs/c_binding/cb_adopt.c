@@ -0,0 +1,416 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************
+* Changes:   Copyright (C) 2022-2023 CERN
+******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "phg.h"
+#include "css.h"
+#include "private/phgP.h"
+
+/*******************************************************************************
+ * facet_size
+ *
+ * DESCR:   Size of facet data helper function
+ * RETURNS:   Size in bytes
+ */
+static Pint facet_size(
+                       Pint fflag
+                       )
+{
+  switch (fflag) {
+  case PFACET_COLOUR:
+    return sizeof(Pcoval);
+
+  case PFACET_NORMAL:
+    return sizeof(Pvec3);
+
+  case PFACET_COLOUR_NORMAL:
+    return sizeof(Pconorm3);
+
+  default:
+    return 0;
+  }
+}
+
+/*******************************************************************************
+ * vertex_size
+ *
+ * DESCR:   Size of vertex data helper function
+ * RETURNS:   Size in bytes
+ */
+static Pint vertex_size(
+                        Pint vflag
+                        )
+{
+  switch (vflag) {
+  case PVERT_COORD:
+    return sizeof(Ppoint3);
+
+  case PVERT_COORD_COLOUR:
+    return sizeof(Pptco3);
+
+  case PVERT_COORD_NORMAL:
+    return sizeof(Pptnorm3);
+
+  case PVERT_COORD_COLOUR_NORMAL:
+    return sizeof(Pptconorm3);
+
+  default:
+    return 0;
+  }
+}
+
+/*******************************************************************************
+ * fasd3_size
+ *
+ * DESCR:   Size of fill area set with data 3D content helper function
+ * RETURNS:   Size in bytes
+ */
+static Pint fasd3_size(
+                       void *pdata
+                       )
+{
+  Pint i, nfa, num;
+  Pint *data = (Pint *) pdata;
+  Pint vsize = vertex_size(data[2]);
+  char *tp = (char *) &data[4] + facet_size(data[0]);
+
+  nfa = *((Pint *) tp);
+  tp += sizeof(Pint);
+
+  if (data[1] == PEDGE_VISIBILITY) {
+    for (i = 0; i < nfa; i++) {
+      num = *((Pint *) tp);
+      tp += sizeof(Pint) + num * sizeof(Pedge_flag);
+    }
+  }
+
+  for (i = 0; i < nfa; i++) {
+    num = *((Pint *) tp);
+    tp += sizeof(Pint) + num * vsize;
+  }
+
+  return (Pint) (tp - (char *) pdata);
+}
+
+/*******************************************************************************
+ * sofas3_size
+ *
+ * DESCR:   Size of set of fill area set with data 3D content helper function
+ * RETURNS:   Size in bytes
+ */
+static Pint sofas3_size(
+                        void *pdata
+                        )
+{
+  Pint i, j, num_lists, num;
+  Pint *data = (Pint *) pdata;
+  Pint num_sets = data[4];
+  char *tp = (char *) &data[5] + num_sets * facet_size(data[0]);
+
+  if (data[1] == PEDGE_VISIBILITY) {
+    for (i = 0; i < num_sets; i++) {
+      num_lists = *((Pint *) tp);
+      tp += sizeof(Pint);
+      for (j = 0; j < num_lists; j++) {
+        num = *((Pint *) tp);
+        tp += sizeof(Pint) + num * sizeof(Pedge_flag);
+      }
+    }
+  }
+
+  for (i = 0; i < num_sets; i++) {
+    num_lists = *((Pint *) tp);
+    tp += sizeof(Pint);
+    for (j = 0; j < num_lists; j++) {
+      num = *((Pint *) tp);
+      tp += sizeof(Pint) + num * sizeof(Pint);
+    }
+  }
+
+  num = *((Pint *) tp);
+  tp += sizeof(Pint) + num * vertex_size(data[2]);
+
+  return (Pint) (tp - (char *) pdata);
+}
+
+/*******************************************************************************
+ * adopt_el
+ *
+ * DESCR:   Add element taking over the content helper function,
+ *          the content is released on errors
+ * RETURNS:   N/A
+ */
+static void adopt_el(
+                     Pint fn_id,
+                     Pelem_type el_type,
+                     Pint el_size,
+                     void *el_data
+                     )
+{
+  Phg_args_add_el args;
+
+  if (phg_entry_check(PHG_ERH, ERR5, fn_id)) {
+    if (PSL_STRUCT_STATE(PHG_PSL) != PSTRUCT_ST_STOP) {
+      ERR_REPORT(PHG_ERH, ERR5);
+    }
+    else {
+      args.el_type = el_type;
+      args.el_size = el_size;
+      args.el_data = el_data;
+      phg_adopt_el(PHG_CSS, &args);
+      return;
+    }
+  }
+  pxfree_el_data(el_data);
+}
+
+/*******************************************************************************
+ * adopt_points
+ *
+ * DESCR:   Add point list element taking over the points helper function
+ * RETURNS:   N/A
+ */
+static void adopt_points(
+                         Pint fn_id,
+                         Pelem_type el_type,
+                         Pint num_points,
+                         size_t point_size,
+                         void *points
+                         )
+{
+  Pint *data = ((Pint *) points) - 1;
+
+  data[0] = num_points;
+  adopt_el(fn_id, el_type, sizeof(Pint) + point_size * num_points, data);
+}
+
+/*******************************************************************************
+ * pxalloc_el_data
+ *
+ * DESCR:   Allocate element content for one of the pxadopt functions
+ * RETURNS:   Pointer to content or NULL
+ */
+void* pxalloc_el_data(
+                      size_t size
+                      )
+{
+  Phg_elmt_info *head;
+
+  head = (Phg_elmt_info *) malloc(sizeof(Phg_elmt_info) + size);
+  if (head == NULL) {
+    return NULL;
+  }
+  head->elementType = PELEM_NIL;
+  head->length = 0;
+
+  return &head[1];
+}
+
+/*******************************************************************************
+ * pxfree_el_data
+ *
+ * DESCR:   Release element content that was not handed over
+ * RETURNS:   N/A
+ */
+void pxfree_el_data(
+                    void *data
+                    )
+{
+  if (data != NULL) {
+    free(((Phg_elmt_info *) data) - 1);
+  }
+}
+
+/*******************************************************************************
+ * pxalloc_points
+ *
+ * DESCR:   Allocate points for pxadopt_polyline, pxadopt_polymarker
+ *          or pxadopt_fill_area
+ * RETURNS:   Pointer to points or NULL
+ */
+Ppoint* pxalloc_points(
+                       Pint num_points
+                       )
+{
+  Pint *data;
+
+  data = (Pint *) pxalloc_el_data(sizeof(Pint) + sizeof(Ppoint) * num_points);
+  if (data == NULL) {
+    return NULL;
+  }
+  data[0] = num_points;
+
+  return (Ppoint *) &data[1];
+}
+
+/*******************************************************************************
+ * pxalloc_points3
+ *
+ * DESCR:   Allocate points for pxadopt_polyline3, pxadopt_polymarker3
+ *          or pxadopt_fill_area3
+ * RETURNS:   Pointer to points or NULL
+ */
+Ppoint3* pxalloc_points3(
+                         Pint num_points
+                         )
+{
+  Pint *data;
+
+  data = (Pint *) pxalloc_el_data(sizeof(Pint) + sizeof(Ppoint3) * num_points);
+  if (data == NULL) {
+    return NULL;
+  }
+  data[0] = num_points;
+
+  return (Ppoint3 *) &data[1];
+}
+
+/*******************************************************************************
+ * pxfree_points
+ *
+ * DESCR:   Release points that were not handed over
+ * RETURNS:   N/A
+ */
+void pxfree_points(
+                   void *points
+                   )
+{
+  if (points != NULL) {
+    pxfree_el_data(((Pint *) points) - 1);
+  }
+}
+
+/*******************************************************************************
+ * pxadopt_polyline
+ *
+ * DESCR:   Creates a new element - Polyline, taking over the points
+ * RETURNS:   N/A
+ */
+void pxadopt_polyline(
+                      Ppoint_list *point_list
+                      )
+{
+  adopt_points(Pfn_polyline, PELEM_POLYLINE, point_list->num_points,
+               sizeof(Ppoint), point_list->points);
+}
+
+/*******************************************************************************
+ * pxadopt_polyline3
+ *
+ * DESCR:   Creates a new element - Polyline 3D, taking over the points
+ * RETURNS:   N/A
+ */
+void pxadopt_polyline3(
+                       Ppoint_list3 *point_list
+                       )
+{
+  adopt_points(Pfn_polyline3, PELEM_POLYLINE3, point_list->num_points,
+               sizeof(Ppoint3), point_list->points);
+}
+
+/*******************************************************************************
+ * pxadopt_polymarker
+ *
+ * DESCR:   Creates a new element - Polymarker, taking over the points
+ * RETURNS:   N/A
+ */
+void pxadopt_polymarker(
+                        Ppoint_list *point_list
+                        )
+{
+  adopt_points(Pfn_polymarker, PELEM_POLYMARKER, point_list->num_points,
+               sizeof(Ppoint), point_list->points);
+}
+
+/*******************************************************************************
+ * pxadopt_polymarker3
+ *
+ * DESCR:   Creates a new element - Polymarker 3D, taking over the points
+ * RETURNS:   N/A
+ */
+void pxadopt_polymarker3(
+                         Ppoint_list3 *point_list
+                         )
+{
+  adopt_points(Pfn_polymarker3, PELEM_POLYMARKER3, point_list->num_points,
+               sizeof(Ppoint3), point_list->points);
+}
+
+/*******************************************************************************
+ * pxadopt_fill_area
+ *
+ * DESCR:   Creates a new element - Fill Area, taking over the points
+ * RETURNS:   N/A
+ */
+void pxadopt_fill_area(
+                       Ppoint_list *point_list
+                       )
+{
+  adopt_points(Pfn_fill_area, PELEM_FILL_AREA, point_list->num_points,
+               sizeof(Ppoint), point_list->points);
+}
+
+/*******************************************************************************
+ * pxadopt_fill_area3
+ *
+ * DESCR:   Creates a new element - Fill Area 3D, taking over the points
+ * RETURNS:   N/A
+ */
+void pxadopt_fill_area3(
+                        Ppoint_list3 *point_list
+                        )
+{
+  adopt_points(Pfn_fill_area3, PELEM_FILL_AREA3, point_list->num_points,
+               sizeof(Ppoint3), point_list->points);
+}
+
+/*******************************************************************************
+ * pxadopt_fill_area_set3_data
+ *
+ * DESCR:   Creates a new element - Fill area set with data 3D,
+ *          taking over the content
+ * RETURNS:   N/A
+ */
+void pxadopt_fill_area_set3_data(
+                                 void *data
+                                 )
+{
+  adopt_el(Pfn_fill_area_set3_data, PELEM_FILL_AREA_SET3_DATA,
+           fasd3_size(data), data);
+}
+
+/*******************************************************************************
+ * pxadopt_set_of_fill_area_set3_data
+ *
+ * DESCR:   Creates a new element - Set of fill area set with data 3D,
+ *          taking over the content
+ * RETURNS:   N/A
+ */
+void pxadopt_set_of_fill_area_set3_data(
+                                        void *data
+                                        )
+{
+  adopt_el(Pfn_set_of_fill_area_set3_data, PELEM_SET_OF_FILL_AREA_SET3_DATA,
+           sofas3_size(data), data);
+}
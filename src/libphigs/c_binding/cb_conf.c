@@ -21,6 +21,10 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "phconf.h"
+#include "phg.h"
+#include "ws.h"
+#include "private/wsglP.h"
+#include "private/hcopyP.h"
 
 /*******************************************************************************
  * pxset_conf_file_name
@@ -71,3 +75,83 @@ Pint pxinq_conf_hcsf(
     exit(1);
   }
 }
+
+/*******************************************************************************
+ * pxset_cull_stats_func
+ *
+ * DESCR:       set function called with the culling statistics
+ *              after each traversal, NULL to remove it
+ * RETURNS:     N/A
+ */
+void pxset_cull_stats_func(
+                           Pcull_stats_func func
+                           ){
+  wsgl_cull_stats_func = func;
+}
+
+/*******************************************************************************
+ * pxset_conf_hcopy_file
+ *
+ * DESCR:       set the output file name of a hardcopy workstation
+ * RETURNS:     N/A
+ */
+void pxset_conf_hcopy_file(
+                           Pint wkid,
+                           char *name
+                           ){
+  if (wkid >=0 && wkid <100){
+    strncpy(config[wkid].filename, name, sizeof(config[wkid].filename) - 1);
+    config[wkid].filename[sizeof(config[wkid].filename) - 1] = '\0';
+  } else {
+    printf("FATAL: configuration error. Work station ID out of range: %d\n", wkid);
+    exit(1);
+  }
+}
+
+/*******************************************************************************
+ * pxset_conf_hcopy_samples
+ *
+ * DESCR:       set the multisample count of a hardcopy workstation,
+ *              0 renders single sampled
+ * RETURNS:     N/A
+ */
+void pxset_conf_hcopy_samples(
+                              Pint wkid,
+                              Pint samples
+                              ){
+  if (wkid >=0 && wkid <100){
+    if (samples >= 0 && samples <= 32){
+      config[wkid].hcopy_samples = (samples > 1) ? samples : 0;
+    } else {
+      printf("ERROR: configuration error. Ignoring unreasonable sample count of: %d\n", samples);
+    }
+  } else {
+    printf("FATAL: configuration error. Work station ID out of range: %d\n", wkid);
+    exit(1);
+  }
+}
+
+/*******************************************************************************
+ * pxset_hcopy_threads
+ *
+ * DESCR:       set the number of threads encoding raster hardcopies,
+ *              0 encodes in pclose_ws
+ * RETURNS:     N/A
+ */
+void pxset_hcopy_threads(
+                         Pint num_threads
+                         ){
+  phg_hcopy_set_threads(num_threads);
+}
+
+/*******************************************************************************
+ * pxflush_hcopy
+ *
+ * DESCR:       wait until all raster hardcopy files are written
+ * RETURNS:     N/A
+ */
+void pxflush_hcopy(
+                   void
+                   ){
+  phg_hcopy_flush();
+}
@@ -442,6 +442,98 @@ void pfill_area3(
    }
 }
 
+/*******************************************************************************
+ * add_points_soa3
+ *
+ * DESCR:   Creates a new point element with separate coordinate arrays
+ * RETURNS:   N/A
+ */
+static void add_points_soa3(
+                            Pint fn_id,
+                            Pelem_type el_type,
+                            Pint num_points,
+                            Pfloat *x,
+                            Pfloat *y,
+                            Pfloat *z
+                            )
+{
+  Phg_args_add_el args;
+  Pint *data;
+  Pfloat *fdata;
+
+  if (phg_entry_check(PHG_ERH, ERR5, fn_id)) {
+    if (PSL_STRUCT_STATE(PHG_PSL) != PSTRUCT_ST_STOP) {
+      ERR_REPORT(PHG_ERH, ERR5);
+    }
+    else {
+      args.el_type = el_type;
+      args.el_size = sizeof(Pint) + 3 * sizeof(Pfloat) * num_points;
+      if (!PHG_SCRATCH_SPACE(&PHG_SCRATCH, args.el_size)) {
+        ERR_REPORT(PHG_ERH, ERR900);
+      }
+      else {
+        args.el_data = PHG_SCRATCH.buf;
+        data = (Pint *) args.el_data;
+        data[0] = num_points;
+        fdata = (Pfloat *) &data[1];
+        memcpy(&fdata[0], x, sizeof(Pfloat) * num_points);
+        memcpy(&fdata[num_points], y, sizeof(Pfloat) * num_points);
+        memcpy(&fdata[2 * num_points], z, sizeof(Pfloat) * num_points);
+        phg_add_el(PHG_CSS, &args);
+      }
+    }
+  }
+}
+
+/*******************************************************************************
+ * pxpolyline3_soa
+ *
+ * DESCR:   Creates a new element - Polyline 3D with separate coordinate arrays
+ * RETURNS:   N/A
+ */
+void pxpolyline3_soa(
+                     Pint num_points,
+                     Pfloat *x,
+                     Pfloat *y,
+                     Pfloat *z
+                     )
+{
+  add_points_soa3(Pfn_polyline3, PELEM_POLYLINE3_SOA, num_points, x, y, z);
+}
+
+/*******************************************************************************
+ * pxpolymarker3_soa
+ *
+ * DESCR:   Creates a new element - Polymarker 3D with separate coordinate
+ *          arrays
+ * RETURNS:   N/A
+ */
+void pxpolymarker3_soa(
+                       Pint num_points,
+                       Pfloat *x,
+                       Pfloat *y,
+                       Pfloat *z
+                       )
+{
+  add_points_soa3(Pfn_polymarker3, PELEM_POLYMARKER3_SOA, num_points, x, y, z);
+}
+
+/*******************************************************************************
+ * pxfill_area3_soa
+ *
+ * DESCR:   Creates a new element - Fill area 3D with separate coordinate arrays
+ * RETURNS:   N/A
+ */
+void pxfill_area3_soa(
+                      Pint num_points,
+                      Pfloat *x,
+                      Pfloat *y,
+                      Pfloat *z
+                      )
+{
+  add_points_soa3(Pfn_fill_area3, PELEM_FILL_AREA3_SOA, num_points, x, y, z);
+}
+
 /*******************************************************************************
  * pfill_area_set
  *
@@ -22,12 +22,16 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <poll.h>
 
 #include "phg.h"
 #include "private/phgP.h"
 #include "private/sinqP.h"
 #include "private/wsxP.h"
 
+/* X connections of all input workstations and the queue wakeup */
+#define INP_MAX_WAIT_FDS (2 * MAX_NO_OPEN_WS + 1)
+
 /*******************************************************************************
  * input_ws_open
  *
@@ -172,7 +176,9 @@ void pinit_loc3(
                    loc_data,
                    sizeof(Ploc_data3));
             wsh = PHG_WSID(ws_id);
+            phg_wsx_input_lock();
             (*wsh->init_device)(wsh, &args);
+            phg_wsx_input_unlock();
                }
           else {
             ERR_REPORT(PHG_ERH, ERR260);
@@ -271,7 +277,9 @@ void pinit_stroke3(
                      stroke_data,
                      sizeof(Pstroke_data3));
               wsh = PHG_WSID(ws_id);
+              phg_wsx_input_lock();
               (*wsh->init_device)(wsh, &args);
+              phg_wsx_input_unlock();
             }
             else {
               ERR_REPORT(PHG_ERH, ERR262);
@@ -381,7 +389,9 @@ void pinit_pick3(
                  sizeof(Ppick_data3));
           args.data.pik.porder = order;
           wsh = PHG_WSID(ws_id);
+          phg_wsx_input_lock();
           (*wsh->init_device)(wsh, &args);
+          phg_wsx_input_unlock();
         }
         else {
           ERR_REPORT(PHG_ERH, ERR260);
@@ -441,7 +451,9 @@ void pinit_string3(
          string_data,
          sizeof(Pstring_data3));
   wsh = PHG_WSID(ws_id);
+  phg_wsx_input_lock();
   (*wsh->init_device)(wsh, &args);
+  phg_wsx_input_unlock();
       }
       else {
         ERR_REPORT(PHG_ERH, ERR260);
@@ -507,7 +519,9 @@ void pinit_string(
                string_data,
                sizeof(Pstring_data));
         wsh = PHG_WSID(ws_id);
+        phg_wsx_input_lock();
         (*wsh->init_device)(wsh, &args);
+        phg_wsx_input_unlock();
       }
       else {
         ERR_REPORT(PHG_ERH, ERR260);
@@ -593,7 +607,9 @@ void pinit_choice3(
           break;
         }
         wsh = PHG_WSID(ws_id);
+        phg_wsx_input_lock();
         (*wsh->init_device)(wsh, &args);
+        phg_wsx_input_unlock();
       }
       else {
         ERR_REPORT(PHG_ERH, ERR260);
@@ -678,7 +694,9 @@ void pinit_val3(
                val_data_rec,
                sizeof(Pval_data3));
         wsh = PHG_WSID(ws_id);
+        phg_wsx_input_lock();
         (*wsh->init_device)(wsh, &args);
+        phg_wsx_input_unlock();
       }
       else {
         ERR_REPORT(PHG_ERH, ERR260);
@@ -710,12 +728,14 @@ void pset_pick_filter(
   if (idt != NULL) {
     if ((pick_num > 0) &&  (pick_num <= idt->num_devs.pick)) {
       wsh = PHG_WSID(ws_id);
+      phg_wsx_input_lock();
       (*wsh->set_filter)(wsh,
                          PHG_ARGS_FLT_PICK,
                          pick_num,
                          &filter->incl_set,
                          &filter->excl_set
                          );
+      phg_wsx_input_unlock();
     }
     else {
       ERR_REPORT(PHG_ERH, ERR250);
@@ -771,7 +791,9 @@ static void set_mode(
   args.mode = op_mode;
   args.echo = echo_switch;
 
+  phg_wsx_input_lock();
   (*wsh->set_device_mode)(wsh, &args);
+  phg_wsx_input_unlock();
 }
 
 /*******************************************************************************
@@ -951,7 +973,9 @@ static void sample_device(
   /* Process all events for workstation */
   while (phg_wsx_input_dispatch_next(wsh, PHG_EVT_TABLE));
 
+  phg_wsx_input_lock();
   (*wsh->sample_device)(wsh, dev_class, dev_num, ret);
+  phg_wsx_input_unlock();
 }
 
 /*******************************************************************************
@@ -1188,25 +1212,85 @@ int inp_dispatch_next(
                       Pint fn_id
                       )
 {
-  Pint i, err_ind;
-  Wst_input_wsdt *idt;
-  Wst_phigs_dt *dt;
-  Ws_handle wsh;
+  Pint i;
+  Psl_ws_info *wsinfo;
+  Pws_cat category;
   int status = FALSE;
 
+  if (PSL_WS_STATE(PHG_PSL) != PWS_ST_WSOP) {
+    return FALSE;
+  }
+  /* only the slots in use, no lookup by workstation id */
   for (i = 0; i < MAX_NO_OPEN_WS; i++) {
-    idt = input_ws_open(i, fn_id, &dt, &err_ind);
-    if (idt != NULL) {
-      if ((dt->ws_category == PCAT_IN) ||
-          (dt->ws_category == PCAT_OUTIN)) {
-        wsh = PHG_WSID(i);
-        status = phg_wsx_input_dispatch_next(wsh, PHG_EVT_TABLE);
+    wsinfo = &PHG_PSL->open_ws[i];
+    if (wsinfo->used) {
+      category = wsinfo->wstype->desc_tbl.phigs_dt.ws_category;
+      if ((category == PCAT_IN) || (category == PCAT_OUTIN)) {
+        if (phg_wsx_input_dispatch_next(PHG_WSID(wsinfo->wsid),
+                                        PHG_EVT_TABLE)) {
+          status = TRUE;
+        }
       }
     }
   }
   return status;
 }
 
+/*******************************************************************************
+ * inp_wait
+ *
+ * DESCR:       Block until an input workstation connection becomes readable,
+ *              the input queue is woken up or the timeout in milliseconds
+ *              expires
+ * RETURNS:     N/A
+ */
+static void inp_wait(
+                     time_t timeout
+                     )
+{
+  Pint i;
+  int j, k, num, num_fds = 0;
+  int fds[INP_MAX_WAIT_FDS];
+  struct pollfd pfds[INP_MAX_WAIT_FDS];
+  Psl_ws_info *wsinfo;
+  Pws_cat category;
+  Sin_event_queue *queue = PHG_INPUT_Q;
+
+  for (i = 0; i < MAX_NO_OPEN_WS; i++) {
+    wsinfo = &PHG_PSL->open_ws[i];
+    if (wsinfo->used) {
+      category = wsinfo->wstype->desc_tbl.phigs_dt.ws_category;
+      if ((category == PCAT_IN) || (category == PCAT_OUTIN)) {
+        num = phg_wsx_input_fds(PHG_WSID(wsinfo->wsid),
+                                fds,
+                                INP_MAX_WAIT_FDS - 1 - num_fds);
+        for (j = 0; j < num; j++) {
+          /* workstations may share a connection */
+          for (k = 0; k < num_fds && pfds[k].fd != fds[j]; k++);
+          if (k == num_fds) {
+            pfds[num_fds].fd = fds[j];
+            pfds[num_fds].events = POLLIN;
+            num_fds++;
+          }
+        }
+      }
+    }
+  }
+  if (queue->wakeup_fd >= 0) {
+    pfds[num_fds].fd = queue->wakeup_fd;
+    pfds[num_fds].events = POLLIN;
+    num_fds++;
+  }
+
+  SIN_Q_SET_WAITING(queue, TRUE);
+  /* an event may have been queued before the flag was seen */
+  if (SIN_Q_EMPTY(queue) && !phg_wsx_input_has_deferred()) {
+    poll(pfds, num_fds, (int) timeout);
+  }
+  SIN_Q_SET_WAITING(queue, FALSE);
+  phg_sin_q_clear_wakeup(queue);
+}
+
 /*******************************************************************************
  * inp_event_poll
  *
@@ -1330,8 +1414,9 @@ void pawait_event(
   unsigned size;
   Ppoint3 *pts;
   Ppick_path_elem *path;
-  time_t time, time1, time2;
+  time_t start, now;
   time_t limit = (time_t) (timeout * 1000.0);
+  int dispatched;
   Phg_ret_inp_event *revt = &ret.data.inp_event;
   Phg_inp_event_data ed;
 
@@ -1344,20 +1429,22 @@ void pawait_event(
     /* Process events one at time for each workstation
      * until one is available, or if the timeout expires
      */
-    time = 0;
+    phg_mtime(&start);
     do {
-      phg_mtime(&time1);
-      if (inp_dispatch_next(Pfn_await_event) == FALSE) {
-        /* If there where no events sleep a while */
-        phg_msleep(1);
-      }
+      dispatched = inp_dispatch_next(Pfn_await_event);
       inp_event_poll(&ret);
-      phg_mtime(&time2);
-      time += (time2 - time1);
-      if (time >= limit) {
+      if (revt->id.in_class != PIN_NONE) {
+        break;
+      }
+      phg_mtime(&now);
+      if (now - start >= limit) {
         break;
       }
-    } while (revt->id.in_class == PIN_NONE);
+      if (!dispatched) {
+        /* Nothing pending, sleep until input arrives or time is up */
+        inp_wait(limit - (now - start));
+      }
+    } while (TRUE);
     if (ret.err == 0) {
       *ws_id = revt->id.ws;
       *dev_class = revt->id.in_class;
@@ -1666,7 +1753,9 @@ static void request_device(
 #ifdef DEBUGINP
   printf("now in request_device\n");
 #endif
+  phg_wsx_input_lock();
   (*wsh->request_device)(wsh, dev_class, dev_num, ret);
+  phg_wsx_input_unlock();
 
 #ifdef DEBUGINP
   printf("Entering loop...\n");
@@ -1674,6 +1763,8 @@ static void request_device(
   do {
     while (phg_wsx_input_dispatch_next(wsh, PHG_EVT_TABLE));
 
+    /* the request may be satisfied by the input thread */
+    phg_wsx_input_lock();
     switch (dev_class) {
     case PHG_ARGS_INP_LOC:
     case PHG_ARGS_INP_LOC3:
@@ -1696,6 +1787,7 @@ static void request_device(
       in_status = inp->status.chstat;
       break;
     }
+    phg_wsx_input_unlock();
 
     phg_msleep(1);
 
@@ -70,6 +70,8 @@ void pinq_light_src_rep(
              dt->ws_category == PCAT_PDF ||
              dt->ws_category == PCAT_SVG ||
              dt->ws_category == PCAT_OBJ ||
+             dt->ws_category == PCAT_GLB ||
+             dt->ws_category == PCAT_PLY ||
              dt->ws_category == PCAT_OUTIN ||
              dt->ws_category == PCAT_MO) ) {
         *err_ind = ERR59;
@@ -23,7 +23,6 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
-#include <png.h>
 #ifdef GLEW
 #include <GL/glew.h>
 #include <GL/gl.h>
@@ -41,6 +40,7 @@
 #include "private/cbP.h"
 #include "private/wsglP.h"
 #include "private/wsxP.h"
+#include "private/hcopyP.h"
 #include "phconf.h"
 
 short int wsgl_use_shaders_settings;
@@ -82,6 +82,10 @@ void popen_ws(
     else if (!phg_psl_ws_free_slot(PHG_PSL)) {
       ERR_REPORT(PHG_ERH, ERR63);
     }
+    else if (ws_type == PWST_HCOPY_TRUE_OBJ && wsgl_obj_is_open()) {
+      /* the OBJ stream is shared, one OBJ workstation at a time */
+      ERR_REPORT(PHG_ERH, ERR63);
+    }
     else {
       wst = phg_wst_find(&PHG_WST_LIST, ws_type);
 
@@ -93,6 +97,7 @@ void popen_ws(
         args.width = config[ws_id].display_width;
         args.height = config[ws_id].display_height;
         args.hcsf = config[ws_id].hcsf;
+        args.hcopy_samples = config[ws_id].hcopy_samples;
 #ifdef DEBUG
         printf("cb_ws: WSID=%d type=%d scale factor %f\n", ws_id, ws_type, args.hcsf);
 #endif
@@ -102,6 +107,8 @@ void popen_ws(
         else {
           args.conn_info.background = 0;
           record_geom = FALSE;
+          record_mesh = MESH_NONE;
+          record_vec = VEC_NONE;
           if (
               ws_type == PWST_HCOPY_TRUE_TGA ||
               ws_type == PWST_HCOPY_TRUE_RGB_PNG ||
@@ -109,7 +116,9 @@ void popen_ws(
               ws_type == PWST_HCOPY_TRUE_EPS ||
               ws_type == PWST_HCOPY_TRUE_PDF ||
               ws_type == PWST_HCOPY_TRUE_SVG ||
-              ws_type == PWST_HCOPY_TRUE_OBJ
+              ws_type == PWST_HCOPY_TRUE_OBJ ||
+              ws_type == PWST_HCOPY_TRUE_GLB ||
+              ws_type == PWST_HCOPY_TRUE_PLY
               ) {
             args.conn_type = PHG_ARGS_CONN_HCOPY;
             args.width = config[ws_id].display_width*config[ws_id].hcsf;
@@ -124,14 +133,29 @@ void popen_ws(
         }
         switch (ws_type){
         case PWST_HCOPY_TRUE_EPS:
-        case PWST_HCOPY_TRUE_PDF:
-        case PWST_HCOPY_TRUE_SVG:
           /* switch off shaders for gl2ps exports */
           wsgl_use_shaders_settings = wsgl_use_shaders;
           wsgl_use_shaders = 0;
           break;
+        case PWST_HCOPY_TRUE_PDF:
+          record_geom = TRUE;
+          record_vec = VEC_PDF;
+          break;
+        case PWST_HCOPY_TRUE_SVG:
+          record_geom = TRUE;
+          record_vec = VEC_SVG;
+          break;
         case  PWST_HCOPY_TRUE_OBJ:
           record_geom = TRUE;
+          break;
+        case PWST_HCOPY_TRUE_GLB:
+          record_geom = TRUE;
+          record_mesh = MESH_GLB;
+          break;
+        case PWST_HCOPY_TRUE_PLY:
+          record_geom = TRUE;
+          record_mesh = MESH_PLY;
+          break;
         }
         args.wsid = ws_id;
         args.type = wst;
@@ -147,6 +171,7 @@ void popen_ws(
         args.limits = config[ws_id].vpos;
 
         /* Open workstation */
+        phg_wsx_input_lock();
         PHG_WSID(ws_id) = (*wst->desc_tbl.phigs_dt.ws_open)(&args, &ret);
         if (PHG_WSID(ws_id) == NULL) {
           ERR_REPORT(PHG_ERH, ERR900);
@@ -155,6 +180,13 @@ void popen_ws(
           /* Add workstation to info list */
           phg_psl_add_ws(PHG_PSL, ws_id, NULL, wst);
         }
+        phg_wsx_input_unlock();
+        if (PHG_WSID(ws_id) != NULL &&
+            (wst->desc_tbl.phigs_dt.ws_category == PCAT_IN ||
+             wst->desc_tbl.phigs_dt.ws_category == PCAT_OUTIN)) {
+          phg_wsx_input_thread_start();
+          phg_wsx_input_thread_notify();
+        }
         /* predefine some colors */
         pxset_color_map(ws_id);
         /* set background as specified in configuration file */
@@ -184,6 +216,12 @@ void popen_ws(
           case PCAT_OBJ:
             strcpy(wsh->filename, "output.obj");
             break;
+          case PCAT_GLB:
+            strcpy(wsh->filename, "output.glb");
+            break;
+          case PCAT_PLY:
+            strcpy(wsh->filename, "output.ply");
+            break;
           case PCAT_IN:
           case PCAT_OUT:
           case PCAT_OUTIN:
@@ -196,6 +234,16 @@ void popen_ws(
         } else {
           strncpy(wsh->filename, config[ws_id].filename, sizeof(wsh->filename));
         }
+        if (record_vec){
+          wsgl_begin_vec(wsh->filename, config[ws_id].window_title, record_vec,
+                         args.width, args.height);
+        }
+        else if (record_mesh){
+          wsgl_begin_mesh(wsh->filename, config[ws_id].window_title, record_mesh);
+        }
+        else if (record_geom){
+          wsgl_begin_obj(wsh->filename, config[ws_id].window_title);
+        }
         wsgl_clear(wsh);
       }
     }
@@ -219,17 +267,11 @@ void pclose_ws(
   Wst_phigs_dt *dt;
   Psl_ws_info *wsinfo;
   int width, height;
-  unsigned int buffer_size;
-  int error;
-  int channels;
-  int nvals;
-  int i;
   int clean_fb = FALSE;
+  int single_image = FALSE;
   int gl2ps = 0;
   int ctrl_flag = 0;
-  GLubyte * pixel_buffer;
-  png_byte ** png_rows;
-  png_structp png;
+  Hcopy_image image;
 
   if (phg_ws_open(ws_id, Pfn_close_ws) != NULL) {
     wsh = PHG_WSID(ws_id);
@@ -237,9 +279,25 @@ void pclose_ws(
     int height = wsh->type->desc_tbl.xwin_dt.tool.height;
     wsinfo = phg_psl_get_ws_info(PHG_PSL, ws_id);
     dt = &wsinfo->wstype->desc_tbl.phigs_dt;
+    if (wsh->egl_context != NULL) {
+      phg_wsx_make_current_headless(wsh);
+    }
     glFlush();
-    glFinish();
-    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    if (phg_hcopy_is_raster(dt->ws_category)) {
+      /* multi-frame output already has the last redraw */
+      single_image = (wsh->hcopy_frames == NULL);
+      phg_hcopy_frames_end(wsh);
+      if (single_image && wsh->hcopy_tile[0] > 0) {
+        /* too large for one frame buffer, streamed tile by tile */
+        phg_hcopy_write_tiled(wsh, dt->ws_category, wsh->filename);
+        single_image = FALSE;
+      }
+      else if (single_image) {
+        /* overlaps with the rest of closing, collected before cleanup */
+        phg_hcopy_read_begin(wsh, dt->ws_category, width, height);
+      }
+      clean_fb = TRUE;
+    }
 
     switch (dt->ws_category){
     case PCAT_IN:
@@ -247,123 +305,19 @@ void pclose_ws(
     case PCAT_OUTIN:
     case PCAT_MO:
     case PCAT_MI:
-      break;
     case PCAT_TGA:
-      buffer_size = 3*width*height*sizeof(GLubyte);
-      pixel_buffer = (GLubyte * ) malloc(buffer_size);
-      glReadPixels(0, 0, width, height, GL_BGR_EXT, GL_UNSIGNED_BYTE, pixel_buffer);
-      error = glGetError();
-      if (error != GL_NO_ERROR ){
-        printf("PCLOSEWS ERROR: glReadPixel returned error code %d\n", error);
-      }
-      short header[] = {0, 2, 0, 0, 0, 0, (short) width, (short) height, 24};
-      wsh->fd = fopen(wsh->filename, "w+");
-      fwrite(&header, sizeof(header), 1, wsh->fd);
-      fwrite(pixel_buffer, buffer_size, 1, wsh->fd);
-      fclose(wsh->fd);
-      free(pixel_buffer);
-      clean_fb = TRUE;
-      break;
     case PCAT_PNG:
-      png_rows = (png_byte**)malloc(height * sizeof(png_byte*));
-      channels = 3;
-      buffer_size = channels*width*height*sizeof(GLubyte);
-      pixel_buffer = (GLubyte*) malloc(buffer_size);
-      nvals = channels * width * height;
-      glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixel_buffer);
-      error = glGetError();
-      if (error != GL_NO_ERROR ){
-        printf("PCLOSEWS ERROR: glReadPixel returned error code %d\n", error);
-      }
-      for (i=0; i<height; i++){
-        png_rows[i] = &(pixel_buffer[ (height - i - 1) * width * channels]);
-        }
-        png = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
-        if (png) {
-          png_infop info = png_create_info_struct(png);
-          if (info){
-            wsh->fd = fopen(wsh->filename, "w+");
-            setjmp(png_jmpbuf(png));
-            png_init_io(png, wsh->fd);
-            png_set_IHDR(
-                         png,
-                         info,
-                         width, height,
-                         8,
-                         PNG_COLOR_TYPE_RGB,
-                         PNG_INTERLACE_NONE,
-                         PNG_COMPRESSION_TYPE_DEFAULT,
-                         PNG_FILTER_TYPE_DEFAULT
-                         );
-            png_write_info(png, info);
-            png_write_image(png, png_rows);
-            png_write_end(png, NULL);
-            fclose(wsh->fd);
-          } else {
-            printf("PNG export error: failed to create info structure\n");
-          }
-          png_destroy_write_struct(&png, &info);
-        } else {
-          printf("PNG export error: failed to create write structure\n");
-        }
-        free(pixel_buffer);
-      free(png_rows);
-      clean_fb = TRUE;
-      break;
     case PCAT_PNGA:
-      channels = 4;
-      png_rows = (png_byte**)malloc(height * sizeof(png_byte*));
-      buffer_size = channels*width*height*sizeof(GLubyte);
-      pixel_buffer = (GLubyte*) malloc(buffer_size);
-      nvals = channels * width * height;
-      glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixel_buffer);
-      error = glGetError();
-      if (error != GL_NO_ERROR ){
-        printf("PCLOSEWS ERROR: glReadPixel returned error code %d\n", error);
-      }
-      for (i=0; i<height; i++){
-        png_rows[i] = &(pixel_buffer[ (height - i - 1) * width * channels]);
-      }
-      png = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
-      if (png) {
-        png_infop info = png_create_info_struct(png);
-        if (info){
-          wsh->fd = fopen(wsh->filename, "w+");
-          setjmp(png_jmpbuf(png));
-          png_init_io(png, wsh->fd);
-          png_set_IHDR(
-                       png,
-                       info,
-                       width, height,
-                       8,
-                       PNG_COLOR_TYPE_RGBA,
-                       PNG_INTERLACE_NONE,
-                       PNG_COMPRESSION_TYPE_DEFAULT,
-                       PNG_FILTER_TYPE_DEFAULT
-                       );
-          png_write_info(png, info);
-          png_write_image(png, png_rows);
-          png_write_end(png, NULL);
-          fclose(wsh->fd);
-        } else {
-          printf("PNG export error: failed to create info structure\n");
-        }
-        png_destroy_write_struct(&png, &info);
-      } else {
-        printf("PNG export error: failed to create write structure\n");
-      }
-      free(pixel_buffer);
-      free(png_rows);
-      clean_fb = TRUE;
       break;
     case PCAT_EPS:
       gl2ps = GL2PS_EPS;
       break;
     case PCAT_PDF:
-      gl2ps = GL2PS_PDF;
-      break;
     case PCAT_SVG:
-      gl2ps = GL2PS_SVG;
+      wsgl_export_vec();
+      record_geom = FALSE;
+      wsgl_clear_geometry();
+      clean_fb = TRUE;
       break;
     case PCAT_OBJ:
       wsgl_export_obj(wsh->filename, config[ws_id].window_title);
@@ -371,6 +325,13 @@ void pclose_ws(
       wsgl_clear_geometry();
       clean_fb = TRUE;
       break;
+    case PCAT_GLB:
+    case PCAT_PLY:
+      wsgl_export_mesh();
+      record_geom = FALSE;
+      wsgl_clear_geometry();
+      clean_fb = TRUE;
+      break;
     default:
       break;
     }
@@ -401,6 +362,16 @@ void pclose_ws(
       phg_css_unpost(owsb->cssh, str->structh->struct_id, wsh);
       str = str->higher;
     }
+    if (single_image) {
+      image.pixels = phg_hcopy_read_end(wsh, dt->ws_category, width, height);
+      if (image.pixels != NULL) {
+        image.category = dt->ws_category;
+        image.width = width;
+        image.height = height;
+        strncpy(image.filename, wsh->filename, sizeof(image.filename));
+        phg_hcopy_submit(&image);
+      }
+    }
     /* cleanup */
     if (wsh->glx_context){
       glXDestroyContext(wsh->display, wsh->glx_context);
@@ -419,8 +390,12 @@ void pclose_ws(
                  wsh->old_viewport[2],
                  wsh->old_viewport[3]);
     }
+    phg_wsx_input_lock();
+    phg_wsx_input_drop_deferred(wsh);
     (*wsh->close)(wsh);
     phg_psl_rem_ws(PHG_PSL, ws_id);
+    phg_wsx_input_unlock();
+    phg_wsx_input_thread_notify();
 
   } else {
     printf("PCLOSEWS ERROR: workstation was not open. Ignoring function.");
@@ -671,6 +646,8 @@ void pset_hlhsr_mode(
           dt->ws_category == PCAT_PDF ||
           dt->ws_category == PCAT_SVG ||
           dt->ws_category == PCAT_OBJ ||
+          dt->ws_category == PCAT_GLB ||
+          dt->ws_category == PCAT_PLY ||
           dt->ws_category == PCAT_OUTIN ||
           dt->ws_category == PCAT_MO)) {
       ERR_REPORT(PHG_ERH, ERR59);
@@ -936,6 +913,8 @@ void predraw_all_structs(
     case PCAT_PDF:
     case PCAT_SVG:
     case PCAT_OBJ:
+    case PCAT_GLB:
+    case PCAT_PLY:
     case PCAT_MO:
       wsh = PHG_WSID(ws_id);
       (*wsh->redraw_all)(wsh, ctrl_flag);
@@ -974,6 +953,8 @@ void pupd_ws(
     case PCAT_PDF:
     case PCAT_SVG:
     case PCAT_OBJ:
+    case PCAT_GLB:
+    case PCAT_PLY:
     case PCAT_MO:
       wsh = PHG_WSID(ws_id);
       (*wsh->update)(wsh, regen_flag);
@@ -1015,6 +996,8 @@ void pset_disp_upd_st(
     case PCAT_PDF:
     case PCAT_SVG:
     case PCAT_OBJ:
+    case PCAT_GLB:
+    case PCAT_PLY:
     case PCAT_MO:
       wsh = PHG_WSID(ws_id);
       (*wsh->set_disp_update_state)(wsh, def_mode, mod_mode);
@@ -1088,6 +1071,8 @@ void pset_light_src_rep(
           dt->ws_category == PCAT_PDF ||
           dt->ws_category == PCAT_SVG ||
           dt->ws_category == PCAT_OBJ ||
+          dt->ws_category == PCAT_GLB ||
+          dt->ws_category == PCAT_PLY ||
           dt->ws_category == PCAT_OUTIN ||
           dt->ws_category == PCAT_MO)) {
       ERR_REPORT(PHG_ERH, ERR59);
@@ -1364,6 +1349,8 @@ void pinq_list_line_inds(
             dt->ws_category == PCAT_PDF ||
             dt->ws_category == PCAT_SVG ||
             dt->ws_category == PCAT_OBJ ||
+            dt->ws_category == PCAT_GLB ||
+            dt->ws_category == PCAT_PLY ||
             dt->ws_category == PCAT_OUTIN ||
             dt->ws_category == PCAT_MO)) {
         *err_ind = ERR59;
@@ -1416,6 +1403,8 @@ void pinq_list_marker_inds(
             dt->ws_category == PCAT_PDF ||
             dt->ws_category == PCAT_SVG ||
             dt->ws_category == PCAT_OBJ ||
+            dt->ws_category == PCAT_GLB ||
+            dt->ws_category == PCAT_PLY ||
             dt->ws_category == PCAT_OUTIN ||
             dt->ws_category == PCAT_MO)) {
         *err_ind = ERR59;
@@ -1468,6 +1457,8 @@ void pinq_list_text_inds(
             dt->ws_category == PCAT_PDF ||
             dt->ws_category == PCAT_SVG ||
             dt->ws_category == PCAT_OBJ ||
+            dt->ws_category == PCAT_GLB ||
+            dt->ws_category == PCAT_PLY ||
             dt->ws_category == PCAT_OUTIN ||
             dt->ws_category == PCAT_MO)) {
         *err_ind = ERR59;
@@ -1520,6 +1511,8 @@ void pinq_list_int_inds(
             dt->ws_category == PCAT_PDF ||
             dt->ws_category == PCAT_SVG ||
             dt->ws_category == PCAT_OBJ ||
+            dt->ws_category == PCAT_GLB ||
+            dt->ws_category == PCAT_PLY ||
             dt->ws_category == PCAT_OUTIN ||
             dt->ws_category == PCAT_MO)) {
         *err_ind = ERR59;
@@ -1572,6 +1565,8 @@ void pinq_list_edge_inds(
             dt->ws_category == PCAT_PDF ||
             dt->ws_category == PCAT_SVG ||
             dt->ws_category == PCAT_OBJ ||
+            dt->ws_category == PCAT_GLB ||
+            dt->ws_category == PCAT_PLY ||
             dt->ws_category == PCAT_OUTIN ||
             dt->ws_category == PCAT_MO)) {
         *err_ind = ERR59;
@@ -1624,6 +1619,8 @@ void pinq_list_colr_inds(
             dt->ws_category == PCAT_PDF ||
             dt->ws_category == PCAT_SVG ||
             dt->ws_category == PCAT_OBJ ||
+            dt->ws_category == PCAT_GLB ||
+            dt->ws_category == PCAT_PLY ||
             dt->ws_category == PCAT_OUTIN ||
             dt->ws_category == PCAT_MO)) {
         *err_ind = ERR59;
@@ -1677,6 +1674,8 @@ void pinq_line_rep(
             dt->ws_category == PCAT_PDF ||
             dt->ws_category == PCAT_SVG ||
             dt->ws_category == PCAT_OBJ ||
+            dt->ws_category == PCAT_GLB ||
+            dt->ws_category == PCAT_PLY ||
             dt->ws_category == PCAT_OUTIN ||
             dt->ws_category == PCAT_MO)) {
         *err_ind = ERR59;
@@ -1745,6 +1744,8 @@ void pinq_marker_rep(
             dt->ws_category == PCAT_PDF ||
             dt->ws_category == PCAT_SVG ||
             dt->ws_category == PCAT_OBJ ||
+            dt->ws_category == PCAT_GLB ||
+            dt->ws_category == PCAT_PLY ||
             dt->ws_category == PCAT_OUTIN ||
             dt->ws_category == PCAT_MO)) {
         *err_ind = ERR59;
@@ -1813,6 +1814,8 @@ void pinq_text_rep(
             dt->ws_category == PCAT_PDF ||
             dt->ws_category == PCAT_SVG ||
             dt->ws_category == PCAT_OBJ ||
+            dt->ws_category == PCAT_GLB ||
+            dt->ws_category == PCAT_PLY ||
             dt->ws_category == PCAT_OUTIN ||
             dt->ws_category == PCAT_MO)) {
         *err_ind = ERR59;
@@ -1883,6 +1886,8 @@ void pinq_int_rep(
             dt->ws_category == PCAT_PDF ||
             dt->ws_category == PCAT_SVG ||
             dt->ws_category == PCAT_OBJ ||
+            dt->ws_category == PCAT_GLB ||
+            dt->ws_category == PCAT_PLY ||
             dt->ws_category == PCAT_OUTIN ||
             dt->ws_category == PCAT_MO)) {
         *err_ind = ERR59;
@@ -1951,6 +1956,8 @@ void pinq_edge_rep(
             dt->ws_category == PCAT_PDF ||
             dt->ws_category == PCAT_SVG ||
             dt->ws_category == PCAT_OBJ ||
+            dt->ws_category == PCAT_GLB ||
+            dt->ws_category == PCAT_PLY ||
             dt->ws_category == PCAT_OUTIN ||
             dt->ws_category == PCAT_MO)) {
         *err_ind = ERR59;
@@ -2020,6 +2027,8 @@ void pinq_colr_rep(
             dt->ws_category == PCAT_PDF ||
             dt->ws_category == PCAT_SVG ||
             dt->ws_category == PCAT_OBJ ||
+            dt->ws_category == PCAT_GLB ||
+            dt->ws_category == PCAT_PLY ||
             dt->ws_category == PCAT_OUTIN ||
             dt->ws_category == PCAT_MO)) {
         *err_ind = ERR59;
@@ -2084,6 +2093,8 @@ static void inq_filter(
             dt->ws_category == PCAT_PDF ||
             dt->ws_category == PCAT_SVG ||
             dt->ws_category == PCAT_OBJ ||
+            dt->ws_category == PCAT_GLB ||
+            dt->ws_category == PCAT_PLY ||
             dt->ws_category == PCAT_OUTIN ||
             dt->ws_category == PCAT_MO)) {
         *err_ind = ERR59;
@@ -2181,3 +2192,193 @@ void pmessage(
   args.msg_length = strlen(message);
   (*wsh->message)(wsh, &args);
 }
+
+/*******************************************************************************
+ * pxset_hcopy_frames
+ *
+ * DESCR:   Write an image file after each redraw of a TGA or PNG
+ *          workstation, NULL pattern for one image at close
+ * RETURNS:   N/A
+ */
+void pxset_hcopy_frames(
+                        Pint ws_id,
+                        char *pattern
+                        )
+{
+  Ws_handle wsh;
+
+  if (phg_ws_open(ws_id, Pfn_escape) != NULL) {
+    wsh = PHG_WSID(ws_id);
+    if (wsh->egl_context != NULL) {
+      phg_wsx_make_current_headless(wsh);
+    }
+    if (!phg_hcopy_frames_file(wsh, pattern)) {
+      ERR_REPORT(PHG_ERH, ERR59);
+    }
+  }
+}
+
+/*******************************************************************************
+ * pxset_hcopy_frame_buffer
+ *
+ * DESCR:   Read each redraw of a TGA or PNG workstation into the buffer
+ *          and pass it to func, NULL func to stop
+ * RETURNS:   N/A
+ */
+void pxset_hcopy_frame_buffer(
+                              Pint ws_id,
+                              void *buffer,
+                              size_t size,
+                              Phcopy_frame_func func
+                              )
+{
+  Ws_handle wsh;
+
+  if (phg_ws_open(ws_id, Pfn_escape) != NULL) {
+    wsh = PHG_WSID(ws_id);
+    if (wsh->egl_context != NULL) {
+      phg_wsx_make_current_headless(wsh);
+    }
+    if (!phg_hcopy_frames_buffer(wsh, buffer, size, func)) {
+      ERR_REPORT(PHG_ERH, ERR59);
+    }
+  }
+}
+
+/*******************************************************************************
+ * image_ws
+ *
+ * DESCR:   Get workstation that can render into memory
+ * RETURNS:   Workstation handle or NULL
+ */
+static Ws_handle image_ws(
+                          Pint ws_id,
+                          Pint *err_ind
+                          )
+{
+  Psl_ws_info *ws_info;
+  Ws_handle wsh = NULL;
+
+  if (!phg_entry_check(PHG_ERH, 0, Pfn_INQUIRY)) {
+    *err_ind = ERR3;
+  }
+  else if (PSL_WS_STATE(PHG_PSL) != PWS_ST_WSOP) {
+    *err_ind = ERR3;
+  }
+  else {
+    ws_info = phg_psl_get_ws_info(PHG_PSL, ws_id);
+    if (ws_info == NULL) {
+      *err_ind = ERR54;
+    }
+    else if (!phg_hcopy_is_raster(ws_info->wstype->desc_tbl.phigs_dt.ws_category)) {
+      *err_ind = ERR59;
+    }
+    else {
+      *err_ind = 0;
+      wsh = PHG_WSID(ws_id);
+    }
+  }
+
+  return wsh;
+}
+
+/*******************************************************************************
+ * pxinq_ws_image_size
+ *
+ * DESCR:   Get size in pixels of images rendered by a TGA or PNG workstation
+ * RETURNS:   N/A
+ */
+void pxinq_ws_image_size(
+                         Pint ws_id,
+                         Pint *err_ind,
+                         Pint *width,
+                         Pint *height
+                         )
+{
+  Ws_handle wsh;
+
+  wsh = image_ws(ws_id, err_ind);
+  if (wsh != NULL) {
+    *width = wsh->type->desc_tbl.xwin_dt.tool.width;
+    *height = wsh->type->desc_tbl.xwin_dt.tool.height;
+  }
+}
+
+/*******************************************************************************
+ * pxget_ws_image
+ *
+ * DESCR:   Render posted structures of a TGA or PNG workstation into
+ *          a caller buffer of 4 byte RGBA pixels
+ * RETURNS:   N/A
+ */
+void pxget_ws_image(
+                    Pint ws_id,
+                    Pint top_down,
+                    size_t size,
+                    Pint *err_ind,
+                    void *buffer
+                    )
+{
+  Ws_handle wsh;
+  size_t needed;
+
+  wsh = image_ws(ws_id, err_ind);
+  if (wsh != NULL) {
+    needed = (size_t) 4 *
+      wsh->type->desc_tbl.xwin_dt.tool.width *
+      wsh->type->desc_tbl.xwin_dt.tool.height;
+    if (buffer == NULL || size < needed) {
+      *err_ind = ERR2001;
+    }
+    else {
+      (*wsh->redraw_all)(wsh, PFLAG_ALWAYS);
+      phg_hcopy_read_pixels(wsh, 4, top_down, buffer);
+    }
+  }
+}
+
+/*******************************************************************************
+ * pxget_ws_png
+ *
+ * DESCR:   Render posted structures of a TGA or PNG workstation and
+ *          encode them as PNG in memory, to be released with free
+ * RETURNS:   N/A
+ */
+void pxget_ws_png(
+                  Pint ws_id,
+                  Pint *err_ind,
+                  void **png,
+                  size_t *png_size
+                  )
+{
+  Ws_handle wsh;
+  Hcopy_mem mem;
+  unsigned char *pixels;
+  int width, height, channels;
+
+  *png = NULL;
+  *png_size = 0;
+  wsh = image_ws(ws_id, err_ind);
+  if (wsh != NULL) {
+    width = wsh->type->desc_tbl.xwin_dt.tool.width;
+    height = wsh->type->desc_tbl.xwin_dt.tool.height;
+    channels =
+      (wsh->type->desc_tbl.phigs_dt.ws_category == PCAT_PNGA) ? 4 : 3;
+    pixels = (unsigned char *) malloc((size_t) channels * width * height);
+    if (pixels == NULL) {
+      *err_ind = ERR900;
+    }
+    else {
+      (*wsh->redraw_all)(wsh, PFLAG_ALWAYS);
+      phg_hcopy_read_pixels(wsh, channels, FALSE, pixels);
+      if (phg_hcopy_encode_png(pixels, width, height, channels, &mem)) {
+        *png = mem.data;
+        *png_size = mem.size;
+      }
+      else {
+        *err_ind = ERR900;
+      }
+      free(pixels);
+    }
+  }
+}
@@ -32,6 +32,8 @@
 #include "phconf.h"
 #include "private/wsglP.h"
 #include "ws.h"
+#include "private/hcopyP.h"
+#include "private/wsxP.h"
 
 int max_wkid = 100;
 Pophconf config[256];
@@ -56,6 +58,7 @@ void set_defaults(Pophconf* config){
     config->vpos.y_max = 1.;
     config->set_window_pos = 1;
     config->hcsf = 1.0;
+    config->hcopy_samples = 0;
 }
 
 void init_defaults(){
@@ -89,6 +92,7 @@ void query_settings(){
              cf->vpos.y_max
              );
       printf("  HC Scale fac : %f\n", cf->hcsf);
+      printf("  HC Samples   : %d\n", cf->hcopy_samples);
     }
   }
 }
@@ -104,10 +108,20 @@ void read_config(char * config_file){
   float xmin,  xmax, ymin, ymax;
   float red, green, blue;
   float hcsf;
+  int hcopy_samples;
   unsigned int width, height, border;
   int xpos, ypos;
   Pophconf newconfig;
   int use_shaders;
+  int use_marker_sprites;
+  int use_culling;
+  float lod_tolerance;
+  int use_headless;
+  int hcopy_threads;
+  int hcopy_tile_size;
+  int input_growable;
+  int input_thread;
+  int use_scene_copy;
 
   /* initialize output */
   newconfig.wkid = -1;
@@ -117,6 +131,11 @@ void read_config(char * config_file){
   /* defaults for updated configs */
   init_defaults();
   wsgl_use_shaders = 1;
+  wsgl_use_marker_sprites = 1;
+  wsgl_use_culling = 1;
+  wsgl_lod_tolerance = 0.0;
+  wsgl_use_headless = 0;
+  wsgl_use_scene_copy = 1;
 
   if (config_file == NULL){
     printf("No configuration file name defined. Using defaults instead.\n");
@@ -188,6 +207,10 @@ void read_config(char * config_file){
           newconfig.hcsf = hcsf;
           printf("Scale factor  is: %f\n", hcsf);
         }
+        if (sscanf(line, "%%hm %d", &hcopy_samples) > 0){
+          newconfig.hcopy_samples = (hcopy_samples > 1) ? hcopy_samples : 0;
+          printf("Hardcopy samples is: %d\n", newconfig.hcopy_samples);
+        }
         if (sscanf(line, "%%gs %d", &use_shaders) > 0){
           if (use_shaders == 0){
             wsgl_use_shaders = 0;
@@ -197,6 +220,85 @@ void read_config(char * config_file){
             printf("Shaders are ENABLED by configuration\n");
           }
         }
+        if (sscanf(line, "%%gm %d", &use_marker_sprites) > 0){
+          if (use_marker_sprites == 0){
+            wsgl_use_marker_sprites = 0;
+            printf("Marker sprites are DISABLED by configuration\n");
+          } else {
+            wsgl_use_marker_sprites = 1;
+            printf("Marker sprites are ENABLED by configuration\n");
+          }
+        }
+        if (sscanf(line, "%%gc %d", &use_culling) > 0){
+          if (use_culling == 0){
+            wsgl_use_culling = 0;
+            printf("Structure culling is DISABLED by configuration\n");
+          } else {
+            wsgl_use_culling = 1;
+            printf("Structure culling is ENABLED by configuration\n");
+          }
+        }
+        if (sscanf(line, "%%gl %f", &lod_tolerance) > 0){
+          if (lod_tolerance <= 0.0){
+            wsgl_lod_tolerance = 0.0;
+            printf("Level of detail is DISABLED by configuration\n");
+          } else {
+            wsgl_lod_tolerance = lod_tolerance;
+            printf("Level of detail is ENABLED by configuration, tolerance %f pixels\n", lod_tolerance);
+          }
+        }
+        if (sscanf(line, "%%gh %d", &use_headless) > 0){
+          if (use_headless == 0){
+            wsgl_use_headless = 0;
+            printf("Headless hardcopy is AUTOMATIC by configuration\n");
+          } else {
+            wsgl_use_headless = 1;
+            printf("Headless hardcopy is ENABLED by configuration\n");
+          }
+        }
+        if (sscanf(line, "%%ga %d", &hcopy_threads) > 0){
+          phg_hcopy_set_threads(hcopy_threads);
+          if (phg_hcopy_num_threads == 0){
+            printf("Background hardcopy encoding is DISABLED by configuration\n");
+          } else {
+            printf("Background hardcopy encoding is ENABLED by configuration, %d threads\n", phg_hcopy_num_threads);
+          }
+        }
+        if (sscanf(line, "%%gt %d", &hcopy_tile_size) > 0){
+          if (hcopy_tile_size <= 0){
+            phg_hcopy_tile_size = 0;
+            printf("Hardcopy tile size is AUTOMATIC by configuration\n");
+          } else {
+            phg_hcopy_tile_size = hcopy_tile_size;
+            printf("Hardcopy tile size is %d pixels by configuration\n", hcopy_tile_size);
+          }
+        }
+        if (sscanf(line, "%%gq %d", &input_growable) > 0){
+          if (input_growable == 0){
+            phg_sin_q_growable = 0;
+            printf("Growable input queue is DISABLED by configuration\n");
+          } else {
+            phg_sin_q_growable = 1;
+            printf("Growable input queue is ENABLED by configuration\n");
+          }
+        }
+        if (sscanf(line, "%%gi %d", &input_thread) > 0){
+          if (input_thread == 0){
+            printf("Input thread is DISABLED by configuration\n");
+          } else {
+            phg_wsx_input_thread_init();
+            printf("Input thread is ENABLED by configuration\n");
+          }
+        }
+        if (sscanf(line, "%%gr %d", &use_scene_copy) > 0){
+          if (use_scene_copy == 0){
+            wsgl_use_scene_copy = 0;
+            printf("Repairing exposures from a frame copy is DISABLED by configuration\n");
+          } else {
+            wsgl_use_scene_copy = 1;
+            printf("Repairing exposures from a frame copy is ENABLED by configuration\n");
+          }
+        }
         if (sscanf(line, "%%pc %d", &printconf) > 0){
           if (printconf == 0){
             printf("Printing configuration will be suppressed\n");
@@ -0,0 +1,550 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************
+* Changes:   Copyright (C) 2022-2023 CERN
+******************************************************************************/
+
+/*
+ * Cached modelling coordinate bounds of structure networks.
+ *
+ * The bounds of a structure cover all output primitives of the structure
+ * and of every structure it executes, expressed in the modelling
+ * coordinates the structure is entered with. They are computed lazily
+ * the first time they are asked for and invalidated whenever the
+ * structure, or any structure below it, is edited.
+ *
+ * Markers are sized in modelling coordinates by the renderer, so the
+ * box holds the marker positions only and the required padding is kept
+ * separately: marker_size is the padding due to marker sizes set inside
+ * the network, marker_scale the largest scaling applied to markers that
+ * use a size inherited from the caller.
+ *
+ * Structures whose extent cannot be known before traversal (text,
+ * global modelling transformations, view changes) are flagged
+ * unbounded and never culled.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "phg.h"
+#include "css.h"
+#include "private/phgP.h"
+#include "private/fasd3P.h"
+#include "private/sofas3P.h"
+
+#define BND_SIZE_INHERITED	-1.0
+#define BND_DIM_SOA		0	/* x, y and z arrays one after another */
+
+typedef struct {
+    Css_bounds	*bnd;
+    Pmatrix3	tran;
+    Pfloat	scale;
+    Pfloat	marker_size;	/* individual size or BND_SIZE_INHERITED */
+    int		marker_ind_set;	/* bundled size no longer the caller's */
+} Css_bnd_state;
+
+/*******************
+
+    css_bnd_tran_scale - Upper bound of the scaling done by a transformation,
+			 sqrt(norm_1 * norm_inf) of the linear part
+
+*******************/
+
+static Pfloat css_bnd_tran_scale(Pmatrix3 m)
+{
+    Pfloat	row, col, max_row = 0.0, max_col = 0.0;
+    int		i, j;
+
+    for (i = 0; i < 3; i++) {
+	row = col = 0.0;
+	for (j = 0; j < 3; j++) {
+	    row += fabs(m[i][j]);
+	    col += fabs(m[j][i]);
+	}
+	if (row > max_row) max_row = row;
+	if (col > max_col) max_col = col;
+    }
+
+    return (Pfloat) sqrt((double) (max_row * max_col));
+}
+
+/*******************
+
+    css_bnd_add_point - Add a point in the current modelling coordinates
+
+*******************/
+
+static void css_bnd_add_point(Css_bnd_state *st, Pfloat x, Pfloat y, Pfloat z)
+{
+    Css_bounds	*bnd = st->bnd;
+    Pfloat	(*m)[4] = st->tran;
+    Pfloat	tx, ty, tz;
+
+    tx = m[0][0] * x + m[0][1] * y + m[0][2] * z + m[0][3];
+    ty = m[1][0] * x + m[1][1] * y + m[1][2] * z + m[1][3];
+    tz = m[2][0] * x + m[2][1] * y + m[2][2] * z + m[2][3];
+
+    if (bnd->state != CSS_BOUNDS_VALID) {
+	bnd->state = CSS_BOUNDS_VALID;
+	bnd->box.x_min = bnd->box.x_max = tx;
+	bnd->box.y_min = bnd->box.y_max = ty;
+	bnd->box.z_min = bnd->box.z_max = tz;
+	return;
+    }
+
+    if (tx < bnd->box.x_min) bnd->box.x_min = tx;
+    if (tx > bnd->box.x_max) bnd->box.x_max = tx;
+    if (ty < bnd->box.y_min) bnd->box.y_min = ty;
+    if (ty > bnd->box.y_max) bnd->box.y_max = ty;
+    if (tz < bnd->box.z_min) bnd->box.z_min = tz;
+    if (tz > bnd->box.z_max) bnd->box.z_max = tz;
+}
+
+/*******************
+
+    css_bnd_add_soa - Add points held as separate coordinate arrays, one
+		      pass over the arrays per transformed coordinate
+
+*******************/
+
+static void css_bnd_add_soa(Css_bnd_state *st, Pint num, Pfloat *x)
+{
+    Css_bounds	*bnd = st->bnd;
+    Pfloat	(*m)[4] = st->tran;
+    Pfloat	*y = &x[num];
+    Pfloat	*z = &y[num];
+    Pfloat	t, min[3], max[3];
+    Pint	i;
+    int		j;
+
+    if (num <= 0)
+	return;
+
+    for (j = 0; j < 3; j++) {
+	min[j] = max[j] = m[j][0] * x[0] + m[j][1] * y[0] + m[j][2] * z[0];
+	for (i = 1; i < num; i++) {
+	    t = m[j][0] * x[i] + m[j][1] * y[i] + m[j][2] * z[i];
+	    min[j] = (t < min[j]) ? t : min[j];
+	    max[j] = (t > max[j]) ? t : max[j];
+	}
+	min[j] += m[j][3];
+	max[j] += m[j][3];
+    }
+
+    if (bnd->state != CSS_BOUNDS_VALID) {
+	bnd->state = CSS_BOUNDS_VALID;
+	bnd->box.x_min = min[0]; bnd->box.x_max = max[0];
+	bnd->box.y_min = min[1]; bnd->box.y_max = max[1];
+	bnd->box.z_min = min[2]; bnd->box.z_max = max[2];
+	return;
+    }
+
+    if (min[0] < bnd->box.x_min) bnd->box.x_min = min[0];
+    if (max[0] > bnd->box.x_max) bnd->box.x_max = max[0];
+    if (min[1] < bnd->box.y_min) bnd->box.y_min = min[1];
+    if (max[1] > bnd->box.y_max) bnd->box.y_max = max[1];
+    if (min[2] < bnd->box.z_min) bnd->box.z_min = min[2];
+    if (max[2] > bnd->box.z_max) bnd->box.z_max = max[2];
+}
+
+/*******************
+
+    css_bnd_add_points - Add a list of 2D or 3D points, or BND_DIM_SOA
+			 coordinate arrays
+
+*******************/
+
+static void css_bnd_add_points(Css_bnd_state *st, Pint num, void *pts,
+                               int dim)
+{
+    Pint	i;
+    Ppoint	*p2;
+    Ppoint3	*p3;
+
+    if (dim == BND_DIM_SOA) {
+	css_bnd_add_soa(st, num, (Pfloat *) pts);
+    } else if (dim == 2) {
+	p2 = (Ppoint *) pts;
+	for (i = 0; i < num; i++)
+	    css_bnd_add_point(st, p2[i].x, p2[i].y, 0.0);
+    } else {
+	p3 = (Ppoint3 *) pts;
+	for (i = 0; i < num; i++)
+	    css_bnd_add_point(st, p3[i].x, p3[i].y, p3[i].z);
+    }
+}
+
+/*******************
+
+    css_bnd_add_vdata - Add the points of a facet vertex data list
+
+*******************/
+
+static void css_bnd_add_vdata(Css_bnd_state *st, Pint vflag,
+                              Pfacet_vdata_list3 *vdata)
+{
+    Pint	i;
+
+    for (i = 0; i < vdata->num_vertices; i++) {
+	switch (vflag) {
+	    case PVERT_COORD_COLOUR:
+		css_bnd_add_point(st,
+				  vdata->vertex_data.ptcolrs[i].point.x,
+				  vdata->vertex_data.ptcolrs[i].point.y,
+				  vdata->vertex_data.ptcolrs[i].point.z);
+		break;
+	    case PVERT_COORD_NORMAL:
+		css_bnd_add_point(st,
+				  vdata->vertex_data.ptnorms[i].point.x,
+				  vdata->vertex_data.ptnorms[i].point.y,
+				  vdata->vertex_data.ptnorms[i].point.z);
+		break;
+	    case PVERT_COORD_COLOUR_NORMAL:
+		css_bnd_add_point(st,
+				  vdata->vertex_data.ptconorms[i].point.x,
+				  vdata->vertex_data.ptconorms[i].point.y,
+				  vdata->vertex_data.ptconorms[i].point.z);
+		break;
+	    default:
+		css_bnd_add_point(st,
+				  vdata->vertex_data.points[i].x,
+				  vdata->vertex_data.points[i].y,
+				  vdata->vertex_data.points[i].z);
+		break;
+	}
+    }
+}
+
+/*******************
+
+    css_bnd_add_markers - Add marker positions and account for their size
+
+*******************/
+
+static void css_bnd_add_markers(Css_bnd_state *st, Pint num, void *pts,
+                                int dim)
+{
+    Css_bounds	*bnd = st->bnd;
+
+    if (st->marker_ind_set) {
+	bnd->state = CSS_BOUNDS_UNBOUNDED;
+	return;
+    }
+
+    css_bnd_add_points(st, num, pts, dim);
+    if (st->scale > bnd->marker_scale)
+	bnd->marker_scale = st->scale;
+    if (st->marker_size >= 0.0 &&
+	st->marker_size * st->scale > bnd->marker_size)
+	bnd->marker_size = st->marker_size * st->scale;
+}
+
+/*******************
+
+    css_bnd_add_child - Merge the bounds of an executed structure
+
+*******************/
+
+static void css_bnd_add_child(Css_bnd_state *st, Struct_handle child)
+{
+    Css_bounds	*bnd = st->bnd;
+    Css_bounds	*cbnd;
+    Pfloat	size;
+
+    cbnd = phg_css_struct_bounds(child);
+    if (cbnd->state == CSS_BOUNDS_UNBOUNDED) {
+	bnd->state = CSS_BOUNDS_UNBOUNDED;
+	return;
+    }
+    if (cbnd->state != CSS_BOUNDS_VALID)
+	return;
+
+    css_bnd_add_point(st, cbnd->box.x_min, cbnd->box.y_min, cbnd->box.z_min);
+    css_bnd_add_point(st, cbnd->box.x_max, cbnd->box.y_min, cbnd->box.z_min);
+    css_bnd_add_point(st, cbnd->box.x_min, cbnd->box.y_max, cbnd->box.z_min);
+    css_bnd_add_point(st, cbnd->box.x_max, cbnd->box.y_max, cbnd->box.z_min);
+    css_bnd_add_point(st, cbnd->box.x_min, cbnd->box.y_min, cbnd->box.z_max);
+    css_bnd_add_point(st, cbnd->box.x_max, cbnd->box.y_min, cbnd->box.z_max);
+    css_bnd_add_point(st, cbnd->box.x_min, cbnd->box.y_max, cbnd->box.z_max);
+    css_bnd_add_point(st, cbnd->box.x_max, cbnd->box.y_max, cbnd->box.z_max);
+
+    size = cbnd->marker_size * st->scale;
+    if (cbnd->marker_scale > 0.0) {
+	/* the child inherits the marker size in effect at this point */
+	if (st->marker_ind_set) {
+	    bnd->state = CSS_BOUNDS_UNBOUNDED;
+	    return;
+	}
+	if (st->marker_size >= 0.0)
+	    size += st->marker_size * cbnd->marker_scale * st->scale;
+	if (cbnd->marker_scale * st->scale > bnd->marker_scale)
+	    bnd->marker_scale = cbnd->marker_scale * st->scale;
+    }
+    if (size > bnd->marker_size)
+	bnd->marker_size = size;
+}
+
+/*******************
+
+    css_bnd_fasd3 - Add the vertices of a fill area set 3 with data
+
+*******************/
+
+static void css_bnd_fasd3(Css_bnd_state *st, void *pdata)
+{
+    Pfasd3		fasd3;
+    Pedge_data_list	edata;
+    Pfacet_vdata_list3	vdata;
+    Pint		i;
+
+    fasd3.edata = &edata;
+    fasd3.vdata = &vdata;
+    fasd3_head(&fasd3, pdata);
+    for (i = 0; i < fasd3.nfa; i++) {
+	css_bnd_add_vdata(st, fasd3.vflag, fasd3.vdata);
+	if (i < fasd3.nfa - 1)
+	    fasd3_next_vdata3(&fasd3);
+    }
+}
+
+/*******************
+
+    css_bnd_sofas3 - Add the vertices of a set of fill area set 3 with data
+
+*******************/
+
+static void css_bnd_sofas3(Css_bnd_state *st, void *pdata)
+{
+    Psofas3	sofas3;
+
+    sofas3_head(&sofas3, pdata);
+    css_bnd_add_vdata(st, sofas3.vflag, &sofas3.vdata);
+}
+
+/*******************
+
+    css_bnd_element - Add a single element to the bounds
+
+*******************/
+
+static void css_bnd_element(Css_bnd_state *st, El_handle el)
+{
+    Pint		*data;
+    Pint		i, num_lists;
+    Plocal_tran3	tran3;
+
+    switch (el->eltype) {
+	case PELEM_POLYLINE:
+	case PELEM_FILL_AREA:
+	    data = (Pint *) ELMT_CONTENT(el);
+	    css_bnd_add_points(st, data[0], &data[1], 2);
+	    break;
+
+	case PELEM_POLYLINE3:
+	case PELEM_FILL_AREA3:
+	    data = (Pint *) ELMT_CONTENT(el);
+	    css_bnd_add_points(st, data[0], &data[1], 3);
+	    break;
+
+	case PELEM_POLYLINE3_SOA:
+	case PELEM_FILL_AREA3_SOA:
+	    data = (Pint *) ELMT_CONTENT(el);
+	    css_bnd_add_points(st, data[0], &data[1], BND_DIM_SOA);
+	    break;
+
+	case PELEM_POLYMARKER:
+	    data = (Pint *) ELMT_CONTENT(el);
+	    css_bnd_add_markers(st, data[0], &data[1], 2);
+	    break;
+
+	case PELEM_POLYMARKER3:
+	    data = (Pint *) ELMT_CONTENT(el);
+	    css_bnd_add_markers(st, data[0], &data[1], 3);
+	    break;
+
+	case PELEM_POLYMARKER3_SOA:
+	    data = (Pint *) ELMT_CONTENT(el);
+	    css_bnd_add_markers(st, data[0], &data[1], BND_DIM_SOA);
+	    break;
+
+	case PELEM_FILL_AREA_SET:
+	    data = (Pint *) ELMT_CONTENT(el);
+	    num_lists = *data++;
+	    for (i = 0; i < num_lists; i++) {
+		css_bnd_add_points(st, data[0], &data[1], 2);
+		data = (Pint *) ((Ppoint *) &data[1] + data[0]);
+	    }
+	    break;
+
+	case PELEM_FILL_AREA_SET3:
+	    data = (Pint *) ELMT_CONTENT(el);
+	    num_lists = *data++;
+	    for (i = 0; i < num_lists; i++) {
+		css_bnd_add_points(st, data[0], &data[1], 3);
+		data = (Pint *) ((Ppoint3 *) &data[1] + data[0]);
+	    }
+	    break;
+
+	case PELEM_FILL_AREA_SET3_DATA:
+	    css_bnd_fasd3(st, ELMT_CONTENT(el));
+	    break;
+
+	case PELEM_SET_OF_FILL_AREA_SET3_DATA:
+	    css_bnd_sofas3(st, ELMT_CONTENT(el));
+	    break;
+
+	case PELEM_EXEC_STRUCT:
+	    css_bnd_add_child(st, (Struct_handle) el->eldata.ptr);
+	    break;
+
+	case PELEM_LOCAL_MODEL_TRAN3:
+	    phg_get_local_tran3(&tran3, ELMT_CONTENT(el));
+	    switch (tran3.compose_type) {
+		case PTYPE_PRECONCAT:
+		    phg_mat_mul(st->tran, st->tran, tran3.matrix);
+		    break;
+		case PTYPE_POSTCONCAT:
+		    phg_mat_mul(st->tran, tran3.matrix, st->tran);
+		    break;
+		case PTYPE_REPLACE:
+		default:
+		    phg_mat_copy(st->tran, tran3.matrix);
+		    break;
+	    }
+	    if (st->tran[3][0] != 0.0 || st->tran[3][1] != 0.0 ||
+		st->tran[3][2] != 0.0 || st->tran[3][3] != 1.0) {
+		/* projective modelling transformations are not bounded */
+		st->bnd->state = CSS_BOUNDS_UNBOUNDED;
+		break;
+	    }
+	    st->scale = css_bnd_tran_scale(st->tran);
+	    break;
+
+	case PELEM_MARKER_SIZE:
+	    st->marker_size = PHG_FLOAT(el);
+	    break;
+
+	case PELEM_MARKER_IND:
+	    st->marker_ind_set = TRUE;
+	    break;
+
+	case PELEM_FILL_AREA_SET_DATA:
+	case PELEM_TEXT:
+	case PELEM_TEXT3:
+	case PELEM_ANNO_TEXT_REL:
+	case PELEM_ANNO_TEXT_REL3:
+	case PELEM_GLOBAL_MODEL_TRAN3:
+	case PELEM_VIEW_IND:
+	    st->bnd->state = CSS_BOUNDS_UNBOUNDED;
+	    break;
+
+	default:
+	    break;
+    }
+}
+
+/*******************
+
+    css_bnd_compute - Compute the bounds of a structure network
+
+*******************/
+
+static void css_bnd_compute(Struct_handle structp)
+{
+    Css_bnd_state	st;
+    El_handle		el;
+
+    st.bnd = &structp->bounds;
+    st.bnd->state = CSS_BOUNDS_EMPTY;
+    st.bnd->marker_size = 0.0;
+    st.bnd->marker_scale = 0.0;
+    phg_mat_identity(st.tran);
+    st.scale = 1.0;
+    st.marker_size = BND_SIZE_INHERITED;
+    st.marker_ind_set = FALSE;
+
+    if (structp->num_el == 0)
+	return;
+
+    el = structp->first_el;
+    while (1) {
+	css_bnd_element(&st, el);
+	if (st.bnd->state == CSS_BOUNDS_UNBOUNDED)
+	    break;
+	if (el == structp->last_el)
+	    break;
+	el = el->next;
+    }
+}
+
+/*******************
+
+    phg_css_struct_bounds - Get the bounds of a structure network,
+			    computing them if they are not cached
+
+*******************/
+
+Css_bounds* phg_css_struct_bounds(Struct_handle structp)
+{
+    if (structp->bounds.state == CSS_BOUNDS_INVALID)
+	css_bnd_compute(structp);
+
+    return &structp->bounds;
+}
+
+/*******************
+
+    phg_css_bounds_invalidate - Invalidate the bounds of a structure and
+				of all structures that execute it
+
+*******************/
+
+void phg_css_bounds_invalidate(Struct_handle structp)
+{
+    Css_set_element	*parent;
+
+    if (structp->bounds.state == CSS_BOUNDS_INVALID)
+	return;
+
+    structp->bounds.state = CSS_BOUNDS_INVALID;
+    if (structp->refer_to_me) {
+	for (parent = structp->refer_to_me->elements->next; parent;
+	     parent = parent->next)
+	    phg_css_bounds_invalidate((Struct_handle) parent->key);
+    }
+}
+
+/*******************
+
+    phg_css_bounds_invalidate_all - Invalidate the bounds of all structures
+
+*******************/
+
+void phg_css_bounds_invalidate_all(Css_handle cssh)
+{
+    Css_hash_block	*block;
+    int			i;
+
+    for (i = 0; i < cssh->stab->size; i++) {
+	for (block = cssh->stab->table[i]->next; block; block = block->next)
+	    block->struct_ptr->bounds.state = CSS_BOUNDS_INVALID;
+    }
+}
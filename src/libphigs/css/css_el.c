@@ -77,6 +77,7 @@ int phg_css_add_elem(Css_handle cssh, Phg_args_add_el *args)
 {
     El_handle elptr;
 
+    phg_css_struct_modified(cssh->open_struct);
     if ( (cssh->edit_mode == PEDIT_INSERT) || (!cssh->el_index) ) {
 	/* in replace mode, if current element is #0, insert before element #1*/
 	CSS_CREATE_EL(cssh, elptr)
@@ -115,6 +116,42 @@ int phg_css_add_elem(Css_handle cssh, Phg_args_add_el *args)
     return(TRUE);
 }
 
+/*******************
+
+    phg_css_adopt_elem - Add an element like phg_css_add_elem, but take over
+		     the content instead of copying it. The content must be
+		     allocated behind room for the element head and is freed
+		     if the element cannot be added.
+
+*******************/
+
+int phg_css_adopt_elem(Css_handle cssh, Phg_args_add_el *args)
+{
+    El_handle elptr;
+
+    phg_css_struct_modified(cssh->open_struct);
+    if ( (cssh->edit_mode == PEDIT_INSERT) || (!cssh->el_index) ) {
+	if ( !(elptr = (El_handle) malloc(sizeof(Css_structel))) ) {
+	    free(((Phg_elmt_info *) args->el_data) - 1);
+	    ERR_BUF(cssh->erh, ERR900);
+	    return(FALSE);				/* out of memory */
+	}
+	CSS_INSERT_EL(cssh, elptr)
+    } else {
+	/* replace mode, the old content is always released */
+	elptr = cssh->el_ptr;
+	(void)(*cssh->el_funcs[(int)elptr->eltype])
+	    (cssh, elptr, (caddr_t)cssh->open_struct, CSS_EL_FREE);
+    }
+    elptr->eltype = ARGS_ELMT_TYPE(args);
+    if (!(*cssh->el_funcs[(int)ARGS_ELMT_TYPE(args)]) (cssh, elptr,
+	    (caddr_t) args, CSS_EL_ADOPT)) {
+	ERR_BUF(cssh->erh, ERR901);
+	return(FALSE);
+    }
+    return(TRUE);
+}
+
 /*******************
 
     phg_css_set_ep - Set the element pointer as indicated by opcode. Return
@@ -350,6 +387,7 @@ void phg_css_delete_el(Css_handle cssh,
 	}
     }
 
+    phg_css_struct_modified(structp);
     /* remove group of elements from structure */
     ep1->prev->next = ep2->next;
     ep2->next->prev = ep1->prev;
@@ -458,6 +496,11 @@ int phg_css_struct_ref(Css_handle cssh,
       case CSS_EL_INQ_TYPE_SIZE:
         *((Pint *)argdata) = 0;
         break;
+
+      case CSS_EL_ADOPT:
+	/* only primitive content is taken over */
+	retval = FALSE;
+	break;
     }
     return(retval);
 }
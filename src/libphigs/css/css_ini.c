@@ -153,6 +153,9 @@ Css_handle phg_css_init(Err_handle erh, Css_ssh_type ssh_type)
     fptr[(int)PELEM_FILL_AREA_SET_DATA] = hdl_generic_elmt;
     fptr[(int)PELEM_ALPHA_CHANNEL] = hdl_generic_elmt;
     fptr[(int)PELEM_TEXT3] = hdl_generic_elmt;
+    fptr[(int)PELEM_POLYLINE3_SOA] = hdl_generic_elmt;
+    fptr[(int)PELEM_POLYMARKER3_SOA] = hdl_generic_elmt;
+    fptr[(int)PELEM_FILL_AREA3_SOA] = hdl_generic_elmt;
     fptr[(int)PELEM_GSE] = hdl_generic_elmt;
 
     if ( !(cssh->stab = phg_css_stab_init(CSS_STAB_SIZE)) ) {
@@ -239,6 +239,9 @@ void css_print_eltype(Pelem_type eltype)
         case PELEM_MODEL_CLIP_VOL3: name = "PELEM_MODEL_CLIP_VOL3"; break;
         case PELEM_MODEL_CLIP_IND: name = "PELEM_MODEL_CLIP_IND"; break;
         case PELEM_GSE: name = "PELEM_GSE"; break;
+        case PELEM_POLYLINE3_SOA: name = "PELEM_POLYLINE3_SOA"; break;
+        case PELEM_POLYMARKER3_SOA: name = "PELEM_POLYMARKER3_SOA"; break;
+        case PELEM_FILL_AREA3_SOA: name = "PELEM_FILL_AREA3_SOA"; break;
 
       default:
 	fprintf(stderr, "UNKNOWN TYPE: %d\n", eltype);
@@ -70,6 +70,9 @@ static int css_get_network(Css_handle cssh,
 static int css_change_ref_structp(Struct_handle oldref,
                                   Struct_handle newref);
 
+/* source of structure edit stamps, unique over all structures */
+static unsigned long css_edit_stamp = 0;
+
 #define CSS_ADD_NEW_STRUCT(cssh, structid, structp) \
     if ( !((structp) = phg_css_create_struct((structid))) ) { \
 	ERR_BUF((cssh)->erh, ERR901); \
@@ -141,6 +144,7 @@ int phg_css_copy_struct(Css_handle cssh, Struct_handle structp)
 	skip_copies = cssh->el_index;
     else
 	skip_copies = 0;
+    phg_css_struct_modified(cssh->open_struct);
     elptr = structp->first_el->next;
     for (i = 1; i <= n; i++) {
 	CSS_CREATE_EL(cssh, elnew)
@@ -186,6 +190,7 @@ void phg_css_delete_struct(Css_handle cssh, Struct_handle delstruct)
     refstruct = delstruct->refer_to_me->elements->next;
     while (refstruct) {
 	rstructp = (Struct_handle)refstruct->key;
+	phg_css_struct_modified(rstructp);
 	(void) phg_css_set_element_of(rstructp->i_refer_to,
 	    (caddr_t)delstruct, (caddr_t *)&el_set);
 	/* remove exec struct elements from each struct referencing delstruct */
@@ -464,6 +469,7 @@ Css_ws_list phg_css_change_struct_id(Css_handle cssh,
     Css_set_ptr		el_set;
     Css_ws_list		wsnext;
 
+    phg_css_bounds_invalidate_all(cssh);
     cssh->ws_list->wsh = NULL;
     if (!phg_css_join_ws_list(cssh, orig, newst, &cssh->ws_list, CSS_WS_APPEAR))
 	return(NULL);					/* out of memory */
@@ -583,6 +589,7 @@ Css_ws_list phg_css_change_struct_refs(Css_handle cssh,
     Css_ws_list		wssave = NULL;
     int			was_posted;
 
+    phg_css_bounds_invalidate_all(cssh);
     cssh->ws_list->wsh = NULL;
     if (orig && orig->refer_to_me->num_elements) {
 	/* nothing to do if no references to orig */
@@ -643,6 +650,7 @@ Css_ws_list phg_css_change_struct_idrefs(Css_handle cssh,
     Struct_handle	structp;
     Css_ws_list		wsnext;
 
+    phg_css_bounds_invalidate_all(cssh);
     cssh->ws_list->wsh = NULL;
     if (!phg_css_join_ws_list(cssh, (Struct_handle)NULL, newst,
 	    &cssh->ws_list, CSS_WS_APPEAR))
@@ -832,10 +840,26 @@ Struct_handle phg_css_create_struct(Pint id)
 
     s->struct_id = id;
     s->num_el = 0;
+    s->edit_stamp = ++css_edit_stamp;
+    s->bounds.state = CSS_BOUNDS_INVALID;
 
     return(s);
 }
 
+/*******************
+
+    phg_css_struct_modified - Note that the elements of a structure changed.
+			      Gives the structure a new edit stamp and
+			      invalidates the cached bounds.
+
+*******************/
+
+void phg_css_struct_modified(Struct_handle structp)
+{
+    structp->edit_stamp = ++css_edit_stamp;
+    phg_css_bounds_invalidate(structp);
+}
+
 /*******************
 
     css_struct_free - free all data used by this structure
@@ -27,6 +27,7 @@
 #include "css.h"
 #include "private/phgP.h"
 #include "util/ftn.h"
+#include "util/pack.h"
 
 /*******************************************************************************
  * ppl
@@ -42,7 +43,7 @@ FTN_SUBROUTINE(ppl)(
 {
   Phg_args_add_el args;
   Pint *data;
-  Pint i, num_points;
+  Pint num_points;
   Ppoint *points;
 #ifdef DEBUG
   printf("DEBUG: PPL create poly line\n");
@@ -64,10 +65,7 @@ FTN_SUBROUTINE(ppl)(
         data = (Pint *) args.el_data;
         data[0] = num_points;
         points = (Ppoint *) &data[1];
-        for (i = 0; i < num_points; i++) {
-          points[i].x = FTN_REAL_ARRAY_GET(pxa, i);
-          points[i].y = FTN_REAL_ARRAY_GET(pya, i);
-        }
+        phg_pack_points(points, pxa, pya, num_points);
         phg_add_el(PHG_CSS, &args);
       }
     }
@@ -89,7 +87,6 @@ FTN_SUBROUTINE(ppl3)(
 {
   Pint num_points = FTN_INTEGER_GET(n);
   Phg_args_add_el args;
-  Pint i;
   Pint  *data;
   Ppoint3 *point;
 
@@ -111,11 +108,7 @@ FTN_SUBROUTINE(ppl3)(
         data = (Pint *) args.el_data;
         data[0] = (Pint) num_points;
         point = (Ppoint3*) &data[1];
-        for (i = 0; i < num_points; i++) {
-          point[i].x = FTN_REAL_ARRAY_GET(pxa, i);
-          point[i].y = FTN_REAL_ARRAY_GET(pya, i);
-          point[i].z = FTN_REAL_ARRAY_GET(pza, i);
-        }
+        phg_pack_points3(point, pxa, pya, pza, num_points);
         phg_add_el(PHG_CSS, &args);
       }
     }
@@ -347,7 +340,6 @@ FTN_SUBROUTINE(pfa)(
 #endif
   Pint num_points = FTN_INTEGER_GET(n);
   Phg_args_add_el args;
-  Pint i;
   Pint  *data;
   Ppoint *point;
   if (phg_entry_check(PHG_ERH, 0, Pfn_fill_area)) {
@@ -365,10 +357,7 @@ FTN_SUBROUTINE(pfa)(
         data = (Pint *) args.el_data;
         data[0] = num_points;
         point = (Ppoint*) &data[1];
-        for (i=0; i<num_points;i++){
-          point[i].x = FTN_REAL_ARRAY_GET(pxa, i);
-          point[i].y = FTN_REAL_ARRAY_GET(pya, i);
-        }
+        phg_pack_points(point, pxa, pya, num_points);
         phg_add_el(PHG_CSS, &args);
       }
     }
@@ -393,7 +382,6 @@ FTN_SUBROUTINE(pfa3)(
 #endif
   Pint num_points = FTN_INTEGER_GET(n);
   Phg_args_add_el args;
-  Pint i;
   Pint  *data;
   Ppoint3 *point;
   if (phg_entry_check(PHG_ERH, 0, Pfn_fill_area)) {
@@ -411,11 +399,7 @@ FTN_SUBROUTINE(pfa3)(
         data = (Pint *) args.el_data;
         data[0] = num_points;
         point = (Ppoint3*) &data[1];
-        for (i=0; i<num_points;i++){
-          point[i].x = FTN_REAL_ARRAY_GET(pxa, i);
-          point[i].y = FTN_REAL_ARRAY_GET(pya, i);
-          point[i].z = FTN_REAL_ARRAY_GET(pza, i);
-        }
+        phg_pack_points3(point, pxa, pya, pza, num_points);
         phg_add_el(PHG_CSS, &args);
       }
     }
@@ -469,20 +453,31 @@ FTN_SUBROUTINE(ppm)(
                     FTN_REAL_ARRAY(pya)
                     )
 {
-  int num_points = FTN_INTEGER_GET(n);
-  Ppoint points[num_points];
-  Ppoint_list ppoint_list;
-  int i;
-  ppoint_list.num_points = num_points;
-  for (i=0; i<num_points; i++){
-    points[i].x = FTN_REAL_ARRAY_GET(pxa, i);
-    points[i].y = FTN_REAL_ARRAY_GET(pya, i);
-#ifdef DEBUG
-    printf("PPM %d pos %f %f\n", i, points[i].x, points[i].y);
-#endif
+  Pint num_points = FTN_INTEGER_GET(n);
+  Phg_args_add_el args;
+  Pint *data;
+  Ppoint *points;
+
+  if (phg_entry_check(PHG_ERH, ERR5, Pfn_polymarker)) {
+    if (PSL_STRUCT_STATE(PHG_PSL) != PSTRUCT_ST_STOP) {
+      ERR_REPORT(PHG_ERH, ERR5);
+    }
+    else {
+      args.el_type = PELEM_POLYMARKER;
+      args.el_size = sizeof(Pint) + sizeof(Ppoint) * num_points;
+      if (!PHG_SCRATCH_SPACE(&PHG_SCRATCH, args.el_size)) {
+        ERR_REPORT(PHG_ERH, ERR900);
+      }
+      else {
+        args.el_data = PHG_SCRATCH.buf;
+        data = (Pint *) args.el_data;
+        data[0] = num_points;
+        points = (Ppoint *) &data[1];
+        phg_pack_points(points, pxa, pya, num_points);
+        phg_add_el(PHG_CSS, &args);
+      }
+    }
   }
-  ppoint_list.points = &points[0];
-  ppolymarker(&ppoint_list);
 }
 
 /*******************************************************************************
@@ -498,18 +493,79 @@ FTN_SUBROUTINE(ppm3)(
                      FTN_REAL_ARRAY(pza)
                      )
 {
-  int num_points = FTN_INTEGER_GET(n);
-  Ppoint3 points[num_points];
-  Ppoint_list3 ppoint_list;
-  int i;
-  ppoint_list.num_points = num_points;
-  for (i=0; i<num_points; i++){
-    points[i].x = FTN_REAL_ARRAY_GET(pxa, i);
-    points[i].y = FTN_REAL_ARRAY_GET(pya, i);
-    points[i].z = FTN_REAL_ARRAY_GET(pza, i);
+  Pint num_points = FTN_INTEGER_GET(n);
+  Phg_args_add_el args;
+  Pint *data;
+  Ppoint3 *points;
+
+  if (phg_entry_check(PHG_ERH, ERR5, Pfn_polymarker3)) {
+    if (PSL_STRUCT_STATE(PHG_PSL) != PSTRUCT_ST_STOP) {
+      ERR_REPORT(PHG_ERH, ERR5);
+    }
+    else {
+      args.el_type = PELEM_POLYMARKER3;
+      args.el_size = sizeof(Pint) + sizeof(Ppoint3) * num_points;
+      if (!PHG_SCRATCH_SPACE(&PHG_SCRATCH, args.el_size)) {
+        ERR_REPORT(PHG_ERH, ERR900);
+      }
+      else {
+        args.el_data = PHG_SCRATCH.buf;
+        data = (Pint *) args.el_data;
+        data[0] = num_points;
+        points = (Ppoint3 *) &data[1];
+        phg_pack_points3(points, pxa, pya, pza, num_points);
+        phg_add_el(PHG_CSS, &args);
+      }
+    }
   }
-  ppoint_list.points = &points[0];
-  ppolymarker3(&ppoint_list);
+}
+
+/*******************************************************************************
+ * pxpl3s
+ *
+ * DESCR:   polyline 3 stored with separate coordinate arrays
+ * RETURNS:   N/A
+ */
+FTN_SUBROUTINE(pxpl3s)(
+                       FTN_INTEGER(n),
+                       FTN_REAL_ARRAY(pxa),
+                       FTN_REAL_ARRAY(pya),
+                       FTN_REAL_ARRAY(pza)
+                       )
+{
+  pxpolyline3_soa(FTN_INTEGER_GET(n), pxa, pya, pza);
+}
+
+/*******************************************************************************
+ * pxpm3s
+ *
+ * DESCR:   polymarker 3 stored with separate coordinate arrays
+ * RETURNS:   N/A
+ */
+FTN_SUBROUTINE(pxpm3s)(
+                       FTN_INTEGER(n),
+                       FTN_REAL_ARRAY(pxa),
+                       FTN_REAL_ARRAY(pya),
+                       FTN_REAL_ARRAY(pza)
+                       )
+{
+  pxpolymarker3_soa(FTN_INTEGER_GET(n), pxa, pya, pza);
+}
+
+/*******************************************************************************
+ * pxfa3s
+ *
+ * DESCR:   fill area 3 stored with separate coordinate arrays
+ * RETURNS:   N/A
+ */
+FTN_SUBROUTINE(pxfa3s)(
+                       FTN_INTEGER(n),
+                       FTN_REAL_ARRAY(pxa),
+                       FTN_REAL_ARRAY(pya),
+                       FTN_REAL_ARRAY(pza)
+                       )
+{
+  pxfill_area3_soa(FTN_INTEGER_GET(n), pxa, pya, pza);
 }
 
 /*******************************************************************************
@@ -27,6 +27,7 @@
 #include <css.h>
 #include <private/phgP.h>
 #include <util/ftn.h>
+#include <util/pack.h>
 
 #ifndef  MAX_ARRAY_SIZE
 #define  MAX_ARRAY_SIZE 400
@@ -216,7 +217,6 @@ FTN_SUBROUTINE(pfas3d)(
   Pint *data;
   char *tp;
   Pint num_vertices;
-  Ppoint3 vbuffer[MAX_ARRAY_SIZE];
   Pptco3   cbuffer[MAX_ARRAY_SIZE];
   Pptnorm3 nbuffer[MAX_ARRAY_SIZE];
   Pptconorm3 cnbuffer[MAX_ARRAY_SIZE];
@@ -351,13 +351,11 @@ FTN_SUBROUTINE(pfas3d)(
 
           switch (vflag) {
           case PVERT_COORD:
-            for (j=0; j<num_vertices; j++){
-              vbuffer[j].x = FTN_REAL_ARRAY_GET(pxa, j+num_vertices*i);
-              vbuffer[j].y = FTN_REAL_ARRAY_GET(pya, j+num_vertices*i);
-              vbuffer[j].z = FTN_REAL_ARRAY_GET(pza, j+num_vertices*i);
-            }
-            memcpy(tp, &vbuffer[0],
-                   num_vertices * sizeof(Ppoint3));
+            phg_pack_points3((Ppoint3 *) tp,
+                             &pxa[num_vertices*i],
+                             &pya[num_vertices*i],
+                             &pza[num_vertices*i],
+                             num_vertices);
             tp += num_vertices * sizeof(Ppoint3);
             break;
 
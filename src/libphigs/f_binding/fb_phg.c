@@ -93,7 +93,7 @@ FTN_SUBROUTINE(popph)(
   list_init(&PHG_WST_LIST);
   if (!phg_wst_add_ws_type(PCAT_OUT, 0)) {
     ERR_REPORT(PHG_ERH, ERR900);
-    free(PHG_INPUT_Q);
+    phg_sin_q_destroy(PHG_INPUT_Q);
     phg_sin_evt_tbl_destroy(PHG_EVT_TABLE);
     phg_css_destroy(PHG_CSS);
     phg_psl_destroy(PHG_PSL);
@@ -111,11 +111,13 @@ FTN_SUBROUTINE(popph)(
   phg_wst_add_ws_type(PCAT_PDF, 0);
   phg_wst_add_ws_type(PCAT_SVG, 0);
   phg_wst_add_ws_type(PCAT_OBJ, 0);
+  phg_wst_add_ws_type(PCAT_GLB, 0);
+  phg_wst_add_ws_type(PCAT_PLY, 0);
 
   PHG_WS_LIST = (Ws_handle *) malloc(sizeof(Ws_handle) * MAX_NO_OPEN_WS);
   if (PHG_WS_LIST == NULL) {
     ERR_REPORT(PHG_ERH, ERR900);
-    free(PHG_INPUT_Q);
+    phg_sin_q_destroy(PHG_INPUT_Q);
     phg_wst_remove_ws_types();
     phg_sin_evt_tbl_destroy(PHG_EVT_TABLE);
     phg_css_destroy(PHG_CSS);
@@ -30,6 +30,7 @@
 #include "phg.h"
 #include "private/phgP.h"
 #include "private/wsglP.h"
+#include "private/wsxP.h"
 #include "css.h"
 #include "ws.h"
 #include "util/ftn.h"
@@ -90,6 +91,10 @@ FTN_SUBROUTINE(popwk)(
   else if (!phg_psl_ws_free_slot(PHG_PSL)) {
     ERR_REPORT(PHG_ERH, ERR63);
   }
+  else if (ws_type == PWST_HCOPY_TRUE_OBJ && wsgl_obj_is_open()) {
+    /* the OBJ stream is shared, one OBJ workstation at a time */
+    ERR_REPORT(PHG_ERH, ERR63);
+  }
   else {
     wst = phg_wst_find(&PHG_WST_LIST, ws_type);
 
@@ -101,6 +106,7 @@ FTN_SUBROUTINE(popwk)(
       args.width = config[ws_id].display_width;
       args.height = config[ws_id].display_height;
       args.hcsf = config[ws_id].hcsf;
+      args.hcopy_samples = config[ws_id].hcopy_samples;
 #ifdef DEBUG
       printf("fb_ws: WSID=%d type=%d scale factor %f\n", ws_id, ws_type, args.hcsf);
 #endif
@@ -110,6 +116,8 @@ FTN_SUBROUTINE(popwk)(
       }
       else {
         record_geom = FALSE;
+        record_mesh = MESH_NONE;
+        record_vec = VEC_NONE;
         if (
             ws_type == PWST_HCOPY_TRUE_TGA ||
             ws_type == PWST_HCOPY_TRUE_RGB_PNG ||
@@ -117,7 +125,9 @@ FTN_SUBROUTINE(popwk)(
             ws_type == PWST_HCOPY_TRUE_EPS ||
             ws_type == PWST_HCOPY_TRUE_PDF ||
             ws_type == PWST_HCOPY_TRUE_SVG ||
-            ws_type == PWST_HCOPY_TRUE_OBJ
+            ws_type == PWST_HCOPY_TRUE_OBJ ||
+            ws_type == PWST_HCOPY_TRUE_GLB ||
+            ws_type == PWST_HCOPY_TRUE_PLY
             ) {
           args.conn_type = PHG_ARGS_CONN_HCOPY;
           args.width = config[ws_id].display_width*config[ws_id].hcsf;
@@ -131,15 +141,30 @@ FTN_SUBROUTINE(popwk)(
       }
       switch (ws_type){
       case PWST_HCOPY_TRUE_EPS:
-      case PWST_HCOPY_TRUE_PDF:
-      case PWST_HCOPY_TRUE_SVG:
         /* switch off shaders for gl2ps exports */
         wsgl_use_shaders_settings = wsgl_use_shaders;
         wsgl_use_shaders = 0;
         break;
+      case PWST_HCOPY_TRUE_PDF:
+        record_geom = TRUE;
+        record_vec = VEC_PDF;
+        break;
+      case PWST_HCOPY_TRUE_SVG:
+        record_geom = TRUE;
+        record_vec = VEC_SVG;
+        break;
       case  PWST_HCOPY_TRUE_OBJ:
         printf("fb_ws: switch Recording ON\n");
         record_geom = TRUE;
+        break;
+      case PWST_HCOPY_TRUE_GLB:
+        record_geom = TRUE;
+        record_mesh = MESH_GLB;
+        break;
+      case PWST_HCOPY_TRUE_PLY:
+        record_geom = TRUE;
+        record_mesh = MESH_PLY;
+        break;
       }
       args.wsid = ws_id;
       args.type = wst;
@@ -155,6 +180,7 @@ FTN_SUBROUTINE(popwk)(
       args.limits = config[ws_id].vpos;
 
       /* Open workstation */
+      phg_wsx_input_lock();
       PHG_WSID(ws_id) = (*wst->desc_tbl.phigs_dt.ws_open)(&args, &ret);
       if (PHG_WSID(ws_id) == NULL) {
         ERR_REPORT(PHG_ERH, ERR900);
@@ -163,6 +189,13 @@ FTN_SUBROUTINE(popwk)(
         /* Add workstation to info list */
         phg_psl_add_ws(PHG_PSL, ws_id, NULL, wst);
       }
+      phg_wsx_input_unlock();
+      if (PHG_WSID(ws_id) != NULL &&
+          (wst->desc_tbl.phigs_dt.ws_category == PCAT_IN ||
+           wst->desc_tbl.phigs_dt.ws_category == PCAT_OUTIN)) {
+        phg_wsx_input_thread_start();
+        phg_wsx_input_thread_notify();
+      }
       /* predefine some colors */
       pxset_color_map(ws_id);
       /* set background as specified in configuration file */
@@ -177,6 +210,16 @@ FTN_SUBROUTINE(popwk)(
         strncpy(wsh->filename, config[ws_id].filename, strlen(config[ws_id].filename));
         (wsh->filename)[strlen(config[ws_id].filename)] = '\0';
       }
+      if (record_vec){
+        wsgl_begin_vec(wsh->filename, config[ws_id].window_title, record_vec,
+                       args.width, args.height);
+      }
+      else if (record_mesh){
+        wsgl_begin_mesh(wsh->filename, config[ws_id].window_title, record_mesh);
+      }
+      else if (record_geom){
+        wsgl_begin_obj(wsh->filename, config[ws_id].window_title);
+      }
       wsgl_clear(wsh);
     }
   }
@@ -565,6 +608,8 @@ FTN_SUBROUTINE(pqvwr)(
             dt->ws_category == PCAT_PDF ||
             dt->ws_category == PCAT_SVG ||
             dt->ws_category == PCAT_OBJ ||
+            dt->ws_category == PCAT_GLB ||
+            dt->ws_category == PCAT_PLY ||
             dt->ws_category == PCAT_OUTIN ||
             dt->ws_category == PCAT_MO)) {
         *err_ind = ERR59;
@@ -669,6 +714,8 @@ FTN_SUBROUTINE(pqwkt)(
             dt->ws_category == PCAT_PDF  ||
             dt->ws_category == PCAT_SVG  ||
             dt->ws_category == PCAT_OBJ ||
+            dt->ws_category == PCAT_GLB ||
+            dt->ws_category == PCAT_PLY ||
             dt->ws_category == PCAT_OUTIN ||
             dt->ws_category == PCAT_MO)) {
         *err_ind = ERR59;
@@ -755,6 +802,8 @@ FTN_SUBROUTINE(pqwkt3)(
             dt->ws_category == PCAT_PDF ||
             dt->ws_category == PCAT_SVG ||
             dt->ws_category == PCAT_OBJ ||
+            dt->ws_category == PCAT_GLB ||
+            dt->ws_category == PCAT_PLY ||
             dt->ws_category == PCAT_OUTIN ||
             dt->ws_category == PCAT_MO)) {
         *err_ind = ERR59;
@@ -848,6 +897,8 @@ FTN_SUBROUTINE(pqpost)(
             dt->ws_category == PCAT_PDF ||
             dt->ws_category == PCAT_SVG ||
             dt->ws_category == PCAT_OBJ ||
+            dt->ws_category == PCAT_GLB ||
+            dt->ws_category == PCAT_PLY ||
             dt->ws_category == PCAT_OUTIN ||
             dt->ws_category == PCAT_MO)) {
         *err_ind = ERR59;
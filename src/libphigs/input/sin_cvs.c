@@ -56,6 +56,7 @@ SOFTWARE.
 #include "sin.h"
 #include "private/sinP.h"
 #include "private/cvsP.h"
+#include "private/wsxP.h"
 
 static void activate_loc(
                          Dev_data *dev,
@@ -1023,6 +1024,81 @@ static int map_event(
   return status;
 }
 
+/*******************************************************************************
+ * motion_compressible
+ *
+ * DESCR:       Check if intermediate positions of a motion event are of no
+ *              interest to the devices attached to its trigger. Plain moves
+ *              only update echoes, drags also feed stroke and pick devices.
+ * RETURNS:     TRUE or FALSE
+ */
+
+static int motion_compressible(
+                               Sin_window_table *cvs_tbl,
+                               XEvent *xevent
+                               )
+{
+  Sin_trig_op *op;
+
+  if ( !(xevent->xmotion.state & ALL_BUTTONS) )
+    return TRUE;
+  for ( op = TRIGGER_DATA(cvs_tbl, SIN_PTR_DRAG)->ops; op; op = op->next ) {
+    if ( op->evt_func != locator_event_func )
+      return FALSE;
+  }
+  return TRUE;
+}
+
+/*******************************************************************************
+ * compress_motion
+ *
+ * DESCR:       Replace a motion event by the latest of the motion events
+ *              queued directly behind it for the same window and modifiers.
+ *              Stops at any other event, so button and key events are still
+ *              seen at the position they happened.
+ * RETURNS:     N/A
+ */
+
+static void compress_motion(
+                            Sin_window_table *cvs_tbl,
+                            Display *display,
+                            XEvent *xevent
+                            )
+{
+  XEvent next;
+
+  while ( XEventsQueued( display, QueuedAfterReading ) > 0 ) {
+    XPeekEvent( display, &next );
+    if ( next.type != MotionNotify
+         || next.xmotion.window != xevent->xmotion.window
+         || next.xmotion.state != xevent->xmotion.state )
+      break;
+    XNextEvent( display, xevent );
+    ++cvs_tbl->num_coalesced;
+  }
+}
+
+/*******************************************************************************
+ * needs_render_context
+ *
+ * DESCR:       Check if any device attached to a trigger resolves through
+ *              the renderer, which is only used by the application thread
+ * RETURNS:     TRUE or FALSE
+ */
+
+static int needs_render_context(
+                                Sin_trig_data *trig
+                                )
+{
+  Sin_trig_op *op;
+
+  for ( op = trig->ops; op; op = op->next ) {
+    if ( op->evt_func == pick_event_func )
+      return TRUE;
+  }
+  return FALSE;
+}
+
 /*******************************************************************************
  * process_event
  *
@@ -1040,15 +1116,28 @@ static void process_event(
   Sin_trig_data *trig;
   Sin_cvs_event event;
   Sin_window_table *cvs_tbl = (Sin_window_table *) handle;
+  XEvent motion;
 
   Sin_trig_op	*op, *next;
 #ifdef DEBUGINPUT
   printf("Processing event\n");
 #endif
+  /* Only the last of a burst of pointer motions is echoed. */
+  if ( xevent->type == MotionNotify && motion_compressible( cvs_tbl, xevent ) ) {
+    motion = *xevent;
+    compress_motion( cvs_tbl, ws->display, &motion );
+    xevent = &motion;
+  }
+
   /* Call all the event procs associated with this event. */
   if ( !map_event( xevent, &event ) )
     return;
   if ( (trig = TRIGGER_DATA(cvs_tbl, event.trigger)) ) {
+    /* Picks are resolved where the rendering context lives. */
+    if ( phg_wsx_input_thread_self() && needs_render_context( trig ) ) {
+      (void)phg_wsx_input_defer( process_event, ws, handle, window, xevent );
+      return;
+    }
     op = trig->ops;
     while ( op ) {
       next = op->next; /* remember next node in case list changes */
@@ -1069,6 +1158,9 @@ void phg_sin_cvs_destroy(
                          Sin_input_ws *ws
                          )
 {
+#ifdef DEBUGINPUT
+  printf("Coalesced motion events: %lu\n", phg_sin_cvs_num_coalesced( ws ));
+#endif
   /* Deactivate and free the window table. */
   phg_sin_ws_remove_event_func( ws, ws->input_window,
                                 (caddr_t)ws->window_table, process_event );
@@ -1076,6 +1168,21 @@ void phg_sin_cvs_destroy(
     free(ws->window_table );
 }
 
+/*******************************************************************************
+ * phg_sin_cvs_num_coalesced
+ *
+ * DESCR:       Get number of motion events merged into a later one
+ * RETURNS:     Number of events
+ */
+unsigned long phg_sin_cvs_num_coalesced(
+                                        Sin_input_ws *ws
+                                        )
+{
+  if ( ws->window_table )
+    return ws->window_table->num_coalesced;
+  return 0;
+}
+
 /*******************************************************************************
  * phg_sin_cvs_create
  *
@@ -22,6 +22,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 #include "phg.h"
 #include "private/evtP.h"
@@ -65,6 +66,115 @@ static char *eventNames[] = {
   "unknown event type"
 };
 
+/*******************************************************************************
+ * evt_hash
+ *
+ * DESCR:       Get bucket index for display, window and event type
+ * RETURNS:     Bucket index
+ */
+
+static unsigned evt_hash(
+                         Phg_sin_evt_tbl *ev_tbl,
+                         Display *display,
+                         Window window,
+                         int event_type
+                         )
+{
+  uintptr_t key;
+
+  key = ((uintptr_t) display >> 4) ^ (uintptr_t) window;
+  key = key * 31 + (uintptr_t) event_type;
+  key *= 2654435761U;
+
+  return (unsigned) (key >> 8) & (ev_tbl->num_buckets - 1);
+}
+
+/*******************************************************************************
+ * evt_bucket
+ *
+ * DESCR:       Get bucket list for display, window and event type
+ * RETURNS:     Pointer to list
+ */
+
+static List* evt_bucket(
+                        Phg_sin_evt_tbl *ev_tbl,
+                        Display *display,
+                        Window window,
+                        int event_type
+                        )
+{
+  return &ev_tbl->buckets[evt_hash(ev_tbl, display, window, event_type)];
+}
+
+/*******************************************************************************
+ * evt_tbl_grow
+ *
+ * DESCR:       Double the number of buckets and move all entries over,
+ *              the table is left unchanged if out of memory
+ * RETURNS:     N/A
+ */
+
+static void evt_tbl_grow(
+                         Phg_sin_evt_tbl *ev_tbl
+                         )
+{
+  int i, num_buckets;
+  List *buckets;
+  Phg_sin_evt_entry *ev;
+
+  num_buckets = ev_tbl->num_buckets;
+  buckets = ev_tbl->buckets;
+  ev_tbl->buckets = (List *) malloc(sizeof(List) * num_buckets * 2);
+  if (ev_tbl->buckets == NULL) {
+    ev_tbl->buckets = buckets;
+    return;
+  }
+
+  ev_tbl->num_buckets = num_buckets * 2;
+  for (i = 0; i < ev_tbl->num_buckets; i++) {
+    list_init(&ev_tbl->buckets[i]);
+  }
+  for (i = 0; i < num_buckets; i++) {
+    while ((ev = (Phg_sin_evt_entry *) list_get(&buckets[i])) != NULL) {
+      list_add(evt_bucket(ev_tbl, ev->display, ev->window, ev->event_type),
+               &ev->node);
+    }
+  }
+  free(buckets);
+}
+
+/*******************************************************************************
+ * evt_remove
+ *
+ * DESCR:       Remove all entries matching display and window, any window
+ *              if window is zero
+ * RETURNS:     N/A
+ */
+
+static void evt_remove(
+                       Phg_sin_evt_tbl *ev_tbl,
+                       Display *display,
+                       Window window
+                       )
+{
+  int i;
+  Phg_sin_evt_entry *ev, *next;
+
+  for (i = 0; i < ev_tbl->num_buckets; i++) {
+    for (ev = (Phg_sin_evt_entry *) LIST_HEAD(&ev_tbl->buckets[i]);
+         ev != NULL;
+         ev = next) {
+      next = (Phg_sin_evt_entry *) NODE_NEXT(&ev->node);
+      if ((ev->display == display) &&
+          ((window == 0) || (ev->window == window))) {
+        list_remove(&ev_tbl->buckets[i], &ev->node);
+        free(ev);
+        ev_tbl->num_entries--;
+      }
+    }
+  }
+}
+
 /*******************************************************************************
  * phg_sin_evt_tbl_create
  *
@@ -78,12 +188,13 @@ Phg_sin_evt_tbl* phg_sin_evt_tbl_create(
 {
   Phg_sin_evt_tbl *ev_tbl;
 
-  ev_tbl = (Phg_sin_evt_tbl *) malloc(sizeof(Phg_sin_evt_tbl) +
-                                      sizeof(Phg_sin_evt_entry) * num_events);
+  ev_tbl = (Phg_sin_evt_tbl *) malloc(sizeof(Phg_sin_evt_tbl));
   if (ev_tbl != NULL) {
     ev_tbl->num_events = num_events;
-    ev_tbl->events = (List *) &ev_tbl[1];
-    if (!phg_sin_evt_tbl_init(ev_tbl)) {
+    ev_tbl->num_buckets = PHG_SIN_EVT_BUCKETS;
+    ev_tbl->buckets = (List *) malloc(sizeof(List) * ev_tbl->num_buckets);
+    if ((ev_tbl->buckets == NULL) || !phg_sin_evt_tbl_init(ev_tbl)) {
+      free(ev_tbl->buckets);
       free(ev_tbl);
       ev_tbl = NULL;
     }
@@ -105,9 +216,11 @@ int phg_sin_evt_tbl_init(
 {
   int i;
 
-  for (i = 0; i < ev_tbl->num_events; i++) {
-    list_init(&ev_tbl->events[i]);
+  for (i = 0; i < ev_tbl->num_buckets; i++) {
+    list_init(&ev_tbl->buckets[i]);
   }
+  ev_tbl->num_entries = 0;
+  ev_tbl->dispatching = 0;
 
   return TRUE;
 }
@@ -123,6 +236,15 @@ void phg_sin_evt_tbl_destroy(
                              Phg_sin_evt_tbl *ev_tbl
                              )
 {
+  int i;
+  Node *node;
+
+  for (i = 0; i < ev_tbl->num_buckets; i++) {
+    while ((node = list_get(&ev_tbl->buckets[i])) != NULL) {
+      free(node);
+    }
+  }
+  free(ev_tbl->buckets);
   free(ev_tbl);
 }
 
@@ -142,7 +264,8 @@ int phg_sin_evt_register(
                          void (*callback)(Display*, Window, caddr_t, XEvent*)
                          )
 {
-  int status;
+  int status = TRUE;
+  List *bucket;
   Phg_sin_evt_entry *ev;
 
 #ifdef DEBUGINP
@@ -151,12 +274,18 @@ int phg_sin_evt_register(
   printf("\tWindow = %p, ", (void *) window);
   printf("\tClient_data = %p\n", (void *) cdata);
 #endif
+  if ((event_type < 0) || (event_type >= ev_tbl->num_events)) {
+    return FALSE;
+  }
+
   /* First check if entry exists */
-  for (ev = (Phg_sin_evt_entry *) LIST_HEAD(&ev_tbl->events[event_type]);
+  bucket = evt_bucket(ev_tbl, display, window, event_type);
+  for (ev = (Phg_sin_evt_entry *) LIST_HEAD(bucket);
        ev != NULL;
        ev = (Phg_sin_evt_entry *) NODE_NEXT(&ev->node)) {
     if ((ev->display == display) &&
         (ev->window == window) &&
+        (ev->event_type == event_type) &&
         (ev->cdata == cdata)) {
       ev->callback = callback;
       break;
@@ -172,14 +301,19 @@ int phg_sin_evt_register(
     else {
       ev->display = display;
       ev->window = window;
+      ev->event_type = event_type;
       ev->cdata = cdata;
       ev->callback = callback;
-      list_add(&ev_tbl->events[event_type], &ev->node);
+      list_add(bucket, &ev->node);
+      ev_tbl->num_entries++;
+
+      /* Keep the chains short, but not under the feet of a dispatch */
+      if ((ev_tbl->num_entries > 2 * ev_tbl->num_buckets) &&
+          !ev_tbl->dispatching) {
+        evt_tbl_grow(ev_tbl);
+      }
     }
   }
-  else {
-    status = TRUE;
-  }
 
   return status;
 }
@@ -199,17 +333,25 @@ void phg_sin_evt_unregister(
                             caddr_t cdata
                             )
 {
+  List *bucket;
   Phg_sin_evt_entry *ev;
 
+  if ((event_type < 0) || (event_type >= ev_tbl->num_events)) {
+    return;
+  }
+
   /* First check if entry exists */
-  for (ev = (Phg_sin_evt_entry *) LIST_HEAD(&ev_tbl->events[event_type]);
+  bucket = evt_bucket(ev_tbl, display, window, event_type);
+  for (ev = (Phg_sin_evt_entry *) LIST_HEAD(bucket);
        ev != NULL;
        ev = (Phg_sin_evt_entry *) NODE_NEXT(&ev->node)) {
     if ((ev->display == display) &&
         (ev->window == window) &&
+        (ev->event_type == event_type) &&
         (ev->cdata == cdata)) {
-      list_remove(&ev_tbl->events[event_type], &ev->node);
+      list_remove(bucket, &ev->node);
       free(ev);
+      ev_tbl->num_entries--;
       break;
     }
   }
@@ -227,19 +369,7 @@ void phg_sin_evt_unregister_display(
                                     Display *display
                                     )
 {
-  int i;
-  Phg_sin_evt_entry *ev;
-
-  for (i = 0; i < ev_tbl->num_events; i++) {
-    for (ev = (Phg_sin_evt_entry *) LIST_HEAD(&ev_tbl->events[i]);
-         ev != NULL;
-         ev = (Phg_sin_evt_entry *) NODE_NEXT(&ev->node)) {
-      if (ev->display == display) {
-        list_remove(&ev_tbl->events[i], &ev->node);
-        free(ev);
-      }
-    }
-  }
+  evt_remove(ev_tbl, display, 0);
 }
 
 /*******************************************************************************
@@ -255,19 +385,8 @@ void phg_sin_evt_unregister_window(
                                    Window window
                                    )
 {
-  int i;
-  Phg_sin_evt_entry *ev;
-
-  for (i = 0; i < ev_tbl->num_events; i++) {
-    for (ev = (Phg_sin_evt_entry *) LIST_HEAD(&ev_tbl->events[i]);
-         ev != NULL;
-         ev = (Phg_sin_evt_entry *) NODE_NEXT(&ev->node)) {
-      if ((ev->display == display) &&
-          (ev->window == window)) {
-        list_remove(&ev_tbl->events[i], &ev->node);
-        free(ev);
-      }
-    }
+  if (window != 0) {
+    evt_remove(ev_tbl, display, window);
   }
 }
 
@@ -284,16 +403,27 @@ void phg_sin_evt_dispatch(
                           XEvent *event
                           )
 {
-  Phg_sin_evt_entry *ev;
+  Window window = event->xany.window;
+  List *bucket;
+  Phg_sin_evt_entry *ev, *next;
 #ifdef DEBUGINPUT
       printf("phg_sin_evt_dispatch called\n");
 #endif
-  /* First check if entry exists */
-  for (ev = (Phg_sin_evt_entry *) LIST_HEAD(&ev_tbl->events[event->type]);
+  if ((event->type < 0) || (event->type >= ev_tbl->num_events)) {
+    return;
+  }
+
+  /* Only entries with the same hash share the bucket */
+  ev_tbl->dispatching++;
+  bucket = evt_bucket(ev_tbl, display, window, event->type);
+  for (ev = (Phg_sin_evt_entry *) LIST_HEAD(bucket);
        ev != NULL;
-       ev = (Phg_sin_evt_entry *) NODE_NEXT(&ev->node)) {
+       ev = next) {
+    /* remember next node in case the callback unregisters this one */
+    next = (Phg_sin_evt_entry *) NODE_NEXT(&ev->node);
     if ((ev->display == display) &&
-        (ev->window == event->xany.window)) {
+        (ev->window == window) &&
+        (ev->event_type == event->type)) {
 #ifdef DEBUGINPUT
       printf("phg_sin_evt_dispatch event data\n");
       printf("%p\t", ev->cdata);
@@ -301,11 +431,12 @@ void phg_sin_evt_dispatch(
       printf("\n");
 #endif
       (*ev->callback)(display,
-                      event->xany.window,
+                      window,
                       ev->cdata,
                       event);
     }
   }
+  ev_tbl->dispatching--;
 }
 
 /*******************************************************************************
@@ -333,14 +333,14 @@ int phg_sin_ws_enque_events(
 {
     Sin_input_event *event;
     Sin_event_queue *queue;
-    int	status = SIN_EVENT_NOT_ENQUED_FLAG, simul_id;
+    int	status = SIN_EVENT_NOT_ENQUED_FLAG, simul_id, num_free;
 
 #ifdef DEBUG
     printf("sin_ws: phg_sin_ws_enque_events\n");
 #endif
 
     queue = (*devs)->ws->queue;
-    if ( SIN_Q_ENOUGH_ROOM( queue, count) && !SIN_Q_OVERFLOWED( queue) ) {
+    if ( !SIN_Q_OVERFLOWED( queue) && phg_sin_q_reserve( queue, count) ) {
 	if ( count > 1) {
 	    simul_id = SIN_Q_NEW_SIMUL_ID(queue);
 	} else {
@@ -354,10 +354,15 @@ int phg_sin_ws_enque_events(
 	    }
 	    ++devs;
 	}
+	phg_sin_q_commit_events(queue);
 	status = SIN_EVENT_ENQUED_FLAG;
 
     } else if ( !SIN_Q_OVERFLOWED( queue) ) {
-	SIN_Q_SET_OVERFLOW( queue, devs[SIN_Q_NUM_FREE_EVENTS(queue)]);
+	/* the first device that did not fit, a growable queue is out of memory */
+	num_free = SIN_Q_NUM_FREE_EVENTS(queue);
+	if ( num_free < 0 || num_free >= count )
+	    num_free = 0;
+	SIN_Q_SET_OVERFLOW( queue, devs[num_free]);
     }
 
     if ( queue->event_notify_proc ) {
@@ -53,42 +53,162 @@ SOFTWARE.
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
 
 #include "phg.h"
 #include "sin.h"
 #include "private/sinP.h"
 
+int phg_sin_q_growable = FALSE;
+
+/*******************************************************************************
+ * ring_create
+ *
+ * DESCR:       Create event ring helper function
+ * RETURNS:     Pointer to ring or NULL
+ */
+static Sin_q_ring* ring_create(
+                               unsigned size
+                               )
+{
+  Sin_q_ring *ring;
+
+  ring = (Sin_q_ring *) calloc( 1, sizeof(Sin_q_ring) +
+                                (size - 1) * sizeof(Sin_input_event));
+  if ( ring != NULL ) {
+    ring->size = size;
+  }
+  return ring;
+}
+
+/*******************************************************************************
+ * ring_room
+ *
+ * DESCR:       Number of free events in ring, as seen by the producer
+ * RETURNS:     Number of events
+ */
+static unsigned ring_room(
+                          Sin_q_ring *ring
+                          )
+{
+  return ring->size - (ring->tail - SIN_Q_LOAD(ring->head));
+}
+
+/*******************************************************************************
+ * read_ring
+ *
+ * DESCR:       Get the ring holding the first event, rings drained and
+ *              replaced by the producer are freed on the way.
+ * RETURNS:     Pointer to ring
+ */
+static Sin_q_ring* read_ring(
+                             Sin_event_queue *queue
+                             )
+{
+  Sin_q_ring *ring, *next;
+
+  ring = queue->read_ring;
+  while ( ring->head == SIN_Q_LOAD(ring->tail) ) {
+    next = SIN_Q_LOAD(ring->next);
+    if ( next == NULL ) {
+      break;
+    }
+    /* the last events are published before the next ring */
+    if ( ring->head != SIN_Q_LOAD(ring->tail) ) {
+      break;
+    }
+    queue->read_ring = next;
+    free( ring);
+    ring = next;
+  }
+  return ring;
+}
+
+/*******************************************************************************
+ * phg_sin_q_reserve
+ *
+ * DESCR:       Make room for a number of events to be enqueued together,
+ *              growing the queue if growable.
+ * RETURNS:     TRUE or FALSE if the queue is full
+ */
+int phg_sin_q_reserve(
+                      Sin_event_queue *queue,
+                      int num
+                      )
+{
+  unsigned size;
+  Sin_q_ring *ring;
+
+  queue->pending = 0;
+  if ( !phg_sin_q_growable && SIN_Q_COUNT(queue) + num > queue->size ) {
+    return FALSE;
+  }
+
+  ring = queue->write_ring;
+  if ( ring_room( ring) < (unsigned) num ) {
+    if ( !phg_sin_q_growable ) {
+      return FALSE;
+    }
+    /* continue in a larger ring, the consumer drains this one first */
+    for ( size = 2 * ring->size; size < (unsigned) num; size *= 2 );
+    ring = ring_create( size);
+    if ( ring == NULL ) {
+      return FALSE;
+    }
+    SIN_Q_STORE(queue->write_ring->next, ring);
+    queue->write_ring = ring;
+  }
+  return TRUE;
+}
+
 /*******************************************************************************
  * phg_sin_q_enque_free_event
  *
  * DESCR:       Place a free and empty event on the queue and return a pointer
- *              to it or NULL if the queue is full.
+ *              to it or NULL if the queue is full. The event is seen by the
+ *              consumer after phg_sin_q_commit_events.
  * RETURNS:     Pointer to event or NULL
  */
 Sin_input_event* phg_sin_q_enque_free_event(
                                             Sin_event_queue *queue
                                             )
 {
-  int current;
-  Sin_q_element *element;
+  Sin_q_ring *ring = queue->write_ring;
   Sin_input_event *event;
 
-  if ( SIN_Q_FULL(queue) ) {
+  if ( ring_room( ring) <= (unsigned) queue->pending ) {
     event = NULL;
   } else {
-    ++queue->count;
-    current = SIN_Q_POP_FREE_ELEMENT( queue);
-    element = &queue->events[current];
-    event = &element->event;
-    element->previous = queue->last;
-    element->next = queue->events[queue->last].next;
-    queue->events[queue->events[queue->last].next].previous = current;
-    queue->events[queue->last].next = current;
-    queue->last = current;
+    event = &ring->events[(ring->tail + queue->pending) & (ring->size - 1)];
+    ++queue->pending;
   }
   return event;
 }
 
+/*******************************************************************************
+ * phg_sin_q_commit_events
+ *
+ * DESCR:       Publish the events filled in since the last reserve
+ * RETURNS:     N/A
+ */
+void phg_sin_q_commit_events(
+                             Sin_event_queue *queue
+                             )
+{
+  Sin_q_ring *ring = queue->write_ring;
+
+  if ( queue->pending > 0 ) {
+    SIN_Q_STORE(ring->tail, ring->tail + queue->pending);
+    __atomic_add_fetch(&queue->count, queue->pending, __ATOMIC_SEQ_CST);
+    queue->pending = 0;
+    if ( __atomic_load_n(&queue->waiting, __ATOMIC_SEQ_CST) ) {
+      phg_sin_q_wakeup( queue);
+    }
+  }
+}
+
 /*******************************************************************************
  * phg_sin_q_next_event
  *
@@ -100,12 +220,14 @@ Sin_input_event* phg_sin_q_next_event(
                                       Sin_event_queue *queue
                                       )
 {
+  Sin_q_ring *ring;
   Sin_input_event *event;
 
-  if ( SIN_Q_EMPTY(queue) ) {
+  ring = read_ring( queue);
+  if ( ring->head == SIN_Q_LOAD(ring->tail) ) {
     event = NULL;
   } else {
-    event = &queue->events[queue->events[queue->last].next].event;
+    event = &ring->events[ring->head & (ring->size - 1)];
 #ifdef DEBUGINP
     printf("phg_sin_q_next: return event\n");
 #endif
@@ -126,41 +248,52 @@ void phg_sin_q_deque_event(
                            Sin_event_queue *queue
                            )
 {
-  int current;
-
-  if ( !SIN_Q_EMPTY(queue) ) {
-    --queue->count;
-    current = queue->events[queue->last].next;
-    queue->events[queue->last].next = queue->events[current].next;
-    queue->events[queue->events[current].next].previous = queue->last;
-    SIN_Q_PUSH_FREE_ELEMENT( queue, current);
+  Sin_q_ring *ring;
+
+  ring = read_ring( queue);
+  if ( ring->head != SIN_Q_LOAD(ring->tail) ) {
+    SIN_Q_STORE(ring->head, ring->head + 1);
+    __atomic_sub_fetch(&queue->count, 1, __ATOMIC_SEQ_CST);
   }
 }
 
 /*******************************************************************************
- * delete_event
+ * flush_events
  *
- * DESCR:       Delete event helper function
+ * DESCR:       Delete all events of a workstation, or of one of its devices
+ *              if in_class is not PIN_NONE. The remaining events are moved
+ *              towards the tail, only the head changes under the producer.
  * RETURNS:     N/A
  */
-static void delete_event(
+static void flush_events(
                          Sin_event_queue *queue,
-                         int event_q_id
+                         Pint wsid,
+                         Pin_class in_class,
+                         Pint num
                          )
 {
-  int next, previous;
-
-  if ( !SIN_Q_EMPTY(queue)) {
-    --queue->count;
-    next = queue->events[event_q_id].next;
-    previous = queue->events[event_q_id].previous;
-    queue->events[previous].next = next;
-    queue->events[next].previous = previous;
-    SIN_Q_PUSH_FREE_ELEMENT( queue, event_q_id);
-    if ( event_q_id == queue->last) {
-      queue->last = previous;
+  unsigned i, keep, tail, mask;
+  int removed = 0;
+  Sin_q_ring *ring;
+  Sin_input_event *event;
+
+  for ( ring = read_ring( queue); ring != NULL; ring = SIN_Q_LOAD(ring->next) ) {
+    mask = ring->size - 1;
+    tail = SIN_Q_LOAD(ring->tail);
+    keep = tail;
+    for ( i = tail; i != ring->head; ) {
+      event = &ring->events[--i & mask];
+      if ( event->wsid == wsid
+           && (in_class == PIN_NONE
+               || (event->dev_class == in_class && event->dev_num == num)) ) {
+        ++removed;
+      } else if ( --keep != i ) {
+        ring->events[keep & mask] = *event;
+      }
     }
+    SIN_Q_STORE(ring->head, keep);
   }
+  __atomic_sub_fetch(&queue->count, removed, __ATOMIC_SEQ_CST);
 }
 
 /*******************************************************************************
@@ -174,20 +307,10 @@ void phg_sin_q_flush_ws(
                         int  wsid
                         )
 {
-  int current, next, i, count;
-
-  count = queue->count;
 #ifdef DEBUGINP
-  printf("phg_sin_q_flush was: count %d\n", count);
+  printf("phg_sin_q_flush was: count %d\n", SIN_Q_COUNT(queue));
 #endif
-  current = queue->events[queue->last].next;
-  for ( i = 0; i < count; i++) {
-    next = queue->events[current].next;
-    if ( queue->events[current].event.wsid == wsid) {
-      delete_event( queue, current);
-    }
-    current = next;
-  }
+  flush_events( queue, wsid, PIN_NONE, 0);
 
   if ( queue->overflow == SIN_Q_OVERFLOW_NOT_INQUIRED &&
        queue->overflow_dev.ws == wsid )
@@ -213,22 +336,7 @@ void phg_sin_q_flush_device(
                             Pint num
                             )
 {
-  int current_index, next_index, i, count;
-  Sin_q_element *current;
-
-  count = queue->count;
-  current_index = queue->events[queue->last].next;
-  current = &queue->events[current_index];
-  for ( i = 0; i < count; i++) {
-    next_index = current->next;
-    if ( current->event.wsid == wsid
-         && current->event.dev_class == in_class
-         && current->event.dev_num == num) {
-      delete_event( queue, current_index);
-    }
-    current_index = next_index;
-    current = &queue->events[current_index];
-  }
+  flush_events( queue, wsid, in_class, num);
   /*
     if ( SIN_Q_EMPTY(queue))
     SIN_Q_CLEAR_OVERFLOW(queue);
@@ -239,33 +347,31 @@ void phg_sin_q_flush_device(
  * initialize_queue
  *
  * DESCR:       Initialize queue helper function
- * RETURNS:     N/A
+ * RETURNS:     TRUE or FALSE
  */
 
-static void initialize_queue(
-                             Sin_event_queue *queue,
-                             int size,
-                             Err_handle erh
-                             )
+static int initialize_queue(
+                            Sin_event_queue *queue,
+                            int size,
+                            Err_handle erh
+                            )
 {
-  int i;
+  unsigned ring_size;
 
   queue->erh = erh;
   queue->size = size;
   queue->count = 0;
-  queue->last = 0;
+  queue->pending = 0;
   queue->cur_simul_id = 0;
   queue->next_simul_id = 1;
   queue->overflow = SIN_Q_NO_OVERFLOW;
   queue->event_notify_proc = NULL;
-  queue->events[queue->last].previous = queue->last;
-  queue->events[queue->last].next = queue->last;
+  queue->waiting = FALSE;
 
-  queue->stack_current = -1;
-  i = queue->size;
-  while ( --i >= 0) {
-    SIN_Q_PUSH_FREE_ELEMENT(queue, i);
-  }
+  for ( ring_size = 1; ring_size < (unsigned) size; ring_size *= 2 );
+  queue->read_ring = queue->write_ring = ring_create( ring_size);
+
+  return (queue->read_ring != NULL);
 }
 
 /*******************************************************************************
@@ -283,8 +389,13 @@ Input_q_handle phg_sin_q_create(
   if ( !(queue = (Sin_event_queue*)calloc( 1, sizeof(Sin_event_queue))) ) {
     ERR_BUF( erh, ERR900);
 
+  } else if ( !initialize_queue(queue, SIN_Q_SIZE, erh) ) {
+    ERR_BUF( erh, ERR900);
+    free(queue);
+    queue = NULL;
+
   } else {
-    initialize_queue(queue, SIN_Q_SIZE, erh);
+    queue->wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
   }
 
   return (Input_q_handle) queue;
@@ -300,9 +411,56 @@ void phg_sin_q_destroy(
                        Sin_event_queue *queue
                        )
 {
+  Sin_q_ring *ring, *next;
+
+  for ( ring = queue->read_ring; ring != NULL; ring = next ) {
+    next = ring->next;
+    free(ring);
+  }
+  if ( queue->wakeup_fd >= 0 ) {
+    close(queue->wakeup_fd);
+  }
   free(queue);
 }
 
+/*******************************************************************************
+ * phg_sin_q_wakeup
+ *
+ * DESCR:       Wake up a wait blocked on the wakeup descriptor of the queue
+ * RETURNS:     N/A
+ */
+void phg_sin_q_wakeup(
+                      Sin_event_queue *queue
+                      )
+{
+  uint64_t one = 1;
+
+  if ( queue->wakeup_fd >= 0 ) {
+    if ( write(queue->wakeup_fd, &one, sizeof(one)) != sizeof(one) ) {
+      /* counter already set, the waiter wakes up anyway */
+    }
+  }
+}
+
+/*******************************************************************************
+ * phg_sin_q_clear_wakeup
+ *
+ * DESCR:       Consume pending wakeups of the queue
+ * RETURNS:     N/A
+ */
+void phg_sin_q_clear_wakeup(
+                            Sin_event_queue *queue
+                            )
+{
+  uint64_t count;
+
+  if ( queue->wakeup_fd >= 0 ) {
+    if ( read(queue->wakeup_fd, &count, sizeof(count)) != sizeof(count) ) {
+      /* nothing pending */
+    }
+  }
+}
+
 /*******************************************************************************
  * phg_sin_q_overflow_event
  *
@@ -82,6 +82,31 @@ void phg_add_el(
    }
 }
 
+/*******************************************************************************
+ * phg_adopt_el
+ *
+ * DESCR:	Add an element taking over its content and update workstations
+ *		posted to
+ * RETURNS:	N/A
+ */
+
+void phg_adopt_el(
+   Css_handle cssh,
+   Phg_args_add_el *args
+   )
+{
+   Css_ws_list ws_list;
+
+   ws_list = CSS_GET_WS_ON(CSS_CUR_STRUCTP(cssh));
+
+   if (phg_css_adopt_elem(cssh, args)) {
+      if (ws_list != NULL) {
+         for (; ws_list->wsh != NULL; ws_list++)
+            (*ws_list->wsh->add_el)(ws_list->wsh);
+      }
+   }
+}
+
 /*******************************************************************************
  * phg_del_el
  *
@@ -559,6 +584,8 @@ void phg_set_ws_filter(
          case PCAT_PDF:
          case PCAT_SVG:
          case PCAT_OBJ:
+         case PCAT_GLB:
+         case PCAT_PLY:
          case PCAT_MO:
             wsh = PHG_WSID(ws_id);
             (*wsh->set_filter)(wsh,
@@ -209,6 +209,41 @@ static void phg_swap_point_list3(
    }
 }
 
+/******************************************************************************
+ * phg_swap_point_soa3
+ *
+ * DESCR:       Swap point 3D element with separate coordinate arrays
+ * RETURNS:     N/A
+ */
+
+static void phg_swap_point_soa3(
+   Phg_swap *swp,
+   void *data
+   )
+{
+   Pint *idata;
+   Pint num_points;
+   Pfloat *fdata;
+   Pint i;
+
+   idata = (Pint *) data;
+
+   if (swp->fromFormat & PHG_AR_HOST_BYTE_ORDER) {
+      num_points = idata[0];
+      (*swp->conv_long)((uint32_t *) &num_points);
+   }
+   else {
+      (*swp->conv_long)((uint32_t *) idata);
+      num_points = idata[0];
+   }
+
+   /* x, y and z arrays follow each other, swap them as one array */
+   fdata = (Pfloat *) &idata[1];
+   for (i = 0; i < 3 * num_points; i++) {
+      (*swp->conv_float)((float *) &fdata[i]);
+   }
+}
+
 /******************************************************************************
  * phg_swap_text
  *
@@ -461,5 +496,8 @@ Phg_conv phg_swap_tbl[PELEM_NUM_EL_TYPES] = {
    phg_swap_nil,                   /* PELEM_FILL_AREA_SET_DATA */
    phg_swap_nil,                   /* PELEM_GSE */
    phg_swap_nil,                   /* PELEM_ALPHA_CHANNEL */
-   phg_swap_text3                  /* PELEM_TEXT3 */
+   phg_swap_text3,                 /* PELEM_TEXT3 */
+   phg_swap_point_soa3,            /* PELEM_POLYLINE3_SOA */
+   phg_swap_point_soa3,            /* PELEM_POLYMARKER3_SOA */
+   phg_swap_point_soa3             /* PELEM_FILL_AREA3_SOA */
 };
@@ -49,6 +49,7 @@ SOFTWARE.
 #include <stdlib.h>
 #include <sys/select.h>
 #include <sys/time.h>
+#include <time.h>
 
 #include "phg.h"
 
@@ -109,7 +110,8 @@ int phg_msleep(
 /*******************************************************************************
  * phg_mtime
  *
- * DESCR:	Get current time in milleseconds
+ * DESCR:	Get current time in milleseconds, from a monotonic clock so
+ *              differences are not disturbed by changes of the system time
  * RETURNS:	TRUE or FALSE
  */
 
@@ -118,10 +120,10 @@ int phg_mtime(
    )
 {
    int status;
-   struct timeval tv;
+   struct timespec ts;
 
-   if (gettimeofday(&tv, NULL) == 0) {
-      *tm_val = tv.tv_sec * 1000 + tv.tv_usec / 1000;
+   if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+      *tm_val = ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
       status = TRUE;
    }
    else {
@@ -26,6 +26,73 @@
 #include "phg.h"
 #include "util/nset.h"
 
+/* initial number of names in the sparse list, doubled when full */
+#define NSET_SPARSE_INIT 16
+
+/*******************************************************************************
+ * sparse_find
+ *
+ * DESCR:       Binary search for name in sparse part of nameset helper function
+ * RETURNS:     TRUE if found, insertion index in pos
+ */
+
+static int sparse_find(
+   Nameset nset,
+   Pint name,
+   unsigned *pos
+   )
+{
+   unsigned lo, hi, mid;
+
+   lo = 0;
+   hi = nset->num_sparse;
+   while (lo < hi) {
+      mid = (lo + hi) >> 1;
+      if (nset->sparse[mid] < name) {
+         lo = mid + 1;
+      }
+      else {
+         hi = mid;
+      }
+   }
+   *pos = lo;
+
+   return ((lo < nset->num_sparse) && (nset->sparse[lo] == name));
+}
+
+/*******************************************************************************
+ * sparse_reserve
+ *
+ * DESCR:       Make room for names in sparse part of nameset helper function
+ * RETURNS:     TRUE or FALSE
+ */
+
+static int sparse_reserve(
+   Nameset nset,
+   unsigned num_sparse
+   )
+{
+   unsigned size;
+   Pint *sparse;
+
+   if (num_sparse <= nset->max_sparse) {
+      return TRUE;
+   }
+
+   size = (nset->max_sparse > 0) ? nset->max_sparse : NSET_SPARSE_INIT;
+   while (size < num_sparse) {
+      size <<= 1;
+   }
+   sparse = (Pint *) realloc(nset->sparse, size * sizeof(Pint));
+   if (sparse == NULL) {
+      return FALSE;
+   }
+   nset->sparse = sparse;
+   nset->max_sparse = size;
+
+   return TRUE;
+}
+
 /*******************************************************************************
  * phg_nset_create
  *
@@ -72,6 +139,57 @@ void phg_nset_init(
    nset->num_chunks = num_chunks;
    nset->nameset    = buf;
    memset(nset->nameset, 0, num_chunks * sizeof(uint32_t));
+   nset->max_sparse = 0;
+   nset->num_sparse = 0;
+   nset->sparse     = NULL;
+}
+
+/*******************************************************************************
+ * phg_nset_dup_sparse
+ *
+ * DESCR:       Give nameset a private copy of its sparse names, copies of
+ *              the nameset made before keep the old list
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_nset_dup_sparse(
+   Nameset nset
+   )
+{
+   Pint *sparse;
+
+   sparse = NULL;
+   if (nset->num_sparse > 0) {
+      sparse = (Pint *) malloc(nset->num_sparse * sizeof(Pint));
+      if (sparse == NULL) {
+         nset->max_sparse = 0;
+         nset->num_sparse = 0;
+         nset->sparse     = NULL;
+         return FALSE;
+      }
+      memcpy(sparse, nset->sparse, nset->num_sparse * sizeof(Pint));
+   }
+   nset->max_sparse = nset->num_sparse;
+   nset->sparse     = sparse;
+
+   return TRUE;
+}
+
+/*******************************************************************************
+ * phg_nset_free_sparse
+ *
+ * DESCR:       Release storage of sparse names in nameset
+ * RETURNS:     N/A
+ */
+
+void phg_nset_free_sparse(
+   Nameset nset
+   )
+{
+   free(nset->sparse);
+   nset->max_sparse = 0;
+   nset->num_sparse = 0;
+   nset->sparse     = NULL;
 }
 
 /*******************************************************************************
@@ -85,6 +203,7 @@ void phg_nset_destroy(
    Nameset nset
    )
 {
+   free(nset->sparse);
    free(nset);
 }
 
@@ -101,16 +220,31 @@ int phg_nset_name_set(
    )
 {
    int status;
+   unsigned pos;
    uint32_t bit;
 
-   if (name > nset->max_names) {
+   if (name < 0) {
       status = FALSE;
    }
-   else {
+   else if ((unsigned) name < nset->max_names) {
       bit = 0x1 << (name & 31);
       nset->nameset[name >> 5] |= bit;
       status = TRUE;
    }
+   else if (sparse_find(nset, name, &pos)) {
+      status = TRUE;
+   }
+   else if (!sparse_reserve(nset, nset->num_sparse + 1)) {
+      status = FALSE;
+   }
+   else {
+      memmove(&nset->sparse[pos + 1],
+              &nset->sparse[pos],
+              (nset->num_sparse - pos) * sizeof(Pint));
+      nset->sparse[pos] = name;
+      nset->num_sparse++;
+      status = TRUE;
+   }
 
    return status;
 }
@@ -128,16 +262,26 @@ int phg_nset_name_clear(
    )
 {
    int status;
+   unsigned pos;
    uint32_t bit;
 
-   if (name > nset->max_names) {
+   if (name < 0) {
       status = FALSE;
    }
-   else {
+   else if ((unsigned) name < nset->max_names) {
       bit = 0x1 << (name & 31);
       nset->nameset[name >> 5] &= ~bit;
       status = TRUE;
    }
+   else {
+      if (sparse_find(nset, name, &pos)) {
+         nset->num_sparse--;
+         memmove(&nset->sparse[pos],
+                 &nset->sparse[pos + 1],
+                 (nset->num_sparse - pos) * sizeof(Pint));
+      }
+      status = TRUE;
+   }
 
    return status;
 }
@@ -146,7 +290,7 @@ int phg_nset_name_clear(
  * phg_nset_names_set
  *
  * DESCR:       Set names in nameset from integer list
- * RETURNS:     TRUE of FALSE
+ * RETURNS:     TRUE or FALSE if the names could not be stored
  */
 
 int phg_nset_names_set(
@@ -156,16 +300,14 @@ int phg_nset_names_set(
    )
 {
    int status;
-   unsigned i;
+   Pint i;
 
-   if (num_names > nset->max_names) {
-      status = FALSE;
-   }
-   else {
-      for (i = 0; i < num_names; i++) {
-         phg_nset_name_set(nset, name_list[i]);
+   /* negative names are never set, only running out of memory fails */
+   status = TRUE;
+   for (i = 0; i < num_names; i++) {
+      if (name_list[i] >= 0 && !phg_nset_name_set(nset, name_list[i])) {
+         status = FALSE;
       }
-      status = TRUE;
    }
 
    return status;
@@ -184,26 +326,19 @@ int phg_nset_names_clear(
    Pint *name_list
    )
 {
-   int status;
-   unsigned i;
+   Pint i;
 
-   if (num_names > nset->max_names) {
-      status = FALSE;
-   }
-   else {
-      for (i = 0; i < num_names; i++) {
-         phg_nset_name_clear(nset, name_list[i]);
-      }
-      status = TRUE;
+   for (i = 0; i < num_names; i++) {
+      phg_nset_name_clear(nset, name_list[i]);
    }
 
-   return status;
+   return TRUE;
 }
 
 /*******************************************************************************
  * phg_nset_names_set_all
  *
- * DESCR:       Set all names in nameset
+ * DESCR:       Set all names in bit mask part of nameset
  * RETURNS:     N/A
  */
 
@@ -226,6 +361,7 @@ void phg_nset_names_clear_all(
    )
 {
    memset(nset->nameset, 0x00000000, nset->num_chunks * sizeof(uint32_t));
+   nset->num_sparse = 0;
 }
 
 /*******************************************************************************
@@ -242,13 +378,20 @@ int phg_nset_names_copy_all(
 {
    int status;
 
-   if (dest->num_chunks != src->num_chunks) {
+   if ((dest->num_chunks != src->num_chunks) ||
+       !sparse_reserve(dest, src->num_sparse)) {
       status = FALSE;
    }
    else {
       memcpy(dest->nameset,
              src->nameset,
              src->num_chunks * sizeof(uint32_t));
+      if (src->num_sparse > 0) {
+         memcpy(dest->sparse,
+                src->sparse,
+                src->num_sparse * sizeof(Pint));
+      }
+      dest->num_sparse = src->num_sparse;
       status = TRUE;
    }
 
@@ -268,7 +411,7 @@ int phg_nset_names_intersect(
    )
 {
    int status;
-   unsigned i;
+   unsigned i, j;
    uint32_t *nameset1 = nset1->nameset;
    uint32_t *nameset2 = nset2->nameset;
    unsigned num_chunks = PHG_MIN(nset1->num_chunks, nset2->num_chunks);
@@ -281,6 +424,21 @@ int phg_nset_names_intersect(
       }
    }
 
+   /* Both sparse lists are sorted, walk them in step */
+   i = 0;
+   j = 0;
+   while (!status && i < nset1->num_sparse && j < nset2->num_sparse) {
+      if (nset1->sparse[i] < nset2->sparse[j]) {
+         i++;
+      }
+      else if (nset1->sparse[i] > nset2->sparse[j]) {
+         j++;
+      }
+      else {
+         status = TRUE;
+      }
+   }
+
    return status;
 }
 
@@ -297,12 +455,13 @@ int phg_nset_name_is_set(
    )
 {
    int status;
+   unsigned pos;
    uint32_t bit;
 
-   if (name > nset->max_names) {
+   if (name < 0) {
       status = FALSE;
    }
-   else {
+   else if ((unsigned) name < nset->max_names) {
       bit = 0x1 << (name & 31);
       if (nset->nameset[name >> 5] & bit) {
          status = TRUE;
@@ -311,6 +470,9 @@ int phg_nset_name_is_set(
          status = FALSE;
       }
    }
+   else {
+      status = sparse_find(nset, name, &pos);
+   }
 
    return status;
 }
@@ -319,7 +481,7 @@ int phg_nset_name_is_set(
  * phg_nset_num_names_get
  *
  * DESCR:       Get number of names in nameset
- * RETURNS:     TRUE of FALSE
+ * RETURNS:     Number of names
  */
 
 int phg_nset_num_names_get(
@@ -327,14 +489,16 @@ int phg_nset_num_names_get(
    )
 {
    unsigned i;
+   uint32_t bits;
+   int count = 0;
 
-   for (i = nset->max_names; i > 0; i--) {
-      if (phg_nset_name_is_set(nset, i)) {
-         break;
+   for (i = 0; i < nset->num_chunks; i++) {
+      for (bits = nset->nameset[i]; bits != 0x0; bits &= bits - 1) {
+         count++;
       }
    }
 
-   return i;
+   return count + nset->num_sparse;
 }
 
 /*******************************************************************************
@@ -353,15 +517,18 @@ int phg_nset_names_get(
    int status;
    unsigned i, count;
 
-   if (num_names > nset->max_names) {
+   if (num_names > nset->max_names + nset->num_sparse) {
       status = FALSE;
    }
    else {
-      for (i = 1, count = 0; i <= nset->max_names && count < num_names; i++) {
+      for (i = 0, count = 0; i < nset->max_names && count < num_names; i++) {
          if (phg_nset_name_is_set(nset, i)) {
             name_list[count++] = i;
          }
       }
+      for (i = 0; i < nset->num_sparse && count < num_names; i++) {
+         name_list[count++] = nset->sparse[i];
+      }
       status = TRUE;
    }
 
@@ -380,12 +547,11 @@ int phg_nset_names_is_empty_all(
    )
 {
    unsigned i;
-   int status = TRUE;
+   int status = (nset->num_sparse == 0);
 
-   for (i = 0; i < nset->num_chunks; i++) {
+   for (i = 0; status && i < nset->num_chunks; i++) {
       if (nset->nameset[i] != 0x0) {
          status = FALSE;
-         break;
       }
    }
 
@@ -408,6 +574,8 @@ void phg_nset_print(
    for (i = 0; i < nset->num_chunks; i++) {
       printf("%x ", nset->nameset[i]);
    }
+   for (i = 0; i < nset->num_sparse; i++) {
+      printf("%d ", nset->sparse[i]);
+   }
    printf("\n");
 }
-
@@ -0,0 +1,307 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+    defined(__SSE2__)
+#define PACK_SSE
+#include <immintrin.h>
+#endif
+
+#include "phg.h"
+#include "util/pack.h"
+
+typedef void (*Pack_func)(Pfloat *dst, Pfloat *x, Pfloat *y, Pfloat *z,
+                          Pint n);
+
+/*******************************************************************************
+ * pack_2_scalar
+ *
+ * DESCR:       Interleave two coordinate arrays one point at a time
+ * RETURNS:     N/A
+ */
+
+static void pack_2_scalar(
+   Pfloat *dst,
+   Pfloat *x,
+   Pfloat *y,
+   Pfloat *z,
+   Pint n
+   )
+{
+   Pint i;
+
+   for (i = 0; i < n; i++) {
+      dst[0] = x[i];
+      dst[1] = y[i];
+      dst += 2;
+   }
+}
+
+/*******************************************************************************
+ * pack_3_scalar
+ *
+ * DESCR:       Interleave three coordinate arrays one point at a time
+ * RETURNS:     N/A
+ */
+
+static void pack_3_scalar(
+   Pfloat *dst,
+   Pfloat *x,
+   Pfloat *y,
+   Pfloat *z,
+   Pint n
+   )
+{
+   Pint i;
+
+   for (i = 0; i < n; i++) {
+      dst[0] = x[i];
+      dst[1] = y[i];
+      dst[2] = z[i];
+      dst += 3;
+   }
+}
+
+#ifdef PACK_SSE
+
+/*******************************************************************************
+ * pack_2_sse
+ *
+ * DESCR:       Interleave two coordinate arrays four points at a time
+ * RETURNS:     N/A
+ */
+
+static void pack_2_sse(
+   Pfloat *dst,
+   Pfloat *x,
+   Pfloat *y,
+   Pfloat *z,
+   Pint n
+   )
+{
+   Pint i;
+   __m128 vx, vy;
+
+   for (i = 0; i + 4 <= n; i += 4) {
+      vx = _mm_loadu_ps(&x[i]);
+      vy = _mm_loadu_ps(&y[i]);
+      _mm_storeu_ps(&dst[0], _mm_unpacklo_ps(vx, vy));
+      _mm_storeu_ps(&dst[4], _mm_unpackhi_ps(vx, vy));
+      dst += 8;
+   }
+   pack_2_scalar(dst, &x[i], &y[i], NULL, n - i);
+}
+
+/*******************************************************************************
+ * pack_3_sse
+ *
+ * DESCR:       Interleave three coordinate arrays four points at a time
+ * RETURNS:     N/A
+ */
+
+static void pack_3_sse(
+   Pfloat *dst,
+   Pfloat *x,
+   Pfloat *y,
+   Pfloat *z,
+   Pint n
+   )
+{
+   Pint i;
+   __m128 vx, vy, vz;
+   __m128 xy_lo, xy_hi, yz_lo, yz_hi, zx_lo, zx_hi;
+
+   for (i = 0; i + 4 <= n; i += 4) {
+      vx = _mm_loadu_ps(&x[i]);
+      vy = _mm_loadu_ps(&y[i]);
+      vz = _mm_loadu_ps(&z[i]);
+      xy_lo = _mm_unpacklo_ps(vx, vy);   /* x0 y0 x1 y1 */
+      xy_hi = _mm_unpackhi_ps(vx, vy);   /* x2 y2 x3 y3 */
+      yz_lo = _mm_unpacklo_ps(vy, vz);   /* y0 z0 y1 z1 */
+      yz_hi = _mm_unpackhi_ps(vy, vz);   /* y2 z2 y3 z3 */
+      zx_lo = _mm_unpacklo_ps(vz, vx);   /* z0 x0 z1 x1 */
+      zx_hi = _mm_unpackhi_ps(vz, vx);   /* z2 x2 z3 x3 */
+
+      /* x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3 */
+      _mm_storeu_ps(&dst[0],
+                    _mm_shuffle_ps(xy_lo, zx_lo, _MM_SHUFFLE(3, 0, 1, 0)));
+      _mm_storeu_ps(&dst[4],
+                    _mm_shuffle_ps(yz_lo, xy_hi, _MM_SHUFFLE(1, 0, 3, 2)));
+      _mm_storeu_ps(&dst[8],
+                    _mm_shuffle_ps(zx_hi, yz_hi, _MM_SHUFFLE(3, 2, 3, 0)));
+      dst += 12;
+   }
+   pack_3_scalar(dst, &x[i], &y[i], &z[i], n - i);
+}
+
+/*******************************************************************************
+ * pack_2_avx
+ *
+ * DESCR:       Interleave two coordinate arrays eight points at a time
+ * RETURNS:     N/A
+ */
+
+__attribute__((target("avx")))
+static void pack_2_avx(
+   Pfloat *dst,
+   Pfloat *x,
+   Pfloat *y,
+   Pfloat *z,
+   Pint n
+   )
+{
+   Pint i;
+   __m256 vx, vy, lo, hi;
+
+   for (i = 0; i + 8 <= n; i += 8) {
+      vx = _mm256_loadu_ps(&x[i]);
+      vy = _mm256_loadu_ps(&y[i]);
+
+      /* The unpacks work on each 128-bit lane, points 0-1/4-5 and 2-3/6-7 */
+      lo = _mm256_unpacklo_ps(vx, vy);
+      hi = _mm256_unpackhi_ps(vx, vy);
+      _mm256_storeu_ps(&dst[0], _mm256_permute2f128_ps(lo, hi, 0x20));
+      _mm256_storeu_ps(&dst[8], _mm256_permute2f128_ps(lo, hi, 0x31));
+      dst += 16;
+   }
+   pack_2_sse(dst, &x[i], &y[i], NULL, n - i);
+}
+
+/*******************************************************************************
+ * pack_3_avx
+ *
+ * DESCR:       Interleave three coordinate arrays eight points at a time
+ * RETURNS:     N/A
+ */
+
+__attribute__((target("avx")))
+static void pack_3_avx(
+   Pfloat *dst,
+   Pfloat *x,
+   Pfloat *y,
+   Pfloat *z,
+   Pint n
+   )
+{
+   Pint i;
+   __m256 vx, vy, vz;
+   __m256 xy_lo, xy_hi, yz_lo, yz_hi, zx_lo, zx_hi;
+   __m256 out0, out1, out2;
+
+   for (i = 0; i + 8 <= n; i += 8) {
+      vx = _mm256_loadu_ps(&x[i]);
+      vy = _mm256_loadu_ps(&y[i]);
+      vz = _mm256_loadu_ps(&z[i]);
+      xy_lo = _mm256_unpacklo_ps(vx, vy);
+      xy_hi = _mm256_unpackhi_ps(vx, vy);
+      yz_lo = _mm256_unpacklo_ps(vy, vz);
+      yz_hi = _mm256_unpackhi_ps(vy, vz);
+      zx_lo = _mm256_unpacklo_ps(vz, vx);
+      zx_hi = _mm256_unpackhi_ps(vz, vx);
+
+      /* Same shuffles as the SSE kernel, giving points 0-3 in the low
+       * lanes and points 4-7 in the high lanes
+       */
+      out0 = _mm256_shuffle_ps(xy_lo, zx_lo, _MM_SHUFFLE(3, 0, 1, 0));
+      out1 = _mm256_shuffle_ps(yz_lo, xy_hi, _MM_SHUFFLE(1, 0, 3, 2));
+      out2 = _mm256_shuffle_ps(zx_hi, yz_hi, _MM_SHUFFLE(3, 2, 3, 0));
+      _mm256_storeu_ps(&dst[0], _mm256_permute2f128_ps(out0, out1, 0x20));
+      _mm256_storeu_ps(&dst[8], _mm256_permute2f128_ps(out2, out0, 0x30));
+      _mm256_storeu_ps(&dst[16], _mm256_permute2f128_ps(out1, out2, 0x31));
+      dst += 24;
+   }
+   pack_3_sse(dst, &x[i], &y[i], &z[i], n - i);
+}
+
+#endif /* PACK_SSE */
+
+static Pack_func pack_2_func = NULL;
+static Pack_func pack_3_func = NULL;
+
+/*******************************************************************************
+ * pack_select
+ *
+ * DESCR:       Select interleave kernels supported by the processor
+ * RETURNS:     N/A
+ */
+
+static void pack_select(
+   void
+   )
+{
+#ifdef PACK_SSE
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx")) {
+      pack_3_func = pack_3_avx;
+      pack_2_func = pack_2_avx;
+   }
+   else {
+      pack_3_func = pack_3_sse;
+      pack_2_func = pack_2_sse;
+   }
+#else
+   pack_3_func = pack_3_scalar;
+   pack_2_func = pack_2_scalar;
+#endif
+}
+
+/*******************************************************************************
+ * phg_pack_points
+ *
+ * DESCR:       Interleave separate x and y coordinate arrays into points
+ * RETURNS:     N/A
+ */
+
+void phg_pack_points(
+   Ppoint *dst,
+   Pfloat *x,
+   Pfloat *y,
+   Pint n
+   )
+{
+   if (pack_2_func == NULL) {
+      pack_select();
+   }
+   (*pack_2_func)((Pfloat *) dst, x, y, NULL, n);
+}
+
+/*******************************************************************************
+ * phg_pack_points3
+ *
+ * DESCR:       Interleave separate x, y and z coordinate arrays into points
+ * RETURNS:     N/A
+ */
+
+void phg_pack_points3(
+   Ppoint3 *dst,
+   Pfloat *x,
+   Pfloat *y,
+   Pfloat *z,
+   Pint n
+   )
+{
+   if (pack_3_func == NULL) {
+      pack_select();
+   }
+   (*pack_3_func)((Pfloat *) dst, x, y, z, n);
+}
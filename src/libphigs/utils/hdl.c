@@ -113,6 +113,7 @@ int hdl_generic_elmt(
    )
 {
    void *data;
+   Phg_elmt_info *head;
 
    switch (op) {
       case CSS_EL_CREATE:
@@ -136,6 +137,14 @@ int hdl_generic_elmt(
                 ((Phg_args_add_el *) argdata)->el_size);
          break;
 
+      case CSS_EL_ADOPT:
+         /* Content was allocated behind room for the head */
+         head = ((Phg_elmt_info *) ((Phg_args_add_el *) argdata)->el_data) - 1;
+         head->elementType = ARGS_ELMT_TYPE(argdata);
+         head->length = ARGS_ELMT_SIZE_FULL(argdata);
+         ELMT_HEAD(elmt) = head;
+         break;
+
       case CSS_EL_COPY:
          ELMT_HEAD(elmt) = hdl_dup(argdata);
          if (ELMT_HEAD(elmt) == NULL) {
@@ -0,0 +1,1264 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************
+* Changes:   Copyright (C) 2022-2023 CERN
+******************************************************************************/
+
+/*
+ * Raster hardcopy output.
+ *
+ * The frame buffer is read into a pixel buffer object, so the transfer
+ * overlaps with the remaining work of closing the workstation. The pixels
+ * are then handed to a bounded queue served by a small pool of encoder
+ * threads, which write the TGA or PNG file while the application carries
+ * on. phg_hcopy_flush waits for all pending files.
+ *
+ * In multi-frame mode every redraw emits an image without closing the
+ * workstation. Two pixel buffer objects alternate, so frame n is copied
+ * while frame n + 1 is rendered.
+ *
+ * Images larger than the maximum frame buffer size are rendered in tiles.
+ * The frame buffer holds a single tile and the projection is shifted and
+ * scaled for each one. A row of tiles is read back at a time and its rows
+ * are streamed into the encoder, so memory stays bounded by one row of
+ * tiles whatever the size of the image.
+ *
+ * A multisampled frame buffer is resolved into the single sampled texture
+ * with a blit before every read back.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <png.h>
+
+#ifdef GLEW
+#include <GL/glew.h>
+#include <GL/gl.h>
+#else
+#include <epoxy/gl.h>
+#endif
+
+#include "phg.h"
+#include "ws.h"
+#include "private/wsglP.h"
+#include "private/wsxP.h"
+#include "private/hcopyP.h"
+
+typedef struct _Hcopy_job {
+   Hcopy_image       image;
+   struct _Hcopy_job *next;
+} Hcopy_job;
+
+typedef struct {
+   FILE              *fd;
+   png_structp       png;
+   unsigned char     *buffer;
+   size_t            stride;
+   int               height;
+   int               top_down;
+} Hcopy_rows;
+
+typedef void (*Hcopy_row_func)(
+   void *data,
+   int y,
+   unsigned char *row
+   );
+
+int phg_hcopy_num_threads = 0;
+int phg_hcopy_tile_size = 0;
+
+static pthread_mutex_t hcopy_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t hcopy_work = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t hcopy_space = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t hcopy_done = PTHREAD_COND_INITIALIZER;
+static pthread_t hcopy_threads[HCOPY_MAX_THREADS];
+static Hcopy_job *hcopy_head = NULL;
+static Hcopy_job *hcopy_tail = NULL;
+static int hcopy_num_pending = 0;
+static int hcopy_num_busy = 0;
+static int hcopy_num_running = 0;
+static int hcopy_stop = FALSE;
+static int hcopy_atexit = FALSE;
+
+/*******************************************************************************
+ * hcopy_format
+ *
+ * DESCR:       Get OpenGL pixel format and number of channels for category
+ * RETURNS:     Number of channels
+ */
+
+static int hcopy_format(
+   Pws_cat category,
+   GLenum *format
+   )
+{
+   switch (category) {
+   case PCAT_TGA:
+      *format = GL_BGR_EXT;
+      return 3;
+   case PCAT_PNGA:
+      *format = GL_RGBA;
+      return 4;
+   case PCAT_PNG:
+   default:
+      *format = GL_RGB;
+      return 3;
+   }
+}
+
+/*******************************************************************************
+ * hcopy_write_tga
+ *
+ * DESCR:       Write uncompressed TGA file
+ * RETURNS:     N/A
+ */
+
+static void hcopy_write_tga(
+   Hcopy_image *image
+   )
+{
+   FILE *fd;
+   short header[] = {0, 2, 0, 0, 0, 0,
+                     (short) image->width, (short) image->height, 24};
+
+   fd = fopen(image->filename, "w+");
+   if (fd == NULL) {
+      printf("TGA export error: cannot open %s\n", image->filename);
+      return;
+   }
+   fwrite(&header, sizeof(header), 1, fd);
+   fwrite(image->pixels, 3 * image->width * image->height, 1, fd);
+   fclose(fd);
+}
+
+/*******************************************************************************
+ * hcopy_mem_write
+ *
+ * DESCR:       libpng write callback appending to growable memory buffer
+ * RETURNS:     N/A
+ */
+
+static void hcopy_mem_write(
+   png_structp png,
+   png_bytep data,
+   png_size_t length
+   )
+{
+   Hcopy_mem *mem = (Hcopy_mem *) png_get_io_ptr(png);
+   unsigned char *new_data;
+   size_t new_size;
+
+   if (mem->size + length > mem->max_size) {
+      new_size = (mem->max_size == 0) ? 65536 : 2 * mem->max_size;
+      while (new_size < mem->size + length) {
+         new_size *= 2;
+      }
+      new_data = (unsigned char *) realloc(mem->data, new_size);
+      if (new_data == NULL) {
+         png_error(png, "out of memory");
+      }
+      mem->data = new_data;
+      mem->max_size = new_size;
+   }
+   memcpy(&mem->data[mem->size], data, length);
+   mem->size += length;
+}
+
+/*******************************************************************************
+ * hcopy_mem_flush
+ *
+ * DESCR:       libpng flush callback for memory buffer
+ * RETURNS:     N/A
+ */
+
+static void hcopy_mem_flush(
+   png_structp png
+   )
+{
+}
+
+/*******************************************************************************
+ * hcopy_png
+ *
+ * DESCR:       Encode pixels as PNG to file or memory buffer
+ * RETURNS:     TRUE or FALSE
+ */
+
+static int hcopy_png(
+   unsigned char *pixels,
+   int width,
+   int height,
+   int channels,
+   FILE *fd,
+   Hcopy_mem *mem
+   )
+{
+   int i;
+   int status = FALSE;
+   png_structp png;
+   png_infop info;
+   png_byte **png_rows;
+
+   png_rows = (png_byte **) malloc(height * sizeof(png_byte *));
+   if (png_rows == NULL) {
+      printf("PNG export error: out of memory\n");
+      return FALSE;
+   }
+   for (i = 0; i < height; i++) {
+      png_rows[i] = &pixels[(height - i - 1) * width * channels];
+   }
+
+   png = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+   if (png == NULL) {
+      printf("PNG export error: failed to create write structure\n");
+      free(png_rows);
+      return FALSE;
+   }
+   info = png_create_info_struct(png);
+   if (info == NULL) {
+      printf("PNG export error: failed to create info structure\n");
+      png_destroy_write_struct(&png, NULL);
+      free(png_rows);
+      return FALSE;
+   }
+   if (setjmp(png_jmpbuf(png))) {
+      printf("PNG export error: failed to encode image\n");
+   }
+   else {
+      if (mem != NULL) {
+         png_set_write_fn(png, mem, hcopy_mem_write, hcopy_mem_flush);
+      }
+      else {
+         png_init_io(png, fd);
+      }
+      png_set_IHDR(png,
+                   info,
+                   width, height,
+                   8,
+                   (channels == 4) ? PNG_COLOR_TYPE_RGBA : PNG_COLOR_TYPE_RGB,
+                   PNG_INTERLACE_NONE,
+                   PNG_COMPRESSION_TYPE_DEFAULT,
+                   PNG_FILTER_TYPE_DEFAULT);
+      png_write_info(png, info);
+      png_write_image(png, png_rows);
+      png_write_end(png, NULL);
+      status = TRUE;
+   }
+   png_destroy_write_struct(&png, &info);
+   free(png_rows);
+
+   return status;
+}
+
+/*******************************************************************************
+ * hcopy_write_png
+ *
+ * DESCR:       Write PNG file
+ * RETURNS:     N/A
+ */
+
+static void hcopy_write_png(
+   Hcopy_image *image
+   )
+{
+   FILE *fd;
+
+   fd = fopen(image->filename, "w+");
+   if (fd == NULL) {
+      printf("PNG export error: cannot open %s\n", image->filename);
+      return;
+   }
+   hcopy_png(image->pixels,
+             image->width,
+             image->height,
+             (image->category == PCAT_PNGA) ? 4 : 3,
+             fd,
+             NULL);
+   fclose(fd);
+}
+
+/*******************************************************************************
+ * hcopy_write
+ *
+ * DESCR:       Encode image file and release pixel data
+ * RETURNS:     N/A
+ */
+
+static void hcopy_write(
+   Hcopy_image *image
+   )
+{
+   if (image->category == PCAT_TGA) {
+      hcopy_write_tga(image);
+   }
+   else {
+      hcopy_write_png(image);
+   }
+   free(image->pixels);
+   image->pixels = NULL;
+}
+
+/*******************************************************************************
+ * hcopy_worker
+ *
+ * DESCR:       Encoder thread main loop
+ * RETURNS:     NULL
+ */
+
+static void* hcopy_worker(
+   void *arg
+   )
+{
+   Hcopy_job *job;
+
+   pthread_mutex_lock(&hcopy_lock);
+   while (1) {
+      while (hcopy_head == NULL && !hcopy_stop) {
+         pthread_cond_wait(&hcopy_work, &hcopy_lock);
+      }
+      if (hcopy_head == NULL) {
+         break;
+      }
+      job = hcopy_head;
+      hcopy_head = job->next;
+      if (hcopy_head == NULL) {
+         hcopy_tail = NULL;
+      }
+      hcopy_num_pending--;
+      hcopy_num_busy++;
+      pthread_cond_signal(&hcopy_space);
+      pthread_mutex_unlock(&hcopy_lock);
+
+      hcopy_write(&job->image);
+      free(job);
+
+      pthread_mutex_lock(&hcopy_lock);
+      hcopy_num_busy--;
+      if (hcopy_head == NULL && hcopy_num_busy == 0) {
+         pthread_cond_broadcast(&hcopy_done);
+      }
+   }
+   pthread_mutex_unlock(&hcopy_lock);
+
+   return NULL;
+}
+
+/*******************************************************************************
+ * hcopy_stop_threads
+ *
+ * DESCR:       Write pending images and stop encoder threads
+ * RETURNS:     N/A
+ */
+
+static void hcopy_stop_threads(
+   void
+   )
+{
+   int i, num_running;
+
+   pthread_mutex_lock(&hcopy_lock);
+   hcopy_stop = TRUE;
+   num_running = hcopy_num_running;
+   hcopy_num_running = 0;
+   pthread_cond_broadcast(&hcopy_work);
+   pthread_mutex_unlock(&hcopy_lock);
+
+   for (i = 0; i < num_running; i++) {
+      pthread_join(hcopy_threads[i], NULL);
+   }
+   hcopy_stop = FALSE;
+}
+
+/*******************************************************************************
+ * hcopy_start_threads
+ *
+ * DESCR:       Start encoder threads if not running yet
+ * RETURNS:     Number of running threads
+ */
+
+static int hcopy_start_threads(
+   void
+   )
+{
+   int num_threads;
+
+   if (hcopy_num_running > 0) {
+      return hcopy_num_running;
+   }
+
+   num_threads = phg_hcopy_num_threads;
+   if (num_threads > HCOPY_MAX_THREADS) {
+      num_threads = HCOPY_MAX_THREADS;
+   }
+   while (hcopy_num_running < num_threads) {
+      if (pthread_create(&hcopy_threads[hcopy_num_running],
+                         NULL,
+                         hcopy_worker,
+                         NULL) != 0) {
+         printf("Hardcopy: failed to start encoder thread\n");
+         break;
+      }
+      hcopy_num_running++;
+   }
+   if (hcopy_num_running > 0 && !hcopy_atexit) {
+      /* do not lose images when the application exits without flush */
+      atexit(hcopy_stop_threads);
+      hcopy_atexit = TRUE;
+   }
+
+   return hcopy_num_running;
+}
+
+/*******************************************************************************
+ * phg_hcopy_is_raster
+ *
+ * DESCR:       Check if workstation category is a raster image file
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_hcopy_is_raster(
+   Pws_cat category
+   )
+{
+   return (category == PCAT_TGA ||
+           category == PCAT_PNG ||
+           category == PCAT_PNGA);
+}
+
+/*******************************************************************************
+ * phg_hcopy_tile_setup
+ *
+ * DESCR:       Choose the frame buffer size of a hardcopy workstation,
+ *              split into tiles if the image exceeds the maximum size
+ * RETURNS:     N/A
+ */
+
+void phg_hcopy_tile_setup(
+   Ws *ws,
+   int *width,
+   int *height
+   )
+{
+   GLint max_size, size;
+   GLint dims[2];
+
+   glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &max_size);
+   glGetIntegerv(GL_MAX_TEXTURE_SIZE, &size);
+   if (size < max_size) {
+      max_size = size;
+   }
+   glGetIntegerv(GL_MAX_VIEWPORT_DIMS, dims);
+   if (dims[0] < max_size) {
+      max_size = dims[0];
+   }
+   if (dims[1] < max_size) {
+      max_size = dims[1];
+   }
+   if (phg_hcopy_tile_size > 0 && phg_hcopy_tile_size < max_size) {
+      max_size = phg_hcopy_tile_size;
+   }
+
+   ws->hcopy_tile[0] = 0;
+   ws->hcopy_tile[1] = 0;
+   if (max_size > 0 && (*width > max_size || *height > max_size)) {
+      if (*width > max_size) {
+         *width = max_size;
+      }
+      if (*height > max_size) {
+         *height = max_size;
+      }
+      ws->hcopy_tile[0] = *width;
+      ws->hcopy_tile[1] = *height;
+#ifdef DEBUG
+      printf("Hardcopy: rendering in tiles of %d x %d\n", *width, *height);
+#endif
+   }
+}
+
+/*******************************************************************************
+ * hcopy_tiles
+ *
+ * DESCR:       Render a tiled workstation one row of tiles at a time and
+ *              pass the image rows, top or bottom first, to a row function
+ * RETURNS:     TRUE or FALSE
+ */
+
+static int hcopy_tiles(
+   Ws *ws,
+   GLenum format,
+   int channels,
+   int top_down,
+   Hcopy_row_func func,
+   void *data
+   )
+{
+   int i, k, num_rows;
+   int x, y, w, h;
+   int width = ws->type->desc_tbl.xwin_dt.tool.width;
+   int height = ws->type->desc_tbl.xwin_dt.tool.height;
+   int tile_w = ws->hcopy_tile[0];
+   int tile_h = ws->hcopy_tile[1];
+   size_t stride = (size_t) channels * width;
+   unsigned char *strip;
+
+   strip = (unsigned char *) malloc(stride * tile_h);
+   if (strip == NULL) {
+      printf("Hardcopy: out of memory for %d x %d tiles\n", width, tile_h);
+      return FALSE;
+   }
+
+   num_rows = (height + tile_h - 1) / tile_h;
+   for (k = 0; k < num_rows; k++) {
+      y = (top_down ? num_rows - 1 - k : k) * tile_h;
+      h = (height - y < tile_h) ? height - y : tile_h;
+      for (x = 0; x < width; x += tile_w) {
+         w = (width - x < tile_w) ? width - x : tile_w;
+         wsgl_set_tile(ws, x, y);
+         (*ws->redraw_all)(ws, PFLAG_ALWAYS);
+         phg_wsx_resolve_fb(ws);
+         glPixelStorei(GL_PACK_ALIGNMENT, 1);
+         glPixelStorei(GL_PACK_ROW_LENGTH, width);
+         glReadPixels(0, 0, w, h, format, GL_UNSIGNED_BYTE,
+                      &strip[(size_t) channels * x]);
+         glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+      }
+      for (i = 0; i < h; i++) {
+         if (top_down) {
+            (*func)(data, y + h - 1 - i, &strip[(h - 1 - i) * stride]);
+         }
+         else {
+            (*func)(data, y + i, &strip[i * stride]);
+         }
+      }
+   }
+   wsgl_set_tile(ws, 0, 0);
+   free(strip);
+
+   return TRUE;
+}
+
+/*******************************************************************************
+ * hcopy_tga_row
+ *
+ * DESCR:       Append a row to a TGA file
+ * RETURNS:     N/A
+ */
+
+static void hcopy_tga_row(
+   void *data,
+   int y,
+   unsigned char *row
+   )
+{
+   Hcopy_rows *rows = (Hcopy_rows *) data;
+
+   fwrite(row, rows->stride, 1, rows->fd);
+}
+
+/*******************************************************************************
+ * hcopy_png_row
+ *
+ * DESCR:       Pass a row to the PNG encoder
+ * RETURNS:     N/A
+ */
+
+static void hcopy_png_row(
+   void *data,
+   int y,
+   unsigned char *row
+   )
+{
+   Hcopy_rows *rows = (Hcopy_rows *) data;
+
+   png_write_row(rows->png, row);
+}
+
+/*******************************************************************************
+ * hcopy_buffer_row
+ *
+ * DESCR:       Copy a row into the caller buffer
+ * RETURNS:     N/A
+ */
+
+static void hcopy_buffer_row(
+   void *data,
+   int y,
+   unsigned char *row
+   )
+{
+   Hcopy_rows *rows = (Hcopy_rows *) data;
+
+   if (rows->top_down) {
+      y = rows->height - y - 1;
+   }
+   memcpy(&rows->buffer[y * rows->stride], row, rows->stride);
+}
+
+/*******************************************************************************
+ * phg_hcopy_write_tiled
+ *
+ * DESCR:       Render a tiled workstation tile by tile into an image file
+ * RETURNS:     N/A
+ */
+
+void phg_hcopy_write_tiled(
+   Ws *ws,
+   Pws_cat category,
+   char *filename
+   )
+{
+   Hcopy_rows rows;
+   GLenum format;
+   png_infop info;
+   int channels;
+   int width = ws->type->desc_tbl.xwin_dt.tool.width;
+   int height = ws->type->desc_tbl.xwin_dt.tool.height;
+   short header[] = {0, 2, 0, 0, 0, 0,
+                     (short) width, (short) height, 24};
+
+   channels = hcopy_format(category, &format);
+   memset(&rows, 0, sizeof(Hcopy_rows));
+   rows.stride = (size_t) channels * width;
+   rows.height = height;
+   rows.fd = fopen(filename, "w+");
+   if (rows.fd == NULL) {
+      printf("Hardcopy: cannot open %s\n", filename);
+      return;
+   }
+
+   if (category == PCAT_TGA) {
+      /* TGA rows are stored bottom up, as read by OpenGL */
+      fwrite(&header, sizeof(header), 1, rows.fd);
+      hcopy_tiles(ws, format, channels, FALSE, hcopy_tga_row, &rows);
+      fclose(rows.fd);
+      return;
+   }
+
+   rows.png = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+   info = (rows.png != NULL) ? png_create_info_struct(rows.png) : NULL;
+   if (info == NULL) {
+      printf("PNG export error: failed to create write structure\n");
+      png_destroy_write_struct(&rows.png, NULL);
+      fclose(rows.fd);
+      return;
+   }
+   if (setjmp(png_jmpbuf(rows.png))) {
+      printf("PNG export error: failed to encode image\n");
+   }
+   else {
+      png_init_io(rows.png, rows.fd);
+      png_set_IHDR(rows.png,
+                   info,
+                   width, height,
+                   8,
+                   (channels == 4) ? PNG_COLOR_TYPE_RGBA : PNG_COLOR_TYPE_RGB,
+                   PNG_INTERLACE_NONE,
+                   PNG_COMPRESSION_TYPE_DEFAULT,
+                   PNG_FILTER_TYPE_DEFAULT);
+      png_write_info(rows.png, info);
+      if (hcopy_tiles(ws, format, channels, TRUE, hcopy_png_row, &rows)) {
+         png_write_end(rows.png, NULL);
+      }
+   }
+   png_destroy_write_struct(&rows.png, &info);
+   fclose(rows.fd);
+}
+
+/*******************************************************************************
+ * hcopy_has_pbo
+ *
+ * DESCR:       Check for pixel buffer object support
+ * RETURNS:     TRUE or FALSE
+ */
+
+static int hcopy_has_pbo(
+   void
+   )
+{
+#ifdef GLEW
+   return (GLEW_ARB_pixel_buffer_object) ? TRUE : FALSE;
+#else
+   return TRUE;
+#endif
+}
+
+/*******************************************************************************
+ * hcopy_pbo_read
+ *
+ * DESCR:       Queue frame buffer read into pixel buffer object
+ * RETURNS:     N/A
+ */
+
+static void hcopy_pbo_read(
+   GLuint pbo,
+   Pws_cat category,
+   int width,
+   int height
+   )
+{
+   GLenum format;
+   int channels;
+
+   channels = hcopy_format(category, &format);
+   glPixelStorei(GL_PACK_ALIGNMENT, 1);
+   glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+   glBufferData(GL_PIXEL_PACK_BUFFER,
+                channels * width * height,
+                NULL,
+                GL_STREAM_READ);
+   /* returns immediately, the copy is queued behind the rendering */
+   glReadPixels(0, 0, width, height, format, GL_UNSIGNED_BYTE, NULL);
+   glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+/*******************************************************************************
+ * hcopy_pbo_collect
+ *
+ * DESCR:       Copy pixel buffer object contents, or read the frame buffer
+ *              directly when pbo is zero
+ * RETURNS:     Pixel data allocated with malloc or NULL
+ */
+
+static unsigned char* hcopy_pbo_collect(
+   GLuint pbo,
+   Pws_cat category,
+   int width,
+   int height
+   )
+{
+   GLenum format;
+   int channels;
+   int error;
+   unsigned int buffer_size;
+   unsigned char *pixels;
+   void *mapped = NULL;
+
+   channels = hcopy_format(category, &format);
+   buffer_size = channels * width * height;
+   pixels = (unsigned char *) malloc(buffer_size);
+   if (pixels == NULL) {
+      printf("Hardcopy: out of memory for %d x %d image\n", width, height);
+   }
+
+   if (pbo != 0) {
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+      if (pixels != NULL) {
+         mapped = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+      }
+      if (mapped != NULL) {
+         memcpy(pixels, mapped, buffer_size);
+         glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+      }
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+   }
+   else if (pixels != NULL) {
+      glPixelStorei(GL_PACK_ALIGNMENT, 1);
+      glReadPixels(0, 0, width, height, format, GL_UNSIGNED_BYTE, pixels);
+      mapped = pixels;
+   }
+
+   error = glGetError();
+   if (error != GL_NO_ERROR) {
+      printf("Hardcopy: glReadPixel returned error code %d\n", error);
+   }
+   if (pixels != NULL && mapped == NULL) {
+      free(pixels);
+      pixels = NULL;
+   }
+
+   return pixels;
+}
+
+/*******************************************************************************
+ * phg_hcopy_read_begin
+ *
+ * DESCR:       Start reading back the frame buffer into a pixel buffer object
+ * RETURNS:     N/A
+ */
+
+void phg_hcopy_read_begin(
+   Ws *ws,
+   Pws_cat category,
+   int width,
+   int height
+   )
+{
+   ws->hcopy_pbo = 0;
+   phg_wsx_resolve_fb(ws);
+   if (hcopy_has_pbo()) {
+      glGenBuffers(1, &ws->hcopy_pbo);
+      hcopy_pbo_read(ws->hcopy_pbo, category, width, height);
+   }
+}
+
+/*******************************************************************************
+ * phg_hcopy_read_end
+ *
+ * DESCR:       Complete frame buffer read back
+ * RETURNS:     Pixel data allocated with malloc or NULL
+ */
+
+unsigned char* phg_hcopy_read_end(
+   Ws *ws,
+   Pws_cat category,
+   int width,
+   int height
+   )
+{
+   unsigned char *pixels;
+
+   pixels = hcopy_pbo_collect(ws->hcopy_pbo, category, width, height);
+   if (ws->hcopy_pbo != 0) {
+      glDeleteBuffers(1, &ws->hcopy_pbo);
+      ws->hcopy_pbo = 0;
+   }
+
+   return pixels;
+}
+
+/*******************************************************************************
+ * phg_hcopy_submit
+ *
+ * DESCR:       Encode and write image file, in an encoder thread if enabled.
+ *              The pixel data is owned and freed by the encoder.
+ * RETURNS:     N/A
+ */
+
+void phg_hcopy_submit(
+   Hcopy_image *image
+   )
+{
+   Hcopy_job *job = NULL;
+
+   if (phg_hcopy_num_threads > 0 && hcopy_start_threads() > 0) {
+      job = (Hcopy_job *) malloc(sizeof(Hcopy_job));
+   }
+   if (job == NULL) {
+      hcopy_write(image);
+      return;
+   }
+
+   memcpy(&job->image, image, sizeof(Hcopy_image));
+   job->next = NULL;
+   image->pixels = NULL;
+
+   pthread_mutex_lock(&hcopy_lock);
+   while (hcopy_num_pending >= HCOPY_MAX_PENDING) {
+      pthread_cond_wait(&hcopy_space, &hcopy_lock);
+   }
+   if (hcopy_tail == NULL) {
+      hcopy_head = job;
+   }
+   else {
+      hcopy_tail->next = job;
+   }
+   hcopy_tail = job;
+   hcopy_num_pending++;
+   pthread_cond_signal(&hcopy_work);
+   pthread_mutex_unlock(&hcopy_lock);
+}
+
+/*******************************************************************************
+ * phg_hcopy_flush
+ *
+ * DESCR:       Wait until all submitted images are written
+ * RETURNS:     N/A
+ */
+
+void phg_hcopy_flush(
+   void
+   )
+{
+   pthread_mutex_lock(&hcopy_lock);
+   while (hcopy_head != NULL || hcopy_num_busy > 0) {
+      pthread_cond_wait(&hcopy_done, &hcopy_lock);
+   }
+   pthread_mutex_unlock(&hcopy_lock);
+}
+
+/*******************************************************************************
+ * hcopy_frames_get
+ *
+ * DESCR:       Get multi-frame state of workstation, create if needed
+ * RETURNS:     Pointer to state or NULL
+ */
+
+static Hcopy_frames* hcopy_frames_get(
+   Ws *ws
+   )
+{
+   Hcopy_frames *frames = ws->hcopy_frames;
+
+   if (!phg_hcopy_is_raster(ws->type->desc_tbl.phigs_dt.ws_category)) {
+      printf("Hardcopy: multiple frames need a TGA or PNG workstation\n");
+      return NULL;
+   }
+   if (ws->hcopy_tile[0] > 0) {
+      printf("Hardcopy: multiple frames need an image that fits in one tile\n");
+      return NULL;
+   }
+   if (frames == NULL) {
+      frames = (Hcopy_frames *) calloc(1, sizeof(Hcopy_frames));
+      if (frames == NULL) {
+         return NULL;
+      }
+      frames->pending = -1;
+      ws->hcopy_frames = frames;
+   }
+
+   return frames;
+}
+
+/*******************************************************************************
+ * hcopy_frames_submit
+ *
+ * DESCR:       Write frame held in readback buffer
+ * RETURNS:     N/A
+ */
+
+static void hcopy_frames_submit(
+   Ws *ws,
+   Hcopy_frames *frames,
+   int index,
+   Pint frame
+   )
+{
+   Hcopy_image image;
+   Pws_cat category = ws->type->desc_tbl.phigs_dt.ws_category;
+   int width = ws->type->desc_tbl.xwin_dt.tool.width;
+   int height = ws->type->desc_tbl.xwin_dt.tool.height;
+
+   image.pixels = hcopy_pbo_collect((index < 0) ? 0 : frames->pbo[index],
+                                    category,
+                                    width,
+                                    height);
+   if (image.pixels != NULL) {
+      image.category = category;
+      image.width = width;
+      image.height = height;
+      snprintf(image.filename, sizeof(image.filename), frames->pattern, frame);
+      phg_hcopy_submit(&image);
+   }
+}
+
+/*******************************************************************************
+ * hcopy_pattern_valid
+ *
+ * DESCR:       Check that file name pattern holds exactly one integer
+ *              conversion and no other conversion than %%
+ * RETURNS:     TRUE or FALSE
+ */
+
+static int hcopy_pattern_valid(
+   char *pattern
+   )
+{
+   char *p;
+   int num_conv = 0;
+
+   if (strlen(pattern) >= sizeof(((Hcopy_frames *) NULL)->pattern)) {
+      return FALSE;
+   }
+
+   for (p = pattern; *p != '\0'; p++) {
+      if (*p != '%') {
+         continue;
+      }
+      p++;
+      if (*p == '%') {
+         continue;
+      }
+      while (*p != '\0' && strchr("-+ #0", *p) != NULL) {
+         p++;
+      }
+      while (*p >= '0' && *p <= '9') {
+         p++;
+      }
+      if (*p == '.') {
+         p++;
+         while (*p >= '0' && *p <= '9') {
+            p++;
+         }
+      }
+      if (*p == '\0' || strchr("diuoxX", *p) == NULL) {
+         return FALSE;
+      }
+      num_conv++;
+   }
+
+   return (num_conv == 1) ? TRUE : FALSE;
+}
+
+/*******************************************************************************
+ * phg_hcopy_frames_file
+ *
+ * DESCR:       Write an image file per redraw, NULL pattern to stop
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_hcopy_frames_file(
+   Ws *ws,
+   char *pattern
+   )
+{
+   Hcopy_frames *frames;
+
+   if (pattern != NULL && !hcopy_pattern_valid(pattern)) {
+      printf("Hardcopy: frame pattern needs one integer conversion\n");
+      return FALSE;
+   }
+
+   phg_hcopy_frames_end(ws);
+   if (pattern == NULL) {
+      return TRUE;
+   }
+
+   frames = hcopy_frames_get(ws);
+   if (frames == NULL) {
+      return FALSE;
+   }
+   strncpy(frames->pattern, pattern, sizeof(frames->pattern) - 1);
+   if (hcopy_has_pbo()) {
+      glGenBuffers(2, frames->pbo);
+   }
+
+   return TRUE;
+}
+
+/*******************************************************************************
+ * phg_hcopy_frames_buffer
+ *
+ * DESCR:       Read each redraw into caller buffer, NULL func to stop
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_hcopy_frames_buffer(
+   Ws *ws,
+   void *buffer,
+   size_t size,
+   Phcopy_frame_func func
+   )
+{
+   Hcopy_frames *frames;
+   GLenum format;
+   size_t needed;
+
+   phg_hcopy_frames_end(ws);
+   if (func == NULL) {
+      return TRUE;
+   }
+
+   needed = (size_t) hcopy_format(ws->type->desc_tbl.phigs_dt.ws_category,
+                                  &format) *
+      ws->type->desc_tbl.xwin_dt.tool.width *
+      ws->type->desc_tbl.xwin_dt.tool.height;
+   if (buffer == NULL || size < needed) {
+      printf("Hardcopy: frame buffer needs %lu bytes\n",
+             (unsigned long) needed);
+      return FALSE;
+   }
+
+   frames = hcopy_frames_get(ws);
+   if (frames == NULL) {
+      return FALSE;
+   }
+   frames->buffer = buffer;
+   frames->size = size;
+   frames->func = func;
+
+   return TRUE;
+}
+
+/*******************************************************************************
+ * phg_hcopy_frame
+ *
+ * DESCR:       Emit the frame just rendered on a multi-frame hardcopy
+ * RETURNS:     N/A
+ */
+
+void phg_hcopy_frame(
+   Ws *ws
+   )
+{
+   Hcopy_frames *frames = ws->hcopy_frames;
+   Pws_cat category = ws->type->desc_tbl.phigs_dt.ws_category;
+   int width = ws->type->desc_tbl.xwin_dt.tool.width;
+   int height = ws->type->desc_tbl.xwin_dt.tool.height;
+   GLenum format;
+   int next;
+
+   phg_wsx_resolve_fb(ws);
+   if (frames->func != NULL) {
+      /* straight into the caller buffer, no copy */
+      hcopy_format(category, &format);
+      glPixelStorei(GL_PACK_ALIGNMENT, 1);
+      glReadPixels(0, 0, width, height, format, GL_UNSIGNED_BYTE,
+                   frames->buffer);
+      (*frames->func)(ws->id, frames->frame, width, height, frames->buffer);
+   }
+   else if (frames->pbo[0] != 0) {
+      /* read this frame while the previous one is encoded */
+      next = (frames->pending == 0) ? 1 : 0;
+      hcopy_pbo_read(frames->pbo[next], category, width, height);
+      if (frames->pending >= 0) {
+         hcopy_frames_submit(ws, frames, frames->pending,
+                             frames->pending_frame);
+      }
+      frames->pending = next;
+      frames->pending_frame = frames->frame;
+   }
+   else {
+      hcopy_frames_submit(ws, frames, -1, frames->frame);
+   }
+   frames->frame++;
+}
+
+/*******************************************************************************
+ * phg_hcopy_frames_end
+ *
+ * DESCR:       Write pending frame and stop multi-frame hardcopy
+ * RETURNS:     N/A
+ */
+
+void phg_hcopy_frames_end(
+   Ws *ws
+   )
+{
+   Hcopy_frames *frames = ws->hcopy_frames;
+
+   if (frames == NULL) {
+      return;
+   }
+   if (frames->pending >= 0) {
+      hcopy_frames_submit(ws, frames, frames->pending, frames->pending_frame);
+   }
+   if (frames->pbo[0] != 0) {
+      glDeleteBuffers(2, frames->pbo);
+   }
+   free(frames);
+   ws->hcopy_frames = NULL;
+}
+
+/*******************************************************************************
+ * phg_hcopy_read_pixels
+ *
+ * DESCR:       Read frame buffer of workstation into caller buffer, a tiled
+ *              workstation is rendered again tile by tile
+ * RETURNS:     N/A
+ */
+
+void phg_hcopy_read_pixels(
+   Ws *ws,
+   int channels,
+   int top_down,
+   void *buffer
+   )
+{
+   int i;
+   int width = ws->type->desc_tbl.xwin_dt.tool.width;
+   int height = ws->type->desc_tbl.xwin_dt.tool.height;
+   size_t stride = (size_t) channels * width;
+   unsigned char *top, *bottom, tmp;
+   size_t j;
+   Hcopy_rows rows;
+
+   if (ws->hcopy_tile[0] > 0) {
+      memset(&rows, 0, sizeof(Hcopy_rows));
+      rows.buffer = (unsigned char *) buffer;
+      rows.stride = stride;
+      rows.height = height;
+      rows.top_down = top_down;
+      hcopy_tiles(ws, (channels == 4) ? GL_RGBA : GL_RGB, channels, FALSE,
+                  hcopy_buffer_row, &rows);
+      return;
+   }
+
+   phg_wsx_resolve_fb(ws);
+   glPixelStorei(GL_PACK_ALIGNMENT, 1);
+   glReadPixels(0, 0, width, height,
+                (channels == 4) ? GL_RGBA : GL_RGB,
+                GL_UNSIGNED_BYTE,
+                buffer);
+   if (top_down) {
+      /* swap rows in place, no scratch buffer */
+      for (i = 0; i < height / 2; i++) {
+         top = (unsigned char *) buffer + i * stride;
+         bottom = (unsigned char *) buffer + (height - i - 1) * stride;
+         for (j = 0; j < stride; j++) {
+            tmp = top[j];
+            top[j] = bottom[j];
+            bottom[j] = tmp;
+         }
+      }
+   }
+}
+
+/*******************************************************************************
+ * phg_hcopy_encode_png
+ *
+ * DESCR:       Encode pixels, bottom row first, as PNG in memory
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_hcopy_encode_png(
+   unsigned char *pixels,
+   int width,
+   int height,
+   int channels,
+   Hcopy_mem *mem
+   )
+{
+   mem->data = NULL;
+   mem->size = 0;
+   mem->max_size = 0;
+   if (!hcopy_png(pixels, width, height, channels, NULL, mem)) {
+      free(mem->data);
+      mem->data = NULL;
+      mem->size = 0;
+      return FALSE;
+   }
+
+   return TRUE;
+}
+
+/*******************************************************************************
+ * phg_hcopy_set_threads
+ *
+ * DESCR:       Set number of encoder threads
+ * RETURNS:     N/A
+ */
+
+void phg_hcopy_set_threads(
+   int num_threads
+   )
+{
+   if (num_threads < 0) {
+      num_threads = 0;
+   }
+   if (num_threads > HCOPY_MAX_THREADS) {
+      num_threads = HCOPY_MAX_THREADS;
+   }
+   if (num_threads != phg_hcopy_num_threads) {
+      /* restarted on the next submit with the new size */
+      hcopy_stop_threads();
+      phg_hcopy_num_threads = num_threads;
+   }
+}
@@ -2120,7 +2120,10 @@ void phg_ws_inp_repaint(
                         XRectangle *rects
                         )
 {
+  /* The echoes are also drawn by the input thread. */
+  phg_wsx_input_lock();
   phg_sin_repaint( ws->in_ws.sin_handle, num_rects, rects );
+  phg_wsx_input_unlock();
 }
 
 /*******************************************************************************
@@ -66,6 +66,8 @@ SOFTWARE.
 #include "private/wsbP.h"
 #include "private/wsglP.h"
 #include "private/wsxP.h"
+#include "private/hcopyP.h"
+#include "private/evtP.h"
 #include "css.h"
 #include "alloc.h"
 
@@ -462,6 +464,69 @@ static void init_views(
   list_init(&owsb->views);
 }
 
+/* Repair an exposed window from the copy of the last frame, without a
+ * traversal, and draw the echoes of active input devices on top of it.
+ * Without a usable copy the exposure is left to the application.
+ */
+static void wsb_repair(
+                       Ws *ws
+                       )
+{
+  if ( !wsgl_restore_scene( ws ) )
+    return;
+
+  if ( ws->input_repaint && WS_ANY_INP_DEV_ACTIVE(ws) )
+    (ws->input_repaint)( ws, -1, (XRectangle *)NULL );
+}
+
+static void wsb_expose_deferred(
+                                struct _Sin_input_ws *sin_ws,
+                                caddr_t handle,
+                                Window window,
+                                XEvent *event
+                                )
+{
+  wsb_repair( (Ws *)handle );
+}
+
+static void wsb_expose(
+                       Display *display,
+                       Window window,
+                       caddr_t client_data,
+                       XEvent *event
+                       )
+{
+  Ws *ws = (Ws *)client_data;
+
+  /* Wait for the last rectangle of the exposure. */
+  if ( event->xexpose.count > 0 )
+    return;
+
+  /* The rendering context belongs to the application thread. */
+  if ( phg_wsx_input_thread_self() ) {
+    (void)phg_wsx_input_defer( wsb_expose_deferred, ws->in_ws.sin_handle,
+                               client_data, window, event );
+    return;
+  }
+
+  wsb_repair( ws );
+}
+
+static void wsb_select_expose(
+                              Ws *ws
+                              )
+{
+  XWindowAttributes wattr;
+
+  (void)phg_sin_evt_register( PHG_EVT_TABLE, ws->display, ws->drawable_id,
+                              Expose, (caddr_t)ws, wsb_expose );
+
+  /* Keep events the owner of the window selected. */
+  (void)XGetWindowAttributes( ws->display, ws->drawable_id, &wattr );
+  XSelectInput( ws->display, ws->drawable_id,
+                wattr.your_event_mask | ExposureMask );
+}
+
 Ws* phg_wsb_open_ws(
                     Phg_args_open_ws *args,
                     Phg_ret *ret
@@ -505,17 +570,28 @@ Ws* phg_wsb_open_ws(
     lun = args->conn_info.lun;
     /* set scale factor for hardcopy */
     ws->hcsf = (Pfloat)args->hcsf;
+    ws->hcopy_samples = args->hcopy_samples;
     /* store the output lun */
     ws->lun = lun;
-    ws->display = phg_wsx_open_gl_display(NULL, &ret->err);
-    if (ws->display == NULL) {
-      ERR_BUF(ws->erh, ret->err);
-      printf("Open GL display failed\n");
-      goto abort;
+    if (phg_wsx_use_headless()) {
+      /* own offscreen context, no X server required */
+      if (!phg_wsx_setup_tool_headless(ws, args)) {
+        ERR_BUF(ws->erh, ERR900);
+        printf("Open headless context failed\n");
+        goto abort;
+      }
     }
-    if (!phg_wsx_setup_tool_nodisp(ws, NULL, args)) {
-      ERR_BUF(ws->erh, ret->err);
-      goto abort;
+    else {
+      ws->display = phg_wsx_open_gl_display(NULL, &ret->err);
+      if (ws->display == NULL) {
+        ERR_BUF(ws->erh, ret->err);
+        printf("Open GL display failed\n");
+        goto abort;
+      }
+      if (!phg_wsx_setup_tool_nodisp(ws, NULL, args)) {
+        ERR_BUF(ws->erh, ret->err);
+        goto abort;
+      }
     }
   }
   else if (args->conn_type == PHG_ARGS_CONN_OPEN) {
@@ -581,6 +657,7 @@ Ws* phg_wsb_open_ws(
       XDestroyWindow(ws->display, ws->drawable_id);
       goto abort;
     }
+    wsb_select_expose(ws);
   }
   if (args->conn_type == PHG_ARGS_CONN_HCOPY) {
     ws->ws_rect.x = args->x;
@@ -660,8 +737,11 @@ void wsb_destroy_ws(
 {
   if ( ws ) {
     if ( ws->display ) {
-      if ( ws->drawable_id )
+      if ( ws->drawable_id ) {
+        phg_sin_evt_unregister( PHG_EVT_TABLE, ws->display, ws->drawable_id,
+                                Expose, (caddr_t)ws );
         phg_wsx_release_window( ws );
+      }
 
       destroy_resources(ws);
 
@@ -672,6 +752,12 @@ void wsb_destroy_ws(
 
       XFlush( ws->display );
     }
+    else if ( ws->egl_context ) {
+      phg_wsx_make_current_headless( ws );
+      phg_wsx_release_window( ws );
+      destroy_resources(ws);
+      phg_wsx_release_headless( ws );
+    }
     phg_wsx_destroy( ws );
   }
 }
@@ -698,6 +784,8 @@ void phg_wsb_redraw_all(
   (*ws->make_requested_current)( ws );
   (*ws->repaint_all)( ws, clear_control );
   ws->out_ws.model.b.vis_rep = PVISUAL_ST_CORRECT;
+  if ( ws->hcopy_frames )
+    phg_hcopy_frame( ws );
 }
 
 static Ws_view_ref* phg_wsb_find_view(
@@ -838,11 +926,9 @@ void phg_wsb_repaint_all(
     /* now swap the buffers and update the drawable indices */
     wsgl_flush(ws);
 
-#if TODO
     /* Redraw input prompts & echos of any active input devices. */
     if ( ws->input_repaint && WS_ANY_INP_DEV_ACTIVE(ws) )
-      (ws->input_repaint)( ws, num_rects, exposure_rects );
-#endif
+      (ws->input_repaint)( ws, -1, (XRectangle *)NULL );
 }
 
 void phg_wsb_traverse_all_postings(
@@ -874,7 +960,9 @@ void phg_wsb_traverse_net(
 {
   El_handle el;
 
-  wsgl_begin_structure(ws, structp->struct_id);
+  if (wsgl_cull_struct(ws, structp))
+    return;
+  wsgl_begin_structure(ws, structp);
   el = structp->first_el;
   while ( 1 ) { /* termination test is at the bottom */
     switch ( el->eltype ) {
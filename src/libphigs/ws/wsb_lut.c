@@ -675,12 +675,16 @@ void phg_wsb_set_name_set(
 
    switch (type) {
       case PHG_ARGS_FLT_INVIS:
-         phg_nset_names_set(ows->nset.invis_incl,
-                            incl_set->num_ints,
-                            incl_set->ints);
-         phg_nset_names_set(ows->nset.invis_excl,
-                            excl_set->num_ints,
-                            excl_set->ints);
+         if (!phg_nset_names_set(ows->nset.invis_incl,
+                                 incl_set->num_ints,
+                                 incl_set->ints)) {
+            ERR_BUF(ws->erh, ERR900);
+         }
+         if (!phg_nset_names_set(ows->nset.invis_excl,
+                                 excl_set->num_ints,
+                                 excl_set->ints)) {
+            ERR_BUF(ws->erh, ERR900);
+         }
          wsgl_set_filter(ws,
                          PHG_ARGS_FLT_INVIS,
                          ows->nset.invis_incl,
@@ -689,21 +693,29 @@ void phg_wsb_set_name_set(
 
       case PHG_ARGS_FLT_PICK:
          pick = &ws->in_ws.devs.pick[dev_id - 1];
-         phg_nset_names_set(pick->filter.incl,
-                            incl_set->num_ints,
-                            incl_set->ints);
-         phg_nset_names_set(pick->filter.excl,
-                            excl_set->num_ints,
-                            excl_set->ints);
+         if (!phg_nset_names_set(pick->filter.incl,
+                                 incl_set->num_ints,
+                                 incl_set->ints)) {
+            ERR_BUF(ws->erh, ERR900);
+         }
+         if (!phg_nset_names_set(pick->filter.excl,
+                                 excl_set->num_ints,
+                                 excl_set->ints)) {
+            ERR_BUF(ws->erh, ERR900);
+         }
          break;
 
       case PHG_ARGS_FLT_HIGH:
-         phg_nset_names_set(ows->hnset.high_incl,
-                            incl_set->num_ints,
-                            incl_set->ints);
-         phg_nset_names_set(ows->hnset.high_excl,
-                            excl_set->num_ints,
-                            excl_set->ints);
+         if (!phg_nset_names_set(ows->hnset.high_incl,
+                                 incl_set->num_ints,
+                                 incl_set->ints)) {
+            ERR_BUF(ws->erh, ERR900);
+         }
+         if (!phg_nset_names_set(ows->hnset.high_excl,
+                                 excl_set->num_ints,
+                                 excl_set->ints)) {
+            ERR_BUF(ws->erh, ERR900);
+         }
          wsgl_set_filter(ws,
                          PHG_ARGS_FLT_HIGH,
                          ows->hnset.high_incl,
@@ -63,6 +63,8 @@ static void init_output_ws_dt(
       case PWST_HCOPY_TRUE_PDF:
       case PWST_HCOPY_TRUE_SVG:
       case PWST_HCOPY_TRUE_OBJ:
+      case PWST_HCOPY_TRUE_GLB:
+      case PWST_HCOPY_TRUE_PLY:
          wsdt->default_colour_model = PMODEL_RGB;
          wsdt->has_double_buffer    = FALSE;
          break;
@@ -443,6 +445,14 @@ Wst* phg_wstx_create(
          ws_type = PWST_HCOPY_TRUE_OBJ;
          break;
 
+      case PCAT_GLB:
+         ws_type = PWST_HCOPY_TRUE_GLB;
+         break;
+
+      case PCAT_PLY:
+         ws_type = PWST_HCOPY_TRUE_PLY;
+         break;
+
       default:
          ws_type = PWST_OUTPUT_TRUE_DB;
          break;
@@ -472,31 +482,45 @@ int phg_wstx_init(
 {
    Display *display;
    int screen_num;
+   int width, height;
    Wst_phigs_dt *dt;
 
-   display = XOpenDisplay(NULL);
-   if (display == NULL) {
+   /* no X server is contacted when headless hardcopies are forced */
+   if (wsgl_use_headless && phg_wsx_use_headless()) {
+      display = NULL;
+   }
+   else {
+      display = XOpenDisplay(NULL);
+   }
+   if (display != NULL) {
+      screen_num = DefaultScreen(display);
+      width = DisplayWidth(display, screen_num);
+      height = DisplayHeight(display, screen_num);
+      XCloseDisplay(display);
+   }
+   else if (phg_wsx_use_headless()) {
+      /* hardcopies are still possible without a display */
+      width = DISPLAY_WIDTH;
+      height = DISPLAY_HEIGHT;
+   }
+   else {
       fprintf(stderr, "Error - Unable to open display\n");
       return FALSE;
    }
 
-   screen_num = DefaultScreen(display);
-
    dt = &wst->desc_tbl.phigs_dt;
 
    dt->ws_category = category;
    dt->dev_coord_units = PDC_OTHER;
 
-   dt->dev_coords[0] = (float) DisplayWidth(display, screen_num);
-   dt->dev_coords[1] = (float) DisplayHeight(display, screen_num);
+   dt->dev_coords[0] = (float) width;
+   dt->dev_coords[1] = (float) height;
    dt->dev_coords[2] = 1.0;
 
-   dt->dev_addrs_units[0] = DisplayWidth(display, screen_num);
-   dt->dev_addrs_units[1] = DisplayHeight(display, screen_num);
+   dt->dev_addrs_units[0] = width;
+   dt->dev_addrs_units[1] = height;
    dt->dev_addrs_units[2] = 1;
 
-   XCloseDisplay(display);
-
    dt->num_hlhsr_modes = 2;
    dt->hlhsr_modes = (Pint *) malloc(sizeof(Pint) * dt->num_hlhsr_modes);
    if (dt->hlhsr_modes == NULL) {
@@ -41,6 +41,7 @@
 #include "cp.h"
 #include "private/wsglP.h"
 #include "private/wsxP.h"
+#include "private/hcopyP.h"
 
 /*******************************************************************************
  * phg_wsx_create
@@ -188,6 +189,139 @@ int phg_wsx_setup_tool(
   return status;
 }
 
+/*******************************************************************************
+ * phg_wsx_create_fb
+ *
+ * DESCR:       Create the offscreen frame buffer of a hardcopy workstation
+ *              in the current context and make it the draw buffer. Images
+ *              larger than the maximum size get a buffer of one tile.
+ *              With multisampling the drawing goes to multisample render
+ *              buffers and the texture is only the resolve target.
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_wsx_create_fb(
+                      Ws *ws,
+                      int width,
+                      int height
+                      )
+{
+  int status = TRUE;
+  GLint samples, max_samples;
+
+  phg_hcopy_tile_setup(ws, &width, &height);
+  ws->fb_width = width;
+  ws->fb_height = height;
+  samples = ws->hcopy_samples;
+  if (samples > 1) {
+    glGetIntegerv(GL_MAX_SAMPLES, &max_samples);
+    if (samples > max_samples) {
+      samples = max_samples;
+    }
+  }
+  ws->hcopy_samples = (samples > 1) ? samples : 0;
+
+  glGenFramebuffers(1, &(ws->fbuf));
+  glBindFramebuffer(GL_FRAMEBUFFER, ws->fbuf);
+
+  glGenTextures(1, &(ws->colorbuf));
+  glBindTexture(GL_TEXTURE_2D, ws->colorbuf);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8,
+               width,
+               height,
+               0, GL_RGBA, GL_UNSIGNED_BYTE,
+               NULL);
+
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, ws->colorbuf, 0);
+
+  if (ws->hcopy_samples > 0) {
+    glGenFramebuffers(1, &(ws->msaa_fbuf));
+    glBindFramebuffer(GL_FRAMEBUFFER, ws->msaa_fbuf);
+    glGenRenderbuffers(1, &(ws->msaa_colorbuf));
+    glBindRenderbuffer(GL_RENDERBUFFER, ws->msaa_colorbuf);
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, ws->hcopy_samples,
+                                     GL_RGBA8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                              GL_RENDERBUFFER, ws->msaa_colorbuf);
+  }
+
+  glGenRenderbuffers(1, &(ws->depthbuf));
+  glBindRenderbuffer(GL_RENDERBUFFER, ws->depthbuf);
+  if (ws->hcopy_samples > 0) {
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, ws->hcopy_samples,
+                                     GL_DEPTH_COMPONENT24, width, height);
+  }
+  else {
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+  }
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, ws->depthbuf);
+  //    glViewport(0, 0, width, height);
+  glDrawBuffer(GL_COLOR_ATTACHMENT0);
+
+  /* check the status */
+  GLenum fbstatus = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+  switch (fbstatus) {
+  case GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT:
+    printf("Incomplete attachment\n");
+    status = FALSE;
+    break;
+  case GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT:
+    printf("Missing attachment\n");
+    status = FALSE;
+    break;
+  case GL_FRAMEBUFFER_UNSUPPORTED:
+    printf("Unsupported framebuffer config\n");
+    status = FALSE;
+    break;
+  case GL_FRAMEBUFFER_INCOMPLETE_MULTISAMPLE:
+    printf("Incomplete multisample config\n");
+    status = FALSE;
+    break;
+#ifdef DEBUG
+  default:
+    printf("FBO status: 0x%X\n", status);
+#endif
+  }
+  if (ws->hcopy_samples > 0) {
+    /* pixels are read from the resolved texture */
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, ws->fbuf);
+  }
+
+  return status;
+}
+
+/*******************************************************************************
+ * phg_wsx_resolve_fb
+ *
+ * DESCR:       Resolve multisampled frame buffer into the one read back
+ * RETURNS:     N/A
+ */
+
+void phg_wsx_resolve_fb(
+                        Ws *ws
+                        )
+{
+  GLboolean scissor;
+
+  if (ws->msaa_fbuf == 0) {
+    return;
+  }
+  scissor = glIsEnabled(GL_SCISSOR_TEST);
+  glDisable(GL_SCISSOR_TEST);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, ws->msaa_fbuf);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, ws->fbuf);
+  glBlitFramebuffer(0, 0, ws->fb_width, ws->fb_height,
+                    0, 0, ws->fb_width, ws->fb_height,
+                    GL_COLOR_BUFFER_BIT, GL_NEAREST);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, ws->msaa_fbuf);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, ws->fbuf);
+  if (scissor) {
+    glEnable(GL_SCISSOR_TEST);
+  }
+}
+
 /*******************************************************************************
  * phg_wsx_setup_tool_nodisp
  *
@@ -240,47 +374,8 @@ int phg_wsx_setup_tool_nodisp(
     attrs.background_pixel = BlackPixel(display, screen);
     ws->glx_context = 0;
     drawable_id = 0;
-    glGenFramebuffers(1, &(ws->fbuf));
-    glBindFramebuffer(GL_FRAMEBUFFER, ws->fbuf);
-
-    glGenTextures(1, &(ws->colorbuf));
-    glBindTexture(GL_TEXTURE_2D, ws->colorbuf);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8,
-                 args->width,
-                 args->height,
-                 0, GL_RGBA, GL_UNSIGNED_BYTE,
-                 NULL);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, ws->colorbuf, 0);
-
-    glGenRenderbuffers(1, &(ws->depthbuf));
-    glBindRenderbuffer(GL_RENDERBUFFER, ws->depthbuf);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, args->width, args->height);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, ws->depthbuf);
-    //    glViewport(0, 0, args->width, args->height);
-    glDrawBuffer(GL_COLOR_ATTACHMENT0);
-
-    /* check the status */
-    GLenum fbstatus = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-    switch (fbstatus) {
-    case GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT:
-      printf("Incomplete attachment\n");
-      status = FALSE;
-      break;
-    case GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT:
-      printf("Missing attachment\n");
-      status = FALSE;
-      break;
-    case GL_FRAMEBUFFER_UNSUPPORTED:
-      printf("Unsupported framebuffer config\n");
+    if (!phg_wsx_create_fb(ws, args->width, args->height)) {
       status = FALSE;
-      break;
-#ifdef DEBUG
-    default:
-      printf("FBO status: 0x%X\n", status);
-#endif
     }
     /* clear the new buffers */
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -329,6 +424,12 @@ void phg_wsx_cleanup_fb(
   glDeleteFramebuffers(1, &(ws->fbuf));
   glDeleteTextures(1, &(ws->colorbuf));
   glDeleteRenderbuffers(1, &(ws->depthbuf));
+  if (ws->msaa_fbuf != 0) {
+    glDeleteFramebuffers(1, &(ws->msaa_fbuf));
+    glDeleteRenderbuffers(1, &(ws->msaa_colorbuf));
+    ws->msaa_fbuf = 0;
+    ws->msaa_colorbuf = 0;
+  }
 }
 
 /*******************************************************************************
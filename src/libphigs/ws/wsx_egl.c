@@ -0,0 +1,330 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************
+* Changes:   Copyright (C) 2022-2023 CERN
+******************************************************************************/
+
+/*
+ * Headless hardcopy workstations.
+ *
+ * The hardcopy workstation types render into a frame buffer object. Without
+ * an X server they get their own EGL context instead of borrowing the
+ * current GLX one: a surfaceless context when the driver supports it,
+ * otherwise a context with a minimal pbuffer. No X11 request is made.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <X11/Xlib.h>
+
+#ifdef GLEW
+#include <GL/glew.h>
+#include <GL/gl.h>
+#else
+#include <epoxy/gl.h>
+#endif
+#ifdef EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+#include "phg.h"
+#include "ws.h"
+#include "private/wsglP.h"
+#include "private/wsxP.h"
+
+short int wsgl_use_headless = 0;
+
+#ifdef EGL
+static EGLDisplay egl_display = EGL_NO_DISPLAY;
+static int egl_num_contexts = 0;
+
+/*******************************************************************************
+ * phg_wsx_egl_display
+ *
+ * DESCR:       Get the EGL display, preferring the surfaceless platform
+ * RETURNS:     EGL display or EGL_NO_DISPLAY
+ */
+
+static EGLDisplay phg_wsx_egl_display(
+   void
+   )
+{
+   EGLint major, minor;
+   const char *ext;
+
+   if (egl_display != EGL_NO_DISPLAY) {
+      return egl_display;
+   }
+
+#ifdef EGL_PLATFORM_SURFACELESS_MESA
+   ext = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+   if (ext != NULL && strstr(ext, "EGL_MESA_platform_surfaceless") != NULL) {
+      PFNEGLGETPLATFORMDISPLAYEXTPROC get_platform_display;
+
+      get_platform_display = (PFNEGLGETPLATFORMDISPLAYEXTPROC)
+         eglGetProcAddress("eglGetPlatformDisplayEXT");
+      if (get_platform_display != NULL) {
+         egl_display = (*get_platform_display)(EGL_PLATFORM_SURFACELESS_MESA,
+                                               EGL_DEFAULT_DISPLAY,
+                                               NULL);
+      }
+   }
+#endif
+   if (egl_display == EGL_NO_DISPLAY) {
+      egl_display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+   }
+   if (egl_display == EGL_NO_DISPLAY) {
+      fprintf(stderr, "Error - Unable to get EGL display\n");
+      return EGL_NO_DISPLAY;
+   }
+
+   if (!eglInitialize(egl_display, &major, &minor)) {
+      fprintf(stderr, "Error - Unable to initialize EGL\n");
+      egl_display = EGL_NO_DISPLAY;
+      return EGL_NO_DISPLAY;
+   }
+#ifdef DEBUG
+   printf("Headless hardcopy: EGL %d.%d, %s\n",
+          major, minor, eglQueryString(egl_display, EGL_VENDOR));
+#endif
+
+   return egl_display;
+}
+#endif
+
+/*******************************************************************************
+ * phg_wsx_use_headless
+ *
+ * DESCR:       Check if hardcopies are rendered without an X server
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_wsx_use_headless(
+   void
+   )
+{
+#ifdef EGL
+   char *name;
+
+   if (wsgl_use_headless) {
+      return TRUE;
+   }
+   name = getenv("DISPLAY");
+
+   return (name == NULL || name[0] == '\0');
+#else
+   return FALSE;
+#endif
+}
+
+/*******************************************************************************
+ * phg_wsx_setup_tool_headless
+ *
+ * DESCR:       Create own offscreen context and frame buffer for hardcopy
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_wsx_setup_tool_headless(
+   Ws *ws,
+   Phg_args_open_ws *args
+   )
+{
+#ifdef EGL
+   static const EGLint pbuffer_attrs[] = {
+      EGL_WIDTH, 1,
+      EGL_HEIGHT, 1,
+      EGL_NONE
+   };
+   EGLint config_attrs[] = {
+      EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+      EGL_RED_SIZE, 8,
+      EGL_GREEN_SIZE, 8,
+      EGL_BLUE_SIZE, 8,
+      EGL_ALPHA_SIZE, 8,
+      EGL_DEPTH_SIZE, 24,
+      EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+      EGL_NONE
+   };
+   EGLDisplay display;
+   EGLConfig config;
+   EGLContext context;
+   EGLSurface surface = EGL_NO_SURFACE;
+   EGLint num_configs;
+   const char *ext;
+   int surfaceless;
+   Pgcolr background;
+#ifdef GLEW
+   GLenum err;
+#endif
+
+   display = phg_wsx_egl_display();
+   if (display == EGL_NO_DISPLAY) {
+      return FALSE;
+   }
+
+   ext = eglQueryString(display, EGL_EXTENSIONS);
+   surfaceless = (ext != NULL &&
+                  strstr(ext, "EGL_KHR_surfaceless_context") != NULL);
+   if (surfaceless) {
+      /* rendering goes to the frame buffer object only */
+      config_attrs[1] = 0;
+   }
+
+   if (!eglBindAPI(EGL_OPENGL_API) ||
+       !eglChooseConfig(display, config_attrs, &config, 1, &num_configs) ||
+       num_configs < 1) {
+      fprintf(stderr, "Error - No suitable EGL configuration\n");
+      return FALSE;
+   }
+
+   context = eglCreateContext(display, config, EGL_NO_CONTEXT, NULL);
+   if (context == EGL_NO_CONTEXT) {
+      fprintf(stderr, "Error - Unable to create EGL context\n");
+      return FALSE;
+   }
+   if (!surfaceless) {
+      surface = eglCreatePbufferSurface(display, config, pbuffer_attrs);
+      if (surface == EGL_NO_SURFACE) {
+         fprintf(stderr, "Error - Unable to create EGL pbuffer\n");
+         eglDestroyContext(display, context);
+         return FALSE;
+      }
+   }
+   if (!eglMakeCurrent(display, surface, surface, context)) {
+      fprintf(stderr, "Error - Unable to make EGL context current\n");
+      if (surface != EGL_NO_SURFACE) {
+         eglDestroySurface(display, surface);
+      }
+      eglDestroyContext(display, context);
+      return FALSE;
+   }
+   egl_num_contexts++;
+
+   ws->egl_display = display;
+   ws->egl_context = context;
+   ws->egl_surface = surface;
+   ws->glx_context = 0;
+   ws->drawable_id = 0;
+
+#ifdef GLEW
+   /* the frame buffer is created before the renderer initialises GLEW.
+      A GLX flavoured GLEW loads the GL entry points and then fails to
+      find a GLX display, which is expected in an EGL context. */
+   err = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+   if (err == GLEW_ERROR_NO_GLX_DISPLAY) {
+      err = GLEW_OK;
+   }
+#endif
+   if (err != GLEW_OK) {
+      fprintf(stderr, "Error - Unable to initialize GLEW: %s\n",
+              glewGetErrorString(err));
+      phg_wsx_release_headless(ws);
+      return FALSE;
+   }
+#endif
+
+   /* nothing to restore on close */
+   ws->old_viewport[0] = 0;
+   ws->old_viewport[1] = 0;
+   ws->old_viewport[2] = args->width;
+   ws->old_viewport[3] = args->height;
+
+   if (!phg_wsx_create_fb(ws, args->width, args->height)) {
+      phg_wsx_release_headless(ws);
+      return FALSE;
+   }
+   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+   background.type = PMODEL_RGB;
+   background.val.general.x = 0.0;
+   background.val.general.y = 0.0;
+   background.val.general.z = 0.0;
+   if (!wsgl_init(ws, &background, NUM_SELECTABLE_STRUCTS)) {
+      ERR_BUF(ws->erh, ERR900);
+      phg_wsx_cleanup_fb(ws);
+      phg_wsx_release_headless(ws);
+      return FALSE;
+   }
+
+   return TRUE;
+#else
+   return FALSE;
+#endif
+}
+
+/*******************************************************************************
+ * phg_wsx_make_current_headless
+ *
+ * DESCR:       Make offscreen context current
+ * RETURNS:     N/A
+ */
+
+void phg_wsx_make_current_headless(
+   Ws *ws
+   )
+{
+#ifdef EGL
+   if (ws->egl_context != NULL &&
+       eglGetCurrentContext() != (EGLContext) ws->egl_context) {
+      eglMakeCurrent((EGLDisplay) ws->egl_display,
+                     (EGLSurface) ws->egl_surface,
+                     (EGLSurface) ws->egl_surface,
+                     (EGLContext) ws->egl_context);
+   }
+#endif
+}
+
+/*******************************************************************************
+ * phg_wsx_release_headless
+ *
+ * DESCR:       Release offscreen context
+ * RETURNS:     N/A
+ */
+
+void phg_wsx_release_headless(
+   Ws *ws
+   )
+{
+#ifdef EGL
+   EGLDisplay display = (EGLDisplay) ws->egl_display;
+
+   if (ws->egl_context == NULL) {
+      return;
+   }
+
+   if (eglGetCurrentContext() == (EGLContext) ws->egl_context) {
+      eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+   }
+   if (ws->egl_surface != NULL) {
+      eglDestroySurface(display, (EGLSurface) ws->egl_surface);
+   }
+   eglDestroyContext(display, (EGLContext) ws->egl_context);
+   ws->egl_context = NULL;
+   ws->egl_surface = NULL;
+   ws->egl_display = NULL;
+
+   if (--egl_num_contexts == 0) {
+      eglTerminate(egl_display);
+      egl_display = EGL_NO_DISPLAY;
+   }
+#endif
+}
@@ -22,12 +22,382 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
 #include <X11/Xlib.h>
 
 #include "phg.h"
 #include "private/evtP.h"
 #include "private/wsxP.h"
 
+/* X connections of all input workstations and the control descriptor */
+#define INPUT_MAX_FDS (2 * MAX_NO_OPEN_WS + 1)
+
+/* Longest sleep of the input thread, events read from the connection by
+ * another thread do not make the descriptor readable
+ */
+#define INPUT_POLL_TIMEOUT 50
+
+typedef struct {
+   Node                 node;
+   Wsx_input_defer_func func;
+   struct _Sin_input_ws *sin_ws;
+   caddr_t              handle;
+   Window               window;
+   XEvent               event;
+} Input_deferred;
+
+int phg_wsx_input_threaded = FALSE;
+
+static pthread_once_t input_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t input_lock;
+static pthread_t input_thread;
+static int input_running = FALSE;
+static volatile int input_stop = FALSE;
+static int input_control_fd = -1;
+static List input_deferred;
+static int input_num_deferred = 0;
+
+/*******************************************************************************
+ * input_lock_init
+ *
+ * DESCR:       Create the recursive input lock, once
+ * RETURNS:     N/A
+ */
+
+static void input_lock_init(
+   void
+   )
+{
+   pthread_mutexattr_t attr;
+
+   pthread_mutexattr_init(&attr);
+   pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+   pthread_mutex_init(&input_lock, &attr);
+   pthread_mutexattr_destroy(&attr);
+   list_init(&input_deferred);
+}
+
+/*******************************************************************************
+ * phg_wsx_input_lock
+ *
+ * DESCR:       Lock input device state against the input thread
+ * RETURNS:     N/A
+ */
+
+void phg_wsx_input_lock(
+   void
+   )
+{
+   pthread_once(&input_once, input_lock_init);
+   pthread_mutex_lock(&input_lock);
+}
+
+/*******************************************************************************
+ * phg_wsx_input_unlock
+ *
+ * DESCR:       Unlock input device state
+ * RETURNS:     N/A
+ */
+
+void phg_wsx_input_unlock(
+   void
+   )
+{
+   pthread_mutex_unlock(&input_lock);
+}
+
+/*******************************************************************************
+ * phg_wsx_input_thread_self
+ *
+ * DESCR:       Check if called by the input thread
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_wsx_input_thread_self(
+   void
+   )
+{
+   return (input_running && pthread_equal(pthread_self(), input_thread));
+}
+
+/*******************************************************************************
+ * phg_wsx_input_has_deferred
+ *
+ * DESCR:       Check if the input thread handed over events to process
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_wsx_input_has_deferred(
+   void
+   )
+{
+   return (__atomic_load_n(&input_num_deferred, __ATOMIC_SEQ_CST) > 0);
+}
+
+/*******************************************************************************
+ * phg_wsx_input_defer
+ *
+ * DESCR:       Hand an event over from the input thread to the application
+ *              thread, for processing that needs the rendering context.
+ *              Called with the input lock held.
+ * RETURNS:     TRUE or FALSE
+ */
+
+int phg_wsx_input_defer(
+   Wsx_input_defer_func func,
+   struct _Sin_input_ws *sin_ws,
+   caddr_t handle,
+   Window window,
+   XEvent *event
+   )
+{
+   Input_deferred *entry;
+   Sin_event_queue *queue = PHG_INPUT_Q;
+
+   entry = (Input_deferred *) malloc(sizeof(Input_deferred));
+   if (entry == NULL) {
+      return FALSE;
+   }
+   entry->func = func;
+   entry->sin_ws = sin_ws;
+   entry->handle = handle;
+   entry->window = window;
+   memcpy(&entry->event, event, sizeof(XEvent));
+   list_add(&input_deferred, &entry->node);
+   __atomic_add_fetch(&input_num_deferred, 1, __ATOMIC_SEQ_CST);
+
+   if (__atomic_load_n(&queue->waiting, __ATOMIC_SEQ_CST)) {
+      phg_sin_q_wakeup(queue);
+   }
+
+   return TRUE;
+}
+
+/*******************************************************************************
+ * input_run_deferred
+ *
+ * DESCR:       Process the oldest event handed over by the input thread
+ * RETURNS:     TRUE or FALSE if there was none
+ */
+
+static int input_run_deferred(
+   void
+   )
+{
+   Input_deferred *entry;
+
+   phg_wsx_input_lock();
+   entry = (Input_deferred *) list_get(&input_deferred);
+   if (entry != NULL) {
+      __atomic_sub_fetch(&input_num_deferred, 1, __ATOMIC_SEQ_CST);
+      (*entry->func)(entry->sin_ws, entry->handle, entry->window,
+                     &entry->event);
+      free(entry);
+   }
+   phg_wsx_input_unlock();
+
+   return (entry != NULL);
+}
+
+/*******************************************************************************
+ * phg_wsx_input_drop_deferred
+ *
+ * DESCR:       Drop events handed over for a workstation about to close.
+ *              Called with the input lock held.
+ * RETURNS:     N/A
+ */
+
+void phg_wsx_input_drop_deferred(
+   Ws *ws
+   )
+{
+   Input_deferred *entry, *next;
+
+   for (entry = (Input_deferred *) LIST_HEAD(&input_deferred);
+        entry != NULL;
+        entry = next) {
+      next = (Input_deferred *) NODE_NEXT(&entry->node);
+      if (entry->sin_ws == ws->in_ws.sin_handle) {
+         list_remove(&input_deferred, &entry->node);
+         __atomic_sub_fetch(&input_num_deferred, 1, __ATOMIC_SEQ_CST);
+         free(entry);
+      }
+   }
+}
+
+/*******************************************************************************
+ * input_thread_main
+ *
+ * DESCR:       Input thread, dispatch the events of all input workstations
+ *              and sleep until one of their connections becomes readable
+ * RETURNS:     NULL
+ */
+
+static void* input_thread_main(
+   void *arg
+   )
+{
+   Pint i;
+   int j, k, num, num_fds;
+   int fds[INPUT_MAX_FDS];
+   struct pollfd pfds[INPUT_MAX_FDS];
+   uint64_t count;
+   Psl_ws_info *wsinfo;
+   Pws_cat category;
+   Ws *ws;
+
+   /* started under the lock */
+   phg_wsx_input_lock();
+   phg_wsx_input_unlock();
+
+   while (!input_stop) {
+      num_fds = 0;
+      phg_wsx_input_lock();
+      for (i = 0; i < MAX_NO_OPEN_WS; i++) {
+         wsinfo = &PHG_PSL->open_ws[i];
+         if (!wsinfo->used) {
+            continue;
+         }
+         category = wsinfo->wstype->desc_tbl.phigs_dt.ws_category;
+         if ((category != PCAT_IN) && (category != PCAT_OUTIN)) {
+            continue;
+         }
+         ws = PHG_WSID(wsinfo->wsid);
+         while (phg_wsx_input_dispatch_next(ws, PHG_EVT_TABLE));
+
+         num = phg_wsx_input_fds(ws, fds, INPUT_MAX_FDS - 1 - num_fds);
+         for (j = 0; j < num; j++) {
+            for (k = 0; k < num_fds && pfds[k].fd != fds[j]; k++);
+            if (k == num_fds) {
+               pfds[num_fds].fd = fds[j];
+               pfds[num_fds].events = POLLIN;
+               num_fds++;
+            }
+         }
+      }
+      phg_wsx_input_unlock();
+
+      pfds[num_fds].fd = input_control_fd;
+      pfds[num_fds].events = POLLIN;
+      num_fds++;
+      if (poll(pfds, num_fds, INPUT_POLL_TIMEOUT) > 0 &&
+          (pfds[num_fds - 1].revents & POLLIN)) {
+         if (read(input_control_fd, &count, sizeof(count)) != sizeof(count)) {
+            /* already consumed */
+         }
+      }
+   }
+
+   return NULL;
+}
+
+/*******************************************************************************
+ * phg_wsx_input_thread_init
+ *
+ * DESCR:       Enable the input thread, must be called before the first
+ *              display connection is opened
+ * RETURNS:     N/A
+ */
+
+void phg_wsx_input_thread_init(
+   void
+   )
+{
+   if (!phg_wsx_input_threaded) {
+      XInitThreads();
+      XtToolkitThreadInitialize();
+      phg_wsx_input_threaded = TRUE;
+   }
+}
+
+/*******************************************************************************
+ * phg_wsx_input_thread_start
+ *
+ * DESCR:       Start the input thread if enabled and not running yet
+ * RETURNS:     N/A
+ */
+
+void phg_wsx_input_thread_start(
+   void
+   )
+{
+   if (!phg_wsx_input_threaded || input_running) {
+      return;
+   }
+
+   pthread_once(&input_once, input_lock_init);
+   input_control_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+   if (input_control_fd < 0) {
+      return;
+   }
+   input_stop = FALSE;
+   input_running = TRUE;
+
+   /* the thread waits for the lock, input_thread is set by then */
+   phg_wsx_input_lock();
+   if (pthread_create(&input_thread, NULL, input_thread_main, NULL) != 0) {
+      input_running = FALSE;
+      close(input_control_fd);
+      input_control_fd = -1;
+   }
+   phg_wsx_input_unlock();
+}
+
+/*******************************************************************************
+ * phg_wsx_input_thread_notify
+ *
+ * DESCR:       Make the input thread look at the open workstations again
+ * RETURNS:     N/A
+ */
+
+void phg_wsx_input_thread_notify(
+   void
+   )
+{
+   uint64_t one = 1;
+
+   if (input_running) {
+      if (write(input_control_fd, &one, sizeof(one)) != sizeof(one)) {
+         /* counter already set */
+      }
+   }
+}
+
+/*******************************************************************************
+ * phg_wsx_input_thread_stop
+ *
+ * DESCR:       Stop the input thread and drop events not yet processed
+ * RETURNS:     N/A
+ */
+
+void phg_wsx_input_thread_stop(
+   void
+   )
+{
+   Node *node;
+
+   if (!input_running) {
+      return;
+   }
+
+   input_stop = TRUE;
+   phg_wsx_input_thread_notify();
+   pthread_join(input_thread, NULL);
+   input_running = FALSE;
+   close(input_control_fd);
+   input_control_fd = -1;
+
+   while ((node = list_get(&input_deferred)) != NULL) {
+      free(node);
+   }
+   input_num_deferred = 0;
+}
+
 #include <X11/Shell.h>
 #include <X11/StringDefs.h>
 
@@ -48,6 +418,14 @@ int phg_wsx_input_dispatch_next(
    XtInputMask m;
    XtInputMask t;
 
+   /* The input thread reads the connections, only what it handed over
+    * is left to process here
+    */
+   if (input_running && !phg_wsx_input_thread_self()) {
+      return input_run_deferred();
+   }
+
+   status = FALSE;
    m = XtIMXEvent;
    if (((t = XtAppPending(ws->app_context)) & m)) {
      /* wait for certain events, stepping through choices */
@@ -62,9 +440,45 @@ int phg_wsx_input_dispatch_next(
                          &event) == True) {
       status = TRUE;
    }
-   else {
-      status = FALSE;
-   }
 
    return status;
 }
+
+/*******************************************************************************
+ * phg_wsx_input_fds
+ *
+ * DESCR:       Get the connection file descriptors delivering input events
+ *              of the workstation, to wait on when no event is pending
+ * RETURNS:     Number of file descriptors
+ */
+
+int phg_wsx_input_fds(
+   Ws *ws,
+   int *fds,
+   int max_fds
+   )
+{
+   int num_fds = 0;
+   Display **displays;
+   Cardinal i, num_displays;
+
+   /* owned by the input thread */
+   if (input_running && !phg_wsx_input_thread_self()) {
+      return 0;
+   }
+
+   if (ws->display != NULL && num_fds < max_fds) {
+      fds[num_fds++] = ConnectionNumber(ws->display);
+   }
+   if (ws->app_context != NULL) {
+      XtGetDisplays(ws->app_context, &displays, &num_displays);
+      for (i = 0; i < num_displays && num_fds < max_fds; i++) {
+         if (displays[i] != ws->display) {
+            fds[num_fds++] = ConnectionNumber(displays[i]);
+         }
+      }
+      XtFree((char *) displays);
+   }
+
+   return num_fds;
+}
@@ -137,6 +137,8 @@ int phg_wsx_set_best_args(
       case PWST_HCOPY_TRUE_PDF:
       case PWST_HCOPY_TRUE_SVG:
       case PWST_HCOPY_TRUE_OBJ:
+      case PWST_HCOPY_TRUE_GLB:
+      case PWST_HCOPY_TRUE_PLY:
           args[argc++] = GLX_RENDER_TYPE;
           args[argc++] = GLX_RGBA_BIT;
           args[argc++] = GLX_DRAWABLE_TYPE;
@@ -44,8 +44,13 @@
 #include "private/wsglP.h"
 #include "private/wsbP.h"
 #include "private/sofas3P.h"
+#include "util/pack.h"
 
 short int wsgl_use_shaders = 1;
+short int wsgl_use_marker_sprites = 1;
+short int wsgl_use_culling = 1;
+short int wsgl_use_scene_copy = 1;
+Pcull_stats_func wsgl_cull_stats_func = NULL;
 #define LOG_INT(DATA) \
    css_print_eltype(ELMT_HEAD(DATA)->elementType); \
    printf(":\tSIZE: %d\t", ELMT_HEAD(DATA)->length); \
@@ -81,6 +86,21 @@ int wsgl_init(
     free(wsgl);
     return FALSE;
   }
+  wsgl->text_cache = phg_htab_create(WS_TEXT_CACHE_HASH_SIZE);
+  if (wsgl->text_cache == NULL) {
+    free(wsgl->struct_stack);
+    free(wsgl);
+    return FALSE;
+  }
+  wsgl->lod_cache = phg_htab_create(WS_LOD_HASH_SIZE);
+  if (wsgl->lod_cache == NULL) {
+    phg_htab_destroy(wsgl->text_cache, NULL);
+    free(wsgl->struct_stack);
+    free(wsgl);
+    return FALSE;
+  }
+  wsgl->num_cull_tested = 0;
+  wsgl->num_culled = 0;
 #ifdef DEBUG
   printf("wsgl_init: background color type %d (%f %f %f)\n",
          background->type,
@@ -95,11 +115,13 @@ int wsgl_init(
   phg_nset_init(&wsgl->cur_struct.cur_nameset,
                 WS_MAX_NAMES_IN_NAMESET / 32,
                 wsgl->cur_struct.nameset_buf);
+  wsgl->cur_struct.filter_valid = FALSE;
   phg_nset_init(&wsgl->cur_struct.lightstat,
-                1,
+                WS_MAX_SHADER_LIGHT_SRC / 32,
                 wsgl->cur_struct.lightstat_buf);
   memcpy(&wsgl->background, background, sizeof(Pgcolr));
   wsgl->render_mode = WS_RENDER_MODE_DRAW;
+  phg_mat_identity(wsgl->tile_tran);
   wsgl->select_size = select_size;
   wsgl->select_buf  = (unsigned *) &wsgl[1];
   ws->render_context = wsgl;
@@ -128,6 +150,25 @@ void wsgl_close(
 {
   Wsgl_handle wsgl = ws->render_context;
 
+  wsgl_text_cache_flush(ws);
+  if (wsgl->text_cache != NULL) {
+    phg_htab_destroy(wsgl->text_cache, NULL);
+  }
+  wsgl_lod_cache_flush(ws);
+  if (wsgl->lod_cache != NULL) {
+    phg_htab_destroy(wsgl->lod_cache, NULL);
+  }
+  phg_nset_free_sparse(&wsgl->cur_struct.cur_nameset);
+  if (wsgl->light_buffer != 0) {
+    glDeleteBuffers(1, &wsgl->light_buffer);
+  }
+  if (wsgl->scene_fbuf != 0) {
+    glDeleteFramebuffers(1, &wsgl->scene_fbuf);
+    glDeleteRenderbuffers(1, &wsgl->scene_colorbuf);
+  }
+  if (wsgl->soa_scratch.size > 0) {
+    free(wsgl->soa_scratch.buf);
+  }
   free(wsgl->struct_stack);
   free(ws->render_context);
 }
@@ -186,6 +227,77 @@ void wsgl_set_hlhsr_mode(
   wsgl->hlhsr_changed = 1;
 }
 
+/*******************************************************************************
+ * apply_viewport
+ *
+ * DESCR:	Set the viewport, or the tile of it held in the frame buffer
+ * RETURNS:	N/A
+ */
+static void apply_viewport(
+                           Ws *ws
+                           )
+{
+  Pvec3 v;
+  Pmatrix3 trans, scale;
+  GLint x0, y0, x1, y1;
+  Wsgl_handle wsgl = ws->render_context;
+  GLint *vp = wsgl->viewport;
+  GLint tile_w = ws->hcopy_tile[0];
+  GLint tile_h = ws->hcopy_tile[1];
+
+  if (tile_w == 0) {
+    glViewport(vp[0], vp[1], vp[2], vp[3]);
+    return;
+  }
+
+  /* map the whole viewport so the tile lands on the frame buffer */
+  v.delta_x = (2.0 * (float) (vp[0] - wsgl->tile_x) + (float) vp[2]) /
+    (float) tile_w - 1.0;
+  v.delta_y = (2.0 * (float) (vp[1] - wsgl->tile_y) + (float) vp[3]) /
+    (float) tile_h - 1.0;
+  v.delta_z = 0.0;
+  phg_mat_translate(trans, &v);
+
+  v.delta_x = (float) vp[2] / (float) tile_w;
+  v.delta_y = (float) vp[3] / (float) tile_h;
+  v.delta_z = 1.0;
+  phg_mat_scale(scale, &v);
+
+  phg_mat_mul(wsgl->tile_tran, trans, scale);
+  glViewport(0, 0, tile_w, tile_h);
+
+  /* the view volume now spans more than the viewport */
+  x0 = vp[0] - wsgl->tile_x;
+  y0 = vp[1] - wsgl->tile_y;
+  x1 = x0 + vp[2];
+  y1 = y0 + vp[3];
+  if (x0 < 0) x0 = 0;
+  if (y0 < 0) y0 = 0;
+  if (x1 > tile_w) x1 = tile_w;
+  if (y1 > tile_h) y1 = tile_h;
+  glScissor(x0, y0, (x1 > x0) ? x1 - x0 : 0, (y1 > y0) ? y1 - y0 : 0);
+  glEnable(GL_SCISSOR_TEST);
+}
+
+/*******************************************************************************
+ * clear_buffers
+ *
+ * DESCR:	Clear the whole frame buffer, also outside the scissor box
+ * RETURNS:	N/A
+ */
+static void clear_buffers(
+                          Ws *ws
+                          )
+{
+  if (ws->hcopy_tile[0] > 0) {
+    glDisable(GL_SCISSOR_TEST);
+  }
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  if (ws->hcopy_tile[0] > 0) {
+    glEnable(GL_SCISSOR_TEST);
+  }
+}
+
 /*******************************************************************************
  * wsgl_clear
  *
@@ -222,8 +334,15 @@ void wsgl_clear(
   if (ws->drawable_id != 0){
     glXMakeContextCurrent(ws->display, ws->drawable_id, ws->drawable_id, ws->glx_context);
   }
+  else if (ws->egl_context != NULL){
+    phg_wsx_make_current_headless(ws);
+  }
   wsgl_clear_geometry();
-  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  if (record_vec) {
+    wsgl_vec_clear(ws);
+  }
+  clear_buffers(ws);
+  wsgl->scene_valid = 0;
   if (ws->has_double_buffer) {
 #ifdef DEBUG
     printf("Swapping buffers in clear\n");
@@ -257,6 +376,9 @@ void wsgl_flush(
   if (ws->drawable_id != 0){
     glXMakeContextCurrent(ws->display, ws->drawable_id, ws->drawable_id, ws->glx_context);
   }
+  else if (ws->egl_context != NULL){
+    phg_wsx_make_current_headless(ws);
+  }
   if (wsgl->vp_changed || wsgl->win_changed) {
     phg_wsx_compute_ws_transform(&wsgl->cur_win, &wsgl->cur_vp, &ws_xform);
     x = (GLint)   (ws_xform.offset.x - ws_xform.scale.x);
@@ -276,7 +398,11 @@ void wsgl_flush(
     printf("%d %d %d %d\n", x, y, w, h);
 #endif
 
-    glViewport(x, y, w, h);
+    wsgl->viewport[0] = x;
+    wsgl->viewport[1] = y;
+    wsgl->viewport[2] = w;
+    wsgl->viewport[3] = h;
+    apply_viewport(ws);
     glDepthRange(ws_xform.scale.z, ws_xform.offset.z);
 
     if (wsgl->vp_changed) {
@@ -344,6 +470,25 @@ void wsgl_flush(
   }
 }
 
+/*******************************************************************************
+ * wsgl_set_tile
+ *
+ * DESCR:	Select the part of a tiled hardcopy rendered next
+ * RETURNS:	N/A
+ */
+void wsgl_set_tile(
+                   Ws *ws,
+                   Pint x,
+                   Pint y
+                   )
+{
+  Wsgl_handle wsgl = ws->render_context;
+
+  wsgl->tile_x = x;
+  wsgl->tile_y = y;
+  apply_viewport(ws);
+}
+
 /*******************************************************************************
  * init_rendering_state
  *
@@ -389,8 +534,10 @@ static void init_rendering_state(
   wsgl_set_view_ind(ws, 0);
   wsgl_set_clip_ind(ws, 0);
   phg_nset_names_clear_all(&wsgl->cur_struct.cur_nameset);
+  wsgl->cur_struct.filter_valid = FALSE;
   phg_nset_names_clear_all(&wsgl->cur_struct.lightstat);
   wsgl->cur_struct.pick_id = 0;
+  wsgl->cur_struct.structp = NULL;
 }
 
 /*******************************************************************************
@@ -419,8 +566,127 @@ void wsgl_begin_rendering(
   if (ws->drawable_id != 0){
     glXMakeContextCurrent(ws->display, ws->drawable_id, ws->drawable_id, ws->glx_context);
   }
-  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  else if (ws->egl_context != NULL){
+    phg_wsx_make_current_headless(ws);
+  }
+  clear_buffers(ws);
   init_rendering_state(ws);
+  ((Wsgl_handle) ws->render_context)->num_cull_tested = 0;
+  ((Wsgl_handle) ws->render_context)->num_culled = 0;
+}
+
+/*******************************************************************************
+ * blit_scene
+ *
+ * DESCR:	Copy the frame between the window and the scene copy
+ *		helper function
+ * RETURNS:	N/A
+ */
+static void blit_scene(
+                       Ws *ws,
+                       GLuint read_fbuf,
+                       GLuint draw_fbuf
+                       )
+{
+  Wsgl_handle wsgl = ws->render_context;
+  GLboolean scissor = glIsEnabled(GL_SCISSOR_TEST);
+
+  if (scissor) {
+    glDisable(GL_SCISSOR_TEST);
+  }
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, read_fbuf);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, draw_fbuf);
+  glBlitFramebuffer(0, 0, wsgl->scene_width, wsgl->scene_height,
+                    0, 0, wsgl->scene_width, wsgl->scene_height,
+                    GL_COLOR_BUFFER_BIT, GL_NEAREST);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  if (scissor) {
+    glEnable(GL_SCISSOR_TEST);
+  }
+}
+
+/*******************************************************************************
+ * save_scene
+ *
+ * DESCR:	Keep a copy of the frame just rendered, before it is swapped
+ *		to the front, for repairing the window without a traversal
+ * RETURNS:	N/A
+ */
+static void save_scene(
+                       Ws *ws
+                       )
+{
+  Wsgl_handle wsgl = ws->render_context;
+  GLsizei width = (GLsizei) ws->ws_rect.width;
+  GLsizei height = (GLsizei) ws->ws_rect.height;
+
+  wsgl->scene_valid = 0;
+  if (width <= 0 || height <= 0) {
+    return;
+  }
+
+  if (wsgl->scene_fbuf == 0) {
+    glGenFramebuffers(1, &wsgl->scene_fbuf);
+    glGenRenderbuffers(1, &wsgl->scene_colorbuf);
+  }
+  if (width != wsgl->scene_width || height != wsgl->scene_height) {
+    glBindRenderbuffer(GL_RENDERBUFFER, wsgl->scene_colorbuf);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, wsgl->scene_fbuf);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                              GL_RENDERBUFFER, wsgl->scene_colorbuf);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+#ifdef DEBUG
+      printf("wsgl: scene copy frame buffer incomplete\n");
+#endif
+      glBindFramebuffer(GL_FRAMEBUFFER, 0);
+      wsgl->scene_width = 0;
+      wsgl->scene_height = 0;
+      return;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    wsgl->scene_width = width;
+    wsgl->scene_height = height;
+  }
+
+  blit_scene(ws, 0, wsgl->scene_fbuf);
+  wsgl->scene_valid = 1;
+}
+
+/*******************************************************************************
+ * wsgl_restore_scene
+ *
+ * DESCR:	Copy the last rendered frame back to the render window
+ * RETURNS:	TRUE or FALSE if the frame must be rendered again
+ */
+int wsgl_restore_scene(
+                       Ws *ws
+                       )
+{
+  Wsgl_handle wsgl = ws->render_context;
+
+  if (!wsgl->scene_valid ||
+      ws->drawable_id == 0 ||
+      wsgl->scene_width != (GLsizei) ws->ws_rect.width ||
+      wsgl->scene_height != (GLsizei) ws->ws_rect.height) {
+    return FALSE;
+  }
+
+#ifdef DEBUG
+  printf("wsgl: restore scene %d x %d\n", wsgl->scene_width, wsgl->scene_height);
+#endif
+  glXMakeContextCurrent(ws->display, ws->drawable_id, ws->drawable_id, ws->glx_context);
+  clear_buffers(ws);
+  blit_scene(ws, wsgl->scene_fbuf, 0);
+  if (ws->has_double_buffer) {
+    glXSwapBuffers(ws->display, ws->drawable_id);
+  }
+  else {
+    glFlush();
+  }
+
+  return TRUE;
 }
 
 /*******************************************************************************
@@ -433,9 +699,19 @@ void wsgl_end_rendering(
                         Ws *ws
                         )
 {
+  Wsgl_handle wsgl = ws->render_context;
+
 #ifdef DEBUG
   printf("End rendering\n");
+  printf("Culled %d of %d structures\n", wsgl->num_culled, wsgl->num_cull_tested);
 #endif
+  if (wsgl_cull_stats_func != NULL) {
+    (*wsgl_cull_stats_func)(ws->id, wsgl->num_cull_tested, wsgl->num_culled);
+  }
+
+  if (wsgl_use_scene_copy && ws->drawable_id != 0 && ws->fbuf == 0) {
+    save_scene(ws);
+  }
 
   if (ws->has_double_buffer) {
 #ifdef DEBUG
@@ -492,84 +768,109 @@ static void update_cur_struct(
   wsgl->cur_struct.offset++;
 }
 
-static int check_draw_primitive(
-                                Ws *ws
-                                )
+/*******************************************************************************
+ * update_filter_verdicts
+ *
+ * DESCR:	Evaluate filters against the current nameset helper function.
+ *		The verdicts are kept in the structure state until the nameset,
+ *		the filters or the render mode changes.
+ * RETURNS:	N/A
+ */
+static void update_filter_verdicts(
+                                   Ws *ws
+                                   )
 {
-  int status;
   Wsgl_handle wsgl = ws->render_context;
+  Nameset nset = &wsgl->cur_struct.cur_nameset;
 
   switch (wsgl->render_mode) {
   case WS_RENDER_MODE_DRAW:
     if (wsgl->invis_filter.used) {
-      if (!phg_nset_names_intersect(&wsgl->cur_struct.cur_nameset,
-                                    wsgl->invis_filter.incl) ||
-          phg_nset_names_intersect(&wsgl->cur_struct.cur_nameset,
-                                   wsgl->invis_filter.excl)) {
-        status = TRUE;
+      if (!phg_nset_names_intersect(nset, wsgl->invis_filter.incl) ||
+          phg_nset_names_intersect(nset, wsgl->invis_filter.excl)) {
+        wsgl->cur_struct.filter_draw = TRUE;
       }
       else {
-        status = FALSE;
+        wsgl->cur_struct.filter_draw = FALSE;
       }
     }
     else {
-      status = TRUE;
+      wsgl->cur_struct.filter_draw = TRUE;
     }
     break;
 
   case WS_RENDER_MODE_SELECT:
     if (wsgl->pick_filter.used) {
-      if (phg_nset_names_intersect(&wsgl->cur_struct.cur_nameset,
-                                   wsgl->pick_filter.incl) &&
-          !phg_nset_names_intersect(&wsgl->cur_struct.cur_nameset,
-                                    wsgl->pick_filter.excl)) {
-        status = TRUE;
+      if (phg_nset_names_intersect(nset, wsgl->pick_filter.incl) &&
+          !phg_nset_names_intersect(nset, wsgl->pick_filter.excl)) {
+        wsgl->cur_struct.filter_draw = TRUE;
       }
       else {
-        status = FALSE;
+        wsgl->cur_struct.filter_draw = FALSE;
       }
     }
     else {
-      status = TRUE;
+      wsgl->cur_struct.filter_draw = TRUE;
     }
     break;
 
   default:
-    status = TRUE;
+    wsgl->cur_struct.filter_draw = TRUE;
     break;
   }
 
-  return status;
+  if (wsgl->highl_filter.used) {
+    if (!phg_nset_names_intersect(nset, wsgl->highl_filter.incl) ||
+        phg_nset_names_intersect(nset, wsgl->highl_filter.excl)) {
+      wsgl->cur_struct.filter_highl = FALSE;
+    }
+    else {
+      wsgl->cur_struct.filter_highl = TRUE;
+    }
+  }
+  else {
+    wsgl->cur_struct.filter_highl = FALSE;
+  }
+
+  wsgl->cur_struct.filter_valid = TRUE;
+}
+
+/*******************************************************************************
+ * check_draw_primitive
+ *
+ * DESCR:	check if the current primitive passes the filters
+ * RETURNS:	TRUE or FALSE
+ */
+static int check_draw_primitive(
+                                Ws *ws
+                                )
+{
+  Wsgl_handle wsgl = ws->render_context;
+
+  if (!wsgl->cur_struct.filter_valid) {
+    update_filter_verdicts(ws);
+  }
+
+  return wsgl->cur_struct.filter_draw;
 }
 
 /*******************************************************************************
  * check_highlight_primitive
  *
  * DESCR:	check if the current primitive is highlighted
- * RETURNS:	N/A
+ * RETURNS:	TRUE or FALSE
  */
 static int check_highlight_primitive(
                                      Ws *ws
                                      )
 {
-  int status;
   Wsgl_handle wsgl = ws->render_context;
 
-  if (wsgl->highl_filter.used) {
-    if (!phg_nset_names_intersect(&wsgl->cur_struct.cur_nameset,
-                                  wsgl->highl_filter.incl) ||
-        phg_nset_names_intersect(&wsgl->cur_struct.cur_nameset,
-                                 wsgl->highl_filter.excl)) {
-      status = FALSE;
-    }
-    else {
-      status = TRUE;
-    }
-  }
-  else {
-    status = FALSE;
+  if (!wsgl->cur_struct.filter_valid) {
+    update_filter_verdicts(ws);
   }
-  return status;
+
+  return wsgl->cur_struct.filter_highl;
 }
 
 /*******************************************************************************
@@ -580,20 +881,29 @@ static int check_highlight_primitive(
  */
 void wsgl_begin_structure(
                           Ws *ws,
-                          Pint struct_id
+                          Struct_handle structp
                           )
 {
   Wsgl_handle wsgl = ws->render_context;
 
 #ifdef DEBUG
-  printf("Begin new structure element: %d\n", struct_id);
+  printf("Begin new structure element: %d\n", structp->struct_id);
   printf("Old was: %d\n", wsgl->cur_struct.id);
   printf("Push: offset = %d\n",
          wsgl->cur_struct.offset);
 #endif
 
-  stack_push(wsgl->struct_stack, (caddr_t) &wsgl->cur_struct);
-  wsgl->cur_struct.id      = struct_id;
+  if (record_vec) {
+    wsgl_vec_begin_structure();
+  }
+  if (stack_push(wsgl->struct_stack, (caddr_t) &wsgl->cur_struct) &&
+      !phg_nset_dup_sparse(&wsgl->cur_struct.cur_nameset)) {
+    /* the pushed parent keeps its list, the child starts without */
+    ERR_BUF(ws->erh, ERR900);
+    wsgl->cur_struct.filter_valid = FALSE;
+  }
+  wsgl->cur_struct.id      = structp->struct_id;
+  wsgl->cur_struct.structp = structp;
   wsgl->cur_struct.offset  = 0;
   phg_mat_copy(wsgl->cur_struct.global_tran, wsgl->composite_tran);
   phg_mat_identity(wsgl->cur_struct.local_tran);
@@ -603,14 +913,98 @@ void wsgl_begin_structure(
 
   if (wsgl->render_mode == WS_RENDER_MODE_SELECT) {
 #ifdef DEBUG
-    printf("\tPush name: %d\n", struct_id);
+    printf("\tPush name: %d\n", structp->struct_id);
 #endif
-    glPushName(struct_id);
+    glPushName(structp->struct_id);
     glPushName(-1);
     store_cur_struct(ws);
   }
 }
 
+/*******************************************************************************
+ * wsgl_cull_struct
+ *
+ * DESCR:	Test if a structure network is outside the view volume.
+ *		The cached bounds are taken to clip coordinates with the
+ *		current modelling, orientation and mapping matrices and
+ *		tested against the planes of the homogeneous clip cube.
+ * RETURNS:	TRUE if the structure network can be skipped
+ */
+int wsgl_cull_struct(
+                     Ws *ws,
+                     Struct_handle structp
+                     )
+{
+  Wsgl_handle wsgl = ws->render_context;
+  Css_bounds *bnd;
+  Pmatrix3 tran;
+  Pfloat pad, size, scalef;
+  Pfloat p[3], c[4];
+  unsigned int outside, code;
+  int i, j;
+
+  /* geometry export wants the whole network */
+  if (!wsgl_use_culling || record_geom) {
+    return FALSE;
+  }
+
+  wsgl->num_cull_tested++;
+  bnd = phg_css_struct_bounds(structp);
+  if (bnd->state == CSS_BOUNDS_UNBOUNDED) {
+    return FALSE;
+  }
+
+  if (bnd->state == CSS_BOUNDS_VALID) {
+    scalef = ws->hcsf;
+    if (scalef == 0.0) {
+      scalef = 1.0;
+    }
+    size = wsgl->cur_struct.ast.indiv_group.marker_bundle.size;
+    if (wsgl->cur_struct.ast.bundl_group.marker_bundle.size > size) {
+      size = wsgl->cur_struct.ast.bundl_group.marker_bundle.size;
+    }
+    pad = bnd->marker_size * scalef;
+    if (size * bnd->marker_scale > pad) {
+      pad = size * bnd->marker_scale;
+    }
+
+    phg_mat_mul(tran,
+                wsgl->cur_struct.view_rep.ori_matrix,
+                wsgl->composite_tran);
+    phg_mat_mul(tran,
+                wsgl->cur_struct.view_rep.map_matrix,
+                tran);
+
+    outside = 0x3f;
+    for (i = 0; i < 8; i++) {
+      p[0] = (i & 1) ? bnd->box.x_max + pad : bnd->box.x_min - pad;
+      p[1] = (i & 2) ? bnd->box.y_max + pad : bnd->box.y_min - pad;
+      p[2] = (i & 4) ? bnd->box.z_max + pad : bnd->box.z_min - pad;
+      for (j = 0; j < 4; j++) {
+        c[j] = tran[j][0] * p[0] + tran[j][1] * p[1] + tran[j][2] * p[2] +
+          tran[j][3];
+      }
+      code = 0;
+      if (c[0] >  c[3]) code |= 0x01;
+      if (c[0] < -c[3]) code |= 0x02;
+      if (c[1] >  c[3]) code |= 0x04;
+      if (c[1] < -c[3]) code |= 0x08;
+      if (c[2] >  c[3]) code |= 0x10;
+      if (c[2] < -c[3]) code |= 0x20;
+      outside &= code;
+      if (!outside) {
+        return FALSE;
+      }
+    }
+  }
+
+  /* leave the state a traversal of the structure would have left behind */
+  wsgl_set_clip_ind(ws, 0);
+  wsgl_set_alpha_channel(ws, 1.0);
+  wsgl->num_culled++;
+  return TRUE;
+}
+
 /*******************************************************************************
  * wsgl_end_structure
  *
@@ -622,12 +1016,19 @@ void wsgl_end_structure(
                         )
 {
   Wsgl_handle wsgl = ws->render_context;
+  Nset child_nameset;
 
 #ifdef DEBUG
   printf("End structure element: %d\n", wsgl->cur_struct.id);
 #endif
 
-   stack_pop(wsgl->struct_stack, (caddr_t) &wsgl->cur_struct);
+   if (record_vec) {
+     wsgl_vec_end_structure();
+   }
+   child_nameset = wsgl->cur_struct.cur_nameset;
+   if (stack_pop(wsgl->struct_stack, (caddr_t) &wsgl->cur_struct)) {
+     phg_nset_free_sparse(&child_nameset);
+   }
    wsgl_update_hlhsr_id(ws);
    wsgl_update_projection(ws);
    wsgl_update_modelview(ws);
@@ -651,6 +1052,47 @@ void wsgl_end_structure(
    }
 }
 
+/*******************************************************************************
+ * el_points3
+ *
+ * DESCR:	Get point list 3D data of element, elements with separate
+ *		coordinate arrays are interleaved into a renderer buffer
+ * RETURNS:	Pointer to element data or NULL
+ */
+
+static void* el_points3(
+                        Ws *ws,
+                        El_handle el
+                        )
+{
+  Wsgl_handle wsgl = ws->render_context;
+  Pint *data = (Pint *) ELMT_CONTENT(el);
+  Pint *pdata;
+  Pfloat *fdata;
+
+  if (el->eltype != PELEM_POLYLINE3_SOA &&
+      el->eltype != PELEM_POLYMARKER3_SOA &&
+      el->eltype != PELEM_FILL_AREA3_SOA) {
+    return data;
+  }
+
+  if (!PHG_SCRATCH_SPACE(&wsgl->soa_scratch,
+                         sizeof(Pint) + data[0] * sizeof(Ppoint3))) {
+    ERR_REPORT(ws->erh, ERR900);
+    return NULL;
+  }
+  pdata = (Pint *) wsgl->soa_scratch.buf;
+  pdata[0] = data[0];
+  fdata = (Pfloat *) &data[1];
+  phg_pack_points3((Ppoint3 *) &pdata[1],
+                   fdata,
+                   &fdata[data[0]],
+                   &fdata[2 * data[0]],
+                   data[0]);
+
+  return pdata;
+}
+
 /*******************************************************************************
  * wsgl_render_element
  *
@@ -666,6 +1108,7 @@ void wsgl_render_element(
   Pmatrix3 mat3;
   Plocal_tran3 tran3;
   Wsgl_handle wsgl = ws->render_context;
+  void *pdata;
   Pgse_elem gse_elem;
   Pgcolr highlight_color;
   Ws_output_ws *ows;
@@ -910,7 +1353,9 @@ void wsgl_render_element(
 
   case PELEM_POLYLINE:
     if (check_draw_primitive(ws)) {
-      wsgl_polyline(ws, ELMT_CONTENT(el), &wsgl->cur_struct.ast);
+      if (!wsgl_lod_polyline(ws, el, &wsgl->cur_struct.ast)) {
+        wsgl_polyline(ws, ELMT_CONTENT(el), &wsgl->cur_struct.ast);
+      }
     }
     break;
 
@@ -921,11 +1366,13 @@ void wsgl_render_element(
     break;
 
   case PELEM_FILL_AREA3:
-    if (check_draw_primitive(ws)) {
+  case PELEM_FILL_AREA3_SOA:
+    if (check_draw_primitive(ws) &&
+        (pdata = el_points3(ws, el)) != NULL) {
       style = wsgl_get_int_style(&wsgl->cur_struct.ast);
       if (wsgl->cur_struct.hlhsr_id == PHIGS_HLHSR_ID_ON) {
         if (style == PSTYLE_EMPTY || style == PSTYLE_HOLLOW) {
-          wsgl_clear_area3(ws, ELMT_CONTENT(el), &wsgl->cur_struct.ast);
+          wsgl_clear_area3(ws, pdata, &wsgl->cur_struct.ast);
         }
       }
       if (style != PSTYLE_EMPTY) {
@@ -933,7 +1380,7 @@ void wsgl_render_element(
           if (wsgl->cur_struct.ast.disting_mode == PDISTING_YES) {
             glEnable(GL_CULL_FACE);
             wsgl_back_area3(ws,
-                            ELMT_CONTENT(el),
+                            pdata,
                             &wsgl->cur_struct.ast);
             glDisable(GL_CULL_FACE);
           }
@@ -942,19 +1389,19 @@ void wsgl_render_element(
           if (wsgl->cur_struct.ast.disting_mode == PDISTING_YES) {
             glEnable(GL_CULL_FACE);
             wsgl_fill_area3(ws,
-                            ELMT_CONTENT(el),
+                            pdata,
                             &wsgl->cur_struct.ast);
             glDisable(GL_CULL_FACE);
           }
           else {
             wsgl_fill_area3(ws,
-                            ELMT_CONTENT(el),
+                            pdata,
                             &wsgl->cur_struct.ast);
           }
         }
       }
       if (wsgl_get_edge_flag(&wsgl->cur_struct.ast) == PEDGE_ON) {
-        wsgl_edge_area3(ws, ELMT_CONTENT(el), &wsgl->cur_struct.ast);
+        wsgl_edge_area3(ws, pdata, &wsgl->cur_struct.ast);
       }
     }
     break;
@@ -1032,6 +1479,7 @@ void wsgl_render_element(
         }
       }
       if (style != PSTYLE_EMPTY) {
+        wsgl_lod_begin(ws, el);
         if (wsgl->cur_struct.ast.cull_mode != PCULL_BACKFACE) {
           if (wsgl->cur_struct.ast.disting_mode == PDISTING_YES) {
             glEnable(GL_CULL_FACE);
@@ -1055,6 +1503,7 @@ void wsgl_render_element(
                                            &wsgl->cur_struct.ast);
           }
         }
+        wsgl_lod_end(ws);
       }
       if (wsgl_get_edge_flag(&wsgl->cur_struct.ast) == PEDGE_ON) {
         wsgl_edge_area_set3_data(ws,
@@ -1075,6 +1524,7 @@ void wsgl_render_element(
         }
       }
       if (style != PSTYLE_EMPTY) {
+        wsgl_lod_begin(ws, el);
         if (wsgl->cur_struct.ast.cull_mode != PCULL_BACKFACE) {
           if (wsgl->cur_struct.ast.disting_mode == PDISTING_YES) {
             glEnable(GL_CULL_FACE);
@@ -1098,6 +1548,7 @@ void wsgl_render_element(
                                                   &wsgl->cur_struct.ast);
           }
         }
+        wsgl_lod_end(ws);
       }
       if (wsgl_get_edge_flag(&wsgl->cur_struct.ast) == PEDGE_ON) {
         wsgl_set_of_edge_area_set3_data(ws,
@@ -1108,14 +1559,20 @@ void wsgl_render_element(
     break;
 
   case PELEM_POLYLINE3:
+  case PELEM_POLYLINE3_SOA:
     if (check_draw_primitive(ws)) {
-      wsgl_polyline3(ws, ELMT_CONTENT(el), &wsgl->cur_struct.ast);
+      if (!wsgl_lod_polyline(ws, el, &wsgl->cur_struct.ast) &&
+          (pdata = el_points3(ws, el)) != NULL) {
+        wsgl_polyline3(ws, pdata, &wsgl->cur_struct.ast);
+      }
     }
     break;
 
   case PELEM_POLYMARKER3:
-    if (check_draw_primitive(ws)) {
-      wsgl_polymarker3(ws, ELMT_CONTENT(el), &wsgl->cur_struct.ast);
+  case PELEM_POLYMARKER3_SOA:
+    if (check_draw_primitive(ws) &&
+        (pdata = el_points3(ws, el)) != NULL) {
+      wsgl_polymarker3(ws, pdata, &wsgl->cur_struct.ast);
     }
     break;
 
@@ -1275,6 +1732,7 @@ void wsgl_set_filter(
 {
   Wsgl_handle wsgl = ws->render_context;
 
+  wsgl->cur_struct.filter_valid = FALSE;
   switch (type) {
   case PHG_ARGS_FLT_INVIS:
     wsgl->invis_filter.used = TRUE;
@@ -1334,6 +1792,7 @@ void wsgl_begin_pick(
   Pmatrix3 trans, scale;
   Wsgl_handle wsgl = ws->render_context;
   wsgl->render_mode = WS_RENDER_MODE_SELECT;
+  wsgl->cur_struct.filter_valid = FALSE;
 
 #ifdef DEBUGINP
   printf("WSGL Begin pick\n");
@@ -1411,6 +1870,7 @@ void wsgl_end_pick(
   Ws_pick_elmt *data = NULL;
   GLuint zmin = UINT_MAX;
   wsgl->render_mode = WS_RENDER_MODE_DRAW;
+  wsgl->cur_struct.filter_valid = FALSE;
   glFlush();
 #ifdef DEBUGINP
   GLint viewport[4];
@@ -114,6 +114,7 @@ void wsgl_update_projection(
                             Ws *ws
                             )
 {
+  Pmatrix3 tran;
   Wsgl_handle wsgl = ws->render_context;
 
 #ifdef DEBUG
@@ -137,17 +138,29 @@ void wsgl_update_projection(
       }
   }
   else {
+    if (ws->hcopy_tile[0] > 0) {
+      /* one tile of a hardcopy larger than the frame buffer */
+      phg_mat_mul(tran,
+                  wsgl->tile_tran,
+                  wsgl->cur_struct.view_rep.map_matrix);
+    }
+    else {
+      phg_mat_copy(tran, wsgl->cur_struct.view_rep.map_matrix);
+    }
 #ifdef GLEW
     if (wsgl_use_shaders && GLEW_ARB_vertex_shader && GLEW_ARB_fragment_shader && GLEW_ARB_shader_objects)
 #else
       if (wsgl_use_shaders)
 #endif
         {
-          wsgl_set_projection_matrix(wsgl->cur_struct.view_rep.map_matrix);
+          wsgl_set_projection_matrix(tran);
         } else {
-        wsgl_set_matrix(wsgl->cur_struct.view_rep.map_matrix, FALSE);
+        wsgl_set_matrix(tran, FALSE);
       }
   }
+  if (record_vec) {
+    wsgl_vec_update(ws);
+  }
 }
 
 /*******************************************************************************
@@ -189,6 +202,9 @@ void wsgl_update_modelview(
       } else {
       wsgl_set_matrix(wsgl->model_tran, FALSE);
     }
+  if (record_vec) {
+    wsgl_vec_update(ws);
+  }
 }
 
 /*******************************************************************************
@@ -339,6 +355,9 @@ void wsgl_update_hlhsr_id(
   default:
     break;
   }
+  if (record_vec) {
+    wsgl_vec_update(ws);
+  }
 }
 
 /*******************************************************************************
@@ -395,6 +414,11 @@ void wsgl_set_colr(
                 colr->direct.rgb.green,
                 colr->direct.rgb.blue);
     }
+    if (record_geom) {
+      wsgl_set_current_colr(colr->direct.rgb.red,
+                            colr->direct.rgb.green,
+                            colr->direct.rgb.blue);
+    }
     break;
 
   default:
@@ -434,6 +458,11 @@ void wsgl_set_gcolr(
                 gcolr->val.general.y,
                 gcolr->val.general.z);
     }
+    if (record_geom) {
+      wsgl_set_current_colr(gcolr->val.general.x,
+                            gcolr->val.general.y,
+                            gcolr->val.general.z);
+    }
     break;
 
   default:
@@ -542,9 +571,15 @@ void wsgl_setup_line_attr(
   }
   if (phg_nset_name_is_set(&ast->asf_nameset, (Pint) PASPECT_LINEWIDTH)) {
     glLineWidth(ast->indiv_group.line_bundle.width);
+    if (record_geom) {
+      wsgl_set_current_width(ast->indiv_group.line_bundle.width);
+    }
   }
   else {
     glLineWidth(ast->bundl_group.line_bundle.width);
+    if (record_geom) {
+      wsgl_set_current_width(ast->bundl_group.line_bundle.width);
+    }
   }
 #ifdef GLEW
   if (wsgl_use_shaders && GLEW_ARB_vertex_shader && GLEW_ARB_fragment_shader && GLEW_ARB_shader_objects)
@@ -841,6 +876,9 @@ void wsgl_setup_edge_attr(
   }
 
   glLineWidth(wsgl_get_edge_width(ast));
+  if (record_geom) {
+    wsgl_set_current_width(wsgl_get_edge_width(ast));
+  }
 
   if (phg_nset_name_is_set(&ast->asf_nameset, (Pint) PASPECT_EDGETYPE)) {
     type = ast->indiv_group.edge_bundle.type;
@@ -1132,9 +1170,12 @@ void wsgl_add_names_set(
   num_ints = *data;
   data++;
 
-  phg_nset_names_set(&wsgl->cur_struct.cur_nameset,
-                     num_ints,
-                     data);
+  if (!phg_nset_names_set(&wsgl->cur_struct.cur_nameset,
+                          num_ints,
+                          data)) {
+    ERR_BUF(ws->erh, ERR900);
+  }
+  wsgl->cur_struct.filter_valid = FALSE;
 }
 
 /*******************************************************************************
@@ -1158,4 +1199,5 @@ void wsgl_remove_names_set(
   phg_nset_names_clear(&wsgl->cur_struct.cur_nameset,
                        num_ints,
                        data);
+  wsgl->cur_struct.filter_valid = FALSE;
 }
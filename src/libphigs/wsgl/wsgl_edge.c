@@ -40,22 +40,19 @@ void priv_edge_area(
                     )
 {
   int i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
 
   glBegin(GL_LINE_LOOP);
   for (i = 0; i < point_list->num_points; i++) {
     glVertex2f(point_list->points[i].x,
                point_list->points[i].y);
     if (record_geom){
-      vertex_indices[n_vertices] = wsgl_add_vertex(point_list->points[i].x,
-                                                   point_list->points[i].y,
-                                                   0.);
-      n_vertices ++;
+      wsgl_rec_vertex(point_list->points[i].x,
+                      point_list->points[i].y,
+                      0.);
     }
   }
   if (record_geom){
-    wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+    wsgl_rec_geometry(GEOM_LINE);
   }
   glEnd();
 }
@@ -72,8 +69,6 @@ void priv_edge_area3(
                      )
 {
   int i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
 
   glBegin(GL_LINE_LOOP);
   for (i = 0; i < point_list->num_points; i++) {
@@ -81,14 +76,13 @@ void priv_edge_area3(
                point_list->points[i].y,
                point_list->points[i].z);
     if (record_geom){
-      vertex_indices[n_vertices] = wsgl_add_vertex(point_list->points[i].x,
-                                                   point_list->points[i].y,
-                                                   point_list->points[i].z);
-      n_vertices ++;
+      wsgl_rec_vertex(point_list->points[i].x,
+                      point_list->points[i].y,
+                      point_list->points[i].z);
     }
   }
   if (record_geom){
-    wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+    wsgl_rec_geometry(GEOM_LINE);
   }
   glEnd();
 }
@@ -470,6 +470,16 @@ void wsgl_setup_int_refl_props(
      break;
    }
 
+   if (record_vec) {
+     wsgl_vec_refl_props((colr_type == PMODEL_RGB &&
+                          (refl_eqn == PREFL_AMBIENT ||
+                           refl_eqn == PREFL_AMB_DIFF ||
+                           refl_eqn == PREFL_AMB_DIFF_SPEC)),
+                         ambient,
+                         diffuse,
+                         specular);
+   }
+
 #ifdef GLEW
    if (wsgl_use_shaders && GLEW_ARB_vertex_shader && GLEW_ARB_fragment_shader && GLEW_ARB_shader_objects) {
 #else
@@ -45,8 +45,6 @@ static void priv_edges_points(
    )
 {
    Pint i;
-   int vertex_indices[MAX_VERTICES];
-   int n_vertices = 0;
 
    if (eflag == PEDGE_VISIBILITY) {
       glBegin(GL_LINES);
@@ -59,14 +57,12 @@ static void priv_edges_points(
                        points[i + 1].y,
                        points[i + 1].z);
             if (record_geom){
-              vertex_indices[n_vertices] = wsgl_add_vertex(points[i].x,
-                                                           points[i].y,
-                                                           points[i].z);
-              n_vertices ++;
-              vertex_indices[n_vertices] = wsgl_add_vertex(points[i+1].x,
-                                                           points[i+1].y,
-                                                           points[i+1].z);
-              n_vertices ++;
+              wsgl_rec_vertex(points[i].x,
+                              points[i].y,
+                              points[i].z);
+              wsgl_rec_vertex(points[i+1].x,
+                              points[i+1].y,
+                              points[i+1].z);
             }
          }
       }
@@ -79,14 +75,12 @@ static void priv_edges_points(
                        points[i + 1].y,
                        points[i + 1].z);
             if (record_geom){
-              vertex_indices[n_vertices] = wsgl_add_vertex(points[i].x,
-                                                           points[i].y,
-                                                           points[i].z);
-              n_vertices ++;
-              vertex_indices[n_vertices] = wsgl_add_vertex(points[i+1].x,
-                                                           points[i+1].y,
-                                                           points[i+1].z);
-              n_vertices ++;
+              wsgl_rec_vertex(points[i].x,
+                              points[i].y,
+                              points[i].z);
+              wsgl_rec_vertex(points[i+1].x,
+                              points[i+1].y,
+                              points[i+1].z);
             }
          }
       }
@@ -100,18 +94,16 @@ static void priv_edges_points(
                        points[0].z);
          }
          if (record_geom){
-           vertex_indices[n_vertices] =  wsgl_add_vertex(points[i].x,
-                                                         points[i].y,
-                                                         points[i].z);
-           n_vertices ++;
-           vertex_indices[n_vertices] = wsgl_add_vertex(points[0].x,
-                                                        points[0].y,
-                                                        points[0].z);
-           n_vertices ++;
+           wsgl_rec_vertex(points[i].x,
+                           points[i].y,
+                           points[i].z);
+           wsgl_rec_vertex(points[0].x,
+                           points[0].y,
+                           points[0].z);
          }
       }
       if (record_geom){
-        wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+        wsgl_rec_geometry(GEOM_SEGMENTS);
       }
       glEnd();
    }
@@ -122,14 +114,13 @@ static void priv_edges_points(
                     points[i].y,
                     points[i].z);
          if (record_geom){
-           vertex_indices[n_vertices] = wsgl_add_vertex(points[i].x,
-                                                        points[i].y,
-                                                        points[i].z);
-           n_vertices ++;
+           wsgl_rec_vertex(points[i].x,
+                           points[i].y,
+                           points[i].z);
          }
       }
       if (record_geom){
-        wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+        wsgl_rec_geometry(GEOM_LINE);
       }
       glEnd();
    }
@@ -150,8 +141,6 @@ static void priv_edges_ptcolrs(
    )
 {
    Pint i;
-   int vertex_indices[MAX_VERTICES];
-   int n_vertices = 0;
 
    if (eflag == PEDGE_VISIBILITY) {
       glBegin(GL_LINES);
@@ -164,14 +153,12 @@ static void priv_edges_ptcolrs(
                        ptcolrs[i + 1].point.y,
                        ptcolrs[i + 1].point.z);
             if (record_geom){
-              vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[i].point.x,
-                                                           ptcolrs[i].point.y,
-                                                           ptcolrs[i].point.z);
-              n_vertices ++;
-              vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[i + 1].point.x,
-                                                           ptcolrs[i + 1].point.y,
-                                                           ptcolrs[i + 1].point.z);
-              n_vertices ++;
+              wsgl_rec_vertex(ptcolrs[i].point.x,
+                              ptcolrs[i].point.y,
+                              ptcolrs[i].point.z);
+              wsgl_rec_vertex(ptcolrs[i + 1].point.x,
+                              ptcolrs[i + 1].point.y,
+                              ptcolrs[i + 1].point.z);
             }
          }
       }
@@ -184,14 +171,12 @@ static void priv_edges_ptcolrs(
                        ptcolrs[i + 1].point.y,
                        ptcolrs[i + 1].point.z);
             if (record_geom){
-              vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[i].point.x,
-                                                           ptcolrs[i].point.y,
-                                                           ptcolrs[i].point.z);
-              n_vertices ++;
-              vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[i + 1].point.x,
-                                                           ptcolrs[i + 1].point.y,
-                                                           ptcolrs[i + 1].point.z);
-              n_vertices ++;
+              wsgl_rec_vertex(ptcolrs[i].point.x,
+                              ptcolrs[i].point.y,
+                              ptcolrs[i].point.z);
+              wsgl_rec_vertex(ptcolrs[i + 1].point.x,
+                              ptcolrs[i + 1].point.y,
+                              ptcolrs[i + 1].point.z);
             }
          }
       }
@@ -204,19 +189,17 @@ static void priv_edges_ptcolrs(
                        ptcolrs[0].point.y,
                        ptcolrs[0].point.z);
             if (record_geom){
-              vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[i].point.x,
-                                                           ptcolrs[i].point.y,
-                                                           ptcolrs[i].point.z);
-              n_vertices ++;
-              vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[0].point.x,
-                                                           ptcolrs[0].point.y,
-                                                           ptcolrs[0].point.z);
-              n_vertices ++;
+              wsgl_rec_vertex(ptcolrs[i].point.x,
+                              ptcolrs[i].point.y,
+                              ptcolrs[i].point.z);
+              wsgl_rec_vertex(ptcolrs[0].point.x,
+                              ptcolrs[0].point.y,
+                              ptcolrs[0].point.z);
             }
          }
       }
       if (record_geom){
-        wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+        wsgl_rec_geometry(GEOM_SEGMENTS);
       }
       glEnd();
    }
@@ -227,14 +210,13 @@ static void priv_edges_ptcolrs(
                     ptcolrs[i].point.y,
                     ptcolrs[i].point.z);
          if (record_geom){
-           vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[i].point.x,
-                                                        ptcolrs[i].point.y,
-                                                        ptcolrs[i].point.z);
-           n_vertices ++;
+           wsgl_rec_vertex(ptcolrs[i].point.x,
+                           ptcolrs[i].point.y,
+                           ptcolrs[i].point.z);
          }
       }
       if (record_geom){
-        wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+        wsgl_rec_geometry(GEOM_LINE);
       }
       glEnd();
    }
@@ -255,8 +237,6 @@ static void priv_edges_ptnorms(
    )
 {
    Pint i;
-   int vertex_indices[MAX_VERTICES];
-   int n_vertices = 0;
 
    if (eflag == PEDGE_VISIBILITY) {
       glBegin(GL_LINES);
@@ -269,14 +249,12 @@ static void priv_edges_ptnorms(
                        ptnorms[i + 1].point.y,
                        ptnorms[i + 1].point.z);
             if (record_geom){
-              vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[i].point.x,
-                                                           ptnorms[i].point.y,
-                                                           ptnorms[i].point.z);
-              n_vertices ++;
-              vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[i+1].point.x,
-                                                           ptnorms[i+1].point.y,
-                                                           ptnorms[i+1].point.z);
-              n_vertices ++;
+              wsgl_rec_vertex(ptnorms[i].point.x,
+                              ptnorms[i].point.y,
+                              ptnorms[i].point.z);
+              wsgl_rec_vertex(ptnorms[i+1].point.x,
+                              ptnorms[i+1].point.y,
+                              ptnorms[i+1].point.z);
             }
          }
       }
@@ -289,14 +267,12 @@ static void priv_edges_ptnorms(
                        ptnorms[i + 1].point.y,
                        ptnorms[i + 1].point.z);
             if (record_geom){
-              vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[i].point.x,
-                                                           ptnorms[i].point.y,
-                                                           ptnorms[i].point.z);
-              n_vertices ++;
-              vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[i+1].point.x,
-                                                           ptnorms[i+1].point.y,
-                                                           ptnorms[i+1].point.z);
-              n_vertices ++;
+              wsgl_rec_vertex(ptnorms[i].point.x,
+                              ptnorms[i].point.y,
+                              ptnorms[i].point.z);
+              wsgl_rec_vertex(ptnorms[i+1].point.x,
+                              ptnorms[i+1].point.y,
+                              ptnorms[i+1].point.z);
             }
          }
       }
@@ -309,19 +285,17 @@ static void priv_edges_ptnorms(
                        ptnorms[0].point.y,
                        ptnorms[0].point.z);
             if (record_geom){
-              vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[i].point.x,
-                                                           ptnorms[i].point.y,
-                                                           ptnorms[i].point.z);
-              n_vertices ++;
-              vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[0].point.x,
-                                                           ptnorms[0].point.y,
-                                                           ptnorms[0].point.z);
-              n_vertices ++;
+              wsgl_rec_vertex(ptnorms[i].point.x,
+                              ptnorms[i].point.y,
+                              ptnorms[i].point.z);
+              wsgl_rec_vertex(ptnorms[0].point.x,
+                              ptnorms[0].point.y,
+                              ptnorms[0].point.z);
             }
          }
       }
       if (record_geom){
-        wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+        wsgl_rec_geometry(GEOM_SEGMENTS);
       }
       glEnd();
    }
@@ -332,14 +306,13 @@ static void priv_edges_ptnorms(
                    ptnorms[i].point.y,
                    ptnorms[i].point.z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[i].point.x,
-                                                       ptnorms[i].point.y,
-                                                       ptnorms[i].point.z);
-          n_vertices ++;
+          wsgl_rec_vertex(ptnorms[i].point.x,
+                          ptnorms[i].point.y,
+                          ptnorms[i].point.z);
         }
       }
       if (record_geom){
-        wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+        wsgl_rec_geometry(GEOM_LINE);
       }
       glEnd();
    }
@@ -360,8 +333,6 @@ static void priv_edges_ptconorms(
    )
 {
    Pint i;
-   int vertex_indices[MAX_VERTICES];
-   int n_vertices = 0;
 
    if (eflag == PEDGE_VISIBILITY) {
       glBegin(GL_LINES);
@@ -374,14 +345,12 @@ static void priv_edges_ptconorms(
                        ptconorms[i + 1].point.y,
                        ptconorms[i + 1].point.z);
             if (record_geom){
-              vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[i].point.x,
-                                                           ptconorms[i].point.y,
-                                                           ptconorms[i].point.z);
-              n_vertices ++;
-              vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[i + 1].point.x,
-                                                           ptconorms[i + 1].point.y,
-                                                           ptconorms[i + 1].point.z);
-              n_vertices ++;
+              wsgl_rec_vertex(ptconorms[i].point.x,
+                              ptconorms[i].point.y,
+                              ptconorms[i].point.z);
+              wsgl_rec_vertex(ptconorms[i + 1].point.x,
+                              ptconorms[i + 1].point.y,
+                              ptconorms[i + 1].point.z);
             }
          }
       }
@@ -394,14 +363,12 @@ static void priv_edges_ptconorms(
                        ptconorms[i + 1].point.y,
                        ptconorms[i + 1].point.z);
             if (record_geom){
-              vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[i].point.x,
-                                                           ptconorms[i].point.y,
-                                                           ptconorms[i].point.z);
-              n_vertices ++;
-              vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[i + 1].point.x,
-                                                           ptconorms[i + 1].point.y,
-                                                           ptconorms[i + 1].point.z);
-              n_vertices ++;
+              wsgl_rec_vertex(ptconorms[i].point.x,
+                              ptconorms[i].point.y,
+                              ptconorms[i].point.z);
+              wsgl_rec_vertex(ptconorms[i + 1].point.x,
+                              ptconorms[i + 1].point.y,
+                              ptconorms[i + 1].point.z);
             }
          }
       }
@@ -414,19 +381,17 @@ static void priv_edges_ptconorms(
                        ptconorms[0].point.y,
                        ptconorms[0].point.z);
             if (record_geom){
-              vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[i].point.x,
-                                                           ptconorms[i].point.y,
-                                                           ptconorms[i].point.z);
-              n_vertices ++;
-              vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[0].point.x,
-                                                           ptconorms[0].point.y,
-                                                           ptconorms[0].point.z);
-              n_vertices ++;
+              wsgl_rec_vertex(ptconorms[i].point.x,
+                              ptconorms[i].point.y,
+                              ptconorms[i].point.z);
+              wsgl_rec_vertex(ptconorms[0].point.x,
+                              ptconorms[0].point.y,
+                              ptconorms[0].point.z);
             }
          }
       }
       if (record_geom){
-        wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+        wsgl_rec_geometry(GEOM_SEGMENTS);
       }
       glEnd();
    }
@@ -437,14 +402,13 @@ static void priv_edges_ptconorms(
                     ptconorms[i].point.y,
                     ptconorms[i].point.z);
          if (record_geom){
-           vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[i].point.x,
-                                                        ptconorms[i].point.y,
-                                                        ptconorms[i].point.z);
-           n_vertices ++;
+           wsgl_rec_vertex(ptconorms[i].point.x,
+                           ptconorms[i].point.y,
+                           ptconorms[i].point.z);
          }
       }
       if (record_geom){
-        wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+        wsgl_rec_geometry(GEOM_LINE);
       }
       glEnd();
    }
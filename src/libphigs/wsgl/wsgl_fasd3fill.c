@@ -32,6 +32,38 @@
 #include "private/wsglP.h"
 #include "private/fasd3P.h"
 
+static unsigned char *lod_keep = NULL;
+static unsigned char *lod_cur = NULL;
+static unsigned char lod_bit = 0;
+
+/*******************************************************************************
+ * priv_lod_facet
+ *
+ * DESCR:	Select the level of detail flags for the next facet
+ * RETURNS:	FALSE if too few vertices of the facet are kept to draw it
+ */
+
+static int priv_lod_facet(
+                          Pint num_vertices
+                          )
+{
+  Pint i, n;
+
+  lod_cur = lod_keep;
+  if (lod_cur == NULL) {
+    return TRUE;
+  }
+  lod_keep += num_vertices;
+
+  for (i = 0, n = 0; i < num_vertices && n < 3; i++) {
+    if (lod_cur[i] & lod_bit) {
+      n++;
+    }
+  }
+
+  return (n >= 3);
+}
+
 /*******************************************************************************
  * priv_fill_area3_points
  *
@@ -45,29 +77,30 @@ static void priv_fill_area3_points(
                                    )
 {
   Pint i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
+
+  if (!priv_lod_facet(num_vertices)) {
+    return;
+  }
 
   glBegin(GL_POLYGON);
   for (i = 0; i < num_vertices; i++) {
+    if (lod_cur != NULL && !(lod_cur[i] & lod_bit)) {
+      continue;
+    }
     glVertex3f(points[i].x,
                points[i].y,
                points[i].z);
     if (record_geom && record_geom_fill){
-      vertex_indices[n_vertices] = wsgl_add_vertex(points[i].x,
-                                                   points[i].y,
-                                                   points[i].z);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(points[i].x,
+                      points[i].y,
+                      points[i].z);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom && record_geom_fill){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -88,30 +121,31 @@ static void priv_fill_area3_ptcolrs(
                                     )
 {
   Pint i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
+
+  if (!priv_lod_facet(num_vertices)) {
+    return;
+  }
 
   glBegin(GL_POLYGON);
   for (i = 0; i < num_vertices; i++) {
+    if (lod_cur != NULL && !(lod_cur[i] & lod_bit)) {
+      continue;
+    }
     wsgl_setup_int_colr(ws, colr_type, &ptcolrs[i].colr, ast);
     glVertex3f(ptcolrs[i].point.x,
                ptcolrs[i].point.y,
                ptcolrs[i].point.z);
     if (record_geom && record_geom_fill){
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[i].point.x,
-                                                   ptcolrs[i].point.y,
-                                                   ptcolrs[i].point.z);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptcolrs[i].point.x,
+                      ptcolrs[i].point.y,
+                      ptcolrs[i].point.z);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom && record_geom_fill){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -132,30 +166,31 @@ static void priv_back_area3_ptcolrs(
                                     )
 {
   Pint i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
+
+  if (!priv_lod_facet(num_vertices)) {
+    return;
+  }
 
   glBegin(GL_POLYGON);
   for (i = 0; i < num_vertices; i++) {
+    if (lod_cur != NULL && !(lod_cur[i] & lod_bit)) {
+      continue;
+    }
     wsgl_setup_back_int_colr(ws, colr_type, &ptcolrs[i].colr, ast);
     glVertex3f(ptcolrs[i].point.x,
                ptcolrs[i].point.y,
                ptcolrs[i].point.z);
     if (record_geom && record_geom_fill){
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[i].point.x,
-                                                   ptcolrs[i].point.y,
-                                                   ptcolrs[i].point.z);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptcolrs[i].point.x,
+                      ptcolrs[i].point.y,
+                      ptcolrs[i].point.z);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom && record_geom_fill){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -173,13 +208,16 @@ static void priv_fill_area3_ptnorms(
                                     )
 {
   Pint i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
+
+  if (!priv_lod_facet(num_vertices)) {
+    return;
+  }
 
   glBegin(GL_POLYGON);
   for (i = 0; i < num_vertices; i++) {
+    if (lod_cur != NULL && !(lod_cur[i] & lod_bit)) {
+      continue;
+    }
     glNormal3f(ptnorms[i].norm.delta_x,
                ptnorms[i].norm.delta_y,
                ptnorms[i].norm.delta_z);
@@ -190,18 +228,16 @@ static void priv_fill_area3_ptnorms(
                ptnorms[i].point.y,
                ptnorms[i].point.z);
     if (record_geom && record_geom_fill){
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[i].point.x,
-                                                   ptnorms[i].point.y,
-                                                   ptnorms[i].point.z);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptnorms[i].point.x,
+                      ptnorms[i].point.y,
+                      ptnorms[i].point.z);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom && record_geom_fill){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -223,13 +259,16 @@ static void priv_fill_area3_ptconorms(
                                       )
 {
   Pint i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
+
+  if (!priv_lod_facet(num_vertices)) {
+    return;
+  }
 
   glBegin(GL_POLYGON);
   for (i = 0; i < num_vertices; i++) {
+    if (lod_cur != NULL && !(lod_cur[i] & lod_bit)) {
+      continue;
+    }
     wsgl_setup_int_colr(ws, colr_type, &ptconorms[i].colr, ast);
     glNormal3f(ptconorms[i].norm.delta_x,
                ptconorms[i].norm.delta_y,
@@ -241,18 +280,16 @@ static void priv_fill_area3_ptconorms(
                ptconorms[i].point.y,
                ptconorms[i].point.z);
     if (record_geom && record_geom_fill){
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[i].point.x,
-                                                   ptconorms[i].point.y,
-                                                   ptconorms[i].point.z);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptconorms[i].point.x,
+                      ptconorms[i].point.y,
+                      ptconorms[i].point.z);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom && record_geom_fill){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -274,13 +311,16 @@ static void priv_back_area3_ptconorms(
                                       )
 {
   Pint i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
+
+  if (!priv_lod_facet(num_vertices)) {
+    return;
+  }
 
   glBegin(GL_POLYGON);
   for (i = 0; i < num_vertices; i++) {
+    if (lod_cur != NULL && !(lod_cur[i] & lod_bit)) {
+      continue;
+    }
     wsgl_setup_back_int_colr(ws, colr_type, &ptconorms[i].colr, ast);
     glNormal3f(ptconorms[i].norm.delta_x,
                ptconorms[i].norm.delta_y,
@@ -292,18 +332,16 @@ static void priv_back_area3_ptconorms(
                ptconorms[i].point.y,
                ptconorms[i].point.z);
     if (record_geom && record_geom_fill){
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[i].point.x,
-                                                   ptconorms[i].point.y,
-                                                   ptconorms[i].point.z);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptconorms[i].point.x,
+                      ptconorms[i].point.y,
+                      ptconorms[i].point.z);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom && record_geom_fill){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -332,6 +370,8 @@ void wsgl_fill_area_set3_data_front(
   fasd3.edata = &edata;
   fasd3.vdata = &vdata;
   fasd3_head(&fasd3, pdata);
+  lod_keep = ((Wsgl_handle) ws->render_context)->lod_keep;
+  lod_bit = ((Wsgl_handle) ws->render_context)->lod_bit;
 
   glPolygonOffset(WS_FILL_AREA_OFFSET, wsgl_get_edge_width(ast));
   glEnable(GL_POLYGON_OFFSET_FILL);
@@ -546,6 +586,8 @@ void wsgl_fill_area_set3_data_back(
   fasd3.edata = &edata;
   fasd3.vdata = &vdata;
   fasd3_head(&fasd3, pdata);
+  lod_keep = ((Wsgl_handle) ws->render_context)->lod_keep;
+  lod_bit = ((Wsgl_handle) ws->render_context)->lod_bit;
 
   glPolygonOffset(WS_FILL_AREA_OFFSET, wsgl_get_edge_width(ast));
   glEnable(GL_POLYGON_OFFSET_FILL);
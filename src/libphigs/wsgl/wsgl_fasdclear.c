@@ -47,10 +47,6 @@ static void priv_clear_area_points(
                                    )
 {
   Pint i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
 
   glBegin(GL_POLYGON);
   for (i = 0; i < num_vertices; i++) {
@@ -58,18 +54,16 @@ static void priv_clear_area_points(
                points[i].y,
                0.);
     if (record_geom){
-      vertex_indices[n_vertices] = wsgl_add_vertex(points[i].x,
-                                                   points[i].y,
-                                                   0.);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(points[i].x,
+                      points[i].y,
+                      0.);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -87,10 +81,6 @@ static void priv_clear_area_ptcolrs(
                                     )
 {
   Pint i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
 
   glBegin(GL_POLYGON);
   for (i = 0; i < num_vertices; i++) {
@@ -98,18 +88,16 @@ static void priv_clear_area_ptcolrs(
                ptcolrs[i].point.y,
                0.0);
     if (record_geom){
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[i].point.x,
-                                                   ptcolrs[i].point.y,
-                                                   0.0);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptcolrs[i].point.x,
+                      ptcolrs[i].point.y,
+                      0.0);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -127,10 +115,6 @@ static void priv_clear_area_ptnorms(
                                     )
 {
   Pint i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
 
   glBegin(GL_POLYGON);
   for (i = 0; i < num_vertices; i++) {
@@ -138,18 +122,16 @@ static void priv_clear_area_ptnorms(
                ptnorms[i].point.y,
                0.0);
     if (record_geom){
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[i].point.x,
-                                                   ptnorms[i].point.y,
-                                                   0.0);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptnorms[i].point.x,
+                      ptnorms[i].point.y,
+                      0.0);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -168,10 +150,6 @@ static void priv_clear_area_ptconorms(
                                       )
 {
   Pint i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
 
   glBegin(GL_POLYGON);
   for (i = 0; i < num_vertices; i++) {
@@ -179,18 +157,16 @@ static void priv_clear_area_ptconorms(
                ptconorms[i].point.y,
                0.0);
     if (record_geom){
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[i].point.x,
-                                                   ptconorms[i].point.y,
-                                                   0.0);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptconorms[i].point.x,
+                      ptconorms[i].point.y,
+                      0.0);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -47,10 +47,6 @@ static void priv_fill_area_points(
                                   )
 {
   Pint i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
 
   glBegin(GL_POLYGON);
   for (i = 0; i < num_vertices; i++) {
@@ -58,18 +54,16 @@ static void priv_fill_area_points(
                points[i].y,
                0.0);
     if (record_geom && record_geom_fill){
-      vertex_indices[n_vertices] = wsgl_add_vertex(points[i].x,
-                                                   points[i].y,
-                                                   0.0);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(points[i].x,
+                      points[i].y,
+                      0.0);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom && record_geom_fill){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -90,10 +84,6 @@ static void priv_fill_area_ptcolrs(
                                    )
 {
   Pint i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
 
   glBegin(GL_POLYGON);
   for (i = 0; i < num_vertices; i++) {
@@ -102,18 +92,16 @@ static void priv_fill_area_ptcolrs(
                ptcolrs[i].point.y,
                0.0);
     if (record_geom && record_geom_fill){
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[i].point.x,
-                                                   ptcolrs[i].point.y,
-                                                   0.0);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptcolrs[i].point.x,
+                      ptcolrs[i].point.y,
+                      0.0);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom && record_geom_fill){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -134,10 +122,6 @@ static void priv_back_area_ptcolrs(
                                    )
 {
   Pint i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
 
   glBegin(GL_POLYGON);
   for (i = 0; i < num_vertices; i++) {
@@ -146,18 +130,16 @@ static void priv_back_area_ptcolrs(
                ptcolrs[i].point.y,
                0.0);
     if (record_geom && record_geom_fill){
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[i].point.x,
-                                                   ptcolrs[i].point.y,
-                                                   0.0);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptcolrs[i].point.x,
+                      ptcolrs[i].point.y,
+                      0.0);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom && record_geom_fill){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -175,10 +157,6 @@ static void priv_fill_area_ptnorms(
                                    )
 {
   Pint i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
 
   glBegin(GL_POLYGON);
   for (i = 0; i < num_vertices; i++) {
@@ -192,18 +170,16 @@ static void priv_fill_area_ptnorms(
                ptnorms[i].point.y,
                0.0);
     if (record_geom && record_geom_fill){
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[i].point.x,
-                                                   ptnorms[i].point.y,
-                                                   0.0);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptnorms[i].point.x,
+                      ptnorms[i].point.y,
+                      0.0);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom && record_geom_fill){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -225,10 +201,6 @@ static void priv_fill_area_ptconorms(
                                      )
 {
   Pint i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
 
   glBegin(GL_POLYGON);
   for (i = 0; i < num_vertices; i++) {
@@ -243,18 +215,16 @@ static void priv_fill_area_ptconorms(
                ptconorms[i].point.y,
                0.0);
     if (record_geom && record_geom_fill){
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[i].point.x,
-                                                   ptconorms[i].point.y,
-                                                   0.0);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptconorms[i].point.x,
+                      ptconorms[i].point.y,
+                      0.0);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom && record_geom_fill){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
  glEnd();
 }
@@ -276,10 +246,6 @@ static void priv_back_area_ptconorms(
                                      )
 {
   Pint i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
 
   glBegin(GL_POLYGON);
   for (i = 0; i < num_vertices; i++) {
@@ -294,18 +260,16 @@ static void priv_back_area_ptconorms(
                ptconorms[i].point.y,
                0.0);
     if (record_geom && record_geom_fill){
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[i].point.x,
-                                                   ptconorms[i].point.y,
-                                                   0.0);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptconorms[i].point.x,
+                      ptconorms[i].point.y,
+                      0.0);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom && record_geom_fill){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -47,8 +47,6 @@ static void priv_edges_points(
                               )
 {
   Pint i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
 
   if (eflag == PEDGE_VISIBILITY) {
     glBegin(GL_LINES);
@@ -61,14 +59,12 @@ static void priv_edges_points(
                    points[i + 1].y,
                    points[i + 1].z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(points[i].x,
-                                                       points[i].y,
-                                                       points[i].z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(points[i+1].x,
-                                                       points[i+1].y,
-                                                       points[i+1].z);
-          n_vertices ++;
+          wsgl_rec_vertex(points[i].x,
+                          points[i].y,
+                          points[i].z);
+          wsgl_rec_vertex(points[i+1].x,
+                          points[i+1].y,
+                          points[i+1].z);
         }
       }
     }
@@ -81,14 +77,12 @@ static void priv_edges_points(
                    points[i + 1].y,
                    points[i + 1].z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(points[i].x,
-                                                       points[i].y,
-                                                       points[i].z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(points[i+1].x,
-                                                       points[i+1].y,
-                                                       points[i+1].z);
-          n_vertices ++;
+          wsgl_rec_vertex(points[i].x,
+                          points[i].y,
+                          points[i].z);
+          wsgl_rec_vertex(points[i+1].x,
+                          points[i+1].y,
+                          points[i+1].z);
         }
       }
     }
@@ -101,19 +95,17 @@ static void priv_edges_points(
                    points[0].y,
                    points[0].z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(points[i].x,
-                                                       points[i].y,
-                                                       points[i].z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(points[0].x,
-                                                       points[0].y,
-                                                       points[0].z);
-          n_vertices ++;
+          wsgl_rec_vertex(points[i].x,
+                          points[i].y,
+                          points[i].z);
+          wsgl_rec_vertex(points[0].x,
+                          points[0].y,
+                          points[0].z);
         }
       }
     }
     if (record_geom){
-      wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+      wsgl_rec_geometry(GEOM_SEGMENTS);
     }
     glEnd();
   }
@@ -125,13 +117,12 @@ static void priv_edges_points(
                  points[i].z);
     }
     if (record_geom){
-      vertex_indices[n_vertices] = wsgl_add_vertex(points[i].x,
-                                                   points[i].y,
-                                                   points[i].z);
-      n_vertices ++;
+      wsgl_rec_vertex(points[i].x,
+                      points[i].y,
+                      points[i].z);
     }
     if (record_geom){
-      wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+      wsgl_rec_geometry(GEOM_LINE);
     }
     glEnd();
   }
@@ -153,8 +144,6 @@ static void priv_edges_ptcolrs(
                                )
 {
   Pint i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
 
   if (eflag == PEDGE_VISIBILITY) {
     glBegin(GL_LINES);
@@ -167,14 +156,12 @@ static void priv_edges_ptcolrs(
                    ptcolrs[i + 1].point.y,
                    ptcolrs[i + 1].point.z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[i].point.x,
-                                                       ptcolrs[i].point.y,
-                                                       ptcolrs[i].point.z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[i+1].point.x,
-                                                       ptcolrs[i+1].point.y,
-                                                       ptcolrs[i+1].point.z);
-          n_vertices ++;
+          wsgl_rec_vertex(ptcolrs[i].point.x,
+                          ptcolrs[i].point.y,
+                          ptcolrs[i].point.z);
+          wsgl_rec_vertex(ptcolrs[i+1].point.x,
+                          ptcolrs[i+1].point.y,
+                          ptcolrs[i+1].point.z);
         }
       }
     }
@@ -187,14 +174,12 @@ static void priv_edges_ptcolrs(
                    ptcolrs[i + 1].point.y,
                    ptcolrs[i + 1].point.z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[i].point.x,
-                                                       ptcolrs[i].point.y,
-                                                       ptcolrs[i].point.z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[i+1].point.x,
-                                                       ptcolrs[i+1].point.y,
-                                                       ptcolrs[i+1].point.z);
-          n_vertices ++;
+          wsgl_rec_vertex(ptcolrs[i].point.x,
+                          ptcolrs[i].point.y,
+                          ptcolrs[i].point.z);
+          wsgl_rec_vertex(ptcolrs[i+1].point.x,
+                          ptcolrs[i+1].point.y,
+                          ptcolrs[i+1].point.z);
         }
       }
     }
@@ -207,19 +192,17 @@ static void priv_edges_ptcolrs(
                    ptcolrs[0].point.y,
                    ptcolrs[0].point.z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[i].point.x,
-                                                       ptcolrs[i].point.y,
-                                                       ptcolrs[i].point.z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[0].point.x,
-                                                       ptcolrs[0].point.y,
-                                                       ptcolrs[0].point.z);
-          n_vertices ++;
+          wsgl_rec_vertex(ptcolrs[i].point.x,
+                          ptcolrs[i].point.y,
+                          ptcolrs[i].point.z);
+          wsgl_rec_vertex(ptcolrs[0].point.x,
+                          ptcolrs[0].point.y,
+                          ptcolrs[0].point.z);
         }
       }
     }
     if (record_geom){
-      wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+      wsgl_rec_geometry(GEOM_SEGMENTS);
     }
     glEnd();
   }
@@ -230,14 +213,13 @@ static void priv_edges_ptcolrs(
                  ptcolrs[i].point.y,
                  ptcolrs[i].point.z);
       if (record_geom){
-        vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[i].point.x,
-                                                     ptcolrs[i].point.y,
-                                                     ptcolrs[i].point.z);
-        n_vertices ++;
+        wsgl_rec_vertex(ptcolrs[i].point.x,
+                        ptcolrs[i].point.y,
+                        ptcolrs[i].point.z);
       }
     }
     if (record_geom){
-      wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+      wsgl_rec_geometry(GEOM_LINE);
     }
     glEnd();
   }
@@ -258,8 +240,6 @@ static void priv_edges_ptnorms(
                                )
 {
   Pint i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
 
   if (eflag == PEDGE_VISIBILITY) {
     glBegin(GL_LINES);
@@ -272,14 +252,12 @@ static void priv_edges_ptnorms(
                    ptnorms[i + 1].point.y,
                    ptnorms[i + 1].point.z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[i].point.x,
-                                                       ptnorms[i].point.y,
-                                                       ptnorms[i].point.z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[i+1].point.x,
-                                                       ptnorms[i+1].point.y,
-                                                       ptnorms[i+1].point.z);
-          n_vertices ++;
+          wsgl_rec_vertex(ptnorms[i].point.x,
+                          ptnorms[i].point.y,
+                          ptnorms[i].point.z);
+          wsgl_rec_vertex(ptnorms[i+1].point.x,
+                          ptnorms[i+1].point.y,
+                          ptnorms[i+1].point.z);
         }
       }
     }
@@ -292,14 +270,12 @@ static void priv_edges_ptnorms(
                    ptnorms[i + 1].point.y,
                    ptnorms[i + 1].point.z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[i].point.x,
-                                                       ptnorms[i].point.y,
-                                                       ptnorms[i].point.z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[i+1].point.x,
-                                                       ptnorms[i+1].point.y,
-                                                       ptnorms[i+1].point.z);
-          n_vertices ++;
+          wsgl_rec_vertex(ptnorms[i].point.x,
+                          ptnorms[i].point.y,
+                          ptnorms[i].point.z);
+          wsgl_rec_vertex(ptnorms[i+1].point.x,
+                          ptnorms[i+1].point.y,
+                          ptnorms[i+1].point.z);
         }
       }
     }
@@ -312,19 +288,17 @@ static void priv_edges_ptnorms(
                    ptnorms[0].point.y,
                    ptnorms[0].point.z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[i].point.x,
-                                                       ptnorms[i].point.y,
-                                                       ptnorms[i].point.z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[0].point.x,
-                                                       ptnorms[0].point.y,
-                                                       ptnorms[0].point.z);
-          n_vertices ++;
+          wsgl_rec_vertex(ptnorms[i].point.x,
+                          ptnorms[i].point.y,
+                          ptnorms[i].point.z);
+          wsgl_rec_vertex(ptnorms[0].point.x,
+                          ptnorms[0].point.y,
+                          ptnorms[0].point.z);
         }
       }
     }
     if (record_geom){
-      wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+      wsgl_rec_geometry(GEOM_SEGMENTS);
     }
     glEnd();
   }
@@ -335,14 +309,13 @@ static void priv_edges_ptnorms(
                  ptnorms[i].point.y,
                  ptnorms[i].point.z);
       if (record_geom){
-        vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[i].point.x,
-                                                     ptnorms[i].point.y,
-                                                     ptnorms[i].point.z);
-        n_vertices ++;
+        wsgl_rec_vertex(ptnorms[i].point.x,
+                        ptnorms[i].point.y,
+                        ptnorms[i].point.z);
       }
     }
     if (record_geom){
-      wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+      wsgl_rec_geometry(GEOM_LINE);
     }
     glEnd();
   }
@@ -363,8 +336,6 @@ static void priv_edges_ptconorms(
                                  )
 {
   Pint i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
 
   if (eflag == PEDGE_VISIBILITY) {
     glBegin(GL_LINES);
@@ -377,14 +348,12 @@ static void priv_edges_ptconorms(
                    ptconorms[i + 1].point.y,
                    ptconorms[i + 1].point.z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[i].point.x,
-                                                       ptconorms[i].point.y,
-                                                       ptconorms[i].point.z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[i+1].point.x,
-                                                       ptconorms[i+1].point.y,
-                                                       ptconorms[i+1].point.z);
-          n_vertices ++;
+          wsgl_rec_vertex(ptconorms[i].point.x,
+                          ptconorms[i].point.y,
+                          ptconorms[i].point.z);
+          wsgl_rec_vertex(ptconorms[i+1].point.x,
+                          ptconorms[i+1].point.y,
+                          ptconorms[i+1].point.z);
         }
       }
     }
@@ -397,14 +366,12 @@ static void priv_edges_ptconorms(
                    ptconorms[i + 1].point.y,
                    ptconorms[i + 1].point.z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[i].point.x,
-                                                       ptconorms[i].point.y,
-                                                       ptconorms[i].point.z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[i+1].point.x,
-                                                       ptconorms[i+1].point.y,
-                                                       ptconorms[i+1].point.z);
-          n_vertices ++;
+          wsgl_rec_vertex(ptconorms[i].point.x,
+                          ptconorms[i].point.y,
+                          ptconorms[i].point.z);
+          wsgl_rec_vertex(ptconorms[i+1].point.x,
+                          ptconorms[i+1].point.y,
+                          ptconorms[i+1].point.z);
         }
       }
     }
@@ -417,19 +384,17 @@ static void priv_edges_ptconorms(
                    ptconorms[0].point.y,
                    ptconorms[0].point.z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[i].point.x,
-                                                       ptconorms[i].point.y,
-                                                       ptconorms[i].point.z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[0].point.x,
-                                                       ptconorms[0].point.y,
-                                                       ptconorms[0].point.z);
-          n_vertices ++;
+          wsgl_rec_vertex(ptconorms[i].point.x,
+                          ptconorms[i].point.y,
+                          ptconorms[i].point.z);
+          wsgl_rec_vertex(ptconorms[0].point.x,
+                          ptconorms[0].point.y,
+                          ptconorms[0].point.z);
         }
       }
     }
     if (record_geom){
-      wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+      wsgl_rec_geometry(GEOM_SEGMENTS);
     }
     glEnd();
   }
@@ -440,14 +405,13 @@ static void priv_edges_ptconorms(
                  ptconorms[i].point.y,
                  ptconorms[i].point.z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[i].point.x,
-                                                       ptconorms[i].point.y,
-                                                       ptconorms[i].point.z);
-          n_vertices ++;
+          wsgl_rec_vertex(ptconorms[i].point.x,
+                          ptconorms[i].point.y,
+                          ptconorms[i].point.z);
         }
     }
     if (record_geom){
-      wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+      wsgl_rec_geometry(GEOM_LINE);
     }
     glEnd();
   }
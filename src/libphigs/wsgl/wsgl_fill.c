@@ -40,10 +40,6 @@ void priv_fill_area(
                     )
 {
   int i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
 
   glBegin(GL_POLYGON);
   for (i = 0; i < point_list->num_points; i++) {
@@ -53,18 +49,16 @@ void priv_fill_area(
 #ifdef DEBUG_OBJ
       printf("wsgl_fill: priv_fill_area called\n");
 #endif
-      vertex_indices[n_vertices] = wsgl_add_vertex(point_list->points[i].x,
-                                                   point_list->points[i].y,
-                                                   0.0);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(point_list->points[i].x,
+                      point_list->points[i].y,
+                      0.0);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom && record_geom_fill){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -113,10 +107,6 @@ void priv_fill_area3(
                      )
 {
   int i;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
 
   glBegin(GL_POLYGON);
   for (i = 0; i < point_list->num_points; i++) {
@@ -127,18 +117,16 @@ void priv_fill_area3(
 #ifdef DEBUG_OBJ
       printf("wsgl_fill: priv_fill_area3 called\n");
 #endif
-      vertex_indices[n_vertices] = wsgl_add_vertex(point_list->points[i].x,
-                                                   point_list->points[i].y,
-                                                   point_list->points[i].z);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(point_list->points[i].x,
+                      point_list->points[i].y,
+                      point_list->points[i].z);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom && record_geom_fill){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
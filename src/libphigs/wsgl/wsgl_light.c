@@ -23,6 +23,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 #ifdef GLEW
 #include <GL/glew.h>
 #include <GL/gl.h>
@@ -38,13 +39,7 @@
 #include "private/wsxP.h"
 #include "private/wsglP.h"
 
-extern GLint lightSource0, lightSourceTyp0, lightSourceCol0, lightSourcePos0, lightSourceCoef0;
-extern GLint lightSource1, lightSourceTyp1, lightSourceCol1, lightSourcePos1, lightSourceCoef1;
-extern GLint lightSource2, lightSourceTyp2, lightSourceCol2, lightSourcePos2, lightSourceCoef2;
-extern GLint lightSource3, lightSourceTyp3, lightSourceCol3, lightSourcePos3, lightSourceCoef3;
-extern GLint lightSource4, lightSourceTyp4, lightSourceCol4, lightSourcePos4, lightSourceCoef4;
-extern GLint lightSource5, lightSourceTyp5, lightSourceCol5, lightSourcePos5, lightSourceCoef5;
-extern GLint lightSource6, lightSourceTyp6, lightSourceCol6, lightSourcePos6, lightSourceCoef6;
+extern GLint num_lights, light_data;
 
 /*******************************************************************************
  * get_light_id
@@ -73,6 +68,46 @@ static GLuint get_light_id(
    return id;
 }
 
+/*******************************************************************************
+ * add_light_src
+ *
+ * DESCR:	Add light source to the shader light block helper function.
+ *		The light type is stored in the last coefficient.
+ * RETURNS:	N/A
+ */
+
+static void add_light_src(
+   Wsgl_light_block *block,
+   Pint type,
+   GLfloat *colr,
+   GLfloat *pos,
+   GLfloat *coef
+   )
+{
+   GLfloat (*light)[4];
+
+   if (block->num_lights >= WS_MAX_SHADER_LIGHT_SRC) {
+      printf("ERROR: Too many active light sources\n");
+      return;
+   }
+
+   light = block->data[block->num_lights++];
+   memcpy(light[0], colr, 4 * sizeof(GLfloat));
+   if (pos != NULL) {
+      memcpy(light[1], pos, 4 * sizeof(GLfloat));
+   }
+   else {
+      memset(light[1], 0, 4 * sizeof(GLfloat));
+   }
+   if (coef != NULL) {
+      memcpy(light[2], coef, 4 * sizeof(GLfloat));
+   }
+   else {
+      memset(light[2], 0, 4 * sizeof(GLfloat));
+   }
+   light[2][3] = (GLfloat) type;
+}
+
 /*******************************************************************************
  * setup_ambient_light
  *
@@ -81,6 +116,7 @@ static GLuint get_light_id(
  */
 
 static void setup_ambient_light(
+   Wsgl_light_block *block,
    Pint ind,
    Pamb_light_src_rec *rec
    )
@@ -96,53 +132,8 @@ static void setup_ambient_light(
 #ifdef DEBUG
    printf("Ambient light: %f %f %f\n", amb[0], amb[1], amb[2]);
 #endif
-#ifdef GLEW
-   if (wsgl_use_shaders && GLEW_ARB_vertex_shader && GLEW_ARB_fragment_shader && GLEW_ARB_shader_objects){
-#else
-   if (wsgl_use_shaders){
-#endif
-     switch (ind){
-     case 0:
-       glUniform1i(lightSource0, 0);
-     case 1:
-       glUniform1i(lightSource0, 1);
-       glUniform1i(lightSourceTyp0, PLIGHT_AMBIENT);
-       glUniform4fv(lightSourceCol0, 1, amb);
-       break;
-     case 2:
-       glUniform1i(lightSource1, 1);
-       glUniform1i(lightSourceTyp1, PLIGHT_AMBIENT);
-       glUniform4fv(lightSourceCol1, 1, amb);
-       break;
-     case 3:
-       glUniform1i(lightSource2, 1);
-       glUniform1i(lightSourceTyp2, PLIGHT_AMBIENT);
-       glUniform4fv(lightSourceCol2, 1, amb);
-       break;
-     case 4:
-       glUniform1i(lightSource3, 1);
-       glUniform1i(lightSourceTyp3, PLIGHT_AMBIENT);
-       glUniform4fv(lightSourceCol3, 1, amb);
-       break;
-     case 5:
-       glUniform1i(lightSource4, 1);
-       glUniform1i(lightSourceTyp4, PLIGHT_AMBIENT);
-       glUniform4fv(lightSourceCol4, 1, amb);
-       break;
-     case 6:
-       glUniform1i(lightSource5, 1);
-       glUniform1i(lightSourceTyp5, PLIGHT_AMBIENT);
-       glUniform4fv(lightSourceCol5, 1, amb);
-       break;
-     case 7:
-       glUniform1i(lightSource6, 1);
-       glUniform1i(lightSourceTyp6, PLIGHT_AMBIENT);
-       glUniform4fv(lightSourceCol6, 1, amb);
-       break;
-     default:
-       printf("ERROR: Unknown ambient light source index\n");
-       break;
-     }
+   if (block != NULL) {
+     add_light_src(block, PLIGHT_AMBIENT, amb, NULL, NULL);
    } else {
      id = get_light_id(ind);
      glLightfv(id, GL_AMBIENT, amb);
@@ -158,6 +149,7 @@ static void setup_ambient_light(
  */
 
 static void setup_directional_light(
+   Wsgl_light_block *block,
    Pint ind,
    Pdir_light_src_rec *rec
    )
@@ -181,60 +173,8 @@ static void setup_directional_light(
           dif[0], dif[1], dif[2],
           pos[0], pos[1], pos[2]);
 #endif
-#ifdef GLEW
-   if (wsgl_use_shaders && GLEW_ARB_vertex_shader && GLEW_ARB_fragment_shader && GLEW_ARB_shader_objects){
-#else
-   if (wsgl_use_shaders){
-#endif
-     switch (ind){
-     case 0:
-       glUniform1i(lightSource0, 0);
-     case 1:
-       glUniform1i(lightSource0, 1);
-       glUniform1i(lightSourceTyp0, PLIGHT_DIRECTIONAL);
-       glUniform4fv(lightSourceCol0, 1, dif);
-       glUniform4fv(lightSourcePos0, 1, pos);
-       break;
-     case 2:
-       glUniform1i(lightSource1, 1);
-       glUniform1i(lightSourceTyp1, PLIGHT_DIRECTIONAL);
-       glUniform4fv(lightSourceCol1, 1, dif);
-       glUniform4fv(lightSourcePos1, 1, pos);
-       break;
-     case 3:
-       glUniform1i(lightSource2, 1);
-       glUniform1i(lightSourceTyp2, PLIGHT_DIRECTIONAL);
-       glUniform4fv(lightSourceCol2, 1, dif);
-       glUniform4fv(lightSourcePos2, 1, pos);
-       break;
-     case 4:
-       glUniform1i(lightSource3, 1);
-       glUniform1i(lightSourceTyp3, PLIGHT_DIRECTIONAL);
-       glUniform4fv(lightSourceCol3, 1, dif);
-       glUniform4fv(lightSourcePos3, 1, pos);
-       break;
-     case 5:
-       glUniform1i(lightSource4, 1);
-       glUniform1i(lightSourceTyp4, PLIGHT_DIRECTIONAL);
-       glUniform4fv(lightSourceCol4, 1, dif);
-       glUniform4fv(lightSourcePos4, 1, pos);
-       break;
-     case 6:
-       glUniform1i(lightSource5, 1);
-       glUniform1i(lightSourceTyp5, PLIGHT_DIRECTIONAL);
-       glUniform4fv(lightSourceCol5, 1, dif);
-       glUniform4fv(lightSourcePos5, 1, pos);
-       break;
-     case 7:
-       glUniform1i(lightSource6, 1);
-       glUniform1i(lightSourceTyp6, PLIGHT_DIRECTIONAL);
-       glUniform4fv(lightSourceCol6, 1, dif);
-       glUniform4fv(lightSourcePos6, 1, pos);
-       break;
-     default:
-       printf("ERROR: Unknown directional light source index\n");
-       break;
-     }
+   if (block != NULL) {
+     add_light_src(block, PLIGHT_DIRECTIONAL, dif, pos, NULL);
    } else {
      id = get_light_id(ind);
      glLightfv(id, GL_DIFFUSE, dif);
@@ -251,6 +191,7 @@ static void setup_directional_light(
  */
 
 static void setup_positional_light(
+   Wsgl_light_block *block,
    Pint ind,
    Ppos_light_src_rec *rec
    )
@@ -281,67 +222,8 @@ static void setup_positional_light(
           pos[0], pos[1], pos[2],
           coef[0], coef[1]);
 #endif
-#ifdef GLEW
-   if (wsgl_use_shaders && GLEW_ARB_vertex_shader && GLEW_ARB_fragment_shader && GLEW_ARB_shader_objects){
-#else
-   if (wsgl_use_shaders){
-#endif
-     switch (ind){
-     case 0:
-       glUniform1i(lightSource0, 0);
-     case 1:
-       glUniform1i(lightSource0, 1);
-       glUniform1i(lightSourceTyp0, PLIGHT_POSITIONAL);
-       glUniform4fv(lightSourceCol0, 1, dif);
-       glUniform4fv(lightSourcePos0, 1, pos);
-       glUniform4fv(lightSourceCoef0, 1, coef);
-       break;
-     case 2:
-       glUniform1i(lightSource1, 1);
-       glUniform1i(lightSourceTyp1, PLIGHT_POSITIONAL);
-       glUniform4fv(lightSourceCol1, 1, dif);
-       glUniform4fv(lightSourcePos1, 1, pos);
-       glUniform4fv(lightSourceCoef1, 1, coef);
-       break;
-     case 3:
-       glUniform1i(lightSource2, 1);
-       glUniform1i(lightSourceTyp2, PLIGHT_POSITIONAL);
-       glUniform4fv(lightSourceCol2, 1, dif);
-       glUniform4fv(lightSourcePos2, 1, pos);
-       glUniform4fv(lightSourceCoef2, 1, coef);
-       break;
-     case 4:
-       glUniform1i(lightSource3, 1);
-       glUniform1i(lightSourceTyp3, PLIGHT_POSITIONAL);
-       glUniform4fv(lightSourceCol3, 1, dif);
-       glUniform4fv(lightSourcePos3, 1, pos);
-       glUniform4fv(lightSourceCoef3, 1, coef);
-       break;
-     case 5:
-       glUniform1i(lightSource4, 1);
-       glUniform1i(lightSourceTyp4, PLIGHT_POSITIONAL);
-       glUniform4fv(lightSourceCol4, 1, dif);
-       glUniform4fv(lightSourcePos4, 1, pos);
-       glUniform4fv(lightSourceCoef4, 1, coef);
-       break;
-     case 6:
-       glUniform1i(lightSource5, 1);
-       glUniform1i(lightSourceTyp5, PLIGHT_POSITIONAL);
-       glUniform4fv(lightSourceCol5, 1, dif);
-       glUniform4fv(lightSourcePos5, 1, pos);
-       glUniform4fv(lightSourceCoef5, 1, coef);
-       break;
-     case 7:
-       glUniform1i(lightSource6, 1);
-       glUniform1i(lightSourceTyp6, PLIGHT_POSITIONAL);
-       glUniform4fv(lightSourceCol6, 1, dif);
-       glUniform4fv(lightSourcePos6, 1, pos);
-       glUniform4fv(lightSourceCoef6, 1, coef);
-       break;
-     default:
-       printf("ERROR: Unknown positional light source index\n");
-       break;
-     }
+   if (block != NULL) {
+     add_light_src(block, PLIGHT_POSITIONAL, dif, pos, coef);
    } else {
      id = get_light_id(ind);
      glLightfv(id, GL_DIFFUSE, dif);
@@ -350,6 +232,41 @@ static void setup_positional_light(
    }
 }
 
+/*******************************************************************************
+ * upload_light_block
+ *
+ * DESCR:	Upload the active light sources to the shaders if they changed
+ * RETURNS:	N/A
+ */
+
+static void upload_light_block(
+   Wsgl *wsgl,
+   Wsgl_light_block *block
+   )
+{
+   size_t size;
+
+   size = offsetof(Wsgl_light_block, data) +
+      block->num_lights * sizeof(block->data[0]);
+   if (wsgl->light_block_valid &&
+       memcmp(&wsgl->light_block, block, size) == 0) {
+      return;
+   }
+   memcpy(&wsgl->light_block, block, size);
+   wsgl->light_block_valid = TRUE;
+
+   if (wsgl->light_buffer != 0) {
+      glBindBuffer(GL_UNIFORM_BUFFER, wsgl->light_buffer);
+      glBufferSubData(GL_UNIFORM_BUFFER, 0, size, block);
+      glBindBuffer(GL_UNIFORM_BUFFER, 0);
+   } else {
+      glUniform1i(num_lights, block->num_lights);
+      if (block->num_lights > 0) {
+         glUniform4fv(light_data, 3 * block->num_lights, block->data[0][0]);
+      }
+   }
+}
+
 /*******************************************************************************
  * wsgl_update_light_src_state
  *
@@ -361,15 +278,28 @@ void wsgl_update_light_src_state(
    Ws *ws
    )
 {
-   Pint i;
+   Pint i, max_lights;
    Phg_ret ret;
    Wsgl *wsgl = ws->render_context;
+   Wsgl_light_block block, *shader_block;
 
-   glPushMatrix();
-   glLoadIdentity();
+#ifdef GLEW
+   if (wsgl_use_shaders && GLEW_ARB_vertex_shader && GLEW_ARB_fragment_shader && GLEW_ARB_shader_objects){
+#else
+   if (wsgl_use_shaders){
+#endif
+     memset(&block, 0, offsetof(Wsgl_light_block, data));
+     shader_block = &block;
+     max_lights = WS_MAX_SHADER_LIGHT_SRC;
+   } else {
+     shader_block = NULL;
+     max_lights = WS_MAX_LIGHT_SRC;
+     glPushMatrix();
+     glLoadIdentity();
+   }
 
    /* Activate light sources */
-   for (i = 0; i < WS_MAX_LIGHT_SRC; i++) {
+   for (i = 0; i < max_lights; i++) {
       if (phg_nset_name_is_set(&wsgl->cur_struct.lightstat, i)) {
 #ifdef DEBUG
          printf("Setup light source: %d\n", i);
@@ -382,15 +312,15 @@ void wsgl_update_light_src_state(
          if (ret.err == 0) {
             switch (ret.data.rep.lightsrcrep.type) {
                case PLIGHT_AMBIENT:
-                  setup_ambient_light(i, &ret.data.rep.lightsrcrep.rec.ambient);
+                  setup_ambient_light(shader_block, i, &ret.data.rep.lightsrcrep.rec.ambient);
                   break;
 
                case PLIGHT_DIRECTIONAL:
-                  setup_directional_light(i, &ret.data.rep.lightsrcrep.rec.directional);
+                  setup_directional_light(shader_block, i, &ret.data.rep.lightsrcrep.rec.directional);
                   break;
 
                case PLIGHT_POSITIONAL:
-                  setup_positional_light(i, &ret.data.rep.lightsrcrep.rec.positional);
+                  setup_positional_light(shader_block, i, &ret.data.rep.lightsrcrep.rec.positional);
                   break;
 		  /* FIXME
                case PLIGHT_SPOT:
@@ -401,45 +331,16 @@ void wsgl_update_light_src_state(
                   break;
             }
          }
-      } else {
-#ifdef GLEW
-	if (wsgl_use_shaders && GLEW_ARB_vertex_shader && GLEW_ARB_fragment_shader && GLEW_ARB_shader_objects){
-#else
-	if (wsgl_use_shaders){
-#endif
-	  switch (i){
-	  case 1:
-	    glUniform1i(lightSource0, 0);
-	    break;
-	  case 2:
-	    glUniform1i(lightSource1, 0);
-	    break;
-	  case 3:
-	    glUniform1i(lightSource2, 0);
-	    break;
-	  case 4:
-	    glUniform1i(lightSource3, 0);
-	    break;
-	  case 5:
-	    glUniform1i(lightSource4, 0);
-	    break;
-	  case 6:
-	    glUniform1i(lightSource5, 0);
-	    break;
-	  case 7:
-	    glUniform1i(lightSource6, 0);
-	    break;
-	  }
-	} else {
-	  glDisable(get_light_id(i));
-	}
+      } else if (shader_block == NULL) {
+	glDisable(get_light_id(i));
       }
    }
-#ifdef GLEW
-   if (!wsgl_use_shaders || !GLEW_ARB_vertex_shader || !GLEW_ARB_fragment_shader || !GLEW_ARB_shader_objects) glPopMatrix();
-#else
-   if (!wsgl_use_shaders) glPopMatrix();
-#endif
+
+   if (shader_block != NULL) {
+     upload_light_block(wsgl, shader_block);
+   } else {
+     glPopMatrix();
+   }
 }
 
 /*******************************************************************************
@@ -44,8 +44,6 @@ void wsgl_polyline(
    int i;
    Ppoint_list point_list;
    Pint *data = (Pint *) pdata;
-   int vertex_indices[MAX_VERTICES];
-   int n_vertices = 0;
 
    point_list.num_points = *data;
    point_list.points = (Ppoint *) &data[1];
@@ -56,14 +54,13 @@ void wsgl_polyline(
       glVertex2f(point_list.points[i].x,
                  point_list.points[i].y);
       if (record_geom){
-        vertex_indices[n_vertices] = wsgl_add_vertex(point_list.points[i].x,
-                                                     point_list.points[i].y,
-                                                     0.0);
-        n_vertices ++;
+        wsgl_rec_vertex(point_list.points[i].x,
+                        point_list.points[i].y,
+                        0.0);
       }
    }
    if (record_geom){
-     wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+     wsgl_rec_geometry(GEOM_SEGMENTS);
    }
    glEnd();
 }
@@ -84,8 +81,6 @@ void wsgl_polyline3(
    int i;
    Ppoint_list3 point_list;
    Pint *data = (Pint *) pdata;
-   int vertex_indices[MAX_VERTICES];
-   int n_vertices = 0;
 
    point_list.num_points = *data;
    point_list.points = (Ppoint3 *) &data[1];
@@ -97,14 +92,13 @@ void wsgl_polyline3(
                  point_list.points[i].y,
                  point_list.points[i].z);
       if (record_geom){
-        vertex_indices[n_vertices] = wsgl_add_vertex(point_list.points[i].x,
-                                                     point_list.points[i].y,
-                                                     point_list.points[i].z);
-        n_vertices ++;
+        wsgl_rec_vertex(point_list.points[i].x,
+                        point_list.points[i].y,
+                        point_list.points[i].z);
       }
    }
    if (record_geom){
-     wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+     wsgl_rec_geometry(GEOM_SEGMENTS);
    }
    glEnd();
 }
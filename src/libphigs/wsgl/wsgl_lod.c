@@ -0,0 +1,900 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************
+* Changes:   Copyright (C) 2022-2023 CERN
+******************************************************************************/
+
+/*
+ * Screen space level of detail for dense elements.
+ *
+ * Polylines get a Douglas-Peucker error per vertex: the largest tolerance
+ * at which the vertex survives the simplification. Drawing at a given
+ * tolerance then only needs to skip the vertices below it.
+ *
+ * Fill area set 3 with data and set of fill area set 3 with data meshes
+ * are simplified by vertex clustering on WS_LOD_LEVELS nested grids. For
+ * FASD3 each vertex carries a bit per level telling if it is kept; for
+ * SOFAS3 each level maps every vertex to the representative of its cell
+ * and is built the first time the level is used.
+ *
+ * The data is cached per element and rebuilt when the edit stamp of the
+ * owning structure changes. Exact geometry is always used for picking,
+ * hardcopies and geometry export.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <float.h>
+#include <math.h>
+#ifdef GLEW
+#include <GL/glew.h>
+#include <GL/gl.h>
+#else
+#include <epoxy/gl.h>
+#endif
+
+#include "phg.h"
+#include "private/phgP.h"
+#include "ws.h"
+#include "private/wsxP.h"
+#include "private/wsglP.h"
+#include "private/fasd3P.h"
+#include "private/sofas3P.h"
+#include "util/pack.h"
+
+Pfloat wsgl_lod_tolerance = 0.0;
+
+/*******************************************************************************
+ * wsgl_lod_exact
+ *
+ * DESCR:	Check if the exact geometry has to be drawn
+ * RETURNS:	TRUE for exact geometry
+ */
+static int wsgl_lod_exact(
+                          Ws *ws
+                          )
+{
+  Wsgl_handle wsgl = ws->render_context;
+
+  if (wsgl_lod_tolerance <= 0.0 ||
+      wsgl->render_mode != WS_RENDER_MODE_DRAW ||
+      record_geom ||
+      wsgl->cur_struct.structp == NULL) {
+    return TRUE;
+  }
+
+  switch (ws->type->ws_type) {
+  case PWST_HCOPY_TRUE_TGA:
+  case PWST_HCOPY_TRUE_RGB_PNG:
+  case PWST_HCOPY_TRUE_RGBA_PNG:
+  case PWST_HCOPY_TRUE_EPS:
+  case PWST_HCOPY_TRUE_PDF:
+  case PWST_HCOPY_TRUE_SVG:
+  case PWST_HCOPY_TRUE_OBJ:
+  case PWST_HCOPY_TRUE_GLB:
+  case PWST_HCOPY_TRUE_PLY:
+    return TRUE;
+  default:
+    break;
+  }
+
+  return FALSE;
+}
+
+/*******************************************************************************
+ * wsgl_lod_mc_tolerance
+ *
+ * DESCR:	Convert the pixel tolerance to modelling coordinates for an
+ *		element with the given bounds. The scaling is an upper bound
+ *		of the derivative of the projected position over the box.
+ * RETURNS:	Tolerance in modelling coordinates, zero if none applies
+ */
+static Pfloat wsgl_lod_mc_tolerance(
+                                    Ws *ws,
+                                    Plimit3 *box
+                                    )
+{
+  static const int rows[3] = {0, 1, 3};
+  Wsgl_handle wsgl = ws->render_context;
+  Ws_xform xform;
+  Pmatrix3 tran;
+  Pfloat w, w_min, sum, norm_1, norm_inf, px;
+  int i, j;
+
+  phg_mat_mul(tran,
+              wsgl->cur_struct.view_rep.map_matrix,
+              wsgl->model_tran);
+
+  w_min = FLT_MAX;
+  for (i = 0; i < 8; i++) {
+    w = tran[3][0] * ((i & 1) ? box->x_max : box->x_min) +
+      tran[3][1] * ((i & 2) ? box->y_max : box->y_min) +
+      tran[3][2] * ((i & 4) ? box->z_max : box->z_min) +
+      tran[3][3];
+    if (w < w_min) {
+      w_min = w;
+    }
+  }
+  if (w_min <= 1.0e-6) {
+    return 0.0;
+  }
+
+  norm_1 = 0.0;
+  for (j = 0; j < 3; j++) {
+    sum = 0.0;
+    for (i = 0; i < 3; i++) {
+      sum += fabs(tran[rows[i]][j]);
+    }
+    if (sum > norm_1) {
+      norm_1 = sum;
+    }
+  }
+  norm_inf = 0.0;
+  for (i = 0; i < 3; i++) {
+    sum = 0.0;
+    for (j = 0; j < 3; j++) {
+      sum += fabs(tran[rows[i]][j]);
+    }
+    if (sum > norm_inf) {
+      norm_inf = sum;
+    }
+  }
+
+  phg_wsx_compute_ws_transform(&wsgl->cur_win, &wsgl->cur_vp, &xform);
+  px = (xform.scale.x > xform.scale.y) ? xform.scale.x : xform.scale.y;
+  px *= sqrt(norm_1 * norm_inf) / w_min;
+  if (px <= 0.0) {
+    return 0.0;
+  }
+
+  return wsgl_lod_tolerance / px;
+}
+
+/*******************************************************************************
+ * wsgl_lod_vertex
+ *
+ * DESCR:	Get a vertex of facet vertex data
+ * RETURNS:	Pointer to the vertex coordinates
+ */
+static Ppoint3 *wsgl_lod_vertex(
+                                Pint vflag,
+                                Pfacet_vdata_arr3 *vdata,
+                                Pint i
+                                )
+{
+  switch (vflag) {
+  case PVERT_COORD_COLOUR:
+    return &vdata->ptcolrs[i].point;
+  case PVERT_COORD_NORMAL:
+    return &vdata->ptnorms[i].point;
+  case PVERT_COORD_COLOUR_NORMAL:
+    return &vdata->ptconorms[i].point;
+  default:
+    return &vdata->points[i];
+  }
+}
+
+/*******************************************************************************
+ * wsgl_lod_add_box
+ *
+ * DESCR:	Extend bounds by a point
+ * RETURNS:	N/A
+ */
+static void wsgl_lod_add_box(
+                             Plimit3 *box,
+                             Ppoint3 *p,
+                             int first
+                             )
+{
+  if (first) {
+    box->x_min = box->x_max = p->x;
+    box->y_min = box->y_max = p->y;
+    box->z_min = box->z_max = p->z;
+    return;
+  }
+  if (p->x < box->x_min) box->x_min = p->x;
+  if (p->x > box->x_max) box->x_max = p->x;
+  if (p->y < box->y_min) box->y_min = p->y;
+  if (p->y > box->y_max) box->y_max = p->y;
+  if (p->z < box->z_min) box->z_min = p->z;
+  if (p->z > box->z_max) box->z_max = p->z;
+}
+
+/*******************************************************************************
+ * wsgl_lod_cell_size
+ *
+ * DESCR:	Cell size of a clustering level, each level doubles the last
+ * RETURNS:	Cell size in modelling coordinates
+ */
+static Pfloat wsgl_lod_cell_size(
+                                 Plimit3 *box,
+                                 int level
+                                 )
+{
+  Pfloat dx = box->x_max - box->x_min;
+  Pfloat dy = box->y_max - box->y_min;
+  Pfloat dz = box->z_max - box->z_min;
+
+  return sqrt(dx * dx + dy * dy + dz * dz) *
+    ldexp(1.0, level - WS_LOD_LEVELS - 2);
+}
+
+/*******************************************************************************
+ * wsgl_lod_cell
+ *
+ * DESCR:	Cell of a point on a clustering grid
+ * RETURNS:	Packed cell coordinates
+ */
+static uint64_t wsgl_lod_cell(
+                              Plimit3 *box,
+                              Pfloat size,
+                              Ppoint3 *p
+                              )
+{
+  uint64_t ix, iy, iz;
+
+  ix = (uint64_t) ((p->x - box->x_min) / size);
+  iy = (uint64_t) ((p->y - box->y_min) / size);
+  iz = (uint64_t) ((p->z - box->z_min) / size);
+
+  return ix | (iy << 21) | (iz << 42);
+}
+
+/*******************************************************************************
+ * wsgl_lod_seg_dist
+ *
+ * DESCR:	Distance of a point from a line segment
+ * RETURNS:	Distance
+ */
+static Pfloat wsgl_lod_seg_dist(
+                                Ppoint3 *p,
+                                Ppoint3 *a,
+                                Ppoint3 *b
+                                )
+{
+  Pfloat dx, dy, dz, ex, ey, ez, len, t;
+
+  dx = b->x - a->x;
+  dy = b->y - a->y;
+  dz = b->z - a->z;
+  ex = p->x - a->x;
+  ey = p->y - a->y;
+  ez = p->z - a->z;
+  len = dx * dx + dy * dy + dz * dz;
+  if (len > 0.0) {
+    t = (ex * dx + ey * dy + ez * dz) / len;
+    if (t > 1.0) {
+      t = 1.0;
+    }
+    else if (t < 0.0) {
+      t = 0.0;
+    }
+    ex -= t * dx;
+    ey -= t * dy;
+    ez -= t * dz;
+  }
+
+  return sqrt(ex * ex + ey * ey + ez * ez);
+}
+
+/*******************************************************************************
+ * wsgl_lod_build_polyline
+ *
+ * DESCR:	Compute the Douglas-Peucker error of every polyline vertex.
+ *		Polylines are drawn as separate segments, consecutive
+ *		segments sharing an end point form one chain. Chain end
+ *		points get FLT_MAX, repeated start points get -1.
+ * RETURNS:	TRUE on success
+ */
+static int wsgl_lod_build_polyline(
+                                   Ws_lod *lod,
+                                   Ppoint3 *pts
+                                   )
+{
+  Pint num = lod->num_vertices;
+  Pint *seq, *sa, *sb;
+  Pfloat *se, err, d, dmax;
+  Pint j, m, a, b, i, imax, sp;
+
+  lod->error = (Pfloat *) malloc(num * sizeof(Pfloat));
+  seq = (Pint *) malloc(num * 3 * sizeof(Pint));
+  se = (Pfloat *) malloc(num * sizeof(Pfloat));
+  if (lod->error == NULL || seq == NULL || se == NULL) {
+    free(seq);
+    free(se);
+    return FALSE;
+  }
+  sa = &seq[num];
+  sb = &sa[num];
+
+  for (i = 0; i < num; i++) {
+    lod->error[i] = -1.0;
+  }
+  for (i = 0; i < num; i++) {
+    wsgl_lod_add_box(&lod->box, &pts[i], i == 0);
+  }
+
+  j = 0;
+  while (2 * j + 1 < num) {
+    m = 0;
+    seq[m++] = 2 * j;
+    seq[m++] = 2 * j + 1;
+    while (2 * j + 3 < num &&
+           memcmp(&pts[2 * j + 1], &pts[2 * j + 2], sizeof(Ppoint3)) == 0) {
+      j++;
+      seq[m++] = 2 * j + 1;
+    }
+    j++;
+
+    lod->error[seq[0]] = FLT_MAX;
+    lod->error[seq[m - 1]] = FLT_MAX;
+    sp = 0;
+    sa[sp] = 0;
+    sb[sp] = m - 1;
+    se[sp] = FLT_MAX;
+    sp++;
+    while (sp > 0) {
+      sp--;
+      a = sa[sp];
+      b = sb[sp];
+      err = se[sp];
+      if (b - a < 2) {
+        continue;
+      }
+      dmax = -1.0;
+      imax = a + 1;
+      for (i = a + 1; i < b; i++) {
+        d = wsgl_lod_seg_dist(&pts[seq[i]], &pts[seq[a]], &pts[seq[b]]);
+        if (d > dmax) {
+          dmax = d;
+          imax = i;
+        }
+      }
+      if (dmax < err) {
+        err = dmax;
+      }
+      lod->error[seq[imax]] = err;
+      sa[sp] = a;
+      sb[sp] = imax;
+      se[sp] = err;
+      sp++;
+      sa[sp] = imax;
+      sb[sp] = b;
+      se[sp] = err;
+      sp++;
+    }
+  }
+
+  free(seq);
+  free(se);
+  return TRUE;
+}
+
+/*******************************************************************************
+ * wsgl_lod_build_fasd3
+ *
+ * DESCR:	Mark the vertices of each facet kept on each clustering level.
+ *		A vertex is dropped when it falls into the cell of the last
+ *		kept vertex of its facet.
+ * RETURNS:	TRUE on success
+ */
+static int wsgl_lod_build_fasd3(
+                                Ws_lod *lod,
+                                void *pdata
+                                )
+{
+  Pfasd3 fasd3;
+  Pedge_data_list edata;
+  Pfacet_vdata_list3 vdata;
+  Pfloat size[WS_LOD_LEVELS];
+  uint64_t last[WS_LOD_LEVELS], cell;
+  Ppoint3 *p;
+  Pint f, i, v;
+  int k;
+
+  lod->keep = (unsigned char *) malloc(lod->num_vertices);
+  if (lod->keep == NULL) {
+    return FALSE;
+  }
+
+  fasd3.edata = &edata;
+  fasd3.vdata = &vdata;
+  fasd3_head(&fasd3, pdata);
+  for (f = 0, v = 0; f < fasd3.nfa; f++) {
+    for (i = 0; i < vdata.num_vertices; i++, v++) {
+      p = wsgl_lod_vertex(fasd3.vflag, &vdata.vertex_data, i);
+      wsgl_lod_add_box(&lod->box, p, v == 0);
+    }
+    if (f < fasd3.nfa - 1) {
+      fasd3_next_vdata3(&fasd3);
+    }
+  }
+
+  for (k = 0; k < WS_LOD_LEVELS; k++) {
+    size[k] = wsgl_lod_cell_size(&lod->box, k);
+    if (size[k] <= 0.0) {
+      return FALSE;
+    }
+  }
+
+  fasd3_head(&fasd3, pdata);
+  for (f = 0, v = 0; f < fasd3.nfa; f++) {
+    for (i = 0; i < vdata.num_vertices; i++, v++) {
+      p = wsgl_lod_vertex(fasd3.vflag, &vdata.vertex_data, i);
+      lod->keep[v] = 0;
+      for (k = 0; k < WS_LOD_LEVELS; k++) {
+        cell = wsgl_lod_cell(&lod->box, size[k], p);
+        if (i == 0 || cell != last[k]) {
+          lod->keep[v] |= 1 << k;
+          last[k] = cell;
+        }
+      }
+    }
+    if (f < fasd3.nfa - 1) {
+      fasd3_next_vdata3(&fasd3);
+    }
+  }
+
+  return TRUE;
+}
+
+/*******************************************************************************
+ * wsgl_lod_build_remap
+ *
+ * DESCR:	Map each vertex of a set of fill area set to the first vertex
+ *		sharing its cell on a clustering level
+ * RETURNS:	Vertex map or NULL on error
+ */
+static Pint *wsgl_lod_build_remap(
+                                  Ws_lod *lod,
+                                  Psofas3 *sofas3,
+                                  int level
+                                  )
+{
+  Pint *remap, *rep;
+  uint64_t *cells, cell;
+  size_t size, mask, h;
+  Pfloat cell_size;
+  Ppoint3 *p;
+  Pint i;
+
+  cell_size = wsgl_lod_cell_size(&lod->box, level);
+  if (cell_size <= 0.0) {
+    return NULL;
+  }
+
+  for (size = 16; size < 2 * (size_t) lod->num_vertices; size <<= 1)
+    ;
+  mask = size - 1;
+  remap = (Pint *) malloc(lod->num_vertices * sizeof(Pint));
+  rep = (Pint *) malloc(size * sizeof(Pint));
+  cells = (uint64_t *) malloc(size * sizeof(uint64_t));
+  if (remap == NULL || rep == NULL || cells == NULL) {
+    free(remap);
+    free(rep);
+    free(cells);
+    return NULL;
+  }
+  for (h = 0; h < size; h++) {
+    rep[h] = -1;
+  }
+
+  for (i = 0; i < lod->num_vertices; i++) {
+    p = wsgl_lod_vertex(sofas3->vflag, &sofas3->vdata.vertex_data, i);
+    cell = wsgl_lod_cell(&lod->box, cell_size, p);
+    h = (size_t) ((cell * 0x9e3779b97f4a7c15ULL) >> 32) & mask;
+    while (rep[h] != -1 && cells[h] != cell) {
+      h = (h + 1) & mask;
+    }
+    if (rep[h] == -1) {
+      rep[h] = i;
+      cells[h] = cell;
+    }
+    remap[i] = rep[h];
+  }
+
+  free(rep);
+  free(cells);
+  return remap;
+}
+
+/*******************************************************************************
+ * wsgl_lod_free
+ *
+ * DESCR:	Free a chain of level of detail data
+ * RETURNS:	N/A
+ */
+static void wsgl_lod_free(
+                          int hash,
+                          caddr_t data
+                          )
+{
+  Ws_lod *lod, *next;
+  int k;
+
+  for (lod = (Ws_lod *) data; lod != NULL; lod = next) {
+    next = lod->next;
+    free(lod->error);
+    free(lod->keep);
+    for (k = 0; k < WS_LOD_LEVELS; k++) {
+      free(lod->remap[k]);
+    }
+    free(lod);
+  }
+}
+
+/*******************************************************************************
+ * wsgl_lod_cache_flush
+ *
+ * DESCR:	Discard all level of detail data. If the new table can not
+ *		be allocated level of detail stays disabled.
+ * RETURNS:	N/A
+ */
+void wsgl_lod_cache_flush(
+                          Ws *ws
+                          )
+{
+  Wsgl_handle wsgl = ws->render_context;
+
+  if (wsgl->lod_cache != NULL && wsgl->lod_cache_entries > 0) {
+    phg_htab_destroy(wsgl->lod_cache, wsgl_lod_free);
+    wsgl->lod_cache = phg_htab_create(WS_LOD_HASH_SIZE);
+    wsgl->lod_cache_entries = 0;
+  }
+}
+
+/*******************************************************************************
+ * wsgl_lod_get
+ *
+ * DESCR:	Find the level of detail data of an element, building it
+ *		if it is missing or out of date
+ * RETURNS:	Level of detail data or NULL to draw at full detail
+ */
+static Ws_lod *wsgl_lod_get(
+                            Ws *ws,
+                            El_handle el,
+                            Pint num_vertices
+                            )
+{
+  Wsgl_handle wsgl = ws->render_context;
+  unsigned long stamp = wsgl->cur_struct.structp->edit_stamp;
+  int hash = (int) (((uintptr_t) el >> 4) & 0x7fffffff);
+  Ppoint3 *pts;
+  Ppoint *pts2;
+  Pfloat *x;
+  Pint *data;
+  caddr_t chain;
+  Ws_lod *lod;
+  int status, i;
+
+  if (wsgl->lod_cache == NULL) {
+    return NULL;
+  }
+  if (phg_htab_get_entry(wsgl->lod_cache, hash, &chain)) {
+    for (lod = (Ws_lod *) chain; lod != NULL; lod = lod->next) {
+      if (lod->el == el) {
+        if (lod->edit_stamp == stamp &&
+            lod->num_vertices == num_vertices) {
+          return lod;
+        }
+        /* stale, the element changed since the data was built */
+        break;
+      }
+    }
+  }
+
+  /* keep the cache bounded, a rebuild is cheap compared to drawing */
+  if (wsgl->lod_cache_entries >= WS_LOD_MAX) {
+    wsgl_lod_cache_flush(ws);
+    if (wsgl->lod_cache == NULL) {
+      return NULL;
+    }
+  }
+
+  lod = (Ws_lod *) calloc(1, sizeof(Ws_lod));
+  if (lod == NULL) {
+    return NULL;
+  }
+  lod->el = el;
+  lod->edit_stamp = stamp;
+  lod->num_vertices = num_vertices;
+
+  data = (Pint *) ELMT_CONTENT(el);
+  switch (el->eltype) {
+  case PELEM_POLYLINE:
+    pts = (Ppoint3 *) malloc(num_vertices * sizeof(Ppoint3));
+    status = (pts != NULL);
+    if (status) {
+      pts2 = (Ppoint *) &data[1];
+      for (i = 0; i < num_vertices; i++) {
+        pts[i].x = pts2[i].x;
+        pts[i].y = pts2[i].y;
+        pts[i].z = 0.0;
+      }
+      status = wsgl_lod_build_polyline(lod, pts);
+      free(pts);
+    }
+    break;
+
+  case PELEM_POLYLINE3:
+    status = wsgl_lod_build_polyline(lod, (Ppoint3 *) &data[1]);
+    break;
+
+  case PELEM_POLYLINE3_SOA:
+    pts = (Ppoint3 *) malloc(num_vertices * sizeof(Ppoint3));
+    status = (pts != NULL);
+    if (status) {
+      x = (Pfloat *) &data[1];
+      phg_pack_points3(pts, x, &x[num_vertices], &x[2 * num_vertices],
+                       num_vertices);
+      status = wsgl_lod_build_polyline(lod, pts);
+      free(pts);
+    }
+    break;
+
+  case PELEM_FILL_AREA_SET3_DATA:
+    status = wsgl_lod_build_fasd3(lod, data);
+    break;
+
+  case PELEM_SET_OF_FILL_AREA_SET3_DATA:
+    {
+      Psofas3 sofas3;
+
+      sofas3_head(&sofas3, data);
+      for (i = 0; i < num_vertices; i++) {
+        wsgl_lod_add_box(&lod->box,
+                         wsgl_lod_vertex(sofas3.vflag,
+                                         &sofas3.vdata.vertex_data,
+                                         i),
+                         i == 0);
+      }
+      status = TRUE;
+    }
+    break;
+
+  default:
+    status = FALSE;
+    break;
+  }
+
+  if (!status) {
+    wsgl_lod_free(0, (caddr_t) lod);
+    return NULL;
+  }
+
+  /* a stale entry with the same element is replaced at the chain head */
+  if (phg_htab_get_entry(wsgl->lod_cache, hash, &chain)) {
+    Ws_lod **prev;
+    Ws_lod *old;
+
+    lod->next = (Ws_lod *) chain;
+    for (prev = &lod->next; *prev != NULL; prev = &(*prev)->next) {
+      if ((*prev)->el == el) {
+        old = *prev;
+        *prev = old->next;
+        old->next = NULL;
+        wsgl_lod_free(0, (caddr_t) old);
+        wsgl->lod_cache_entries--;
+        break;
+      }
+    }
+    phg_htab_change_data(wsgl->lod_cache, hash, (caddr_t) lod);
+  }
+  else {
+    lod->next = NULL;
+    if (!phg_htab_add_entry(wsgl->lod_cache, hash, (caddr_t) lod)) {
+      wsgl_lod_free(0, (caddr_t) lod);
+      return NULL;
+    }
+  }
+  wsgl->lod_cache_entries++;
+
+  return lod;
+}
+
+/*******************************************************************************
+ * wsgl_lod_num_vertices
+ *
+ * DESCR:	Count the vertices of an element
+ * RETURNS:	Number of vertices
+ */
+static Pint wsgl_lod_num_vertices(
+                                  El_handle el
+                                  )
+{
+  Pint *data = (Pint *) ELMT_CONTENT(el);
+  Pfasd3 fasd3;
+  Psofas3 sofas3;
+  Pedge_data_list edata;
+  Pfacet_vdata_list3 vdata;
+  Pint f, num = 0;
+
+  switch (el->eltype) {
+  case PELEM_POLYLINE:
+  case PELEM_POLYLINE3:
+  case PELEM_POLYLINE3_SOA:
+    num = data[0];
+    break;
+
+  case PELEM_FILL_AREA_SET3_DATA:
+    fasd3.edata = &edata;
+    fasd3.vdata = &vdata;
+    fasd3_head(&fasd3, data);
+    for (f = 0; f < fasd3.nfa; f++) {
+      num += vdata.num_vertices;
+      if (f < fasd3.nfa - 1) {
+        fasd3_next_vdata3(&fasd3);
+      }
+    }
+    break;
+
+  case PELEM_SET_OF_FILL_AREA_SET3_DATA:
+    sofas3_head(&sofas3, data);
+    num = sofas3.vdata.num_vertices;
+    break;
+
+  default:
+    break;
+  }
+
+  return num;
+}
+
+/*******************************************************************************
+ * wsgl_lod_polyline
+ *
+ * DESCR:	Draw a polyline or polyline 3 element with the level of
+ *		detail matching its current size on the screen
+ * RETURNS:	TRUE if drawn, FALSE if the exact geometry shall be drawn
+ */
+int wsgl_lod_polyline(
+                      Ws *ws,
+                      El_handle el,
+                      Ws_attr_st *ast
+                      )
+{
+  Pint *data = (Pint *) ELMT_CONTENT(el);
+  Pint num = data[0];
+  Ppoint *pts2 = (Ppoint *) &data[1];
+  Ppoint3 *pts3 = (Ppoint3 *) &data[1];
+  Pfloat *x = (Pfloat *) &data[1];
+  Pfloat *y = &x[num];
+  Pfloat *z = &y[num];
+  Ws_lod *lod;
+  Pfloat tol;
+  Pint j, a, b, last;
+
+  if (num < WS_LOD_MIN_VERTICES || wsgl_lod_exact(ws)) {
+    return FALSE;
+  }
+  lod = wsgl_lod_get(ws, el, num);
+  if (lod == NULL) {
+    return FALSE;
+  }
+  tol = wsgl_lod_mc_tolerance(ws, &lod->box);
+  if (tol <= 0.0) {
+    return FALSE;
+  }
+
+  wsgl_setup_line_attr(ast);
+  glBegin(GL_LINES);
+  last = 0;
+  for (j = 0; 2 * j + 1 < num; j++) {
+    a = 2 * j;
+    b = a + 1;
+    if (lod->error[a] >= 0.0) {
+      last = a;
+    }
+    if (lod->error[b] > tol) {
+      if (el->eltype == PELEM_POLYLINE) {
+        glVertex2f(pts2[last].x, pts2[last].y);
+        glVertex2f(pts2[b].x, pts2[b].y);
+      }
+      else if (el->eltype == PELEM_POLYLINE3_SOA) {
+        glVertex3f(x[last], y[last], z[last]);
+        glVertex3f(x[b], y[b], z[b]);
+      }
+      else {
+        glVertex3f(pts3[last].x, pts3[last].y, pts3[last].z);
+        glVertex3f(pts3[b].x, pts3[b].y, pts3[b].z);
+      }
+      last = b;
+    }
+  }
+  glEnd();
+
+  return TRUE;
+}
+
+/*******************************************************************************
+ * wsgl_lod_begin
+ *
+ * DESCR:	Select the level of detail for the fill of a fill area set 3
+ *		with data or set of fill area set 3 with data element. The
+ *		fill functions pick the selection up from the render context.
+ * RETURNS:	N/A
+ */
+void wsgl_lod_begin(
+                    Ws *ws,
+                    El_handle el
+                    )
+{
+  Wsgl_handle wsgl = ws->render_context;
+  Psofas3 sofas3;
+  Ws_lod *lod;
+  Pfloat tol;
+  Pint num;
+  int k, level;
+
+  wsgl->lod_keep = NULL;
+  wsgl->lod_remap = NULL;
+  if (wsgl_lod_exact(ws)) {
+    return;
+  }
+  num = wsgl_lod_num_vertices(el);
+  if (num < WS_LOD_MIN_VERTICES) {
+    return;
+  }
+  lod = wsgl_lod_get(ws, el, num);
+  if (lod == NULL) {
+    return;
+  }
+  tol = wsgl_lod_mc_tolerance(ws, &lod->box);
+
+  /* coarsest level with cells below the tolerance */
+  level = -1;
+  for (k = 0; k < WS_LOD_LEVELS; k++) {
+    if (wsgl_lod_cell_size(&lod->box, k) <= tol) {
+      level = k;
+    }
+  }
+  if (level < 0) {
+    return;
+  }
+
+  if (el->eltype == PELEM_FILL_AREA_SET3_DATA) {
+    wsgl->lod_keep = lod->keep;
+    wsgl->lod_bit = 1 << level;
+  }
+  else {
+    if (lod->remap[level] == NULL) {
+      sofas3_head(&sofas3, ELMT_CONTENT(el));
+      lod->remap[level] = wsgl_lod_build_remap(lod, &sofas3, level);
+    }
+    wsgl->lod_remap = lod->remap[level];
+  }
+}
+
+/*******************************************************************************
+ * wsgl_lod_end
+ *
+ * DESCR:	Return to exact geometry after wsgl_lod_begin
+ * RETURNS:	N/A
+ */
+void wsgl_lod_end(
+                  Ws *ws
+                  )
+{
+  Wsgl_handle wsgl = ws->render_context;
+
+  wsgl->lod_keep = NULL;
+  wsgl->lod_remap = NULL;
+}
@@ -24,7 +24,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#ifdef GLEW
+#include <GL/glew.h>
 #include <GL/gl.h>
+#else
+#include <epoxy/gl.h>
+#endif
 
 #include "phg.h"
 #include "private/phgP.h"
@@ -33,6 +38,15 @@
 
 #define PI 3.1415926535897932384626433832795
 
+/* marker shapes known to the fragment shader */
+#define WS_MARKER_SHAPE_NONE     0
+#define WS_MARKER_SHAPE_PLUS     1
+#define WS_MARKER_SHAPE_ASTERISK 2
+#define WS_MARKER_SHAPE_CROSS    3
+#define WS_MARKER_SHAPE_POLYGON  4
+
+extern GLint marker_shape, marker_corners, marker_size, marker_viewport;
+
 /*******************************************************************************
  * wsgl_marker_dot
  *
@@ -183,16 +197,236 @@ static void wsgl_marker_polygon(
    glLineWidth(1.0);
    glDisable(GL_LINE_STIPPLE);
    dalpha = 2.0*PI/(float)n;
-   glBegin(GL_TRIANGLE_FAN);
    for (i = 0; i < point_list->num_points; i++) {
      alpha = dalpha/2.0;
+     glBegin(GL_TRIANGLE_FAN);
      for (j = 0; j < n; j++){
        glVertex2f(point_list->points[i].x + scale*cos(alpha),
 		  point_list->points[i].y + scale*sin(alpha));
        alpha += dalpha;
      }
+     glEnd();
+   }
+}
+
+/*******************************************************************************
+ * wsgl_marker_vec_line
+ *
+ * DESCR:	Record one marker stroke for vector hardcopy helper function
+ * RETURNS:	N/A
+ */
+
+static void wsgl_marker_vec_line(
+   float x0,
+   float y0,
+   float x1,
+   float y1,
+   float z
+   )
+{
+   wsgl_vec_vertex(x0, y0, z);
+   wsgl_vec_vertex(x1, y1, z);
+   wsgl_vec_geometry(GEOM_LINE);
+}
+
+/*******************************************************************************
+ * wsgl_marker_vec
+ *
+ * DESCR:	Record markers for vector hardcopy with the same glyphs as the
+ *		geometry drawn by OpenGL, dots as squares of their pixel size
+ * RETURNS:	N/A
+ */
+
+static void wsgl_marker_vec(
+   Pint type,
+   Pfloat scale,
+   Pint dim,
+   Pint num_points,
+   Pfloat *points
+   )
+{
+   int i, j, n;
+   float x, y, z;
+   float half_scale, small_scale;
+   float alpha, dalpha;
+
+   half_scale = scale / 2.0;
+   small_scale = half_scale / 1.414;
+   switch (type) {
+      case PMARKER_CIRCLE:
+         n = 40;
+         break;
+
+      case PMARKER_TRIANG:
+         n = 3;
+         break;
+
+      case PMARKER_SQUARE:
+         n = 4;
+         break;
+
+      case PMARKER_PENTAGON:
+         n = 5;
+         break;
+
+      case PMARKER_HEXAGON:
+         n = 6;
+         break;
+
+      default:
+         n = 0;
+         wsgl_set_current_width(1.0);
+         break;
+   }
+   dalpha = 2.0 * PI / (float) PHG_MAX(n, 1);
+
+   for (i = 0; i < num_points; i++, points += dim) {
+      x = points[0];
+      y = points[1];
+      z = (dim == 3) ? points[2] : 0.0;
+      switch (type) {
+         case PMARKER_DOT:
+            wsgl_vec_dot(x, y, z, scale);
+            break;
+
+         case PMARKER_ASTERISK:
+            wsgl_marker_vec_line(x - small_scale, y + small_scale,
+                                 x + small_scale, y - small_scale, z);
+            wsgl_marker_vec_line(x - small_scale, y - small_scale,
+                                 x + small_scale, y + small_scale, z);
+            /* fall through for the plus */
+         case PMARKER_PLUS:
+            wsgl_marker_vec_line(x - half_scale, y, x + half_scale, y, z);
+            wsgl_marker_vec_line(x, y - half_scale, x, y + half_scale, z);
+            break;
+
+         case PMARKER_CROSS:
+            wsgl_marker_vec_line(x - half_scale, y + half_scale,
+                                 x + half_scale, y - half_scale, z);
+            wsgl_marker_vec_line(x - half_scale, y - half_scale,
+                                 x + half_scale, y + half_scale, z);
+            break;
+
+         default:
+            if (n > 0) {
+               alpha = dalpha / 2.0;
+               for (j = 0; j < n; j++) {
+                  wsgl_vec_vertex(x + scale * cos(alpha),
+                                  y + scale * sin(alpha),
+                                  z);
+                  alpha += dalpha;
+               }
+               wsgl_vec_geometry(GEOM_FACE);
+            }
+            break;
+      }
    }
-   glEnd();
+}
+
+/*******************************************************************************
+ * wsgl_marker_sprites
+ *
+ * DESCR:	Draw markers as point sprites. The marker positions are passed
+ *		as one vertex array and the shapes are rasterized by the
+ *		fragment shader. Falls back to geometry when shaders are off,
+ *		when picking or when rendering into a feedback buffer.
+ * RETURNS:	TRUE if the markers were drawn, otherwise FALSE
+ */
+
+static int wsgl_marker_sprites(
+   Ws *ws,
+   Pint type,
+   Pfloat scale,
+   Pint dim,
+   Pint num_points,
+   void *points
+   )
+{
+   Wsgl_handle wsgl = ws->render_context;
+   GLint render_mode;
+   GLint viewport[4];
+   Pint shape, corners;
+
+#ifdef GLEW
+   if (!wsgl_use_shaders || !GLEW_ARB_vertex_shader || !GLEW_ARB_fragment_shader || !GLEW_ARB_shader_objects)
+#else
+   if (!wsgl_use_shaders)
+#endif
+   {
+      return FALSE;
+   }
+   if (!wsgl_use_marker_sprites ||
+       (wsgl->render_mode != WS_RENDER_MODE_DRAW)) {
+      return FALSE;
+   }
+
+   /* vector hardcopy collects geometry in feedback mode */
+   glGetIntegerv(GL_RENDER_MODE, &render_mode);
+   if (render_mode != GL_RENDER) {
+      return FALSE;
+   }
+
+   corners = 0;
+   switch (type) {
+      case PMARKER_PLUS:
+         shape = WS_MARKER_SHAPE_PLUS;
+         break;
+
+      case PMARKER_ASTERISK:
+         shape = WS_MARKER_SHAPE_ASTERISK;
+         break;
+
+      case PMARKER_CROSS:
+         shape = WS_MARKER_SHAPE_CROSS;
+         break;
+
+      case PMARKER_CIRCLE:
+         shape = WS_MARKER_SHAPE_POLYGON;
+         corners = 40;
+         break;
+
+      case PMARKER_TRIANG:
+         shape = WS_MARKER_SHAPE_POLYGON;
+         corners = 3;
+         break;
+
+      case PMARKER_SQUARE:
+         shape = WS_MARKER_SHAPE_POLYGON;
+         corners = 4;
+         break;
+
+      case PMARKER_PENTAGON:
+         shape = WS_MARKER_SHAPE_POLYGON;
+         corners = 5;
+         break;
+
+      case PMARKER_HEXAGON:
+         shape = WS_MARKER_SHAPE_POLYGON;
+         corners = 6;
+         break;
+
+      default:
+         return FALSE;
+   }
+
+   glGetIntegerv(GL_VIEWPORT, viewport);
+   glUniform1i(marker_shape, shape);
+   glUniform1i(marker_corners, corners);
+   glUniform1f(marker_size, scale);
+   glUniform2f(marker_viewport, (GLfloat) viewport[2], (GLfloat) viewport[3]);
+
+   glDisable(GL_LINE_STIPPLE);
+   glEnable(GL_VERTEX_PROGRAM_POINT_SIZE);
+   glEnable(GL_POINT_SPRITE);
+   glEnableClientState(GL_VERTEX_ARRAY);
+   glVertexPointer(dim, GL_FLOAT, 0, points);
+   glDrawArrays(GL_POINTS, 0, num_points);
+   glDisableClientState(GL_VERTEX_ARRAY);
+   glDisable(GL_POINT_SPRITE);
+   glDisable(GL_VERTEX_PROGRAM_POINT_SIZE);
+   glUniform1i(marker_shape, WS_MARKER_SHAPE_NONE);
+
+   return TRUE;
 }
 
 /*******************************************************************************
@@ -217,6 +451,14 @@ void wsgl_polymarker(
    point_list.points = (Ppoint *) &data[1];
 
    wsgl_setup_marker_attr(ast, &type, &size);
+   if (record_vec) {
+      wsgl_marker_vec(type, size, 2,
+                      point_list.num_points, (Pfloat *) point_list.points);
+   }
+   if (wsgl_marker_sprites(ws, type, size, 2,
+                           point_list.num_points, point_list.points)) {
+      return;
+   }
    switch (type) {
       case PMARKER_DOT:
 	wsgl_marker_dot(&point_list, size);
@@ -280,6 +522,15 @@ void wsgl_polymarker3(
    point_list.points = (Ppoint3 *) &data[1];
 
    wsgl_setup_line_attr(ast);
+   wsgl_setup_marker_attr(ast, &type, &size);
+   if (record_vec) {
+      wsgl_marker_vec(type, size, 3,
+                      point_list.num_points, (Pfloat *) point_list.points);
+   }
+   if (wsgl_marker_sprites(ws, type, size, 3,
+                           point_list.num_points, point_list.points)) {
+      return;
+   }
 
    if (PHG_SCRATCH_SPACE(&ws->scratch,
                          point_list.num_points * sizeof(Ppoint))) {
@@ -291,7 +542,6 @@ void wsgl_polymarker3(
          plist.points[i].y = point_list.points[i].y;
       }
 
-      wsgl_setup_marker_attr(ast, &type, &size);
       switch (type) {
       case PMARKER_DOT:
 	wsgl_marker_dot(&plist, size);
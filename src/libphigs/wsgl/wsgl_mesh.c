@@ -0,0 +1,700 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************
+* Changes:   Copyright (C) 2022-2023 CERN
+******************************************************************************/
+
+/*
+ * Binary mesh export.
+ *
+ * The primitives recorded for OBJ export can be collected as an indexed
+ * mesh instead and written as binary glTF (GLB) or binary little endian
+ * PLY. Every vertex carries position, normal and colour, identical
+ * vertices are shared. Faces are split into triangle fans, polylines into
+ * line segments. Both formats need the element counts before the data,
+ * so the mesh is kept in memory and written when the workstation closes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <math.h>
+#ifdef GLEW
+#include <GL/glew.h>
+#else
+#include <epoxy/gl.h>
+#endif
+#include "phg.h"
+#include "private/phgP.h"
+#include "private/wsglP.h"
+
+#define MESH_JSON_SIZE 8192
+#define MESH_IO_WORDS  16384
+
+#define GLB_MAGIC      0x46546C67
+#define GLB_CHUNK_JSON 0x4E4F534A
+#define GLB_CHUNK_BIN  0x004E4942
+
+#define GLTF_UNSIGNED_INT 5125
+#define GLTF_FLOAT        5126
+#define GLTF_LINES        1
+#define GLTF_TRIANGLES    4
+
+typedef struct {
+  float pos[3];
+  float norm[3];
+  float colr[3];
+} Mesh_vertex;
+
+typedef struct {
+  float *pos;                    /* three floats per vertex each */
+  float *norm;
+  float *colr;
+  int num;
+  int size;
+  unsigned int *slots;           /* deduplication, vertex + 1, 0 empty */
+  unsigned int num_slots;        /* power of two */
+  float min[3];
+  float max[3];
+} Mesh_vertices;
+
+typedef struct {
+  uint32_t *ind;
+  int num;
+  int size;
+} Mesh_indices;
+
+int record_mesh = MESH_NONE;
+
+static char mesh_filename[512];
+static char mesh_title[256];
+static Mesh_vertices mesh_vertices;
+static Mesh_indices mesh_triangles;
+static Mesh_indices mesh_lines;
+static Mesh_vertex *mesh_pending = NULL;
+static int mesh_num_pending = 0;
+static int mesh_size_pending = 0;
+static int mesh_num_normals = 0;
+
+/*******************************************************************************
+ * mesh_vertex_key
+ *
+ * DESCR:       hash of all vertex attributes
+ * RETURNS:     hash value
+ */
+static unsigned int mesh_vertex_key(const Mesh_vertex *v) {
+  uint32_t u[9];
+  unsigned int key = 2166136261u;
+  int i;
+
+  memcpy(u, v, sizeof(u));
+  for (i = 0; i < 9; i++) {
+    key = (key ^ u[i]) * 16777619u;
+  }
+  return key ^ (key >> 15);
+}
+
+/*******************************************************************************
+ * mesh_vertex_equal
+ *
+ * DESCR:       compare vertex with stored vertex
+ * RETURNS:     Non zero if equal
+ */
+static int mesh_vertex_equal(const Mesh_vertex *v, int index) {
+  return (memcmp(v->pos, &mesh_vertices.pos[3 * index], 3 * sizeof(float)) == 0 &&
+          memcmp(v->norm, &mesh_vertices.norm[3 * index], 3 * sizeof(float)) == 0 &&
+          memcmp(v->colr, &mesh_vertices.colr[3 * index], 3 * sizeof(float)) == 0);
+}
+
+/*******************************************************************************
+ * mesh_slots_grow
+ *
+ * DESCR:       double deduplication table and reinsert vertices
+ * RETURNS:     Non zero or zero on error
+ */
+static int mesh_slots_grow(void) {
+  unsigned int size, i, j;
+  unsigned int *slots;
+  Mesh_vertex v;
+
+  size = (mesh_vertices.num_slots == 0) ? 4096 : 2 * mesh_vertices.num_slots;
+  slots = (unsigned int *) calloc(size, sizeof(unsigned int));
+  if (slots == NULL) {
+    return FALSE;
+  }
+  for (i = 0; i < (unsigned int) mesh_vertices.num; i++) {
+    memcpy(v.pos, &mesh_vertices.pos[3 * i], 3 * sizeof(float));
+    memcpy(v.norm, &mesh_vertices.norm[3 * i], 3 * sizeof(float));
+    memcpy(v.colr, &mesh_vertices.colr[3 * i], 3 * sizeof(float));
+    j = mesh_vertex_key(&v) & (size - 1);
+    while (slots[j] != 0) {
+      j = (j + 1) & (size - 1);
+    }
+    slots[j] = i + 1;
+  }
+  free(mesh_vertices.slots);
+  mesh_vertices.slots = slots;
+  mesh_vertices.num_slots = size;
+
+  return TRUE;
+}
+
+/*******************************************************************************
+ * mesh_add_vertex
+ *
+ * DESCR:       add vertex to the mesh unless already there
+ * RETURNS:     Vertex index or -1 on error
+ */
+static int mesh_add_vertex(const Mesh_vertex *v) {
+  unsigned int i;
+  int j, size;
+  float *pos, *norm, *colr;
+
+  if (2 * (unsigned int) (mesh_vertices.num + 1) > mesh_vertices.num_slots &&
+      !mesh_slots_grow()) {
+    return -1;
+  }
+  i = mesh_vertex_key(v) & (mesh_vertices.num_slots - 1);
+  while (mesh_vertices.slots[i] != 0) {
+    if (mesh_vertex_equal(v, mesh_vertices.slots[i] - 1)) {
+      return mesh_vertices.slots[i] - 1;
+    }
+    i = (i + 1) & (mesh_vertices.num_slots - 1);
+  }
+
+  if (mesh_vertices.num >= mesh_vertices.size) {
+    size = (mesh_vertices.size > 0) ? 2 * mesh_vertices.size : 4096;
+    pos = (float *) realloc(mesh_vertices.pos, 3 * size * sizeof(float));
+    if (pos != NULL) mesh_vertices.pos = pos;
+    norm = (float *) realloc(mesh_vertices.norm, 3 * size * sizeof(float));
+    if (norm != NULL) mesh_vertices.norm = norm;
+    colr = (float *) realloc(mesh_vertices.colr, 3 * size * sizeof(float));
+    if (colr != NULL) mesh_vertices.colr = colr;
+    if (pos == NULL || norm == NULL || colr == NULL) {
+      return -1;
+    }
+    mesh_vertices.size = size;
+  }
+
+  memcpy(&mesh_vertices.pos[3 * mesh_vertices.num], v->pos, 3 * sizeof(float));
+  memcpy(&mesh_vertices.norm[3 * mesh_vertices.num], v->norm, 3 * sizeof(float));
+  memcpy(&mesh_vertices.colr[3 * mesh_vertices.num], v->colr, 3 * sizeof(float));
+  for (j = 0; j < 3; j++) {
+    if (mesh_vertices.num == 0 || v->pos[j] < mesh_vertices.min[j]) {
+      mesh_vertices.min[j] = v->pos[j];
+    }
+    if (mesh_vertices.num == 0 || v->pos[j] > mesh_vertices.max[j]) {
+      mesh_vertices.max[j] = v->pos[j];
+    }
+  }
+  mesh_vertices.slots[i] = ++mesh_vertices.num;
+
+  return mesh_vertices.num - 1;
+}
+
+/*******************************************************************************
+ * mesh_add_index
+ *
+ * DESCR:       append index to an index list
+ * RETURNS:     Non zero or zero on error
+ */
+static int mesh_add_index(Mesh_indices *list, int index) {
+  uint32_t *ind;
+  int size;
+
+  if (list->num >= list->size) {
+    size = (list->size > 0) ? 2 * list->size : 4096;
+    ind = (uint32_t *) realloc(list->ind, size * sizeof(uint32_t));
+    if (ind == NULL) {
+      return FALSE;
+    }
+    list->ind = ind;
+    list->size = size;
+  }
+  list->ind[list->num++] = (uint32_t) index;
+
+  return TRUE;
+}
+
+/*******************************************************************************
+ * mesh_normalize
+ *
+ * DESCR:       make normal unit length, as required by glTF
+ * RETURNS:     N/A
+ */
+static void mesh_normalize(float *n) {
+  float len = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+  if (len > 0.0f) {
+    n[0] /= len;
+    n[1] /= len;
+    n[2] /= len;
+  }
+  else {
+    n[0] = 0.0f;
+    n[1] = 0.0f;
+    n[2] = 1.0f;
+  }
+}
+
+/*******************************************************************************
+ * mesh_face_normal
+ *
+ * DESCR:       normal of the pending polygon, Newell's method
+ * RETURNS:     N/A
+ */
+static void mesh_face_normal(float *n) {
+  int i, j;
+  float *a, *b;
+
+  n[0] = n[1] = n[2] = 0.0f;
+  for (i = 0; i < mesh_num_pending; i++) {
+    j = (i + 1) % mesh_num_pending;
+    a = mesh_pending[i].pos;
+    b = mesh_pending[j].pos;
+    n[0] += (a[1] - b[1]) * (a[2] + b[2]);
+    n[1] += (a[2] - b[2]) * (a[0] + b[0]);
+    n[2] += (a[0] - b[0]) * (a[1] + b[1]);
+  }
+  mesh_normalize(n);
+}
+
+/*******************************************************************************
+ * mesh_write32
+ *
+ * DESCR:       write 32 bit words little endian, independent of the host
+ * RETURNS:     N/A
+ */
+static void mesh_write32(FILE *fp, const void *data, size_t num) {
+  static unsigned char buf[4 * MESH_IO_WORDS];
+  const unsigned char *words = (const unsigned char *) data;
+  size_t i, n;
+  uint32_t w;
+
+  while (num > 0) {
+    n = (num < MESH_IO_WORDS) ? num : MESH_IO_WORDS;
+    for (i = 0; i < n; i++) {
+      memcpy(&w, words + 4 * i, sizeof(uint32_t));
+      buf[4 * i]     = (unsigned char) (w & 0xff);
+      buf[4 * i + 1] = (unsigned char) ((w >> 8) & 0xff);
+      buf[4 * i + 2] = (unsigned char) ((w >> 16) & 0xff);
+      buf[4 * i + 3] = (unsigned char) ((w >> 24) & 0xff);
+    }
+    fwrite(buf, 4, n, fp);
+    words += 4 * n;
+    num -= n;
+  }
+}
+
+/*******************************************************************************
+ * mesh_put32
+ *
+ * DESCR:       write one 32 bit word little endian
+ * RETURNS:     N/A
+ */
+static void mesh_put32(FILE *fp, uint32_t w) {
+  mesh_write32(fp, &w, 1);
+}
+
+/*******************************************************************************
+ * mesh_json
+ *
+ * DESCR:       append formatted text to JSON buffer
+ * RETURNS:     N/A
+ */
+static void mesh_json(char *json, const char *fmt, ...) {
+  size_t len = strlen(json);
+  va_list ap;
+
+  va_start(ap, fmt);
+  vsnprintf(json + len, MESH_JSON_SIZE - len, fmt, ap);
+  va_end(ap);
+}
+
+/*******************************************************************************
+ * mesh_json_string
+ *
+ * DESCR:       append JSON string with quotes and escapes
+ * RETURNS:     N/A
+ */
+static void mesh_json_string(char *json, const char *str) {
+  mesh_json(json, "\"");
+  for (; *str != '\0'; str++) {
+    if (*str == '"' || *str == '\\') {
+      mesh_json(json, "\\%c", *str);
+    }
+    else if ((unsigned char) *str < 0x20) {
+      mesh_json(json, "\\u%04x", (unsigned char) *str);
+    }
+    else {
+      mesh_json(json, "%c", *str);
+    }
+  }
+  mesh_json(json, "\"");
+}
+
+/*******************************************************************************
+ * mesh_write_glb
+ *
+ * DESCR:       write mesh as binary glTF 2.0
+ * RETURNS:     N/A
+ */
+static void mesh_write_glb(FILE *fp) {
+  char *json;
+  size_t json_len, bin_len;
+  size_t vsize = 3 * sizeof(float) * mesh_vertices.num;
+  size_t tsize = sizeof(uint32_t) * mesh_triangles.num;
+  size_t lsize = sizeof(uint32_t) * mesh_lines.num;
+  int accessor = 3;
+  int view = 3;
+
+  json = (char *) calloc(MESH_JSON_SIZE, 1);
+  if (json == NULL) {
+    return;
+  }
+  mesh_json(json, "{\"asset\":{\"version\":\"2.0\",\"generator\":\"OpenPHIGS\"}");
+  if (mesh_vertices.num == 0) {
+    mesh_json(json, ",\"scene\":0,\"scenes\":[{}]}");
+    bin_len = 0;
+  }
+  else {
+    mesh_json(json, ",\"scene\":0,\"scenes\":[{\"nodes\":[0]}]");
+    mesh_json(json, ",\"nodes\":[{\"mesh\":0,\"name\":");
+    mesh_json_string(json, mesh_title);
+    mesh_json(json, "}],\"meshes\":[{\"primitives\":[");
+    if (mesh_triangles.num > 0) {
+      mesh_json(json,
+                "{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"COLOR_0\":2},"
+                "\"indices\":%d,\"mode\":%d}",
+                accessor++, GLTF_TRIANGLES);
+    }
+    if (mesh_lines.num > 0) {
+      mesh_json(json,
+                "%s{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"COLOR_0\":2},"
+                "\"indices\":%d,\"mode\":%d}",
+                (mesh_triangles.num > 0) ? "," : "", accessor++, GLTF_LINES);
+    }
+    mesh_json(json, "]}],\"accessors\":[");
+    mesh_json(json,
+              "{\"bufferView\":0,\"componentType\":%d,\"count\":%d,"
+              "\"type\":\"VEC3\",\"min\":[%.9g,%.9g,%.9g],\"max\":[%.9g,%.9g,%.9g]}",
+              GLTF_FLOAT, mesh_vertices.num,
+              mesh_vertices.min[0], mesh_vertices.min[1], mesh_vertices.min[2],
+              mesh_vertices.max[0], mesh_vertices.max[1], mesh_vertices.max[2]);
+    mesh_json(json,
+              ",{\"bufferView\":1,\"componentType\":%d,\"count\":%d,\"type\":\"VEC3\"}",
+              GLTF_FLOAT, mesh_vertices.num);
+    mesh_json(json,
+              ",{\"bufferView\":2,\"componentType\":%d,\"count\":%d,\"type\":\"VEC3\"}",
+              GLTF_FLOAT, mesh_vertices.num);
+    if (mesh_triangles.num > 0) {
+      mesh_json(json,
+                ",{\"bufferView\":%d,\"componentType\":%d,\"count\":%d,\"type\":\"SCALAR\"}",
+                view++, GLTF_UNSIGNED_INT, mesh_triangles.num);
+    }
+    if (mesh_lines.num > 0) {
+      mesh_json(json,
+                ",{\"bufferView\":%d,\"componentType\":%d,\"count\":%d,\"type\":\"SCALAR\"}",
+                view++, GLTF_UNSIGNED_INT, mesh_lines.num);
+    }
+    mesh_json(json, "],\"bufferViews\":[");
+    mesh_json(json, "{\"buffer\":0,\"byteOffset\":0,\"byteLength\":%lu,\"target\":34962}",
+              (unsigned long) vsize);
+    mesh_json(json, ",{\"buffer\":0,\"byteOffset\":%lu,\"byteLength\":%lu,\"target\":34962}",
+              (unsigned long) vsize, (unsigned long) vsize);
+    mesh_json(json, ",{\"buffer\":0,\"byteOffset\":%lu,\"byteLength\":%lu,\"target\":34962}",
+              (unsigned long) (2 * vsize), (unsigned long) vsize);
+    if (mesh_triangles.num > 0) {
+      mesh_json(json, ",{\"buffer\":0,\"byteOffset\":%lu,\"byteLength\":%lu,\"target\":34963}",
+                (unsigned long) (3 * vsize), (unsigned long) tsize);
+    }
+    if (mesh_lines.num > 0) {
+      mesh_json(json, ",{\"buffer\":0,\"byteOffset\":%lu,\"byteLength\":%lu,\"target\":34963}",
+                (unsigned long) (3 * vsize + tsize), (unsigned long) lsize);
+    }
+    bin_len = 3 * vsize + tsize + lsize;
+    mesh_json(json, "],\"buffers\":[{\"byteLength\":%lu}]}", (unsigned long) bin_len);
+  }
+
+  /* chunks are padded to four bytes, JSON with spaces */
+  json_len = strlen(json);
+  while (json_len % 4 != 0 && json_len < MESH_JSON_SIZE - 1) {
+    json[json_len++] = ' ';
+  }
+
+  mesh_put32(fp, GLB_MAGIC);
+  mesh_put32(fp, 2);
+  mesh_put32(fp, 12 + 8 + json_len + ((bin_len > 0) ? 8 + bin_len : 0));
+  mesh_put32(fp, json_len);
+  mesh_put32(fp, GLB_CHUNK_JSON);
+  fwrite(json, 1, json_len, fp);
+  if (bin_len > 0) {
+    mesh_put32(fp, bin_len);
+    mesh_put32(fp, GLB_CHUNK_BIN);
+    mesh_write32(fp, mesh_vertices.pos, 3 * mesh_vertices.num);
+    mesh_write32(fp, mesh_vertices.norm, 3 * mesh_vertices.num);
+    mesh_write32(fp, mesh_vertices.colr, 3 * mesh_vertices.num);
+    mesh_write32(fp, mesh_triangles.ind, mesh_triangles.num);
+    mesh_write32(fp, mesh_lines.ind, mesh_lines.num);
+  }
+  free(json);
+}
+
+/*******************************************************************************
+ * mesh_write_ply
+ *
+ * DESCR:       write mesh as binary little endian PLY
+ * RETURNS:     N/A
+ */
+static void mesh_write_ply(FILE *fp) {
+  int i, j;
+  unsigned char c;
+  uint32_t tri[3];
+  float *colr;
+
+  fprintf(fp, "ply\nformat binary_little_endian 1.0\n");
+  fprintf(fp, "comment OpenPHIGS %s\n", mesh_title);
+  fprintf(fp, "element vertex %d\n", mesh_vertices.num);
+  fprintf(fp, "property float x\nproperty float y\nproperty float z\n");
+  fprintf(fp, "property float nx\nproperty float ny\nproperty float nz\n");
+  fprintf(fp, "property uchar red\nproperty uchar green\nproperty uchar blue\n");
+  fprintf(fp, "element face %d\n", mesh_triangles.num / 3);
+  fprintf(fp, "property list uchar uint vertex_indices\n");
+  fprintf(fp, "element edge %d\n", mesh_lines.num / 2);
+  fprintf(fp, "property uint vertex1\nproperty uint vertex2\n");
+  fprintf(fp, "end_header\n");
+
+  for (i = 0; i < mesh_vertices.num; i++) {
+    mesh_write32(fp, &mesh_vertices.pos[3 * i], 3);
+    mesh_write32(fp, &mesh_vertices.norm[3 * i], 3);
+    colr = &mesh_vertices.colr[3 * i];
+    for (j = 0; j < 3; j++) {
+      c = (unsigned char) (colr[j] * 255.0f + 0.5f);
+      fputc(c, fp);
+    }
+  }
+  for (i = 0; i < mesh_triangles.num; i += 3) {
+    fputc(3, fp);
+    for (j = 0; j < 3; j++) {
+      tri[j] = mesh_triangles.ind[i + j];
+    }
+    mesh_write32(fp, tri, 3);
+  }
+  mesh_write32(fp, mesh_lines.ind, mesh_lines.num);
+}
+
+/*******************************************************************************
+ * wsgl_begin_mesh(const char* filename, const char* title, int type)
+ *
+ * DESCR:       start collecting a binary mesh, written on export
+ * RETURNS:     Non zero or zero on error
+ */
+int wsgl_begin_mesh(const char* filename, const char* title, int type) {
+  wsgl_clear_mesh();
+  strncpy(mesh_filename, filename, sizeof(mesh_filename) - 1);
+  mesh_filename[sizeof(mesh_filename) - 1] = '\0';
+  strncpy(mesh_title, title, sizeof(mesh_title) - 1);
+  mesh_title[sizeof(mesh_title) - 1] = '\0';
+  record_mesh = type;
+#ifdef DEBUG_OBJ
+  printf("wsgl_mesh: collecting %s mesh for %s\n",
+         (type == MESH_GLB) ? "GLB" : "PLY", filename);
+#endif
+  return TRUE;
+}
+
+/*******************************************************************************
+ * wsgl_mesh_vertex(float x, float y, float z)
+ *
+ * DESCR:       add vertex with current colour to the pending primitive
+ * RETURNS:     N/A
+ */
+void wsgl_mesh_vertex(float x, float y, float z) {
+  Mesh_vertex *pending;
+  Mesh_vertex *v;
+  int size;
+
+  if (mesh_num_pending >= mesh_size_pending) {
+    size = (mesh_size_pending > 0) ? 2 * mesh_size_pending : 1024;
+    pending = (Mesh_vertex *) realloc(mesh_pending, size * sizeof(Mesh_vertex));
+    if (pending == NULL) {
+      fprintf(stderr, "wsgl_mesh: out of memory, primitive truncated\n");
+      return;
+    }
+    mesh_pending = pending;
+    mesh_size_pending = size;
+  }
+  v = &mesh_pending[mesh_num_pending++];
+  v->pos[0] = x + 0.0f;
+  v->pos[1] = y + 0.0f;
+  v->pos[2] = z + 0.0f;
+  v->norm[0] = 0.0f;
+  v->norm[1] = 0.0f;
+  v->norm[2] = 1.0f;
+  v->colr[0] = current_colr.x;
+  v->colr[1] = current_colr.y;
+  v->colr[2] = current_colr.z;
+}
+
+/*******************************************************************************
+ * wsgl_mesh_normal(float x, float y, float z)
+ *
+ * DESCR:       set normal of the last pending vertex
+ * RETURNS:     N/A
+ */
+void wsgl_mesh_normal(float x, float y, float z) {
+  float *n;
+
+  if (mesh_num_pending > 0) {
+    n = mesh_pending[mesh_num_pending - 1].norm;
+    n[0] = x;
+    n[1] = y;
+    n[2] = z;
+    mesh_normalize(n);
+    mesh_num_normals++;
+  }
+}
+
+/*******************************************************************************
+ * wsgl_mesh_geometry(GeomType type)
+ *
+ * DESCR:       add pending primitive to the mesh and start a new one
+ * RETURNS:     N/A
+ */
+void wsgl_mesh_geometry(GeomType type) {
+  int i, first, prev, index;
+  float n[3];
+
+  if (type == GEOM_FACE && mesh_num_pending >= 3) {
+    if (mesh_num_normals < mesh_num_pending) {
+      mesh_face_normal(n);
+      for (i = 0; i < mesh_num_pending; i++) {
+        memcpy(mesh_pending[i].norm, n, sizeof(n));
+      }
+    }
+    first = mesh_add_vertex(&mesh_pending[0]);
+    prev = mesh_add_vertex(&mesh_pending[1]);
+    for (i = 2; i < mesh_num_pending && first >= 0 && prev >= 0; i++) {
+      index = mesh_add_vertex(&mesh_pending[i]);
+      if (index < 0 ||
+          !mesh_add_index(&mesh_triangles, first) ||
+          !mesh_add_index(&mesh_triangles, prev) ||
+          !mesh_add_index(&mesh_triangles, index)) {
+        fprintf(stderr, "wsgl_mesh: out of memory, face dropped\n");
+        mesh_triangles.num -= mesh_triangles.num % 3;
+        break;
+      }
+      prev = index;
+    }
+  }
+  else if (type == GEOM_LINE && mesh_num_pending >= 2) {
+    prev = mesh_add_vertex(&mesh_pending[0]);
+    for (i = 1; i < mesh_num_pending && prev >= 0; i++) {
+      index = mesh_add_vertex(&mesh_pending[i]);
+      if (index < 0 ||
+          !mesh_add_index(&mesh_lines, prev) ||
+          !mesh_add_index(&mesh_lines, index)) {
+        fprintf(stderr, "wsgl_mesh: out of memory, line dropped\n");
+        mesh_lines.num -= mesh_lines.num % 2;
+        break;
+      }
+      prev = index;
+    }
+  }
+  else if (type == GEOM_SEGMENTS) {
+    for (i = 0; i + 1 < mesh_num_pending; i += 2) {
+      prev = mesh_add_vertex(&mesh_pending[i]);
+      index = mesh_add_vertex(&mesh_pending[i + 1]);
+      if (prev < 0 || index < 0 ||
+          !mesh_add_index(&mesh_lines, prev) ||
+          !mesh_add_index(&mesh_lines, index)) {
+        fprintf(stderr, "wsgl_mesh: out of memory, line dropped\n");
+        mesh_lines.num -= mesh_lines.num % 2;
+        break;
+      }
+    }
+  }
+  mesh_num_pending = 0;
+  mesh_num_normals = 0;
+}
+
+/*******************************************************************************
+ * wsgl_export_mesh()
+ *
+ * DESCR:       write collected mesh and stop collecting
+ * RETURNS:     N/A
+ */
+void wsgl_export_mesh() {
+  FILE *fp;
+
+  if (record_mesh == MESH_NONE) {
+    return;
+  }
+  fp = fopen(mesh_filename, "wb");
+  if (fp == NULL) {
+    perror("fopen");
+  }
+  else {
+#ifdef DEBUG_OBJ
+    printf("wsgl_mesh: exported %d vertices, %d triangles and %d lines\n",
+           mesh_vertices.num, mesh_triangles.num / 3, mesh_lines.num / 2);
+#endif
+    if (record_mesh == MESH_GLB) {
+      mesh_write_glb(fp);
+    }
+    else {
+      mesh_write_ply(fp);
+    }
+    fclose(fp);
+  }
+  record_mesh = MESH_NONE;
+  wsgl_clear_mesh();
+  free(mesh_vertices.pos);
+  free(mesh_vertices.norm);
+  free(mesh_vertices.colr);
+  free(mesh_vertices.slots);
+  free(mesh_triangles.ind);
+  free(mesh_lines.ind);
+  free(mesh_pending);
+  memset(&mesh_vertices, 0, sizeof(Mesh_vertices));
+  memset(&mesh_triangles, 0, sizeof(Mesh_indices));
+  memset(&mesh_lines, 0, sizeof(Mesh_indices));
+  mesh_pending = NULL;
+  mesh_size_pending = 0;
+}
+
+/*******************************************************************************
+ * wsgl_clear_mesh()
+ *
+ * DESCR:       drop collected mesh, keep the buffers
+ * RETURNS:     N/A
+ */
+void wsgl_clear_mesh() {
+  if (mesh_vertices.num > 0) {
+    memset(mesh_vertices.slots, 0,
+           mesh_vertices.num_slots * sizeof(unsigned int));
+  }
+  mesh_vertices.num = 0;
+  mesh_triangles.num = 0;
+  mesh_lines.num = 0;
+  mesh_num_pending = 0;
+  mesh_num_normals = 0;
+}
@@ -24,6 +24,7 @@
 #include <string.h>
 #include <limits.h>
 #include <stdint.h>
+#include <unistd.h>
 #ifdef GLEW
 #include <GL/glew.h>
 #include <GL/glx.h>
@@ -35,19 +36,184 @@
 #include "private/phgP.h"
 #include "private/wsglP.h"
 
-Ppoint3 * vertices = NULL;
-Ppoint3 * normals = NULL;
+/* output buffer of the OBJ stream */
+#define OBJ_IO_BUFFER (1 << 20)
+
+/* initial and maximum number of slots of a deduplication table */
+#define OBJ_HASH_INIT 4096
+#define OBJ_HASH_MAX  (1 << 22)
+
+typedef struct {
+  float x, y, z;
+  int index;                     /* OBJ index, 0 for an empty slot */
+} Obj_slot;
+
+typedef struct {
+  Obj_slot *slots;
+  unsigned int size;             /* power of two */
+  unsigned int used;
+} Obj_hash;
+
+typedef struct {
+  int *indices;
+  int count;
+  int size;                      /* allocated, grows by doubling */
+} Obj_indices;
+
 int vertex_count = 0;
 int normal_count = 0;
-
-Geometry* geometries = NULL;
-int geom_count = 0;
 Ppoint3 current_normal;
+Ppoint3 current_colr = {1.0, 1.0, 1.0};
+float current_width = 1.0;
 
 int record_geom = FALSE;
 int record_geom_fill = TRUE;
 int normal_valid = FALSE;
 
+static FILE *obj_file = NULL;
+static char *obj_iobuf = NULL;
+static long obj_header_end = 0;
+static Obj_hash obj_vertices = {NULL, 0, 0};
+static Obj_hash obj_normals = {NULL, 0, 0};
+
+/* scratch indices of the primitive being recorded, shared by all renderers */
+static Obj_indices rec_vertices = {NULL, 0, 0};
+static Obj_indices rec_normals = {NULL, 0, 0};
+
+/*******************************************************************************
+ * obj_hash_key
+ *
+ * DESCR:       spatial hash of a point
+ * RETURNS:     hash value
+ */
+static unsigned int obj_hash_key(float x, float y, float z) {
+  uint32_t ux, uy, uz;
+
+  memcpy(&ux, &x, sizeof(uint32_t));
+  memcpy(&uy, &y, sizeof(uint32_t));
+  memcpy(&uz, &z, sizeof(uint32_t));
+  return (ux * 73856093u) ^ (uy * 19349663u) ^ (uz * 83492791u);
+}
+
+/*******************************************************************************
+ * obj_hash_grow
+ *
+ * DESCR:       double table size and reinsert entries
+ * RETURNS:     Non zero or zero when the table is at its limit
+ */
+static int obj_hash_grow(Obj_hash *hash) {
+  Obj_slot *old_slots = hash->slots;
+  unsigned int old_size = hash->size;
+  unsigned int size, i, j;
+  Obj_slot *slots;
+
+  size = (old_size == 0) ? OBJ_HASH_INIT : 2 * old_size;
+  if (size > OBJ_HASH_MAX) {
+    return FALSE;
+  }
+  slots = (Obj_slot *) calloc(size, sizeof(Obj_slot));
+  if (slots == NULL) {
+    return FALSE;
+  }
+  for (i = 0; i < old_size; i++) {
+    if (old_slots[i].index != 0) {
+      j = obj_hash_key(old_slots[i].x, old_slots[i].y, old_slots[i].z) &
+        (size - 1);
+      while (slots[j].index != 0) {
+        j = (j + 1) & (size - 1);
+      }
+      slots[j] = old_slots[i];
+    }
+  }
+  free(old_slots);
+  hash->slots = slots;
+  hash->size = size;
+
+  return TRUE;
+}
+
+/*******************************************************************************
+ * obj_hash_find
+ *
+ * DESCR:       find point or remember it with the next index
+ * RETURNS:     Existing index, or zero if the point is new
+ */
+static int obj_hash_find(Obj_hash *hash, float x, float y, float z, int next) {
+  unsigned int i;
+
+  /* keep the load below one half, then stop deduplicating */
+  if (2 * (hash->used + 1) > hash->size && !obj_hash_grow(hash)) {
+    if (hash->size == 0 || hash->used + 1 >= hash->size) {
+      return 0;
+    }
+  }
+  i = obj_hash_key(x, y, z) & (hash->size - 1);
+  while (hash->slots[i].index != 0) {
+    if (hash->slots[i].x == x &&
+        hash->slots[i].y == y &&
+        hash->slots[i].z == z) {
+      return hash->slots[i].index;
+    }
+    i = (i + 1) & (hash->size - 1);
+  }
+  hash->slots[i].x = x;
+  hash->slots[i].y = y;
+  hash->slots[i].z = z;
+  hash->slots[i].index = next;
+  hash->used++;
+
+  return 0;
+}
+
+/*******************************************************************************
+ * obj_hash_clear
+ *
+ * DESCR:       release deduplication table
+ * RETURNS:     N/A
+ */
+static void obj_hash_clear(Obj_hash *hash) {
+  free(hash->slots);
+  hash->slots = NULL;
+  hash->size = 0;
+  hash->used = 0;
+}
+
+/*******************************************************************************
+ * obj_indices_add
+ *
+ * DESCR:       append index to a scratch list, growing it as needed
+ * RETURNS:     N/A
+ */
+static void obj_indices_add(Obj_indices *list, int index) {
+  int *indices;
+  int size;
+
+  if (list->count >= list->size) {
+    size = (list->size > 0) ? 2 * list->size : 1024;
+    indices = (int *) realloc(list->indices, size * sizeof(int));
+    if (indices == NULL) {
+      fprintf(stderr, "wsgl_obj: out of memory, primitive truncated\n");
+      return;
+    }
+    list->indices = indices;
+    list->size = size;
+  }
+  list->indices[list->count++] = index;
+}
+
+/*******************************************************************************
+ * obj_indices_free
+ *
+ * DESCR:       release scratch list
+ * RETURNS:     N/A
+ */
+static void obj_indices_free(Obj_indices *list) {
+  free(list->indices);
+  list->indices = NULL;
+  list->count = 0;
+  list->size = 0;
+}
+
 /*******************************************************************************
  * wsgl_set_current_normal(float x, float y, float z)
  *
@@ -61,6 +227,67 @@ void wsgl_set_current_normal(float x, float y, float z) {
   normal_valid = TRUE;
 };
 
+/*******************************************************************************
+ * wsgl_set_current_colr(float r, float g, float b)
+ *
+ * DESCR:       set colour of the following recorded primitives
+ * RETURNS:     N/A
+ */
+void wsgl_set_current_colr(float r, float g, float b) {
+  current_colr.x = (r < 0.0f) ? 0.0f : (r > 1.0f) ? 1.0f : r;
+  current_colr.y = (g < 0.0f) ? 0.0f : (g > 1.0f) ? 1.0f : g;
+  current_colr.z = (b < 0.0f) ? 0.0f : (b > 1.0f) ? 1.0f : b;
+}
+
+/*******************************************************************************
+ * wsgl_set_current_width(float width)
+ *
+ * DESCR:       set line width of the following recorded primitives
+ * RETURNS:     N/A
+ */
+void wsgl_set_current_width(float width) {
+  current_width = (width > 0.0f) ? width : 1.0f;
+}
+
+/*******************************************************************************
+ * wsgl_obj_is_open()
+ *
+ * DESCR:       check if an OBJ file is being streamed
+ * RETURNS:     TRUE or FALSE
+ */
+int wsgl_obj_is_open(void) {
+  return (obj_file != NULL) ? TRUE : FALSE;
+}
+
+/*******************************************************************************
+ * wsgl_begin_obj(const char* filename, const char* title)
+ *
+ * DESCR:       open OBJ file, records are written while rendering
+ *              only one OBJ workstation at a time owns the stream
+ * RETURNS:     Non zero or zero on error
+ */
+int wsgl_begin_obj(const char* filename, const char* title) {
+  if (obj_file != NULL) {
+    printf("wsgl_obj: OBJ file already open, %s not written\n", filename);
+    return FALSE;
+  }
+  obj_file = fopen(filename, "w");
+  if (obj_file == NULL) {
+    perror("fopen");
+    return FALSE;
+  }
+  obj_iobuf = (char *) malloc(OBJ_IO_BUFFER);
+  if (obj_iobuf != NULL) {
+    setvbuf(obj_file, obj_iobuf, _IOFBF, OBJ_IO_BUFFER);
+  }
+  fprintf(obj_file, "#name:%s\n", title);
+  obj_header_end = ftell(obj_file);
+#ifdef DEBUG_OBJ
+  printf("wsgl_obj: streaming to %s\n", filename);
+#endif
+  return TRUE;
+}
+
 /*******************************************************************************
  * wsgl_add_vertex(float x, float y, float z)
  *
@@ -68,14 +295,19 @@ void wsgl_set_current_normal(float x, float y, float z) {
  * RETURNS:     Non zero or zero on error
  */
 int wsgl_add_vertex(float x, float y, float z) {
-  vertices = realloc(vertices, sizeof(Ppoint3) * (vertex_count + 1));
-  if (!vertices) {
-    fprintf(stderr, "Out of memory adding vertex\n");
-    exit(1);
-  }
-  vertices[vertex_count].x = x;
-  vertices[vertex_count].y = y;
-  vertices[vertex_count].z = z;
+  int index;
+
+  /* no negative zero, it would not match its positive twin */
+  x += 0.0f;
+  y += 0.0f;
+  z += 0.0f;
+  index = obj_hash_find(&obj_vertices, x, y, z, vertex_count + 1);
+  if (index != 0) {
+    return index;
+  }
+  if (obj_file != NULL) {
+    fprintf(obj_file, "v %f %f %f\n", x, y, z);
+  }
 #ifdef DEBUG_OBJ
   printf("wsgl_obj: vertex count is %d \n", vertex_count +1);
 #endif
@@ -89,17 +321,24 @@ int wsgl_add_vertex(float x, float y, float z) {
  * RETURNS:     Non zero or zero on error
  */
 int wsgl_add_normal(float x, float y, float z) {
-  normals = realloc(normals, sizeof(Ppoint3) * (normal_count + 1));
-  if (!normals) {
-    fprintf(stderr, "Out of memory adding normal\n");
-    exit(1);
-  }
-  
-  normals[normal_count].x = current_normal.x;
-  normals[normal_count].y = current_normal.y;
-  normals[normal_count].z = current_normal.z;
+  int index;
+
+  index = obj_hash_find(&obj_normals,
+                        current_normal.x + 0.0f,
+                        current_normal.y + 0.0f,
+                        current_normal.z + 0.0f,
+                        normal_count + 1);
+  if (index != 0) {
+    return index;
+  }
+  if (obj_file != NULL) {
+    fprintf(obj_file, "vn %f %f %f\n",
+            current_normal.x,
+            current_normal.y,
+            current_normal.z);
+  }
 #ifdef DEBUG_OBJ
-  printf("wsgl_obj: normal count is %d \n", vertex_count +1);
+  printf("wsgl_obj: normal count is %d \n", normal_count +1);
 #endif
   return ++normal_count;
 }
@@ -111,25 +350,99 @@ int wsgl_add_normal(float x, float y, float z) {
  * RETURNS:     Non zero or zero on error
  */
 void wsgl_add_geometry(GeomType type, const int* verts, const int* norms, int count) {
-  geometries = realloc(geometries, sizeof(Geometry) * (geom_count + 1));
-  if (!geometries) {
-    fprintf(stderr, "Out of memory adding geometry\n");
-    exit(1);
+  int j;
+
+  if (obj_file == NULL || count <= 0) {
+    return;
   }
 #ifdef DEBUG_OBJ
   printf("wsgl_obj: adding geometry with %d vertices\n", count);
 #endif
-  geometries[geom_count].type = type;
-  geometries[geom_count].count = count;
-  geometries[geom_count].indices = malloc(sizeof(int) * count);
-  memcpy(geometries[geom_count].indices, verts, sizeof(int) * count);
-  if (norms != NULL){
-    geometries[geom_count].norms = malloc(sizeof(int) * count);
-    memcpy(geometries[geom_count].norms, norms, sizeof(int) * count);
+  switch (type) {
+  case GEOM_FACE:
+    fputc('f', obj_file);
+    for (j = 0; j < count; ++j) {
+      if (norms != NULL)
+        fprintf(obj_file, " %d//%d", verts[j], norms[j]);
+      else
+        fprintf(obj_file, " %d", verts[j]);
+    }
+    break;
+  case GEOM_LINE:
+    fputc('l', obj_file);
+    for (j = 0; j < count; ++j)
+      fprintf(obj_file, " %d", verts[j]);
+    break;
+  default:
+    printf("ERROR: Unknown geometry type detected. Ignoring");
+    return;
+  }
+  fputc('\n', obj_file);
+}
+
+/*******************************************************************************
+ * wsgl_rec_vertex(float x, float y, float z)
+ *
+ * DESCR:       add 3d vertex to the primitive being recorded
+ * RETURNS:     N/A
+ */
+void wsgl_rec_vertex(float x, float y, float z) {
+  if (record_vec) {
+    wsgl_vec_vertex(x, y, z);
+    return;
+  }
+  if (record_mesh) {
+    wsgl_mesh_vertex(x, y, z);
+    return;
   }
-  else
-    geometries[geom_count].norms = NULL;
-  geom_count++;
+  obj_indices_add(&rec_vertices, wsgl_add_vertex(x, y, z));
+}
+
+/*******************************************************************************
+ * wsgl_rec_normal(float x, float y, float z)
+ *
+ * DESCR:       add normal to the primitive being recorded
+ * RETURNS:     N/A
+ */
+void wsgl_rec_normal(float x, float y, float z) {
+  if (record_vec) {
+    wsgl_vec_normal(x, y, z);
+    return;
+  }
+  if (record_mesh) {
+    wsgl_mesh_normal(x, y, z);
+    return;
+  }
+  obj_indices_add(&rec_normals, wsgl_add_normal(x, y, z));
+}
+
+/*******************************************************************************
+ * wsgl_rec_geometry(GeomType type)
+ *
+ * DESCR:       add recorded primitive as 3d geometry and start a new one
+ * RETURNS:     N/A
+ */
+void wsgl_rec_geometry(GeomType type) {
+  int *norms = NULL;
+
+  if (record_vec) {
+    wsgl_vec_geometry(type);
+    return;
+  }
+  if (record_mesh) {
+    wsgl_mesh_geometry(type);
+    return;
+  }
+  if (rec_normals.count > 0 && rec_normals.count == rec_vertices.count) {
+    norms = rec_normals.indices;
+  }
+  if (type == GEOM_SEGMENTS) {
+    /* OBJ keeps writing segment lists as one polyline */
+    type = GEOM_LINE;
+  }
+  wsgl_add_geometry(type, rec_vertices.indices, norms, rec_vertices.count);
+  rec_vertices.count = 0;
+  rec_normals.count = 0;
 }
 
 /*******************************************************************************
@@ -138,48 +451,23 @@ void wsgl_add_geometry(GeomType type, const int* verts, const int* norms, int co
  * RETURNS:     Non zero or zero on error
  */
 void wsgl_export_obj(const char* filename, const char* title) {
-  FILE* f = fopen(filename, "w");
-  if (!f) {
-    perror("fopen");
-    return;
+  if (obj_file == NULL) {
+    /* nothing was streamed, write an empty model */
+    if (!wsgl_begin_obj(filename, title)) {
+      return;
+    }
   }
 #ifdef DEBUG_OBJ
-  printf("wsgl_obj: exporting %d vertices and %d normals\n", vertex_count, normal_count);
+  printf("wsgl_obj: exported %d vertices and %d normals\n", vertex_count, normal_count);
 #endif
-  fprintf(f, "#name:%s\n", title);
-  for (int i = 0; i < normal_count; ++i) {
-    fprintf(f, "vn %f %f %f\n",
-            normals[i].x,
-            normals[i].y,
-            normals[i].z);
-  }
-  for (int i = 0; i < vertex_count; ++i) {
-    fprintf(f, "v %f %f %f\n",
-            vertices[i].x,
-            vertices[i].y,
-            vertices[i].z);
-  }
-  
-  for (int i = 0; i < geom_count; ++i) {
-    switch (geometries[i].type) {
-    case GEOM_FACE: 
-      fprintf(f, "f");
-      for (int j = 0; j < geometries[i].count; ++j)
-        fprintf(f, " %d//%d", geometries[i].indices[j], geometries[i].norms[j]);
-        break;
-    case GEOM_LINE:
-      fprintf(f, "l");
-      for (int j = 0; j < geometries[i].count; ++j)
-        fprintf(f, " %d", geometries[i].indices[j]);
-      break;
-    default:
-      printf("ERROR: Unknown geometry type detected. Ignoring");
-      continue;
-    }
-    fprintf(f, "\n");
-  }
-  
-  fclose(f);
+  fclose(obj_file);
+  obj_file = NULL;
+  free(obj_iobuf);
+  obj_iobuf = NULL;
+  obj_hash_clear(&obj_vertices);
+  obj_hash_clear(&obj_normals);
+  obj_indices_free(&rec_vertices);
+  obj_indices_free(&rec_normals);
 }
 
 /*******************************************************************************
@@ -196,37 +484,33 @@ void wsgl_clear_geometry() {
   else 
     printf("wsgl_obj: Recording is OFF\n");
 #endif    
-  if (vertices != NULL){
-    free(vertices);
-    vertices = NULL;
-    vertex_count = 0;
-#ifdef DEBUG_OBJ
-  } else {
-    printf("wsgl_obj: no vertices found\n");
-#endif
+  if (obj_file != NULL) {
+    /* drop records streamed since the header */
+    fflush(obj_file);
+    if (ftruncate(fileno(obj_file), obj_header_end) != 0) {
+      perror("ftruncate");
+    }
+    fseek(obj_file, obj_header_end, SEEK_SET);
   }
-  if (normals != NULL){
-    free(normals);
-    normals = NULL;
-    normal_count = 0;
-#ifdef DEBUG_OBJ
-  } else {
-    printf("wsgl_obj: no normals found\n");
-#endif
+  if (obj_vertices.used > 0) {
+    memset(obj_vertices.slots, 0, obj_vertices.size * sizeof(Obj_slot));
+    obj_vertices.used = 0;
   }
-  if (geom_count > 0){
-    for (int i = 0; i < geom_count; ++i)
-      free(geometries[i].indices);
-    free(geometries);
-    geometries = NULL;
-    geom_count = 0;
-#ifdef DEBUG_OBJ
-  } else {
-    printf("wsgl_obj: no geometries found\n");
-#endif
+  if (obj_normals.used > 0) {
+    memset(obj_normals.slots, 0, obj_normals.size * sizeof(Obj_slot));
+    obj_normals.used = 0;
   }
+  rec_vertices.count = 0;
+  rec_normals.count = 0;
+  wsgl_clear_mesh();
+  vertex_count = 0;
+  normal_count = 0;
   normal_valid = FALSE;
   current_normal.x = 0.0;
   current_normal.y = 0.0;
   current_normal.z = 1.0;
+  current_colr.x = 1.0;
+  current_colr.y = 1.0;
+  current_colr.z = 1.0;
+  current_width = 1.0;
 }
@@ -41,19 +41,15 @@ GLint shading_mode;
 GLint vAmbient, vDiffuse, vSpecular, vPositional;
 GLint ModelViewMatrix, ProjectionMatrix;
 GLint alpha_channel;
-GLint lightSource0, lightSourceTyp0, lightSourceCol0, lightSourcePos0, lightSourceCoef0;
-GLint lightSource1, lightSourceTyp1, lightSourceCol1, lightSourcePos1, lightSourceCoef1;
-GLint lightSource2, lightSourceTyp2, lightSourceCol2, lightSourcePos2, lightSourceCoef2;
-GLint lightSource3, lightSourceTyp3, lightSourceCol3, lightSourcePos3, lightSourceCoef3;
-GLint lightSource4, lightSourceTyp4, lightSourceCol4, lightSourcePos4, lightSourceCoef4;
-GLint lightSource5, lightSourceTyp5, lightSourceCol5, lightSourcePos5, lightSourceCoef5;
-GLint lightSource6, lightSourceTyp6, lightSourceCol6, lightSourcePos6, lightSourceCoef6;
+GLint marker_shape, marker_corners, marker_size, marker_viewport;
+GLint num_lights, light_data;
 
 static const char* vertex_shader_text_130 =
 "#version 130\n"
 "in vec4 vColor;\n"
 "out vec4 Color;\n"
 "out vec4 Normal;\n"
+"out float MarkerPixels;\n"
 "out float gl_ClipDistance[6];\n"
 "uniform mat4 ModelViewMatrix;\n"
 "uniform mat4 ProjectionMatrix;\n"
@@ -61,6 +57,9 @@ static const char* vertex_shader_text_130 =
 "uniform int clipping_ind;\n"
 "uniform vec4 plane0;\n"
 "uniform vec4 point0;\n"
+"uniform int MarkerShape;\n"
+"uniform float MarkerSize;\n"
+"uniform vec2 Viewport;\n"
 "float distance;\n"
 "void main()\n"
 "{\n"
@@ -73,62 +72,59 @@ static const char* vertex_shader_text_130 =
 "      distance = 1.0;\n"
 "    };\n"
 "    gl_ClipDistance[0] = distance;\n"
+"    if (MarkerShape > 0) {\n"
+"      vec4 edge = ProjectionMatrix * ModelViewMatrix * (gl_Vertex + vec4(MarkerSize, 0.0, 0.0, 0.0));\n"
+"      MarkerPixels = max(length((edge.xy / edge.w - gl_Position.xy / gl_Position.w) * Viewport), 1.0);\n"
+"      gl_PointSize = MarkerPixels;\n"
+"    } else {\n"
+"      MarkerPixels = 1.0;\n"
+"    };\n"
 "}\n";
 
 static const char* fragment_shader_text_130 =
-"#version 130\n"
 "uniform int ShadingMode;\n"
 "uniform vec4 vAmbient;\n"
 "uniform vec4 vDiffuse;\n"
 "uniform vec4 vSpecular;\n"
 "\n"
-"uniform int lightSource0;\n"
-"uniform int lightSourceTyp0;\n"
-"uniform vec4 lightSourceCol0;\n"
-"uniform vec4 lightSourcePos0;\n"
-"uniform vec4 lightSourceCoef0;\n"
-"\n"
-"uniform int lightSource1;\n"
-"uniform int lightSourceTyp1;\n"
-"uniform vec4 lightSourceCol1;\n"
-"uniform vec4 lightSourcePos1;\n"
-"uniform vec4 lightSourceCoef1;\n"
-"\n"
-"uniform int lightSource2;\n"
-"uniform int lightSourceTyp2;\n"
-"uniform vec4 lightSourceCol2;\n"
-"uniform vec4 lightSourcePos2;\n"
-"uniform vec4 lightSourceCoef2;\n"
-"\n"
-"uniform int lightSource3;\n"
-"uniform int lightSourceTyp3;\n"
-"uniform vec4 lightSourceCol3;\n"
-"uniform vec4 lightSourcePos3;\n"
-"uniform vec4 lightSourceCoef3;\n"
-"\n"
-"uniform int lightSource4;\n"
-"uniform int lightSourceTyp4;\n"
-"uniform vec4 lightSourceCol4;\n"
-"uniform vec4 lightSourcePos4;\n"
-"uniform vec4 lightSourceCoef4;\n"
-"\n"
-"uniform int lightSource5;\n"
-"uniform int lightSourceTyp5;\n"
-"uniform vec4 lightSourceCol5;\n"
-"uniform vec4 lightSourcePos5;\n"
-"uniform vec4 lightSourceCoef5;\n"
-"\n"
-"uniform int lightSource6;\n"
-"uniform int lightSourceTyp6;\n"
-"uniform vec4 lightSourceCol6;\n"
-"uniform vec4 lightSourcePos6;\n"
-"uniform vec4 lightSourceCoef6;\n"
+"#ifdef LIGHT_BLOCK\n"
+"layout(std140) uniform LightBlock {\n"
+"  int NumLights;\n"
+"  vec4 LightData[3 * MAX_LIGHT_SRC];\n"
+"};\n"
+"#else\n"
+"uniform int NumLights;\n"
+"uniform vec4 LightData[3 * MAX_LIGHT_SRC];\n"
+"#endif\n"
 "uniform float alpha_channel;\n"
+"uniform int MarkerShape;\n"
+"uniform int MarkerCorners;\n"
 "\n"
 "in vec4 Color;\n"
 "in vec4 Normal;\n"
+"in float MarkerPixels;\n"
 "out vec4 FragColor;\n"
 "\n"
+"bool insideMarker(){\n"
+"  vec2 p = vec2(2.0 * gl_PointCoord.x - 1.0, 1.0 - 2.0 * gl_PointCoord.y);\n"
+"  float w = 1.0 / MarkerPixels;\n"
+"  float d = 0.5 / 1.414;\n"
+"  bool plus = (abs(p.x) <= 0.5 && abs(p.y) <= w) || (abs(p.y) <= 0.5 && abs(p.x) <= w);\n"
+"  if (MarkerCorners > 0) {\n"
+"    float dalpha = 6.2831853 / float(MarkerCorners);\n"
+"    float alpha = atan(p.y, p.x);\n"
+"    float k = floor(alpha / dalpha + 0.5);\n"
+"    return length(p) * cos(alpha - k * dalpha) <= cos(dalpha / 2.0);\n"
+"  };\n"
+"  if (MarkerShape == 1) {\n"
+"    return plus;\n"
+"  };\n"
+"  if (MarkerShape == 2) {\n"
+"    return plus || (abs(p.x) <= d && abs(p.y) <= d && (abs(p.x - p.y) <= 1.414 * w || abs(p.x + p.y) <= 1.414 * w));\n"
+"  };\n"
+"  return abs(p.x) <= 0.5 && abs(p.y) <= 0.5 && (abs(p.x - p.y) <= 1.414 * w || abs(p.x + p.y) <= 1.414 * w);\n"
+"}\n"
+
 "vec4 getLight(int type, vec4 color, vec4 pos, vec4 coef){\n"
 "  vec4 light;\n"
 "  float refl = 0.0;\n"
@@ -158,37 +154,15 @@ static const char* fragment_shader_text_130 =
 "void main()\n"
 "{\n"
 "  int i;\n"
+"  if (MarkerShape > 0 && !insideMarker()) {\n"
+"    discard;\n"
+"  };\n"
 "  if (ShadingMode > 0) {\n"
-"    int n = 0;\n"
 "    FragColor = vec4(0., 0., 0, 1.);\n"
-"    for (i=0; i<7; i++){\n"
-"      switch (i) {\n"
-"      case 0:\n"
-"        if (lightSource0 > 0){ FragColor += getLight(lightSourceTyp0, lightSourceCol0, lightSourcePos0, lightSourceCoef0);n += 1;};\n"
-"        break;\n"
-"      case 1:\n"
-"        if (lightSource1 > 0){ FragColor += getLight(lightSourceTyp1, lightSourceCol1, lightSourcePos1, lightSourceCoef1);n += 1;};\n"
-"        break;\n"
-"      case 2:\n"
-"        if (lightSource2 > 0){ FragColor += getLight(lightSourceTyp2, lightSourceCol2, lightSourcePos2, lightSourceCoef2);n += 1;};\n"
-"        break;\n"
-"      case 3:\n"
-"        if (lightSource3 > 0){ FragColor += getLight(lightSourceTyp3, lightSourceCol3, lightSourcePos3, lightSourceCoef3);n += 1;};\n"
-"        break;\n"
-"      case 4:\n"
-"        if (lightSource4 > 0){ FragColor += getLight(lightSourceTyp4, lightSourceCol4, lightSourcePos4, lightSourceCoef4);n += 1;};\n"
-"        break;\n"
-"      case 5:\n"
-"        if (lightSource5 > 0){ FragColor += getLight(lightSourceTyp5, lightSourceCol5, lightSourcePos5, lightSourceCoef5);n += 1;};\n"
-"        break;\n"
-"      case 6:\n"
-"        if (lightSource6 > 0){ FragColor += getLight(lightSourceTyp6, lightSourceCol6, lightSourcePos6, lightSourceCoef6);n += 1;};\n"
-"        break;\n"
-"      default:\n"
-"        break;\n"
-"      };\n"
+"    for (i = 0; i < NumLights; i++) {\n"
+"      FragColor += getLight(int(LightData[3*i+2].w), LightData[3*i], LightData[3*i+1], LightData[3*i+2]);\n"
 "    };\n"
-"    if (n > 0){\n"
+"    if (NumLights > 0){\n"
 "      FragColor = min(FragColor, vec4(1., 1., 1., 1.));"
 "    } else { FragColor = Color;};\n"
 "  } else {\n"
@@ -204,10 +178,14 @@ static const char* vertex_shader_text_120 =
 "attribute vec4 vColor;\n"
 "varying vec4 Color;\n"
 "varying vec4 Normal;\n"
+"varying float MarkerPixels;\n"
 "uniform int num_clip_planes;\n"
 "uniform int clipping_ind;\n"
 "uniform vec4 plane0;\n"
 "uniform vec4 point0;\n"
+"uniform int MarkerShape;\n"
+"uniform float MarkerSize;\n"
+"uniform vec2 Viewport;\n"
 "void main()\n"
 "{\n"
 "    Color = vColor;\n"
@@ -216,60 +194,57 @@ static const char* vertex_shader_text_120 =
 "    if ((num_clip_planes == 1) && (clipping_ind > 0)) {\n"
 "      gl_ClipVertex = transpose(ModelViewMatrix) * gl_Vertex;\n"
 "    };\n"
+"    if (MarkerShape > 0) {\n"
+"      vec4 edge = ProjectionMatrix * ModelViewMatrix * (gl_Vertex + vec4(MarkerSize, 0.0, 0.0, 0.0));\n"
+"      MarkerPixels = max(length((edge.xy / edge.w - gl_Position.xy / gl_Position.w) * Viewport), 1.0);\n"
+"      gl_PointSize = MarkerPixels;\n"
+"    } else {\n"
+"      MarkerPixels = 1.0;\n"
+"    };\n"
 "}\n";
 
 static const char* fragment_shader_text_120 =
-"#version 120\n"
 "uniform int ShadingMode;\n"
 "uniform vec4 vAmbient;\n"
 "uniform vec4 vDiffuse;\n"
 "uniform vec4 vSpecular;\n"
 "\n"
-"uniform int lightSource0;\n"
-"uniform int lightSourceTyp0;\n"
-"uniform vec4 lightSourceCol0;\n"
-"uniform vec4 lightSourcePos0;\n"
-"uniform vec4 lightSourceCoef0;\n"
-"\n"
-"uniform int lightSource1;\n"
-"uniform int lightSourceTyp1;\n"
-"uniform vec4 lightSourceCol1;\n"
-"uniform vec4 lightSourcePos1;\n"
-"uniform vec4 lightSourceCoef1;\n"
-"\n"
-"uniform int lightSource2;\n"
-"uniform int lightSourceTyp2;\n"
-"uniform vec4 lightSourceCol2;\n"
-"uniform vec4 lightSourcePos2;\n"
-"uniform vec4 lightSourceCoef2;\n"
-"\n"
-"uniform int lightSource3;\n"
-"uniform int lightSourceTyp3;\n"
-"uniform vec4 lightSourceCol3;\n"
-"uniform vec4 lightSourcePos3;\n"
-"uniform vec4 lightSourceCoef3;\n"
-"\n"
-"uniform int lightSource4;\n"
-"uniform int lightSourceTyp4;\n"
-"uniform vec4 lightSourceCol4;\n"
-"uniform vec4 lightSourcePos4;\n"
-"uniform vec4 lightSourceCoef4;\n"
-"\n"
-"uniform int lightSource5;\n"
-"uniform int lightSourceTyp5;\n"
-"uniform vec4 lightSourceCol5;\n"
-"uniform vec4 lightSourcePos5;\n"
-"uniform vec4 lightSourceCoef5;\n"
-"\n"
-"uniform int lightSource6;\n"
-"uniform int lightSourceTyp6;\n"
-"uniform vec4 lightSourceCol6;\n"
-"uniform vec4 lightSourcePos6;\n"
-"uniform vec4 lightSourceCoef6;\n"
+"#ifdef LIGHT_BLOCK\n"
+"layout(std140) uniform LightBlock {\n"
+"  int NumLights;\n"
+"  vec4 LightData[3 * MAX_LIGHT_SRC];\n"
+"};\n"
+"#else\n"
+"uniform int NumLights;\n"
+"uniform vec4 LightData[3 * MAX_LIGHT_SRC];\n"
+"#endif\n"
 "uniform float alpha_channel;\n"
+"uniform int MarkerShape;\n"
+"uniform int MarkerCorners;\n"
 "varying vec4 Normal;\n"
 "varying vec4 Color;\n"
+"varying float MarkerPixels;\n"
 "\n"
+"bool insideMarker(){\n"
+"  vec2 p = vec2(2.0 * gl_PointCoord.x - 1.0, 1.0 - 2.0 * gl_PointCoord.y);\n"
+"  float w = 1.0 / MarkerPixels;\n"
+"  float d = 0.5 / 1.414;\n"
+"  bool plus = (abs(p.x) <= 0.5 && abs(p.y) <= w) || (abs(p.y) <= 0.5 && abs(p.x) <= w);\n"
+"  if (MarkerCorners > 0) {\n"
+"    float dalpha = 6.2831853 / float(MarkerCorners);\n"
+"    float alpha = atan(p.y, p.x);\n"
+"    float k = floor(alpha / dalpha + 0.5);\n"
+"    return length(p) * cos(alpha - k * dalpha) <= cos(dalpha / 2.0);\n"
+"  };\n"
+"  if (MarkerShape == 1) {\n"
+"    return plus;\n"
+"  };\n"
+"  if (MarkerShape == 2) {\n"
+"    return plus || (abs(p.x) <= d && abs(p.y) <= d && (abs(p.x - p.y) <= 1.414 * w || abs(p.x + p.y) <= 1.414 * w));\n"
+"  };\n"
+"  return abs(p.x) <= 0.5 && abs(p.y) <= 0.5 && (abs(p.x - p.y) <= 1.414 * w || abs(p.x + p.y) <= 1.414 * w);\n"
+"}\n"
+
 "vec4 getLight(int type, vec4 color, vec4 pos, vec4 coef){\n"
 "  vec4 light;\n"
 "  float refl = 0.0;\n"
@@ -295,33 +270,15 @@ static const char* fragment_shader_text_120 =
 "void main()\n"
 "{\n"
 "  int i;\n"
+"  if (MarkerShape > 0 && !insideMarker()) {\n"
+"    discard;\n"
+"  };\n"
 "  if (ShadingMode > 0) {\n"
-"    int n = 0;\n"
 "    gl_FragColor = vec4(0., 0., 0, 1.);\n"
-"    for (i=0; i<7; i++){\n"
-"      if (i==0) {\n"
-"        if (lightSource0 > 0){ gl_FragColor += getLight(lightSourceTyp0, lightSourceCol0, lightSourcePos0, lightSourceCoef0);n += 1;};\n"
-"      }"
-"      if (i==1) {\n"
-"        if (lightSource1 > 0){ gl_FragColor += getLight(lightSourceTyp1, lightSourceCol1, lightSourcePos1, lightSourceCoef1);n += 1;};\n"
-"      }"
-"      if (i==2) {\n"
-"        if (lightSource2 > 0){ gl_FragColor += getLight(lightSourceTyp2, lightSourceCol2, lightSourcePos2, lightSourceCoef2);n += 1;};\n"
-"      }"
-"      if (i==3) {\n"
-"        if (lightSource3 > 0){ gl_FragColor += getLight(lightSourceTyp3, lightSourceCol3, lightSourcePos3, lightSourceCoef3);n += 1;};\n"
-"      }"
-"      if (i==4) {\n"
-"        if (lightSource4 > 0){ gl_FragColor += getLight(lightSourceTyp4, lightSourceCol4, lightSourcePos4, lightSourceCoef4);n += 1;};\n"
-"      }"
-"      if (i==5) {\n"
-"        if (lightSource5 > 0){ gl_FragColor += getLight(lightSourceTyp5, lightSourceCol5, lightSourcePos5, lightSourceCoef5);n += 1;};\n"
-"      }"
-"      if (i==6) {\n"
-"        if (lightSource6 > 0){ gl_FragColor += getLight(lightSourceTyp6, lightSourceCol6, lightSourcePos6, lightSourceCoef6);n += 1;};\n"
-"      }"
+"    for (i = 0; i < NumLights; i++) {\n"
+"      gl_FragColor += getLight(int(LightData[3*i+2].w), LightData[3*i], LightData[3*i+1], LightData[3*i+2]);\n"
 "    };\n"
-"    if (n > 0){\n"
+"    if (NumLights > 0){\n"
 "      gl_FragColor = min(gl_FragColor, vec4(1., 1., 1., 1.));"
 "    } else { gl_FragColor = Color;};\n"
 "  } else {\n"
@@ -330,6 +287,36 @@ static const char* fragment_shader_text_120 =
 "  gl_FragColor.a = alpha_channel;\n"
 "}\n";
 
+/*******************************************************************************
+ * fragment_shader_source
+ *
+ * DESCR:	Set fragment shader source, prefixed by the version and the
+ *		light source declarations
+ * RETURNS:	N/A
+ */
+
+static void fragment_shader_source(
+                                   GLuint shader,
+                                   const char *version,
+                                   const char *text,
+                                   int light_block
+                                   )
+{
+  char header[256];
+  const char *source[2];
+
+  snprintf(header, sizeof(header),
+           "#version %s\n%s#define MAX_LIGHT_SRC %d\n",
+           version,
+           light_block ?
+           "#extension GL_ARB_uniform_buffer_object : require\n"
+           "#define LIGHT_BLOCK\n" : "",
+           WS_MAX_SHADER_LIGHT_SRC);
+  source[0] = header;
+  source[1] = text;
+  glShaderSource(shader, 2, source, NULL);
+}
+
 /*******************************************************************************
  * wsgl_shaders
  *
@@ -341,6 +328,9 @@ void wsgl_shaders(Ws * ws){
   GLenum err;
   GLint result;
   GLchar eLog[1024] = { 0 };
+  GLuint block_index;
+  int light_block;
+  Wsgl_handle wsgl = ws->render_context;
   if (ws->drawable_id){
     glXMakeCurrent(ws->display, ws->drawable_id, ws->glx_context);
   }
@@ -348,10 +338,13 @@ void wsgl_shaders(Ws * ws){
 #ifdef DEBUG
    printf("DEBUG: Shaders: initialising GLEW\n");
 #endif
-  err = glewInit();
-  if (GLEW_OK != err){
-    fprintf(stderr, "Error: %s\n", glewGetErrorString(err));
-    abort();
+  /* headless workstations initialised GLEW with their EGL context */
+  if (ws->egl_context == NULL) {
+    err = glewInit();
+    if (GLEW_OK != err){
+      fprintf(stderr, "Error: %s\n", glewGetErrorString(err));
+      abort();
+    }
   }
 #endif
 #ifdef GLEW
@@ -378,26 +371,32 @@ void wsgl_shaders(Ws * ws){
       wsgl_use_shaders = 0;
       return;
     }
+    /* light sources go into a uniform buffer when available */
+#ifdef GLEW
+    light_block = GLEW_ARB_uniform_buffer_object;
+#else
+    light_block = epoxy_has_gl_extension("GL_ARB_uniform_buffer_object");
+#endif
     vertex_shader = glCreateShader(GL_VERTEX_SHADER);
     fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
     if (strcmp(ShaderVersion, NewerVersion) < 0 ){
       printf("WARNING: Shader version is %s Using version 1.20 for shaders\n", ShaderVersion);
       glShaderSource(vertex_shader, 1, &vertex_shader_text_120, NULL);
-      glShaderSource(fragment_shader, 1, &fragment_shader_text_120, NULL);
+      fragment_shader_source(fragment_shader, "120", fragment_shader_text_120, FALSE);
     } else {
       if (strcmp(Vendor, "NVIDIA Corporation") == 0){
         printf("Detected NVIDIA card. Using 1.30 for vertex and fragment shaders\n");
         glShaderSource(vertex_shader, 1, &vertex_shader_text_130, NULL);
-        glShaderSource(fragment_shader, 1, &fragment_shader_text_130, NULL);
+        fragment_shader_source(fragment_shader, "130", fragment_shader_text_130, light_block);
       } else if (strcmp(Vendor, "Intel") == 0) {
         printf("Detected Intel card. Using 1.20 for vertex and 1.30 for fragment shader\n");
         glShaderSource(vertex_shader, 1, &vertex_shader_text_120, NULL);
-        glShaderSource(fragment_shader, 1, &fragment_shader_text_130, NULL);
+        fragment_shader_source(fragment_shader, "130", fragment_shader_text_130, light_block);
       } else {
         printf("Unknown vendor card. Trying 1.30 for vertex and 1.30 for fragment shader\n");
         printf("Please report any problems.\n");
         glShaderSource(vertex_shader, 1, &vertex_shader_text_130, NULL);
-        glShaderSource(fragment_shader, 1, &fragment_shader_text_130, NULL);
+        fragment_shader_source(fragment_shader, "130", fragment_shader_text_130, light_block);
       }
     }
     // compile vertex shader
@@ -442,48 +441,33 @@ void wsgl_shaders(Ws * ws){
     point0 = glGetUniformLocation(ws->program, "point0");
     // shading mode
     shading_mode = glGetUniformLocation(ws->program, "ShadingMode");
+    // marker sprites
+    marker_shape = glGetUniformLocation(ws->program, "MarkerShape");
+    marker_corners = glGetUniformLocation(ws->program, "MarkerCorners");
+    marker_size = glGetUniformLocation(ws->program, "MarkerSize");
+    marker_viewport = glGetUniformLocation(ws->program, "Viewport");
+    glUniform1i(marker_shape, 0);
     // light sources
-    lightSource0    = glGetUniformLocation(ws->program, "lightSource0");
-    lightSourceTyp0 = glGetUniformLocation(ws->program, "lightSourceTyp0");
-    lightSourceCol0 = glGetUniformLocation(ws->program, "lightSourceCol0");
-    lightSourcePos0 = glGetUniformLocation(ws->program, "lightSourcePos0");
-    lightSourceCoef0 = glGetUniformLocation(ws->program, "lightSourceCoef0");
-    //
-    lightSource1    = glGetUniformLocation(ws->program, "lightSource1");
-    lightSourceTyp1 = glGetUniformLocation(ws->program, "lightSourceTyp1");
-    lightSourceCol1 = glGetUniformLocation(ws->program, "lightSourceCol1");
-    lightSourcePos1 = glGetUniformLocation(ws->program, "lightSourcePos1");
-    lightSourceCoef1 = glGetUniformLocation(ws->program, "lightSourceCoef1");
-    //
-    lightSource2    = glGetUniformLocation(ws->program, "lightSource2");
-    lightSourceTyp2 = glGetUniformLocation(ws->program, "lightSourceTyp2");
-    lightSourceCol2 = glGetUniformLocation(ws->program, "lightSourceCol2");
-    lightSourcePos2 = glGetUniformLocation(ws->program, "lightSourcePos2");
-    lightSourceCoef2 = glGetUniformLocation(ws->program, "lightSourceCoef2");
-    //
-    lightSource3    = glGetUniformLocation(ws->program, "lightSource3");
-    lightSourceTyp3 = glGetUniformLocation(ws->program, "lightSourceTyp3");
-    lightSourceCol3 = glGetUniformLocation(ws->program, "lightSourceCol3");
-    lightSourcePos3 = glGetUniformLocation(ws->program, "lightSourcePos3");
-    lightSourceCoef3 = glGetUniformLocation(ws->program, "lightSourceCoef3");
-    //
-    lightSource4    = glGetUniformLocation(ws->program, "lightSource4");
-    lightSourceTyp4 = glGetUniformLocation(ws->program, "lightSourceTyp4");
-    lightSourceCol4 = glGetUniformLocation(ws->program, "lightSourceCol4");
-    lightSourcePos4 = glGetUniformLocation(ws->program, "lightSourcePos4");
-    lightSourceCoef4 = glGetUniformLocation(ws->program, "lightSourceCoef4");
-    //
-    lightSource5    = glGetUniformLocation(ws->program, "lightSource5");
-    lightSourceTyp5 = glGetUniformLocation(ws->program, "lightSourceTyp5");
-    lightSourceCol5 = glGetUniformLocation(ws->program, "lightSourceCol5");
-    lightSourcePos5 = glGetUniformLocation(ws->program, "lightSourcePos5");
-    lightSourceCoef5 = glGetUniformLocation(ws->program, "lightSourceCoef5");
-    //
-    lightSource6    = glGetUniformLocation(ws->program, "lightSource6");
-    lightSourceTyp6 = glGetUniformLocation(ws->program, "lightSourceTyp6");
-    lightSourceCol6 = glGetUniformLocation(ws->program, "lightSourceCol6");
-    lightSourcePos6 = glGetUniformLocation(ws->program, "lightSourcePos6");
-    lightSourceCoef6 = glGetUniformLocation(ws->program, "lightSourceCoef6");
+    wsgl->light_block_valid = FALSE;
+    if (light_block) {
+      block_index = glGetUniformBlockIndex(ws->program, "LightBlock");
+      glUniformBlockBinding(ws->program, block_index, WS_LIGHT_BLOCK_BINDING);
+      glGenBuffers(1, &wsgl->light_buffer);
+      glBindBuffer(GL_UNIFORM_BUFFER, wsgl->light_buffer);
+      memset(&wsgl->light_block, 0, sizeof(Wsgl_light_block));
+      glBufferData(GL_UNIFORM_BUFFER,
+                   sizeof(Wsgl_light_block),
+                   &wsgl->light_block,
+                   GL_DYNAMIC_DRAW);
+      glBindBuffer(GL_UNIFORM_BUFFER, 0);
+      glBindBufferBase(GL_UNIFORM_BUFFER,
+                       WS_LIGHT_BLOCK_BINDING,
+                       wsgl->light_buffer);
+    } else {
+      num_lights = glGetUniformLocation(ws->program, "NumLights");
+      light_data = glGetUniformLocation(ws->program, "LightData");
+      glUniform1i(num_lights, 0);
+    }
     // projection matrices
     ModelViewMatrix = glGetUniformLocation(ws->program, "ModelViewMatrix");
     ProjectionMatrix = glGetUniformLocation(ws->program, "ProjectionMatrix");
@@ -42,10 +42,6 @@ static void priv_clear_area3_points(
                                     )
 {
   Pint i, vert;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
 
   glBegin(GL_POLYGON);
   for (i = 0; i < vlist->num_ints; i++) {
@@ -54,18 +50,16 @@ static void priv_clear_area3_points(
                points[vert].y,
                points[vert].z);
     if (record_geom){
-      vertex_indices[n_vertices] = wsgl_add_vertex(points[vert].x,
-                                                   points[vert].y,
-                                                   points[vert].z);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(points[vert].x,
+                      points[vert].y,
+                      points[vert].z);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -83,10 +77,6 @@ static void priv_clear_area3_ptcolrs(
                                      )
 {
   Pint i, vert;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
   
   glBegin(GL_POLYGON);
   for (i = 0; i < vlist->num_ints; i++) {
@@ -95,18 +85,16 @@ static void priv_clear_area3_ptcolrs(
                ptcolrs[vert].point.y,
                ptcolrs[vert].point.z);
     if (record_geom){
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[vert].point.x,
-                                                   ptcolrs[vert].point.y,
-                                                   ptcolrs[vert].point.z);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptcolrs[vert].point.x,
+                      ptcolrs[vert].point.y,
+                      ptcolrs[vert].point.z);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -124,10 +112,6 @@ static void priv_clear_area3_ptnorms(
                                      )
 {
   Pint i, vert;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
 
   glBegin(GL_POLYGON);
   for (i = 0; i < vlist->num_ints; i++) {
@@ -136,18 +120,16 @@ static void priv_clear_area3_ptnorms(
                ptnorms[vert].point.y,
                ptnorms[vert].point.z);
     if (record_geom){
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[vert].point.x,
-                                                   ptnorms[vert].point.y,
-                                                   ptnorms[vert].point.z);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptnorms[vert].point.x,
+                      ptnorms[vert].point.y,
+                      ptnorms[vert].point.z);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -166,10 +148,6 @@ static void priv_clear_area3_ptconorms(
                                        )
 {
   Pint i, vert;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
 
   glBegin(GL_POLYGON);
   for (i = 0; i < vlist->num_ints; i++) {
@@ -178,18 +156,16 @@ static void priv_clear_area3_ptconorms(
                ptconorms[vert].point.y,
                ptconorms[vert].point.z);
     if (record_geom){
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[vert].point.x,
-                                                   ptconorms[vert].point.y,
-                                                   ptconorms[vert].point.z);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptconorms[vert].point.x,
+                      ptconorms[vert].point.y,
+                      ptconorms[vert].point.z);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -44,8 +44,6 @@ static void priv_edges_points(
                               )
 {
   Pint i, vert1, vert2;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
 
   if (eflag == PEDGE_VISIBILITY) {
     glBegin(GL_LINES);
@@ -60,14 +58,12 @@ static void priv_edges_points(
                    points[vert2].y,
                    points[vert2].z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(points[vert1].x,
-                                                       points[vert1].y,
-                                                       points[vert1].z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(points[vert2].x,
-                                                       points[vert2].y,
-                                                       points[vert2].z);
-          n_vertices ++;
+          wsgl_rec_vertex(points[vert1].x,
+                          points[vert1].y,
+                          points[vert1].z);
+          wsgl_rec_vertex(points[vert2].x,
+                          points[vert2].y,
+                          points[vert2].z);
         }
       }
     }
@@ -82,14 +78,12 @@ static void priv_edges_points(
                    points[vert2].y,
                    points[vert2].z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(points[vert1].x,
-                                                       points[vert1].y,
-                                                       points[vert1].z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(points[vert2].x,
-                                                       points[vert2].y,
-                                                       points[vert2].z);
-          n_vertices ++;
+          wsgl_rec_vertex(points[vert1].x,
+                          points[vert1].y,
+                          points[vert1].z);
+          wsgl_rec_vertex(points[vert2].x,
+                          points[vert2].y,
+                          points[vert2].z);
         }
       }
     }
@@ -104,19 +98,17 @@ static void priv_edges_points(
                    points[vert2].y,
                    points[vert2].z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(points[vert1].x,
-                                                       points[vert1].y,
-                                                       points[vert1].z);
-          n_vertices ++;
-          vertex_indices[n_vertices] =  wsgl_add_vertex(points[vert2].x,
-                                                        points[vert2].y,
-                                                        points[vert2].z);
-          n_vertices ++;
+          wsgl_rec_vertex(points[vert1].x,
+                          points[vert1].y,
+                          points[vert1].z);
+          wsgl_rec_vertex(points[vert2].x,
+                          points[vert2].y,
+                          points[vert2].z);
         }
       }
     }
     if (record_geom){
-      wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+      wsgl_rec_geometry(GEOM_SEGMENTS);
     }
     glEnd();
   }
@@ -128,14 +120,13 @@ static void priv_edges_points(
                  points[vert1].y,
                  points[vert1].z);
       if (record_geom){
-        vertex_indices[n_vertices] = wsgl_add_vertex(points[vert1].x,
-                                                     points[vert1].y,
-                                                     points[vert1].z);
-        n_vertices ++;
+        wsgl_rec_vertex(points[vert1].x,
+                        points[vert1].y,
+                        points[vert1].z);
       }
     }
     if (record_geom){
-      wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+      wsgl_rec_geometry(GEOM_LINE);
     }
     glEnd();
   }
@@ -156,8 +147,6 @@ static void priv_edges_ptcolrs(
                                )
 {
   Pint i, vert1, vert2;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
 
   if (eflag == PEDGE_VISIBILITY) {
     glBegin(GL_LINES);
@@ -172,14 +161,12 @@ static void priv_edges_ptcolrs(
                    ptcolrs[vert2].point.y,
                    ptcolrs[vert2].point.z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[vert1].point.x,
-                                                       ptcolrs[vert1].point.y,
-                                                       ptcolrs[vert1].point.z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[vert2].point.x,
-                                                       ptcolrs[vert2].point.y,
-                                                       ptcolrs[vert2].point.z);
-          n_vertices ++;
+          wsgl_rec_vertex(ptcolrs[vert1].point.x,
+                          ptcolrs[vert1].point.y,
+                          ptcolrs[vert1].point.z);
+          wsgl_rec_vertex(ptcolrs[vert2].point.x,
+                          ptcolrs[vert2].point.y,
+                          ptcolrs[vert2].point.z);
         }
       }
     }
@@ -194,14 +181,12 @@ static void priv_edges_ptcolrs(
                    ptcolrs[vert2].point.y,
                    ptcolrs[vert2].point.z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[vert1].point.x,
-                                                       ptcolrs[vert1].point.y,
-                                                       ptcolrs[vert1].point.z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[vert2].point.x,
-                                                       ptcolrs[vert2].point.y,
-                                                       ptcolrs[vert2].point.z);
-          n_vertices ++;
+          wsgl_rec_vertex(ptcolrs[vert1].point.x,
+                          ptcolrs[vert1].point.y,
+                          ptcolrs[vert1].point.z);
+          wsgl_rec_vertex(ptcolrs[vert2].point.x,
+                          ptcolrs[vert2].point.y,
+                          ptcolrs[vert2].point.z);
         }
       }
     }
@@ -216,19 +201,17 @@ static void priv_edges_ptcolrs(
                    ptcolrs[vert2].point.y,
                    ptcolrs[vert2].point.z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[vert1].point.x,
-                                                       ptcolrs[vert1].point.y,
-                                                       ptcolrs[vert1].point.z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[vert2].point.x,
-                                                       ptcolrs[vert2].point.y,
-                                                       ptcolrs[vert2].point.z);
-          n_vertices ++;
+          wsgl_rec_vertex(ptcolrs[vert1].point.x,
+                          ptcolrs[vert1].point.y,
+                          ptcolrs[vert1].point.z);
+          wsgl_rec_vertex(ptcolrs[vert2].point.x,
+                          ptcolrs[vert2].point.y,
+                          ptcolrs[vert2].point.z);
         }
       }
     }
     if (record_geom){
-      wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+      wsgl_rec_geometry(GEOM_SEGMENTS);
     }
     glEnd();
   }
@@ -240,14 +223,13 @@ static void priv_edges_ptcolrs(
                  ptcolrs[vert1].point.y,
                  ptcolrs[vert1].point.z);
       if (record_geom){
-        vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[vert1].point.x,
-                                                     ptcolrs[vert1].point.y,
-                                                     ptcolrs[vert1].point.z);
-        n_vertices ++;
+        wsgl_rec_vertex(ptcolrs[vert1].point.x,
+                        ptcolrs[vert1].point.y,
+                        ptcolrs[vert1].point.z);
       }
     }
     if (record_geom){
-      wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+      wsgl_rec_geometry(GEOM_LINE);
     }
     glEnd();
   }
@@ -268,8 +250,6 @@ static void priv_edges_ptnorms(
                                )
 {
   Pint i, vert1, vert2;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
 
   if (eflag == PEDGE_VISIBILITY) {
     glBegin(GL_LINES);
@@ -284,14 +264,12 @@ static void priv_edges_ptnorms(
                    ptnorms[vert2].point.y,
                    ptnorms[vert2].point.z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[vert1].point.x,
-                                                       ptnorms[vert1].point.y,
-                                                       ptnorms[vert1].point.z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[vert2].point.x,
-                                                       ptnorms[vert2].point.y,
-                                                       ptnorms[vert2].point.z);
-          n_vertices ++;
+          wsgl_rec_vertex(ptnorms[vert1].point.x,
+                          ptnorms[vert1].point.y,
+                          ptnorms[vert1].point.z);
+          wsgl_rec_vertex(ptnorms[vert2].point.x,
+                          ptnorms[vert2].point.y,
+                          ptnorms[vert2].point.z);
         }
       }
     }
@@ -306,14 +284,12 @@ static void priv_edges_ptnorms(
                    ptnorms[vert2].point.y,
                    ptnorms[vert2].point.z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[vert1].point.x,
-                                                       ptnorms[vert1].point.y,
-                                                       ptnorms[vert1].point.z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[vert2].point.x,
-                                                       ptnorms[vert2].point.y,
-                                                       ptnorms[vert2].point.z);
-          n_vertices ++;
+          wsgl_rec_vertex(ptnorms[vert1].point.x,
+                          ptnorms[vert1].point.y,
+                          ptnorms[vert1].point.z);
+          wsgl_rec_vertex(ptnorms[vert2].point.x,
+                          ptnorms[vert2].point.y,
+                          ptnorms[vert2].point.z);
         }
       }
     }
@@ -328,19 +304,17 @@ static void priv_edges_ptnorms(
                    ptnorms[vert2].point.y,
                    ptnorms[vert2].point.z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[vert1].point.x,
-                                                       ptnorms[vert1].point.y,
-                                                       ptnorms[vert1].point.z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[vert2].point.x,
-                                                       ptnorms[vert2].point.y,
-                                                       ptnorms[vert2].point.z);
-          n_vertices ++;
+          wsgl_rec_vertex(ptnorms[vert1].point.x,
+                          ptnorms[vert1].point.y,
+                          ptnorms[vert1].point.z);
+          wsgl_rec_vertex(ptnorms[vert2].point.x,
+                          ptnorms[vert2].point.y,
+                          ptnorms[vert2].point.z);
         }
       }
     }
     if (record_geom){
-      wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+      wsgl_rec_geometry(GEOM_SEGMENTS);
     }
     glEnd();
   }
@@ -352,14 +326,13 @@ static void priv_edges_ptnorms(
                  ptnorms[vert1].point.y,
                  ptnorms[vert1].point.z);
       if (record_geom){
-        vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[vert1].point.x,
-                                                     ptnorms[vert1].point.y,
-                                                     ptnorms[vert1].point.z);
-        n_vertices ++;
+        wsgl_rec_vertex(ptnorms[vert1].point.x,
+                        ptnorms[vert1].point.y,
+                        ptnorms[vert1].point.z);
       }
     }
     if (record_geom){
-      wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+      wsgl_rec_geometry(GEOM_LINE);
     }
     glEnd();
   }
@@ -380,8 +353,6 @@ static void priv_edges_ptconorms(
                                  )
 {
   Pint i, vert1, vert2;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
 
   if (eflag == PEDGE_VISIBILITY) {
     glBegin(GL_LINES);
@@ -396,14 +367,12 @@ static void priv_edges_ptconorms(
                    ptconorms[vert2].point.y,
                    ptconorms[vert2].point.z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[vert1].point.x,
-                                                       ptconorms[vert1].point.y,
-                                                       ptconorms[vert1].point.z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[vert2].point.x,
-                                                       ptconorms[vert2].point.y,
-                                                       ptconorms[vert2].point.z);
-          n_vertices ++;
+          wsgl_rec_vertex(ptconorms[vert1].point.x,
+                          ptconorms[vert1].point.y,
+                          ptconorms[vert1].point.z);
+          wsgl_rec_vertex(ptconorms[vert2].point.x,
+                          ptconorms[vert2].point.y,
+                          ptconorms[vert2].point.z);
         }
       }
     }
@@ -418,14 +387,12 @@ static void priv_edges_ptconorms(
                    ptconorms[vert2].point.y,
                    ptconorms[vert2].point.z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[vert1].point.x,
-                                                       ptconorms[vert1].point.y,
-                                                       ptconorms[vert1].point.z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[vert2].point.x,
-                                                       ptconorms[vert2].point.y,
-                                                       ptconorms[vert2].point.z);
-          n_vertices ++;
+          wsgl_rec_vertex(ptconorms[vert1].point.x,
+                          ptconorms[vert1].point.y,
+                          ptconorms[vert1].point.z);
+          wsgl_rec_vertex(ptconorms[vert2].point.x,
+                          ptconorms[vert2].point.y,
+                          ptconorms[vert2].point.z);
         }
       }
     }
@@ -440,19 +407,17 @@ static void priv_edges_ptconorms(
                    ptconorms[vert2].point.y,
                    ptconorms[vert2].point.z);
         if (record_geom){
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[vert1].point.x,
-                                                       ptconorms[vert1].point.y,
-                                                       ptconorms[vert1].point.z);
-          n_vertices ++;
-          vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[vert2].point.x,
-                                                       ptconorms[vert2].point.y,
-                                                       ptconorms[vert2].point.z);
-          n_vertices ++;
+          wsgl_rec_vertex(ptconorms[vert1].point.x,
+                          ptconorms[vert1].point.y,
+                          ptconorms[vert1].point.z);
+          wsgl_rec_vertex(ptconorms[vert2].point.x,
+                          ptconorms[vert2].point.y,
+                          ptconorms[vert2].point.z);
         }
       }
     }
     if (record_geom){
-      wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+      wsgl_rec_geometry(GEOM_SEGMENTS);
     }
     glEnd();
   }
@@ -464,14 +429,13 @@ static void priv_edges_ptconorms(
                  ptconorms[vert1].point.y,
                  ptconorms[vert1].point.z);
       if (record_geom){
-        vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[vert1].point.x,
-                                                     ptconorms[vert1].point.y,
-                                                     ptconorms[vert1].point.z);
-        n_vertices ++;
+        wsgl_rec_vertex(ptconorms[vert1].point.x,
+                        ptconorms[vert1].point.y,
+                        ptconorms[vert1].point.z);
       }
     }
     if (record_geom){
-      wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+      wsgl_rec_geometry(GEOM_LINE);
     }
     glEnd();
   }
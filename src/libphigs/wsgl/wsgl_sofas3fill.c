@@ -31,6 +31,38 @@
 #include "private/wsglP.h"
 #include "private/sofas3P.h"
 
+static Pint *lod_remap = NULL;
+
+/*******************************************************************************
+ * priv_lod_polygon
+ *
+ * DESCR:	Check if a polygon still has an area at the selected level
+ *              of detail
+ * RETURNS:	FALSE if the polygon collapses
+ */
+
+static int priv_lod_polygon(
+                            Pint_list *vlist
+                            )
+{
+  Pint i, n, vert, prev;
+
+  if (lod_remap == NULL) {
+    return TRUE;
+  }
+
+  prev = -1;
+  for (i = 0, n = 0; i < vlist->num_ints && n < 3; i++) {
+    vert = lod_remap[vlist->ints[i]];
+    if (vert != prev) {
+      n++;
+      prev = vert;
+    }
+  }
+
+  return (n >= 3);
+}
+
 /*******************************************************************************
  * priv_fill_area3_points
  *
@@ -43,15 +75,23 @@ static void priv_fill_area3_points(
                                    Ppoint3 *points
                                    )
 {
-  Pint i, vert;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
+  Pint i, vert, prev;
 
+  if (!priv_lod_polygon(vlist)) {
+    return;
+  }
+
+  prev = -1;
   glBegin(GL_POLYGON);
   for (i = 0; i < vlist->num_ints; i++) {
     vert = vlist->ints[i];
+    if (lod_remap != NULL) {
+      vert = lod_remap[vert];
+      if (vert == prev) {
+        continue;
+      }
+      prev = vert;
+    }
     glVertex3f(points[vert].x,
                points[vert].y,
                points[vert].z);
@@ -59,18 +99,16 @@ static void priv_fill_area3_points(
 #ifdef DEBUG_OBJ
       printf("wsgl_sofas3fill: priv_fill_area3_points called");
 #endif
-      vertex_indices[n_vertices] = wsgl_add_vertex(points[vert].x,
-                                                   points[vert].y,
-                                                   points[vert].z);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(points[vert].x,
+                      points[vert].y,
+                      points[vert].z);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom && record_geom_fill){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -90,15 +128,23 @@ static void priv_fill_area3_ptcolrs(
                                     Ws_attr_st *ast
                                     )
 {
-  Pint i, vert;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
+  Pint i, vert, prev;
+
+  if (!priv_lod_polygon(vlist)) {
+    return;
+  }
 
+  prev = -1;
   glBegin(GL_POLYGON);
   for (i = 0; i < vlist->num_ints; i++) {
     vert = vlist->ints[i];
+    if (lod_remap != NULL) {
+      vert = lod_remap[vert];
+      if (vert == prev) {
+        continue;
+      }
+      prev = vert;
+    }
     wsgl_setup_int_colr(ws, colr_type, &ptcolrs[vert].colr, ast);
     glVertex3f(ptcolrs[vert].point.x,
                ptcolrs[vert].point.y,
@@ -107,18 +153,16 @@ static void priv_fill_area3_ptcolrs(
 #ifdef DEBUG_OBJ
       printf("wsgl_sofas3fill: priv_fill_area3_ptcolrs called");
 #endif
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[vert].point.x,
-                                                   ptcolrs[vert].point.y,
-                                                   ptcolrs[vert].point.z);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptcolrs[vert].point.x,
+                      ptcolrs[vert].point.y,
+                      ptcolrs[vert].point.z);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom && record_geom_fill){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
    glEnd();
 }
@@ -138,15 +182,23 @@ static void priv_back_area3_ptcolrs(
                                     Ws_attr_st *ast
                                     )
 {
-  Pint i, vert;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
+  Pint i, vert, prev;
+
+  if (!priv_lod_polygon(vlist)) {
+    return;
+  }
 
+  prev = -1;
   glBegin(GL_POLYGON);
   for (i = 0; i < vlist->num_ints; i++) {
     vert = vlist->ints[i];
+    if (lod_remap != NULL) {
+      vert = lod_remap[vert];
+      if (vert == prev) {
+        continue;
+      }
+      prev = vert;
+    }
     wsgl_setup_back_int_colr(ws, colr_type, &ptcolrs[vert].colr, ast);
     glVertex3f(ptcolrs[vert].point.x,
                ptcolrs[vert].point.y,
@@ -155,18 +207,16 @@ static void priv_back_area3_ptcolrs(
 #ifdef DEBUG_OBJ
       printf("wsgl_sofas3fill: priv_back_area3_ptcolrs called");
 #endif
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptcolrs[vert].point.x,
-                                                   ptcolrs[vert].point.y,
-                                                   ptcolrs[vert].point.z);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptcolrs[vert].point.x,
+                      ptcolrs[vert].point.y,
+                      ptcolrs[vert].point.z);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom && record_geom_fill){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -183,15 +233,23 @@ static void priv_fill_area3_ptnorms(
                                     Pptnorm3 *ptnorms
                                     )
 {
-  Pint i, vert;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
+  Pint i, vert, prev;
 
+  if (!priv_lod_polygon(vlist)) {
+    return;
+  }
+
+  prev = -1;
   glBegin(GL_POLYGON);
   for (i = 0; i < vlist->num_ints; i++) {
     vert = vlist->ints[i];
+    if (lod_remap != NULL) {
+      vert = lod_remap[vert];
+      if (vert == prev) {
+        continue;
+      }
+      prev = vert;
+    }
     glNormal3f(ptnorms[vert].norm.delta_x,
                ptnorms[vert].norm.delta_y,
                ptnorms[vert].norm.delta_z);
@@ -205,18 +263,16 @@ static void priv_fill_area3_ptnorms(
 #ifdef DEBUG_OBJ
       printf("wsgl_sofas3fill: priv_fill_area3_ptnorms called");
 #endif
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptnorms[vert].point.x,
-                                                   ptnorms[vert].point.y,
-                                                   ptnorms[vert].point.z);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptnorms[vert].point.x,
+                      ptnorms[vert].point.y,
+                      ptnorms[vert].point.z);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom && record_geom_fill){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -237,15 +293,23 @@ static void priv_fill_area3_ptconorms(
                                       Ws_attr_st *ast
                                       )
 {
-  Pint i, vert;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
+  Pint i, vert, prev;
+
+  if (!priv_lod_polygon(vlist)) {
+    return;
+  }
 
+  prev = -1;
   glBegin(GL_POLYGON);
   for (i = 0; i < vlist->num_ints; i++) {
     vert = vlist->ints[i];
+    if (lod_remap != NULL) {
+      vert = lod_remap[vert];
+      if (vert == prev) {
+        continue;
+      }
+      prev = vert;
+    }
     wsgl_setup_int_colr(ws, colr_type, &ptconorms[vert].colr, ast);
     glNormal3f(ptconorms[vert].norm.delta_x,
                ptconorms[vert].norm.delta_y,
@@ -260,18 +324,16 @@ static void priv_fill_area3_ptconorms(
 #ifdef DEBUG_OBJ
       printf("wsgl_sofas3fill: priv_fill_area3_ptconorms called");
 #endif
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[vert].point.x,
-                                                   ptconorms[vert].point.y,
-                                                   ptconorms[vert].point.z);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptconorms[vert].point.x,
+                      ptconorms[vert].point.y,
+                      ptconorms[vert].point.z);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom && record_geom_fill){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -292,15 +354,23 @@ static void priv_back_area3_ptconorms(
                                       Ws_attr_st *ast
                                       )
 {
-  Pint i, vert;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-  int normal_indices[MAX_VERTICES];
-  int n_normals = 0;
+  Pint i, vert, prev;
 
+  if (!priv_lod_polygon(vlist)) {
+    return;
+  }
+
+  prev = -1;
   glBegin(GL_POLYGON);
   for (i = 0; i < vlist->num_ints; i++) {
     vert = vlist->ints[i];
+    if (lod_remap != NULL) {
+      vert = lod_remap[vert];
+      if (vert == prev) {
+        continue;
+      }
+      prev = vert;
+    }
     wsgl_setup_back_int_colr(ws, colr_type, &ptconorms[vert].colr, ast);
     glNormal3f(ptconorms[vert].norm.delta_x,
                ptconorms[vert].norm.delta_y,
@@ -315,18 +385,16 @@ static void priv_back_area3_ptconorms(
 #ifdef DEBUG_OBJ
       printf("wsgl_sofas3fill: priv_back_area3_ptconorms called");
 #endif
-      vertex_indices[n_vertices] = wsgl_add_vertex(ptconorms[vert].point.x,
-                                                   ptconorms[vert].point.y,
-                                                   ptconorms[vert].point.z);
-      n_vertices ++;
-      normal_indices[n_normals] = wsgl_add_normal(current_normal.x,
-                                                  current_normal.y,
-                                                  current_normal.z);
-      n_normals ++;
+      wsgl_rec_vertex(ptconorms[vert].point.x,
+                      ptconorms[vert].point.y,
+                      ptconorms[vert].point.z);
+      wsgl_rec_normal(current_normal.x,
+                      current_normal.y,
+                      current_normal.z);
     }
   }
   if (record_geom && record_geom_fill){
-    wsgl_add_geometry(GEOM_FACE, vertex_indices, normal_indices, n_vertices);
+    wsgl_rec_geometry(GEOM_FACE);
   }
   glEnd();
 }
@@ -352,6 +420,7 @@ void wsgl_set_of_fill_area_set3_data_front(
   Pvec3 norm;
 
   sofas3_head(&sofas3, pdata);
+  lod_remap = ((Wsgl_handle) ws->render_context)->lod_remap;
 
   glPolygonOffset(WS_FILL_AREA_OFFSET, wsgl_get_edge_width(ast));
   glEnable(GL_POLYGON_OFFSET_FILL);
@@ -545,6 +614,7 @@ void wsgl_set_of_fill_area_set3_data_back(
   Pvec3 norm;
 
   sofas3_head(&sofas3, pdata);
+  lod_remap = ((Wsgl_handle) ws->render_context)->lod_remap;
 
   glPolygonOffset(WS_FILL_AREA_OFFSET, wsgl_get_edge_width(ast));
   glEnable(GL_POLYGON_OFFSET_FILL);
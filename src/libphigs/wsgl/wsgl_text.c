@@ -24,7 +24,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#ifdef GLEW
+#include <GL/glew.h>
 #include <GL/gl.h>
+#else
+#include <epoxy/gl.h>
+#endif
 
 #include "phg.h"
 #include "private/phgP.h"
@@ -399,6 +404,276 @@ static void wsgl_set_anno_text_align3(
 
 }
 
+/*******************************************************************************
+ * wsgl_text_key_hash
+ *
+ * DESCR:    Hash key and string of a stroke text element
+ * RETURNS:  Hash value
+ */
+static int wsgl_text_key_hash(
+                              Ws_text_key *key,
+                              char *str
+                              )
+{
+  unsigned char *p = (unsigned char *) key;
+  uint32_t h = 2166136261u;
+  size_t i;
+
+  for (i = 0; i < sizeof(Ws_text_key); i++) {
+    h = (h ^ p[i]) * 16777619u;
+  }
+  for (p = (unsigned char *) str; *p != '\0'; p++) {
+    h = (h ^ *p) * 16777619u;
+  }
+  return (int) (h & 0x7fffffff);
+}
+
+/*******************************************************************************
+ * wsgl_text_geom_free
+ *
+ * DESCR:    Free a chain of cached text geometries
+ * RETURNS:  N/A
+ */
+static void wsgl_text_geom_free(
+                                int hash,
+                                caddr_t data
+                                )
+{
+  Ws_text_geom *geom, *next;
+
+  for (geom = (Ws_text_geom *) data; geom != NULL; geom = next) {
+    next = geom->next;
+    free(geom);
+  }
+}
+
+/*******************************************************************************
+ * wsgl_text_cache_flush
+ *
+ * DESCR:    Discard all cached stroke text geometry. If the new table
+ *           can not be allocated the cache stays disabled.
+ * RETURNS:  N/A
+ */
+void wsgl_text_cache_flush(
+                           Ws *ws
+                           )
+{
+  Wsgl_handle wsgl = ws->render_context;
+
+  if (wsgl->text_cache != NULL && wsgl->text_cache_entries > 0) {
+    phg_htab_destroy(wsgl->text_cache, wsgl_text_geom_free);
+    wsgl->text_cache = phg_htab_create(WS_TEXT_CACHE_HASH_SIZE);
+    wsgl->text_cache_entries = 0;
+  }
+}
+
+/*******************************************************************************
+ * wsgl_text_cache_lookup
+ *
+ * DESCR:    Find cached geometry for a stroke text element
+ * RETURNS:  Geometry or NULL
+ */
+static Ws_text_geom *wsgl_text_cache_lookup(
+                                            Ws *ws,
+                                            Ws_text_key *key,
+                                            char *str
+                                            )
+{
+  Wsgl_handle wsgl = ws->render_context;
+  caddr_t data;
+  Ws_text_geom *geom;
+
+  if (wsgl->text_cache == NULL ||
+      !phg_htab_get_entry(wsgl->text_cache,
+                          wsgl_text_key_hash(key, str),
+                          &data)) {
+    return NULL;
+  }
+  for (geom = (Ws_text_geom *) data; geom != NULL; geom = geom->next) {
+    if (memcmp(&geom->key, key, sizeof(Ws_text_key)) == 0 &&
+        strcmp(geom->str, str) == 0) {
+      return geom;
+    }
+  }
+  return NULL;
+}
+
+/*******************************************************************************
+ * wsgl_text_cache_build
+ *
+ * DESCR:    Stroke all glyphs of a string once and store the resulting
+ *           line strips in the cache. The geometry is stored in the
+ *           coordinates passed to OpenGL, i.e. after transformation by
+ *           the key matrix. With the cache disabled the geometry is
+ *           returned without being stored and the caller frees it.
+ * RETURNS:  Geometry or NULL on error
+ */
+static Ws_text_geom *wsgl_text_cache_build(
+                                           Ws *ws,
+                                           Ws_text_key *key,
+                                           char *str,
+                                           Ppoint3 *start
+                                           )
+{
+  Wsgl_handle wsgl = ws->render_context;
+  Ws_text_geom *geom;
+  caddr_t data;
+  Phg_font *fnt = key->fnt;
+  Phg_char *ch;
+  Ppoint_list *spath;
+  Ppoint pt;
+  Ppoint3 pos, pc;
+  Pvec right;
+  Pfloat height;
+  Pint num_strips, num_vertices;
+  size_t i, len, size;
+  int j, z, hash;
+  Pint s, v;
+
+  len = strlen(str);
+  num_strips = 0;
+  num_vertices = 0;
+  for (i = 0; i < len; i++) {
+    ch = &fnt->chars[(int) str[i]];
+    for (j = 0; j < ch->num_paths; j++) {
+      num_strips++;
+      num_vertices += ch->paths[j].num_points;
+    }
+  }
+
+  /* one block for header, strip table, vertices and string */
+  size = sizeof(Ws_text_geom) +
+    num_vertices * sizeof(Ppoint3) +
+    num_strips * (sizeof(GLint) + sizeof(GLsizei)) +
+    len + 1;
+  geom = (Ws_text_geom *) malloc(size);
+  if (geom == NULL) {
+    return NULL;
+  }
+  memcpy(&geom->key, key, sizeof(Ws_text_key));
+  geom->num_strips = num_strips;
+  geom->num_vertices = num_vertices;
+  geom->vertices = (Ppoint3 *) &geom[1];
+  geom->first = (GLint *) &geom->vertices[num_vertices];
+  geom->count = (GLsizei *) &geom->first[num_strips];
+  geom->str = (char *) &geom->count[num_strips];
+  strcpy(geom->str, str);
+
+  height = fnt->top - fnt->bottom;
+  right.delta_x =  key->up.delta_y;
+  right.delta_y = -key->up.delta_x;
+  pos = *start;
+  s = 0;
+  v = 0;
+  for (i = 0; i < len; i++) {
+
+    ch = &fnt->chars[(int) str[i]];
+    for (j = 0, spath = ch->paths;
+         j < ch->num_paths;
+         j++, spath++) {
+      geom->first[s] = v;
+      geom->count[s] = spath->num_points;
+      s++;
+      for (z = 0; z < spath->num_points; z++) {
+        pt.x = spath->points[z].x * right.delta_x +
+          spath->points[z].y * right.delta_y;
+        pt.y = spath->points[z].x * key->up.delta_x +
+          spath->points[z].y * key->up.delta_y;
+        pc.x = pos.x + pt.x * key->char_ht * key->char_expan;
+        pc.y = pos.y + pt.y * key->char_ht;
+        pc.z = pos.z;
+        if (!phg_tranpt3(&pc, key->tran, &geom->vertices[v])) {
+          geom->vertices[v] = pc;
+        }
+        v++;
+      }
+    }
+
+    switch (key->path) {
+    case PPATH_RIGHT:
+      pos.x += (ch->right + key->char_space) *
+        right.delta_x * key->char_ht * key->char_expan;
+      pos.y += (ch->right + key->char_space) *
+        key->up.delta_x * key->char_ht * key->char_expan;
+      break;
+
+    case PPATH_LEFT:
+      pos.x -= (ch->right + key->char_space) *
+        right.delta_x * key->char_ht * key->char_expan;
+      pos.y -= (ch->right + key->char_space) *
+        key->up.delta_x * key->char_ht * key->char_expan;
+      break;
+
+    case PPATH_UP:
+      pos.x += (height + key->char_space) * right.delta_y * key->char_ht;
+      pos.y += (height + key->char_space) * key->up.delta_y * key->char_ht;
+      break;
+
+    case PPATH_DOWN:
+      pos.x -= (height + key->char_space) * right.delta_y * key->char_ht;
+      pos.y -= (height + key->char_space) * key->up.delta_y * key->char_ht;
+      break;
+    }
+  }
+
+  /* keep the cache bounded, texts of a scene normally fit easily */
+  if (wsgl->text_cache_entries >= WS_TEXT_CACHE_MAX) {
+    wsgl_text_cache_flush(ws);
+  }
+  if (wsgl->text_cache == NULL) {
+    geom->next = NULL;
+    return geom;
+  }
+  hash = wsgl_text_key_hash(key, str);
+  if (phg_htab_get_entry(wsgl->text_cache, hash, &data)) {
+    geom->next = (Ws_text_geom *) data;
+    phg_htab_change_data(wsgl->text_cache, hash, (caddr_t) geom);
+  }
+  else {
+    geom->next = NULL;
+    if (!phg_htab_add_entry(wsgl->text_cache, hash, (caddr_t) geom)) {
+      free(geom);
+      return NULL;
+    }
+  }
+  wsgl->text_cache_entries++;
+
+  return geom;
+}
+
+/*******************************************************************************
+ * wsgl_text_draw_geom
+ *
+ * DESCR:    Draw cached stroke text geometry as one batch
+ * RETURNS:  N/A
+ */
+static void wsgl_text_draw_geom(
+                                Ws_text_geom *geom
+                                )
+{
+  Pint s, v;
+
+  glEnable(GL_LINE_SMOOTH);
+  glEnable(GL_BLEND);
+  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  glHint(GL_LINE_SMOOTH_HINT, GL_DONT_CARE);
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glVertexPointer(3, GL_FLOAT, sizeof(Ppoint3), geom->vertices);
+  glMultiDrawArrays(GL_LINE_STRIP, geom->first, geom->count, geom->num_strips);
+  glDisableClientState(GL_VERTEX_ARRAY);
+
+  if (record_geom) {
+    for (s = 0; s < geom->num_strips; s++) {
+      for (v = geom->first[s]; v < geom->first[s] + geom->count[s]; v++) {
+        wsgl_rec_vertex(geom->vertices[v].x,
+                        geom->vertices[v].y,
+                        geom->vertices[v].z);
+      }
+      wsgl_rec_geometry(GEOM_LINE);
+    }
+  }
+}
+
 /*******************************************************************************
  * wsgl_text_string
  *
@@ -421,8 +696,6 @@ static void wsgl_text_string(
   Ppoint_list *spath;
   Ppoint pos, posa;
   int j, z;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
 
   wsgl_setup_text_attr(ast, &fnt, &char_expan);
   char_ht = ast->char_ht;
@@ -451,14 +724,13 @@ static void wsgl_text_string(
           glVertex2f(pos.x + spath->points[z].x * char_ht * char_expan,
                      pos.y + spath->points[z].y * char_ht);
           if (record_geom){
-            vertex_indices[n_vertices] = wsgl_add_vertex(pos.x + spath->points[z].x * char_ht * char_expan,
-                                                         pos.y + spath->points[z].y * char_ht,
-                                                         0.0);
-            n_vertices ++;
+            wsgl_rec_vertex(pos.x + spath->points[z].x * char_ht * char_expan,
+                            pos.y + spath->points[z].y * char_ht,
+                            0.0);
           }
         }
         if (record_geom){
-          wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+          wsgl_rec_geometry(GEOM_LINE);
         }
         glEnd();
       }
@@ -492,9 +764,6 @@ static void wsgl_text_string3(
   int j, z;
   Ppoint3 pwc;
 
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-
   wsgl_setup_text_attr(ast, &fnt, &char_expan);
   char_ht = ast->char_ht;
 
@@ -525,12 +794,11 @@ static void wsgl_text_string3(
                                pos.y + spath->points[z].y * char_ht,
                                pos.z, &pwc);
           if (record_geom){
-            vertex_indices[n_vertices] = wsgl_add_vertex(pwc.x, pwc.y, pwc.z);
-            n_vertices ++;
+            wsgl_rec_vertex(pwc.x, pwc.y, pwc.z);
           }
         }
         if (record_geom){
-          wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+          wsgl_rec_geometry(GEOM_LINE);
         }
         glEnd();
       }
@@ -564,9 +832,6 @@ static void wsgl_anno_text_string3(
   int j, z;
   Ppoint3 pwc;
 
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-
   wsgl_setup_text_attr(ast, &fnt, &char_expan);
   char_ht = ast->anno_char_ht;
 
@@ -598,12 +863,11 @@ static void wsgl_anno_text_string3(
                                pos.y + spath->points[z].y * char_ht,
                                pos.z, &pwc);
           if (record_geom){
-            vertex_indices[n_vertices] = wsgl_add_vertex(pwc.x, pwc.y, pwc.z);
-            n_vertices ++;
+            wsgl_rec_vertex(pwc.x, pwc.y, pwc.z);
           }
         }
         if (record_geom){
-          wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+          wsgl_rec_geometry(GEOM_LINE);
         }
         glEnd();
       }
@@ -638,9 +902,6 @@ static void wsgl_text_char(
   Ppoint pos, posa;
   int j, z;
 
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-
   wsgl_setup_text_attr(ast, &fnt, &char_expan);
   char_ht = ast->char_ht;
   char_space = wsgl_get_char_space(ast);
@@ -670,13 +931,12 @@ static void wsgl_text_char(
           glVertex2f(pos.x + spath->points[z].x * char_ht * char_expan,
                      pos.y + spath->points[z].y * char_ht);
           if (record_geom){
-            vertex_indices[n_vertices] = wsgl_add_vertex(pos.x + spath->points[z].x * char_ht * char_expan,
-                                                         pos.y + spath->points[z].y * char_ht, 0.);
-            n_vertices ++;
+            wsgl_rec_vertex(pos.x + spath->points[z].x * char_ht * char_expan,
+                            pos.y + spath->points[z].y * char_ht, 0.);
           }
         }
         if (record_geom){
-          wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+          wsgl_rec_geometry(GEOM_LINE);
         }
         glEnd();
       }
@@ -730,9 +990,6 @@ static void wsgl_text_char3(
   int j, z;
   Ppoint3 pwc;
 
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-
   wsgl_setup_text_attr(ast, &fnt, &char_expan);
   char_ht = ast->char_ht;
   char_space = wsgl_get_char_space(ast);
@@ -767,12 +1024,11 @@ static void wsgl_text_char3(
                                pos.y + spath->points[z].y * char_ht,
                                pos.z, &pwc);
           if (record_geom){
-            vertex_indices[n_vertices] = wsgl_add_vertex(pwc.x, pwc.y, pwc.z);
-            n_vertices ++;
+            wsgl_rec_vertex(pwc.x, pwc.y, pwc.z);
           }
         }
         if (record_geom){
-          wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+          wsgl_rec_geometry(GEOM_LINE);
         }
         glEnd();
       }
@@ -826,9 +1082,6 @@ static void wsgl_anno_text_char3(
   int j, z;
   Ppoint3 pwc;
 
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
-
   wsgl_setup_text_attr(ast, &fnt, &char_expan);
   char_ht = ast->anno_char_ht;
   char_space = wsgl_get_char_space(ast);
@@ -863,12 +1116,11 @@ static void wsgl_anno_text_char3(
                                pos.y + spath->points[z].y * char_ht,
                                pos.z, &pwc);
           if (record_geom){
-            vertex_indices[n_vertices] = wsgl_add_vertex(pwc.x, pwc.y, pwc.z);
-            n_vertices ++;
+            wsgl_rec_vertex(pwc.x, pwc.y, pwc.z);
           }
         }
         if (record_geom){
-          wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
+          wsgl_rec_geometry(GEOM_LINE);
         }
         glEnd();
       }
@@ -907,98 +1159,45 @@ static void wsgl_text_stroke(
                              Ws_attr_st *ast
                              )
 {
+  Wsgl_handle wsgl = ws->render_context;
   Phg_font *fnt;
-  Pfloat char_ht;
   Pfloat char_expan;
-  Pfloat char_space;
-  Pfloat height;
-  Ptext_path text_path;
-  char *str;
-  size_t i, len;
-  Phg_char *ch;
-  Ppoint_list *spath;
-  Ppoint pt, pos, posa;
-  int j, z;
-  Pvec *up;
-  Pvec right;
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
+  Ppoint pos, posa;
+  Ppoint3 start;
+  Ws_text_key key;
+  Ws_text_geom *geom;
 
   wsgl_setup_text_attr(ast, &fnt, &char_expan);
-  char_ht = ast->char_ht;
-  char_space = wsgl_get_char_space(ast);
-  text_path = ast->text_path;
-  height = fnt->top - fnt->bottom;
-  up = &ast->char_up_vec;
-
-  right.delta_x =  up->delta_y;
-  right.delta_y = -up->delta_x;
 
-  posa.x = text->pos.x;
-  posa.y = text->pos.y;
-  wsgl_set_text_align(text, ast, posa, &pos);
-  str = text->char_string;
-
-  len = strlen(str);
-  for (i = 0; i < len; i++) {
-
-    ch = &fnt->chars[(int) str[i]];
-    if (ch->num_paths > 0) {
-
-      for (j = 0, spath = ch->paths;
-           j < ch->num_paths;
-           j++, spath++) {
-        glEnable(GL_LINE_SMOOTH);
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glHint(GL_LINE_SMOOTH_HINT, GL_DONT_CARE);
-        glBegin(GL_LINE_STRIP);
-        for(z = 0; z < spath->num_points; z++) {
-          pt.x = spath->points[z].x * right.delta_x +
-            spath->points[z].y * right.delta_y;
-          pt.y = spath->points[z].x * up->delta_x +
-            spath->points[z].y * up->delta_y;
-          glVertex2f(pos.x + pt.x * char_ht * char_expan,
-                     pos.y + pt.y * char_ht);
-          if (record_geom){
-            vertex_indices[n_vertices] = wsgl_add_vertex(pos.x + pt.x * char_ht * char_expan,
-                                                         pos.y + pt.y * char_ht, 0.);
-            n_vertices ++;
-          }
-        }
-        if (record_geom){
-          wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
-        }
-        glEnd();
-      }
-    }
-
-    switch (text_path) {
-    case PPATH_RIGHT:
-      pos.x += (ch->right + char_space) *
-        right.delta_x * char_ht * char_expan;
-      pos.y += (ch->right + char_space) *
-        up->delta_x * char_ht * char_expan;
-      break;
-
-    case PPATH_LEFT:
-      pos.x -= (ch->right + char_space) *
-        right.delta_x * char_ht * char_expan;
-      pos.y -= (ch->right + char_space) *
-        up->delta_x * char_ht * char_expan;
-      break;
-
-    case PPATH_UP:
-      pos.x += (height + char_space) * right.delta_y * char_ht;
-      pos.y += (height + char_space) * up->delta_y * char_ht;
-      break;
-
-    case PPATH_DOWN:
-      pos.x -= (height + char_space) * right.delta_y * char_ht;
-      pos.y -= (height + char_space) * up->delta_y * char_ht;
-      break;
+  memset(&key, 0, sizeof(Ws_text_key));
+  key.fnt = fnt;
+  key.char_ht = ast->char_ht;
+  key.char_expan = char_expan;
+  key.char_space = wsgl_get_char_space(ast);
+  key.up = ast->char_up_vec;
+  key.path = ast->text_path;
+  key.align = ast->text_align;
+  key.pos.x = text->pos.x;
+  key.pos.y = text->pos.y;
+  phg_mat_identity(key.tran);
+
+  geom = wsgl_text_cache_lookup(ws, &key, text->char_string);
+  if (geom == NULL) {
+    posa.x = text->pos.x;
+    posa.y = text->pos.y;
+    wsgl_set_text_align(text, ast, posa, &pos);
+    start.x = pos.x;
+    start.y = pos.y;
+    start.z = 0.0;
+    geom = wsgl_text_cache_build(ws, &key, text->char_string, &start);
+    if (geom == NULL) {
+      return;
     }
   }
+  wsgl_text_draw_geom(geom);
+  if (wsgl->text_cache == NULL) {
+    free(geom);
+  }
 }
 
 /*******************************************************************************
@@ -1015,105 +1214,42 @@ static void wsgl_text_stroke3(
                               Pmatrix3 tmatrix
                               )
 {
+  Wsgl_handle wsgl = ws->render_context;
   Phg_font *fnt;
-  Pfloat char_ht;
   Pfloat char_expan;
-  Pfloat char_space;
-  Pfloat height;
-  Ptext_path text_path;
-  char *str;
-  size_t i, len;
-  Phg_char *ch;
-  Ppoint_list *spath;
   Ppoint3 posa, pos;
-  Ppoint pt;
-  int j, z;
-  Pvec *up;
-  Pvec right;
-  Ppoint3 pwc;
-
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
+  Ws_text_key key;
+  Ws_text_geom *geom;
 
   wsgl_setup_text_attr(ast, &fnt, &char_expan);
-  char_ht = ast->char_ht;
-  char_space = wsgl_get_char_space(ast);
-  text_path = ast->text_path;
-  height = fnt->top - fnt->bottom;
-  up = &ast->char_up_vec;
-
-  right.delta_x =  up->delta_y;
-  right.delta_y = -up->delta_x;
-
-  posa.x = text->pos.x;
-  posa.y = text->pos.y;
-  posa.z = text->pos.z;
-  wsgl_set_text_align3(text, ast, posa, &pos);
-
   glDisable(GL_LINE_STIPPLE);
-  str = text->char_string;
-
-  len = strlen(str);
-  for (i = 0; i < len; i++) {
-
-    ch = &fnt->chars[(int) str[i]];
-    if (ch->num_paths > 0) {
-
-      for (j = 0, spath = ch->paths;
-           j < ch->num_paths;
-           j++, spath++) {
-        glEnable(GL_LINE_SMOOTH);
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glHint(GL_LINE_SMOOTH_HINT, GL_DONT_CARE);
-        glBegin(GL_LINE_STRIP);
-        for(z = 0; z < spath->num_points; z++) {
-          pt.x = spath->points[z].x * right.delta_x +
-            spath->points[z].y * right.delta_y;
-          pt.y = spath->points[z].x * up->delta_x +
-            spath->points[z].y * up->delta_y;
-          wsgl_text_vertex3tcs(tmatrix,
-                               pos.x + pt.x * char_ht * char_expan,
-                               pos.y + pt.y * char_ht,
-                               pos.y, &pwc);
-          if (record_geom){
-            vertex_indices[n_vertices] = wsgl_add_vertex(pwc.x, pwc.y, pwc.z);
-            n_vertices ++;
-          }
-        }
-        if (record_geom){
-          wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
-        }
-        glEnd();
-      }
-    }
-
-    switch (text_path) {
-    case PPATH_RIGHT:
-      pos.x += (ch->right + char_space) *
-        right.delta_x * char_ht * char_expan;
-      pos.y += (ch->right + char_space) *
-        up->delta_x * char_ht * char_expan;
-      break;
-
-    case PPATH_LEFT:
-      pos.x -= (ch->right + char_space) *
-        right.delta_x * char_ht * char_expan;
-      pos.y -= (ch->right + char_space) *
-        up->delta_x * char_ht * char_expan;
-      break;
-
-    case PPATH_UP:
-      pos.x += (height + char_space) * right.delta_y * char_ht;
-      pos.y += (height + char_space) * up->delta_y * char_ht;
-      break;
 
-    case PPATH_DOWN:
-      pos.x -= (height + char_space) * right.delta_y * char_ht;
-      pos.y -= (height + char_space) * up->delta_y * char_ht;
-      break;
+  memset(&key, 0, sizeof(Ws_text_key));
+  key.fnt = fnt;
+  key.char_ht = ast->char_ht;
+  key.char_expan = char_expan;
+  key.char_space = wsgl_get_char_space(ast);
+  key.up = ast->char_up_vec;
+  key.path = ast->text_path;
+  key.align = ast->text_align;
+  key.pos = text->pos;
+  phg_mat_copy(key.tran, tmatrix);
+
+  geom = wsgl_text_cache_lookup(ws, &key, text->char_string);
+  if (geom == NULL) {
+    posa.x = text->pos.x;
+    posa.y = text->pos.y;
+    posa.z = text->pos.z;
+    wsgl_set_text_align3(text, ast, posa, &pos);
+    geom = wsgl_text_cache_build(ws, &key, text->char_string, &pos);
+    if (geom == NULL) {
+      return;
     }
   }
+  wsgl_text_draw_geom(geom);
+  if (wsgl->text_cache == NULL) {
+    free(geom);
+  }
 }
 
 /*******************************************************************************
@@ -1130,104 +1266,42 @@ static void wsgl_anno_text_stroke3(
                                    Pmatrix3 vrc2wc
                                    )
 {
+  Wsgl_handle wsgl = ws->render_context;
   Phg_font *fnt;
-  Pfloat char_ht;
   Pfloat char_expan;
-  Pfloat char_space;
-  Pfloat height;
-  Ptext_path text_path;
-  char *str;
-  size_t i, len;
-  Phg_char *ch;
-  Ppoint_list *spath;
-  Ppoint pt;
   Ppoint3 pos, posa;
-  int j, z;
-  Pvec *up;
-  Pvec right;
-  Ppoint3 pwc;
-
-  int vertex_indices[MAX_VERTICES];
-  int n_vertices = 0;
+  Ws_text_key key;
+  Ws_text_geom *geom;
 
   wsgl_setup_text_attr(ast, &fnt, &char_expan);
-  char_ht = ast->anno_char_ht;
-  char_space = wsgl_get_char_space(ast);
-  text_path = ast->anno_text_path;
-  height = fnt->top - fnt->bottom;
-  up = &ast->anno_char_up_vec;
-
-  right.delta_x =  up->delta_y;
-  right.delta_y = -up->delta_x;
-
-  posa.x = text->pos.x;
-  posa.y = text->pos.y;
-  posa.z = text->pos.z;
-  wsgl_set_anno_text_align3(text, ast, posa, &pos);
-  str = text->char_string;
   glDisable(GL_LINE_STIPPLE);
 
-  len = strlen(str);
-  for (i = 0; i < len; i++) {
-
-    ch = &fnt->chars[(int) str[i]];
-    if (ch->num_paths > 0) {
-
-      for (j = 0, spath = ch->paths;
-           j < ch->num_paths;
-           j++, spath++) {
-        glEnable(GL_LINE_SMOOTH);
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glHint(GL_LINE_SMOOTH_HINT, GL_DONT_CARE);
-        glBegin(GL_LINE_STRIP);
-        for(z = 0; z < spath->num_points; z++) {
-          pt.x = spath->points[z].x * right.delta_x +
-            spath->points[z].y * right.delta_y;
-          pt.y = spath->points[z].x * up->delta_x +
-            spath->points[z].y * up->delta_y;
-          wsgl_text_vertex3tcs(vrc2wc,
-                               pos.x + pt.x * char_ht * char_expan,
-                               pos.y + pt.y * char_ht,
-                               pos.z, &pwc);
-          if (record_geom){
-            vertex_indices[n_vertices] = wsgl_add_vertex(pwc.x, pwc.y, pwc.z);
-            n_vertices ++;
-          }
-        }
-        if (record_geom){
-          wsgl_add_geometry(GEOM_LINE, vertex_indices, NULL, n_vertices);
-        }
-        glEnd();
-      }
-    }
-
-    switch (text_path) {
-    case PPATH_RIGHT:
-      pos.x += (ch->right + char_space) *
-        right.delta_x * char_ht * char_expan;
-      pos.y += (ch->right + char_space) *
-        up->delta_x * char_ht * char_expan;
-      break;
-
-    case PPATH_LEFT:
-      pos.x -= (ch->right + char_space) *
-        right.delta_x * char_ht * char_expan;
-      pos.y -= (ch->right + char_space) *
-        up->delta_x * char_ht * char_expan;
-      break;
-
-    case PPATH_UP:
-      pos.x += (height + char_space) * right.delta_y * char_ht;
-      pos.y += (height + char_space) * up->delta_y * char_ht;
-      break;
-
-    case PPATH_DOWN:
-      pos.x -= (height + char_space) * right.delta_y * char_ht;
-      pos.y -= (height + char_space) * up->delta_y * char_ht;
-      break;
+  memset(&key, 0, sizeof(Ws_text_key));
+  key.fnt = fnt;
+  key.char_ht = ast->anno_char_ht;
+  key.char_expan = char_expan;
+  key.char_space = wsgl_get_char_space(ast);
+  key.up = ast->anno_char_up_vec;
+  key.path = ast->anno_text_path;
+  key.align = ast->anno_text_align;
+  key.pos = text->pos;
+  phg_mat_copy(key.tran, vrc2wc);
+
+  geom = wsgl_text_cache_lookup(ws, &key, text->char_string);
+  if (geom == NULL) {
+    posa.x = text->pos.x;
+    posa.y = text->pos.y;
+    posa.z = text->pos.z;
+    wsgl_set_anno_text_align3(text, ast, posa, &pos);
+    geom = wsgl_text_cache_build(ws, &key, text->char_string, &pos);
+    if (geom == NULL) {
+      return;
     }
   }
+  wsgl_text_draw_geom(geom);
+  if (wsgl->text_cache == NULL) {
+    free(geom);
+  }
 }
 
 /*******************************************************************************
@@ -0,0 +1,707 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************
+* Changes:   Copyright (C) 2022-2023 CERN
+******************************************************************************/
+
+/*
+ * Vector hardcopy.
+ *
+ * SVG and PDF hardcopies are written from the primitives recorded while
+ * the structure network is traversed, the same hooks as the OBJ export.
+ * Vertices are taken through the current modelling, orientation, mapping
+ * and workstation transforms to device coordinates. The primitives of a
+ * posted structure network, executed structures included, are sorted
+ * back to front when hidden surface removal is on and streamed out when
+ * the traversal leaves the root structure, so memory is bound by the
+ * largest network, not by the whole picture. Faces with normals are lit
+ * once per face with the reflectance and light sources of the fragment
+ * shader.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#ifdef GLEW
+#include <GL/glew.h>
+#else
+#include <epoxy/gl.h>
+#endif
+#include "phg.h"
+#include "ws.h"
+#include "private/phgP.h"
+#include "private/wsglP.h"
+#include "private/wsxP.h"
+
+/* output buffer of the vector stream */
+#define VEC_IO_BUFFER (1 << 20)
+
+typedef struct {
+  GeomType type;
+  int first;                     /* first point in vec_points */
+  int count;
+  int seq;                       /* traversal order */
+  float depth;                   /* mean window depth, larger is further */
+  float colr[3];
+  float width;
+} Vec_prim;
+
+int record_vec = VEC_NONE;
+
+static FILE *vec_file = NULL;
+static char *vec_iobuf = NULL;
+static int vec_width;
+static int vec_height;
+static long vec_body = 0;        /* end of header, start of the drawing */
+static long vec_stream = 0;      /* start of the PDF content stream */
+static long vec_obj[5];          /* PDF object offsets */
+
+static Pmatrix3 vec_tran;        /* modelling to clip coordinates */
+static Ws_xform vec_xform;
+static int vec_sort = TRUE;
+static int vec_batch_sort = TRUE;
+
+static Vec_prim *vec_prims = NULL;
+static int vec_num_prims = 0;
+static int vec_size_prims = 0;
+static float *vec_points = NULL; /* x, y and depth per point */
+static int vec_num_points = 0;
+static int vec_size_points = 0;
+static int vec_first = 0;        /* first point of the pending primitive */
+static int vec_depth = 0;        /* structure nesting of the traversal */
+static Wsgl *vec_wsgl = NULL;    /* light sources and modelview transform */
+static int vec_shading = FALSE;  /* faces are lit */
+static float vec_refl[3][3];     /* ambient, diffuse and specular colour */
+static float vec_normal[3];      /* normal sum of the pending primitive */
+static int vec_num_normals = 0;
+
+/*******************************************************************************
+ * vec_add_prim
+ *
+ * DESCR:       append primitive to the current batch
+ * RETURNS:     Non zero or zero on error
+ */
+static int vec_add_prim(Vec_prim *prim) {
+  Vec_prim *prims;
+  int size;
+
+  if (vec_num_prims >= vec_size_prims) {
+    size = (vec_size_prims > 0) ? 2 * vec_size_prims : 1024;
+    prims = (Vec_prim *) realloc(vec_prims, size * sizeof(Vec_prim));
+    if (prims == NULL) {
+      return FALSE;
+    }
+    vec_prims = prims;
+    vec_size_prims = size;
+  }
+  vec_prims[vec_num_prims++] = *prim;
+
+  return TRUE;
+}
+
+/*******************************************************************************
+ * vec_compare
+ *
+ * DESCR:       order primitives back to front, ties in traversal order
+ * RETURNS:     Comparison result
+ */
+static int vec_compare(const void *a, const void *b) {
+  const Vec_prim *pa = (const Vec_prim *) a;
+  const Vec_prim *pb = (const Vec_prim *) b;
+
+  if (pa->depth > pb->depth) return -1;
+  if (pa->depth < pb->depth) return 1;
+  return pa->seq - pb->seq;
+}
+
+/*******************************************************************************
+ * vec_shade
+ *
+ * DESCR:       light face colour like the fragment shader
+ * RETURNS:     N/A
+ */
+static void vec_shade(float *colr) {
+  Wsgl_light_block *block = &vec_wsgl->light_block;
+  float m[3], n[3], *pos, *coef, *light_colr;
+  float angle, len_norm, len_pos, refl;
+  int i, j;
+
+  /* same normal as the vertex shader, modelview times (n, 1),
+     of the mean vertex normal */
+  for (i = 0; i < 3; i++) {
+    m[i] = vec_normal[i] / (float) vec_num_normals;
+  }
+  for (i = 0; i < 3; i++) {
+    n[i] = vec_wsgl->model_tran[i][0] * m[0] +
+      vec_wsgl->model_tran[i][1] * m[1] +
+      vec_wsgl->model_tran[i][2] * m[2] +
+      vec_wsgl->model_tran[i][3];
+  }
+  len_norm = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+  if (len_norm == 0.0f) {
+    len_norm = 1.0f;
+  }
+
+  colr[0] = colr[1] = colr[2] = 0.0f;
+  for (i = 0; i < block->num_lights; i++) {
+    light_colr = block->data[i][0];
+    pos = block->data[i][1];
+    coef = block->data[i][2];
+    len_pos = sqrtf(pos[0] * pos[0] + pos[1] * pos[1] + pos[2] * pos[2]);
+    if (len_pos == 0.0f) {
+      len_pos = 1.0f;
+    }
+    angle = (n[0] * pos[0] + n[1] * pos[1] + n[2] * pos[2]) /
+      len_norm / len_pos;
+    if (angle < 0.0f) {
+      angle = 0.0f;
+    }
+    for (j = 0; j < 3; j++) {
+      switch ((int) coef[3]) {
+      case PLIGHT_AMBIENT:
+        colr[j] += light_colr[j] * vec_refl[0][j];
+        break;
+      case PLIGHT_DIRECTIONAL:
+        colr[j] += light_colr[j] * vec_refl[1][j] * angle;
+        break;
+      case PLIGHT_POSITIONAL:
+        refl = coef[0] * powf(angle, coef[1]);
+        colr[j] += vec_refl[2][j] * refl;
+        break;
+      default:
+        colr[j] += (j == 0) ? 0.5f : 0.0f;
+        break;
+      }
+    }
+  }
+  for (j = 0; j < 3; j++) {
+    if (colr[j] > 1.0f) {
+      colr[j] = 1.0f;
+    }
+  }
+}
+
+/*******************************************************************************
+ * vec_hex
+ *
+ * DESCR:       colour component as integer
+ * RETURNS:     Value from 0 to 255
+ */
+static int vec_hex(float c) {
+  return (int) (c * 255.0f + 0.5f);
+}
+
+/*******************************************************************************
+ * vec_write_background
+ *
+ * DESCR:       fill the page with the background colour
+ * RETURNS:     N/A
+ */
+static void vec_write_background(Pgcolr *background) {
+  float r = background->val.general.x;
+  float g = background->val.general.y;
+  float b = background->val.general.z;
+
+  if (record_vec == VEC_SVG) {
+    fprintf(vec_file,
+            "<rect width=\"100%%\" height=\"100%%\" fill=\"#%02x%02x%02x\"/>\n",
+            vec_hex(r), vec_hex(g), vec_hex(b));
+  }
+  else {
+    fprintf(vec_file, "%.3f %.3f %.3f rg 0 0 %d %d re f\n",
+            r, g, b, vec_width, vec_height);
+  }
+}
+
+/*******************************************************************************
+ * vec_write_prim
+ *
+ * DESCR:       write one primitive
+ * RETURNS:     N/A
+ */
+static void vec_write_prim(Vec_prim *prim) {
+  float *p = &vec_points[3 * prim->first];
+  int i;
+
+  if (record_vec == VEC_SVG) {
+    if (prim->type == GEOM_FACE) {
+      fprintf(vec_file, "<polygon fill=\"#%02x%02x%02x\" points=\"",
+              vec_hex(prim->colr[0]),
+              vec_hex(prim->colr[1]),
+              vec_hex(prim->colr[2]));
+    }
+    else if (prim->type == GEOM_SEGMENTS) {
+      fprintf(vec_file,
+              "<path fill=\"none\" stroke=\"#%02x%02x%02x\" "
+              "stroke-width=\"%g\" d=\"",
+              vec_hex(prim->colr[0]),
+              vec_hex(prim->colr[1]),
+              vec_hex(prim->colr[2]),
+              prim->width);
+      for (i = 0; i < prim->count; i++, p += 3) {
+        fprintf(vec_file, "%s%c%.2f,%.2f", (i > 0) ? " " : "",
+                (i % 2) ? 'L' : 'M', p[0], vec_height - p[1]);
+      }
+      fputs("\"/>\n", vec_file);
+      return;
+    }
+    else {
+      fprintf(vec_file,
+              "<polyline fill=\"none\" stroke=\"#%02x%02x%02x\" "
+              "stroke-width=\"%g\" points=\"",
+              vec_hex(prim->colr[0]),
+              vec_hex(prim->colr[1]),
+              vec_hex(prim->colr[2]),
+              prim->width);
+    }
+    for (i = 0; i < prim->count; i++, p += 3) {
+      fprintf(vec_file, "%s%.2f,%.2f", (i > 0) ? " " : "",
+              p[0], vec_height - p[1]);
+    }
+    fputs("\"/>\n", vec_file);
+  }
+  else {
+    if (prim->type == GEOM_FACE) {
+      fprintf(vec_file, "%.3f %.3f %.3f rg\n",
+              prim->colr[0], prim->colr[1], prim->colr[2]);
+    }
+    else {
+      fprintf(vec_file, "%.3f %.3f %.3f RG %g w\n",
+              prim->colr[0], prim->colr[1], prim->colr[2], prim->width);
+    }
+    for (i = 0; i < prim->count; i++, p += 3) {
+      if (prim->type == GEOM_SEGMENTS) {
+        fprintf(vec_file, "%.2f %.2f %c\n", p[0], p[1], (i % 2) ? 'l' : 'm');
+      }
+      else {
+        fprintf(vec_file, "%.2f %.2f %c\n", p[0], p[1], (i > 0) ? 'l' : 'm');
+      }
+    }
+    fputs((prim->type == GEOM_FACE) ? "h f\n" : "S\n", vec_file);
+  }
+}
+
+/*******************************************************************************
+ * vec_write_header
+ *
+ * DESCR:       write document header up to the drawing
+ * RETURNS:     N/A
+ */
+static void vec_write_header(const char *title) {
+  const char *c;
+
+  if (record_vec == VEC_SVG) {
+    fprintf(vec_file,
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\" "
+            "width=\"%d\" height=\"%d\" viewBox=\"0 0 %d %d\" "
+            "stroke-linejoin=\"round\">\n<title>",
+            vec_width, vec_height, vec_width, vec_height);
+    for (c = title; *c != '\0'; c++) {
+      switch (*c) {
+      case '<': fputs("&lt;", vec_file); break;
+      case '>': fputs("&gt;", vec_file); break;
+      case '&': fputs("&amp;", vec_file); break;
+      default: fputc(*c, vec_file); break;
+      }
+    }
+    fputs("</title>\n", vec_file);
+  }
+  else {
+    /* content stream length is an indirect object written after it */
+    fputs("%PDF-1.4\n%\xe2\xe3\xcf\xd3\n", vec_file);
+    vec_obj[0] = ftell(vec_file);
+    fputs("1 0 obj\n<< /Type /Catalog /Pages 2 0 R >>\nendobj\n", vec_file);
+    vec_obj[1] = ftell(vec_file);
+    fputs("2 0 obj\n<< /Type /Pages /Kids [3 0 R] /Count 1 >>\nendobj\n",
+          vec_file);
+    vec_obj[2] = ftell(vec_file);
+    fprintf(vec_file,
+            "3 0 obj\n<< /Type /Page /Parent 2 0 R /MediaBox [0 0 %d %d] "
+            "/Contents 4 0 R /Resources << >> >>\nendobj\n",
+            vec_width, vec_height);
+    vec_obj[3] = ftell(vec_file);
+    fputs("4 0 obj\n<< /Length 5 0 R >>\nstream\n", vec_file);
+    vec_stream = ftell(vec_file);
+    fputs("1 J 1 j\n", vec_file);
+  }
+  vec_body = ftell(vec_file);
+}
+
+/*******************************************************************************
+ * vec_write_trailer
+ *
+ * DESCR:       end document
+ * RETURNS:     N/A
+ */
+static void vec_write_trailer(void) {
+  long length, xref;
+  int i;
+
+  if (record_vec == VEC_SVG) {
+    fputs("</svg>\n", vec_file);
+  }
+  else {
+    length = ftell(vec_file) - vec_stream;
+    fputs("endstream\nendobj\n", vec_file);
+    vec_obj[4] = ftell(vec_file);
+    fprintf(vec_file, "5 0 obj\n%ld\nendobj\n", length);
+    xref = ftell(vec_file);
+    fputs("xref\n0 6\n0000000000 65535 f \n", vec_file);
+    for (i = 0; i < 5; i++) {
+      fprintf(vec_file, "%010ld 00000 n \n", vec_obj[i]);
+    }
+    fprintf(vec_file, "trailer\n<< /Size 6 /Root 1 0 R >>\nstartxref\n%ld\n%%%%EOF\n",
+            xref);
+  }
+}
+
+/*******************************************************************************
+ * wsgl_begin_vec(const char* filename, const char* title, int type,
+ *                int width, int height)
+ *
+ * DESCR:       open vector hardcopy, primitives are written while rendering
+ * RETURNS:     Non zero or zero on error
+ */
+int wsgl_begin_vec(const char* filename, const char* title, int type,
+                   int width, int height) {
+  if (vec_file != NULL) {
+    wsgl_export_vec();
+  }
+  vec_file = fopen(filename, "wb");
+  if (vec_file == NULL) {
+    perror("fopen");
+    return FALSE;
+  }
+  vec_iobuf = (char *) malloc(VEC_IO_BUFFER);
+  if (vec_iobuf != NULL) {
+    setvbuf(vec_file, vec_iobuf, _IOFBF, VEC_IO_BUFFER);
+  }
+  record_vec = type;
+  vec_width = width;
+  vec_height = height;
+  vec_num_prims = 0;
+  vec_num_points = 0;
+  vec_first = 0;
+  vec_depth = 0;
+  vec_shading = FALSE;
+  vec_normal[0] = vec_normal[1] = vec_normal[2] = 0.0f;
+  vec_num_normals = 0;
+  phg_mat_identity(vec_tran);
+  vec_xform.scale.x = vec_xform.scale.y = vec_xform.scale.z = 1.0;
+  vec_xform.offset.x = vec_xform.offset.y = vec_xform.offset.z = 0.0;
+  vec_write_header(title);
+#ifdef DEBUG_OBJ
+  printf("wsgl_vec: streaming to %s\n", filename);
+#endif
+  return TRUE;
+}
+
+/*******************************************************************************
+ * wsgl_vec_update(Ws *ws)
+ *
+ * DESCR:       take transforms and depth mode of the traversal state
+ * RETURNS:     N/A
+ */
+void wsgl_vec_update(Ws *ws) {
+  Wsgl_handle wsgl = ws->render_context;
+
+  phg_mat_mul(vec_tran,
+              wsgl->cur_struct.view_rep.map_matrix,
+              wsgl->model_tran);
+  phg_wsx_compute_ws_transform(&wsgl->cur_win, &wsgl->cur_vp, &vec_xform);
+  vec_sort = (wsgl->cur_struct.hlhsr_id == PHIGS_HLHSR_ID_ON);
+  vec_wsgl = wsgl;
+}
+
+/*******************************************************************************
+ * wsgl_vec_normal(float x, float y, float z)
+ *
+ * DESCR:       add vertex normal to the pending primitive
+ * RETURNS:     N/A
+ */
+void wsgl_vec_normal(float x, float y, float z) {
+  vec_normal[0] += x;
+  vec_normal[1] += y;
+  vec_normal[2] += z;
+  vec_num_normals++;
+}
+
+/*******************************************************************************
+ * wsgl_vec_refl_props(int shading, GLfloat *ambient, GLfloat *diffuse,
+ *                     GLfloat *specular)
+ *
+ * DESCR:       take surface reflectance of the following faces
+ * RETURNS:     N/A
+ */
+void wsgl_vec_refl_props(int shading, GLfloat *ambient, GLfloat *diffuse,
+                         GLfloat *specular) {
+  vec_shading = shading;
+  if (shading) {
+    memcpy(vec_refl[0], ambient, 3 * sizeof(float));
+    memcpy(vec_refl[1], diffuse, 3 * sizeof(float));
+    memcpy(vec_refl[2], specular, 3 * sizeof(float));
+  }
+}
+
+/*******************************************************************************
+ * vec_project
+ *
+ * DESCR:       take vertex to device coordinates and window depth
+ * RETURNS:     Non zero or zero if the vertex is at infinity
+ */
+static int vec_project(float x, float y, float z, float *p) {
+  float c[4];
+  int i;
+
+  for (i = 0; i < 4; i++) {
+    c[i] = vec_tran[i][0] * x + vec_tran[i][1] * y + vec_tran[i][2] * z +
+      vec_tran[i][3];
+  }
+  if (c[3] == 0.0f) {
+    return FALSE;
+  }
+  /* same as the GL viewport and depth range set by wsgl_flush */
+  p[0] = vec_xform.offset.x + vec_xform.scale.x * c[0] / c[3];
+  p[1] = vec_xform.offset.y + vec_xform.scale.y * c[1] / c[3];
+  p[2] = vec_xform.scale.z +
+    0.5f * (c[2] / c[3] + 1.0f) * (vec_xform.offset.z - vec_xform.scale.z);
+
+  return TRUE;
+}
+
+/*******************************************************************************
+ * vec_add_point
+ *
+ * DESCR:       add point in device coordinates to the pending primitive
+ * RETURNS:     N/A
+ */
+static void vec_add_point(float x, float y, float depth) {
+  float *p;
+  float *points;
+  int size;
+
+  if (vec_num_points >= vec_size_points) {
+    size = (vec_size_points > 0) ? 2 * vec_size_points : 4096;
+    points = (float *) realloc(vec_points, 3 * size * sizeof(float));
+    if (points == NULL) {
+      fprintf(stderr, "wsgl_vec: out of memory, primitive truncated\n");
+      return;
+    }
+    vec_points = points;
+    vec_size_points = size;
+  }
+  p = &vec_points[3 * vec_num_points++];
+  p[0] = x;
+  p[1] = y;
+  p[2] = depth;
+}
+
+/*******************************************************************************
+ * wsgl_vec_vertex(float x, float y, float z)
+ *
+ * DESCR:       add vertex to the pending primitive in device coordinates
+ * RETURNS:     N/A
+ */
+void wsgl_vec_vertex(float x, float y, float z) {
+  float p[3];
+
+  if (vec_project(x, y, z, p)) {
+    vec_add_point(p[0], p[1], p[2]);
+  }
+}
+
+/*******************************************************************************
+ * wsgl_vec_dot(float x, float y, float z, float size)
+ *
+ * DESCR:       add square of size pixels around the vertex as primitive
+ * RETURNS:     N/A
+ */
+void wsgl_vec_dot(float x, float y, float z, float size) {
+  float p[3], half;
+
+  if (!vec_project(x, y, z, p)) {
+    return;
+  }
+  half = 0.5f * ((size > 1.0f) ? size : 1.0f);
+  vec_add_point(p[0] - half, p[1] - half, p[2]);
+  vec_add_point(p[0] + half, p[1] - half, p[2]);
+  vec_add_point(p[0] + half, p[1] + half, p[2]);
+  vec_add_point(p[0] - half, p[1] + half, p[2]);
+  wsgl_vec_geometry(GEOM_FACE);
+}
+
+/*******************************************************************************
+ * wsgl_vec_geometry(GeomType type)
+ *
+ * DESCR:       add pending primitive to the batch and start a new one
+ * RETURNS:     N/A
+ */
+void wsgl_vec_geometry(GeomType type) {
+  Vec_prim prim;
+  int i;
+
+  prim.type = type;
+  prim.first = vec_first;
+  prim.count = vec_num_points - vec_first;
+  if (type == GEOM_SEGMENTS) {
+    /* a vertex without partner is not drawn by GL_LINES either */
+    prim.count -= prim.count % 2;
+    vec_num_points = vec_first + prim.count;
+  }
+  if (prim.count >= ((type == GEOM_FACE) ? 3 : 2)) {
+    prim.seq = vec_num_prims;
+    prim.depth = 0.0f;
+    for (i = prim.first; i < vec_num_points; i++) {
+      prim.depth += vec_points[3 * i + 2];
+    }
+    prim.depth /= (float) prim.count;
+    if (type == GEOM_FACE && vec_shading && vec_num_normals > 0 &&
+        vec_wsgl != NULL && vec_wsgl->light_block_valid &&
+        vec_wsgl->light_block.num_lights > 0) {
+      vec_shade(prim.colr);
+    }
+    else {
+      prim.colr[0] = current_colr.x;
+      prim.colr[1] = current_colr.y;
+      prim.colr[2] = current_colr.z;
+    }
+    prim.width = current_width;
+    if (!vec_sort) {
+      vec_batch_sort = FALSE;
+    }
+    if (!vec_add_prim(&prim)) {
+      fprintf(stderr, "wsgl_vec: out of memory, primitive dropped\n");
+      vec_num_points = vec_first;
+    }
+  }
+  else {
+    vec_num_points = vec_first;
+  }
+  vec_first = vec_num_points;
+  vec_normal[0] = vec_normal[1] = vec_normal[2] = 0.0f;
+  vec_num_normals = 0;
+}
+
+/*******************************************************************************
+ * wsgl_vec_begin_structure()
+ *
+ * DESCR:       enter a structure of the network being traversed
+ * RETURNS:     N/A
+ */
+void wsgl_vec_begin_structure() {
+  vec_depth++;
+}
+
+/*******************************************************************************
+ * wsgl_vec_end_structure()
+ *
+ * DESCR:       leave a structure, the batch is written with the root structure
+ * RETURNS:     N/A
+ */
+void wsgl_vec_end_structure() {
+  if (vec_depth > 0) {
+    vec_depth--;
+  }
+  if (vec_depth == 0) {
+    wsgl_vec_flush();
+  }
+}
+
+/*******************************************************************************
+ * wsgl_vec_flush()
+ *
+ * DESCR:       write the primitives of the batch, back to front
+ * RETURNS:     N/A
+ */
+void wsgl_vec_flush() {
+  int i;
+
+  if (vec_file == NULL) {
+    return;
+  }
+  /* without hidden surface removal later primitives cover earlier ones */
+  if (vec_batch_sort && vec_num_prims > 1) {
+    qsort(vec_prims, vec_num_prims, sizeof(Vec_prim), vec_compare);
+  }
+  for (i = 0; i < vec_num_prims; i++) {
+    vec_write_prim(&vec_prims[i]);
+  }
+#ifdef DEBUG_OBJ
+  printf("wsgl_vec: wrote %d primitives\n", vec_num_prims);
+#endif
+  vec_num_prims = 0;
+  vec_num_points = 0;
+  vec_first = 0;
+  vec_batch_sort = TRUE;
+}
+
+/*******************************************************************************
+ * wsgl_vec_clear(Ws *ws)
+ *
+ * DESCR:       restart the drawing with the background of the workstation
+ * RETURNS:     N/A
+ */
+void wsgl_vec_clear(Ws *ws) {
+  Wsgl_handle wsgl = ws->render_context;
+
+  if (vec_file == NULL) {
+    return;
+  }
+  fflush(vec_file);
+  if (ftruncate(fileno(vec_file), vec_body) != 0) {
+    perror("ftruncate");
+  }
+  fseek(vec_file, vec_body, SEEK_SET);
+  vec_num_prims = 0;
+  vec_num_points = 0;
+  vec_first = 0;
+  vec_depth = 0;
+  vec_batch_sort = TRUE;
+  vec_write_background(&wsgl->background);
+}
+
+/*******************************************************************************
+ * wsgl_export_vec()
+ *
+ * DESCR:       write remaining primitives and close vector hardcopy
+ * RETURNS:     N/A
+ */
+void wsgl_export_vec() {
+  if (vec_file == NULL) {
+    record_vec = VEC_NONE;
+    return;
+  }
+  wsgl_vec_flush();
+  vec_write_trailer();
+  fclose(vec_file);
+  vec_file = NULL;
+  free(vec_iobuf);
+  vec_iobuf = NULL;
+  free(vec_prims);
+  vec_prims = NULL;
+  vec_size_prims = 0;
+  free(vec_points);
+  vec_points = NULL;
+  vec_size_points = 0;
+  vec_wsgl = NULL;
+  record_vec = VEC_NONE;
+}
@@ -0,0 +1,187 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/types.h>
+#include <X11/Xlib.h>
+#include <X11/keysym.h>
+
+#include "phg.h"
+
+#define NUM_ROWS     40
+#define NUM_COLS     8
+#define NUM_FRAMES   100
+
+#define VP_X0    0.0
+#define VP_X1  500.0
+#define VP_Y0    0.0
+#define VP_Y1  500.0
+#define WIN_X0   0.0
+#define WIN_X1   1.0
+#define WIN_Y0   0.0
+#define WIN_Y1   1.0
+
+int num_frames = NUM_FRAMES;
+
+void init_labels(void)
+{
+   Pint i, j;
+   Ppoint text_pos;
+   Ppoint3 text_pos3;
+   Pvec text_up;
+   Pvec3 text_plane[2];
+   Ptext_align text_align;
+   char label[32];
+
+   text_align.hor = PHOR_LEFT;
+   text_align.vert = PVERT_BOTTOM;
+   text_up.delta_x = 0.0;
+   text_up.delta_y = 1.0;
+   text_plane[0].delta_x = 1.0;
+   text_plane[0].delta_y = 0.0;
+   text_plane[0].delta_z = 0.0;
+   text_plane[1].delta_x = 0.0;
+   text_plane[1].delta_y = 1.0;
+   text_plane[1].delta_z = 0.0;
+
+   pset_text_colr_ind(1);
+   pset_text_font(1);
+   pset_text_prec(PREC_STROKE);
+   pset_char_ht(0.015);
+   pset_char_expan(1.0);
+   pset_char_space(0.1);
+   pset_text_path(PPATH_RIGHT);
+   pset_text_align(&text_align);
+   pset_char_up_vec(&text_up);
+
+   /* Grid of axis style labels */
+   for (i = 0; i < NUM_ROWS; i++) {
+      for (j = 0; j < NUM_COLS; j++) {
+         text_pos.x = (Pfloat) j / (Pfloat) NUM_COLS;
+         text_pos.y = (Pfloat) i / (Pfloat) NUM_ROWS;
+         sprintf(label, "%d.%02d", i, j);
+         ptext(&text_pos, label);
+      }
+   }
+
+   /* Rotated labels along the right border */
+   text_up.delta_x = -1.0;
+   text_up.delta_y = 0.0;
+   pset_char_up_vec(&text_up);
+   for (i = 0; i < NUM_ROWS; i++) {
+      text_pos3.x = 0.98;
+      text_pos3.y = (Pfloat) i / (Pfloat) NUM_ROWS;
+      text_pos3.z = 0.0;
+      sprintf(label, "Label %d", i);
+      ptext3(&text_pos3, text_plane, label);
+   }
+}
+
+void run_benchmark(void)
+{
+   Pint i;
+   struct timespec t0, t1;
+   double msec;
+
+   clock_gettime(CLOCK_MONOTONIC, &t0);
+   for (i = 0; i < num_frames; i++) {
+      predraw_all_structs(0, PFLAG_ALWAYS);
+   }
+   clock_gettime(CLOCK_MONOTONIC, &t1);
+
+   msec = (t1.tv_sec - t0.tv_sec) * 1000.0 +
+      (t1.tv_nsec - t0.tv_nsec) / 1000000.0;
+   printf("%d text elements, %d frames: %.3f ms/frame\n",
+          NUM_ROWS * NUM_COLS + NUM_ROWS,
+          num_frames,
+          msec / (double) num_frames);
+}
+
+int main(int argc, char *argv[])
+{
+   XEvent event;
+   KeySym ks;
+   Plimit3 vp, win;
+
+   if (argc > 1) {
+      num_frames = atoi(argv[1]);
+      printf("Number of frames: %d\n", num_frames);
+   }
+
+   popen_phigs(NULL, 0);
+
+   popen_struct(0);
+   init_labels();
+   pclose_struct();
+
+   popen_ws(0, NULL, PWST_OUTPUT_TRUE_DB);
+   vp.x_min = VP_X0;
+   vp.x_max = VP_X1;
+   vp.y_min = VP_Y0;
+   vp.y_max = VP_Y1;
+   vp.z_min = 0.0;
+   vp.z_max = 1.0;
+   win.x_min = WIN_X0;
+   win.x_max = WIN_X1;
+   win.y_min = WIN_Y0;
+   win.y_max = WIN_Y1;
+   win.z_min = 0.0;
+   win.z_max = 1.0;
+   pset_ws_vp3(0, &vp);
+   pset_ws_win3(0, &win);
+
+   ppost_struct(0, 0, 0);
+
+   XSelectInput(PHG_WSID(0)->display,
+                PHG_WSID(0)->drawable_id,
+                ExposureMask | KeyPressMask);
+   while (1) {
+      XNextEvent(PHG_WSID(0)->display, &event);
+      switch(event.type) {
+
+         case Expose:
+            while (XCheckTypedEvent(PHG_WSID(0)->display, Expose, &event));
+            predraw_all_structs(0, PFLAG_ALWAYS);
+            break;
+
+         case KeyPress:
+            ks = XLookupKeysym((XKeyEvent *) &event, 0);
+            if (ks == XK_b) {
+               run_benchmark();
+            }
+            else if (ks == XK_Escape) {
+               goto exit;
+            }
+            break;
+
+         default:
+            break;
+      }
+   }
+
+exit:
+   pclose_ws(0);
+   pclose_phigs();
+
+   return 0;
+}
@@ -0,0 +1,164 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/types.h>
+#include <X11/Xlib.h>
+#include <X11/keysym.h>
+
+#include "phg.h"
+
+#define NUM_MARKERS  500000
+#define MARKER_SIZE  0.004
+#define NUM_FRAMES   20
+
+#define VP_X0    0.0
+#define VP_X1  500.0
+#define VP_Y0    0.0
+#define VP_Y1  500.0
+#define WIN_X0   0.0
+#define WIN_X1   1.0
+#define WIN_Y0   0.0
+#define WIN_Y1   1.0
+
+int num_frames = NUM_FRAMES;
+int num_markers = NUM_MARKERS;
+Pint marker_type = PMARKER_CIRCLE;
+
+void init_markers(void)
+{
+   Pint i;
+   Ppoint_list plist;
+
+   plist.num_points = num_markers;
+   plist.points = (Ppoint *) malloc(sizeof(Ppoint) * num_markers);
+   for (i = 0; i < num_markers; i++) {
+      plist.points[i].x = (Pfloat) rand() / (Pfloat) RAND_MAX;
+      plist.points[i].y = (Pfloat) rand() / (Pfloat) RAND_MAX;
+   }
+
+   pset_marker_colr_ind(1);
+   pset_marker_type(marker_type);
+   pset_marker_size(MARKER_SIZE);
+   ppolymarker(&plist);
+
+   free(plist.points);
+}
+
+void run_benchmark(void)
+{
+   Pint i;
+   struct timespec t0, t1;
+   double msec;
+
+   clock_gettime(CLOCK_MONOTONIC, &t0);
+   for (i = 0; i < num_frames; i++) {
+      predraw_all_structs(0, PFLAG_ALWAYS);
+   }
+   clock_gettime(CLOCK_MONOTONIC, &t1);
+
+   msec = (t1.tv_sec - t0.tv_sec) * 1000.0 +
+      (t1.tv_nsec - t0.tv_nsec) / 1000000.0;
+   printf("%d markers of type %d, %d frames: %.3f ms/frame\n",
+          num_markers,
+          marker_type,
+          num_frames,
+          msec / (double) num_frames);
+}
+
+int main(int argc, char *argv[])
+{
+   XEvent event;
+   KeySym ks;
+   Plimit3 vp, win;
+
+   if (argc > 1) {
+      num_markers = atoi(argv[1]);
+      printf("Number of markers: %d\n", num_markers);
+   }
+   if (argc > 2) {
+      marker_type = atoi(argv[2]);
+      printf("Marker type: %d\n", marker_type);
+   }
+   if (argc > 3) {
+      num_frames = atoi(argv[3]);
+      printf("Number of frames: %d\n", num_frames);
+   }
+
+   popen_phigs(NULL, 0);
+
+   popen_struct(0);
+   init_markers();
+   pclose_struct();
+
+   popen_ws(0, NULL, PWST_OUTPUT_TRUE_DB);
+   vp.x_min = VP_X0;
+   vp.x_max = VP_X1;
+   vp.y_min = VP_Y0;
+   vp.y_max = VP_Y1;
+   vp.z_min = 0.0;
+   vp.z_max = 1.0;
+   win.x_min = WIN_X0;
+   win.x_max = WIN_X1;
+   win.y_min = WIN_Y0;
+   win.y_max = WIN_Y1;
+   win.z_min = 0.0;
+   win.z_max = 1.0;
+   pset_ws_vp3(0, &vp);
+   pset_ws_win3(0, &win);
+
+   ppost_struct(0, 0, 0);
+
+   XSelectInput(PHG_WSID(0)->display,
+                PHG_WSID(0)->drawable_id,
+                ExposureMask | KeyPressMask);
+   while (1) {
+      XNextEvent(PHG_WSID(0)->display, &event);
+      switch(event.type) {
+
+         case Expose:
+            while (XCheckTypedEvent(PHG_WSID(0)->display, Expose, &event));
+            predraw_all_structs(0, PFLAG_ALWAYS);
+            break;
+
+         case KeyPress:
+            ks = XLookupKeysym((XKeyEvent *) &event, 0);
+            if (ks == XK_b) {
+               run_benchmark();
+            }
+            else if (ks == XK_Escape) {
+               goto exit;
+            }
+            break;
+
+         default:
+            break;
+      }
+   }
+
+exit:
+   pclose_ws(0);
+   pclose_phigs();
+
+   return 0;
+}
@@ -0,0 +1,256 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <sys/types.h>
+#include <X11/Xlib.h>
+#include <X11/keysym.h>
+
+#include "phg.h"
+
+#define NUM_LIGHTS   16
+#define GRID_SIZE    256
+#define NUM_FRAMES   20
+
+#define VP_X0    0.0
+#define VP_X1  800.0
+#define VP_Y0    0.0
+#define VP_Y1  800.0
+
+int num_frames = NUM_FRAMES;
+int num_lights = NUM_LIGHTS;
+int grid_size = GRID_SIZE;
+
+void init_lights(Pint ws_id)
+{
+   Pint i;
+   Pfloat phi;
+   Plight_src_bundle light;
+
+   light.type = PLIGHT_AMBIENT;
+   light.rec.ambient.colr.type = PMODEL_RGB;
+   light.rec.ambient.colr.val.general.x = 0.1;
+   light.rec.ambient.colr.val.general.y = 0.1;
+   light.rec.ambient.colr.val.general.z = 0.1;
+   pset_light_src_rep(ws_id, 1, &light);
+
+   for (i = 2; i <= num_lights; i++) {
+      phi = 2.0 * M_PI * (Pfloat) i / (Pfloat) num_lights;
+      light.type = PLIGHT_DIRECTIONAL;
+      light.rec.directional.colr.type = PMODEL_RGB;
+      light.rec.directional.colr.val.general.x = 0.5 + 0.5 * cos(phi);
+      light.rec.directional.colr.val.general.y = 0.5 + 0.5 * sin(phi);
+      light.rec.directional.colr.val.general.z = 0.5;
+      light.rec.directional.dir.delta_x = cos(phi);
+      light.rec.directional.dir.delta_y = sin(phi);
+      light.rec.directional.dir.delta_z = 1.0;
+      pset_light_src_rep(ws_id, i, &light);
+   }
+}
+
+void init_surface(void)
+{
+   Pint i, j, k, n;
+   Pfloat x, y;
+   Pint *lights;
+   Pint_list on_list, off_list;
+   Pint_list_list *vlist;
+   Pint_list *lists;
+   Pint *ints;
+   Pptnorm3 *ptnorms;
+   Pfacet_vdata_list3 vdata;
+   Pgcolr int_colr;
+   Prefl_props refl_props;
+
+   lights = (Pint *) malloc(sizeof(Pint) * num_lights);
+   for (i = 0; i < num_lights; i++) {
+      lights[i] = i + 1;
+   }
+   on_list.num_ints = num_lights;
+   on_list.ints = lights;
+   off_list.num_ints = 0;
+   off_list.ints = NULL;
+
+   int_colr.type = PMODEL_RGB;
+   int_colr.val.general.x = 1.0;
+   int_colr.val.general.y = 1.0;
+   int_colr.val.general.z = 1.0;
+   refl_props.ambient_coef = 1.0;
+   refl_props.diffuse_coef = 1.0;
+
+   pset_hlhsr_id(PHIGS_HLHSR_ID_ON);
+   pset_int_style(PSTYLE_SOLID);
+   pset_int_colr(&int_colr);
+   pset_light_src_state(&on_list, &off_list);
+   pset_int_shad_meth(PSD_COLOUR);
+   pset_refl_eqn(PREFL_AMB_DIFF);
+   pset_refl_props(&refl_props);
+
+   /* a bumpy surface with a normal per vertex */
+   n = grid_size + 1;
+   ptnorms = (Pptnorm3 *) malloc(sizeof(Pptnorm3) * n * n);
+   for (j = 0; j < n; j++) {
+      for (i = 0; i < n; i++) {
+         x = (Pfloat) i / (Pfloat) grid_size;
+         y = (Pfloat) j / (Pfloat) grid_size;
+         k = j * n + i;
+         ptnorms[k].point.x = x;
+         ptnorms[k].point.y = y;
+         ptnorms[k].point.z = 0.05 * sin(20.0 * x) * cos(20.0 * y);
+         ptnorms[k].norm.delta_x = -cos(20.0 * x) * cos(20.0 * y);
+         ptnorms[k].norm.delta_y = sin(20.0 * x) * sin(20.0 * y);
+         ptnorms[k].norm.delta_z = 1.0;
+      }
+   }
+   vdata.num_vertices = n * n;
+   vdata.vertex_data.ptnorms = ptnorms;
+
+   vlist = (Pint_list_list *) malloc(sizeof(Pint_list_list) *
+                                     grid_size * grid_size);
+   lists = (Pint_list *) malloc(sizeof(Pint_list) * grid_size * grid_size);
+   ints = (Pint *) malloc(sizeof(Pint) * 4 * grid_size * grid_size);
+   for (j = 0; j < grid_size; j++) {
+      for (i = 0; i < grid_size; i++) {
+         k = j * grid_size + i;
+         ints[4 * k]     = j * n + i;
+         ints[4 * k + 1] = j * n + i + 1;
+         ints[4 * k + 2] = (j + 1) * n + i + 1;
+         ints[4 * k + 3] = (j + 1) * n + i;
+         lists[k].num_ints = 4;
+         lists[k].ints = &ints[4 * k];
+         vlist[k].num_lists = 1;
+         vlist[k].lists = &lists[k];
+      }
+   }
+
+   pset_of_fill_area_set3_data(PFACET_NONE,
+                               PEDGE_NONE,
+                               PVERT_COORD_NORMAL,
+                               PMODEL_RGB,
+                               grid_size * grid_size,
+                               NULL,
+                               NULL,
+                               vlist,
+                               &vdata);
+
+   free(ints);
+   free(lists);
+   free(vlist);
+   free(ptnorms);
+   free(lights);
+}
+
+void run_benchmark(void)
+{
+   Pint i;
+   struct timespec t0, t1;
+   double msec;
+
+   clock_gettime(CLOCK_MONOTONIC, &t0);
+   for (i = 0; i < num_frames; i++) {
+      predraw_all_structs(0, PFLAG_ALWAYS);
+   }
+   clock_gettime(CLOCK_MONOTONIC, &t1);
+
+   msec = (t1.tv_sec - t0.tv_sec) * 1000.0 +
+      (t1.tv_nsec - t0.tv_nsec) / 1000000.0;
+   printf("%d lights, %d x %d facets, %d frames: %.3f ms/frame\n",
+          num_lights,
+          grid_size,
+          grid_size,
+          num_frames,
+          msec / (double) num_frames);
+}
+
+int main(int argc, char *argv[])
+{
+   XEvent event;
+   KeySym ks;
+   Plimit3 vp;
+
+   if (argc > 1) {
+      num_lights = atoi(argv[1]);
+      printf("Number of lights: %d\n", num_lights);
+   }
+   if (argc > 2) {
+      grid_size = atoi(argv[2]);
+      printf("Grid size: %d\n", grid_size);
+   }
+   if (argc > 3) {
+      num_frames = atoi(argv[3]);
+      printf("Number of frames: %d\n", num_frames);
+   }
+
+   popen_phigs(NULL, 0);
+
+   popen_struct(0);
+   init_surface();
+   pclose_struct();
+
+   popen_ws(0, NULL, PWST_OUTPUT_TRUE_DB);
+   pset_hlhsr_mode(0, PHIGS_HLHSR_MODE_ZBUFF);
+   init_lights(0);
+   vp.x_min = VP_X0;
+   vp.x_max = VP_X1;
+   vp.y_min = VP_Y0;
+   vp.y_max = VP_Y1;
+   vp.z_min = 0.0;
+   vp.z_max = 1.0;
+   pset_ws_vp3(0, &vp);
+
+   ppost_struct(0, 0, 0);
+
+   XSelectInput(PHG_WSID(0)->display,
+                PHG_WSID(0)->drawable_id,
+                ExposureMask | KeyPressMask);
+   while (1) {
+      XNextEvent(PHG_WSID(0)->display, &event);
+      switch(event.type) {
+
+         case Expose:
+            while (XCheckTypedEvent(PHG_WSID(0)->display, Expose, &event));
+            predraw_all_structs(0, PFLAG_ALWAYS);
+            break;
+
+         case KeyPress:
+            ks = XLookupKeysym((XKeyEvent *) &event, 0);
+            if (ks == XK_b) {
+               run_benchmark();
+            }
+            else if (ks == XK_Escape) {
+               goto exit;
+            }
+            break;
+
+         default:
+            break;
+      }
+   }
+
+exit:
+   pclose_ws(0);
+   pclose_phigs();
+
+   return 0;
+}
@@ -0,0 +1,171 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <sys/types.h>
+#include <X11/Xlib.h>
+
+#include "phg.h"
+
+#define NUM_IMAGES   50
+#define NUM_THREADS  4
+#define NUM_SPOKES   64
+
+#define WS_HCOPY     1
+
+int num_images = NUM_IMAGES;
+int num_threads = NUM_THREADS;
+int ws_type = PWST_HCOPY_TRUE_RGB_PNG;
+
+void init_scene(void)
+{
+   Pint i;
+   Pfloat phi;
+   Ppoint pts[3];
+   Ppoint_list plist;
+   Pgcolr colr;
+
+   pset_int_style(PSTYLE_SOLID);
+   plist.num_points = 3;
+   plist.points = pts;
+   for (i = 0; i < NUM_SPOKES; i++) {
+      phi = 2.0 * M_PI * (Pfloat) i / (Pfloat) NUM_SPOKES;
+      colr.type = PMODEL_RGB;
+      colr.val.general.x = 0.5 + 0.5 * cos(phi);
+      colr.val.general.y = 0.5 + 0.5 * sin(phi);
+      colr.val.general.z = 0.5;
+      pset_int_colr(&colr);
+      pts[0].x = 0.5;
+      pts[0].y = 0.5;
+      pts[1].x = 0.5 + 0.45 * cos(phi);
+      pts[1].y = 0.5 + 0.45 * sin(phi);
+      pts[2].x = 0.5 + 0.45 * cos(phi + M_PI / NUM_SPOKES);
+      pts[2].y = 0.5 + 0.45 * sin(phi + M_PI / NUM_SPOKES);
+      pfill_area(&plist);
+   }
+}
+
+void run_benchmark(Pint threads)
+{
+   Pint i;
+   char name[64];
+   Phg_args_conn_info conn;
+   struct timespec t0, t1;
+   double sec;
+
+   memset(&conn, 0, sizeof(Phg_args_conn_info));
+   pxset_hcopy_threads(threads);
+
+   clock_gettime(CLOCK_MONOTONIC, &t0);
+   for (i = 0; i < num_images; i++) {
+      sprintf(name, "test_c14_%03d.%s", i,
+              (ws_type == PWST_HCOPY_TRUE_TGA) ? "tga" : "png");
+      pxset_conf_hcopy_file(WS_HCOPY, name);
+      popen_ws(WS_HCOPY, &conn, ws_type);
+      ppost_struct(WS_HCOPY, 0, 0);
+      predraw_all_structs(WS_HCOPY, PFLAG_ALWAYS);
+      pclose_ws(WS_HCOPY);
+   }
+   pxflush_hcopy();
+   clock_gettime(CLOCK_MONOTONIC, &t1);
+
+   sec = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1.0e9;
+   printf("%d images, %d encoder threads: %.1f images/s\n",
+          num_images,
+          threads,
+          (double) num_images / sec);
+}
+
+void run_frames(Pint threads)
+{
+   Pint i;
+   char pattern[64];
+   Phg_args_conn_info conn;
+   struct timespec t0, t1;
+   double sec;
+
+   memset(&conn, 0, sizeof(Phg_args_conn_info));
+   pxset_hcopy_threads(threads);
+   sprintf(pattern, "test_c14_frame_%%03d.%s",
+           (ws_type == PWST_HCOPY_TRUE_TGA) ? "tga" : "png");
+
+   clock_gettime(CLOCK_MONOTONIC, &t0);
+   popen_ws(WS_HCOPY, &conn, ws_type);
+   pxset_hcopy_frames(WS_HCOPY, pattern);
+   ppost_struct(WS_HCOPY, 0, 0);
+   for (i = 0; i < num_images; i++) {
+      predraw_all_structs(WS_HCOPY, PFLAG_ALWAYS);
+   }
+   pclose_ws(WS_HCOPY);
+   pxflush_hcopy();
+   clock_gettime(CLOCK_MONOTONIC, &t1);
+
+   sec = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1.0e9;
+   printf("%d frames, one workstation, %d encoder threads: %.1f images/s\n",
+          num_images,
+          threads,
+          (double) num_images / sec);
+}
+
+int main(int argc, char *argv[])
+{
+   int has_display;
+
+   if (argc > 1) {
+      num_images = atoi(argv[1]);
+      printf("Number of images: %d\n", num_images);
+   }
+   if (argc > 2) {
+      num_threads = atoi(argv[2]);
+      printf("Number of encoder threads: %d\n", num_threads);
+   }
+   if (argc > 3 && strcmp(argv[3], "tga") == 0) {
+      ws_type = PWST_HCOPY_TRUE_TGA;
+   }
+
+   popen_phigs(NULL, 0);
+
+   popen_struct(0);
+   init_scene();
+   pclose_struct();
+
+   /* without headless rendering hardcopies share the window context */
+   has_display = (getenv("DISPLAY") != NULL);
+   if (has_display) {
+      popen_ws(0, NULL, PWST_OUTPUT_TRUE_DB);
+   }
+
+   run_benchmark(0);
+   if (num_threads > 0) {
+      run_benchmark(num_threads);
+   }
+   run_frames(num_threads);
+
+   if (has_display) {
+      pclose_ws(0);
+   }
+   pclose_phigs();
+
+   return 0;
+}
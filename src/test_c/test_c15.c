@@ -0,0 +1,140 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/types.h>
+#include <X11/Xlib.h>
+
+#include "phg.h"
+
+#define NUM_POINTS   1000000
+
+#define WS_OBJ       1
+#define OBJ_FILE     "test_c15.obj"
+
+int num_points = NUM_POINTS;
+
+void init_scene(void)
+{
+   Pint i;
+   Pfloat phi;
+   Ppoint_list3 plist;
+
+   plist.num_points = num_points;
+   plist.points = (Ppoint3 *) malloc(num_points * sizeof(Ppoint3));
+   if (plist.points == NULL) {
+      fprintf(stderr, "Out of memory\n");
+      exit(1);
+   }
+   /* a spiral, every point distinct */
+   for (i = 0; i < num_points; i++) {
+      phi = 0.01 * (Pfloat) i;
+      plist.points[i].x = 0.5 + 0.4 * cos(phi) * (Pfloat) i / (Pfloat) num_points;
+      plist.points[i].y = 0.5 + 0.4 * sin(phi) * (Pfloat) i / (Pfloat) num_points;
+      plist.points[i].z = (Pfloat) i / (Pfloat) num_points;
+   }
+   ppolyline3(&plist);
+   free(plist.points);
+}
+
+int check_obj(void)
+{
+   FILE *fp;
+   int c, prev;
+   long num_v, num_l, num_ind;
+   int in_line;
+
+   fp = fopen(OBJ_FILE, "r");
+   if (fp == NULL) {
+      perror(OBJ_FILE);
+      return 0;
+   }
+   num_v = num_l = num_ind = 0;
+   in_line = 0;
+   prev = '\n';
+   while ((c = fgetc(fp)) != EOF) {
+      if (prev == '\n') {
+         in_line = (c == 'l');
+         if (c == 'v') {
+            c = fgetc(fp);
+            if (c == ' ') num_v++;
+         }
+         else if (c == 'l') {
+            num_l++;
+         }
+      }
+      else if (in_line && c == ' ') {
+         num_ind++;
+      }
+      prev = c;
+   }
+   fclose(fp);
+
+   printf("%s: %ld vertices, %ld lines, %ld line indices\n",
+          OBJ_FILE, num_v, num_l, num_ind);
+
+   return (num_v == num_points && num_l == 1 && num_ind == num_points);
+}
+
+int main(int argc, char *argv[])
+{
+   Phg_args_conn_info conn;
+   int has_display;
+
+   if (argc > 1) {
+      num_points = atoi(argv[1]);
+      printf("Number of points: %d\n", num_points);
+   }
+
+   popen_phigs(NULL, 0);
+
+   popen_struct(0);
+   init_scene();
+   pclose_struct();
+
+   /* without headless rendering hardcopies share the window context */
+   has_display = (getenv("DISPLAY") != NULL);
+   if (has_display) {
+      popen_ws(0, NULL, PWST_OUTPUT_TRUE_DB);
+   }
+
+   memset(&conn, 0, sizeof(Phg_args_conn_info));
+   pxset_conf_hcopy_file(WS_OBJ, OBJ_FILE);
+   popen_ws(WS_OBJ, &conn, PWST_HCOPY_TRUE_OBJ);
+   ppost_struct(WS_OBJ, 0, 0);
+   predraw_all_structs(WS_OBJ, PFLAG_ALWAYS);
+   pclose_ws(WS_OBJ);
+
+   if (has_display) {
+      pclose_ws(0);
+   }
+   pclose_phigs();
+
+   if (!check_obj()) {
+      printf("FAILED\n");
+      return 1;
+   }
+   printf("PASSED\n");
+
+   return 0;
+}
@@ -0,0 +1,116 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include "phg.h"
+
+#define WS_1         0
+#define DEV_LOC      1
+#define NUM_WAITS    5
+
+double wall_time(void)
+{
+   struct timeval tv;
+
+   gettimeofday(&tv, NULL);
+   return (double) tv.tv_sec + (double) tv.tv_usec * 1.0e-6;
+}
+
+double cpu_time(void)
+{
+   struct rusage ru;
+
+   getrusage(RUSAGE_SELF, &ru);
+   return (double) (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) +
+          (double) (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1.0e-6;
+}
+
+void init_locator(Pint ws_id, Pint dev_id, Pop_mode mode, Pecho_switch echo)
+{
+   Plimit3 echo_volume = {0.0, 500.0, 0.0, 500.0, 0.0, 1.0};
+   Ppoint3 init_pos = {0.0, 0.0, 0.0};
+   Ploc_data3 rec;
+   rec.pets.pet_r1.unused = 0;
+
+   pinit_loc3(ws_id, dev_id, 0, &init_pos, 1, &echo_volume, &rec);
+   pset_loc_mode(ws_id, dev_id, mode, echo);
+}
+
+/* Wait for events nobody generates, report how long it took and the
+ * processor time spent while idle.
+ */
+int measure(Pfloat timeout)
+{
+   int i;
+   Pint ws_id, in_num;
+   Pin_class class;
+   double wall, cpu, err, max_err = 0.0;
+
+   wall = wall_time();
+   cpu = cpu_time();
+   for (i = 0; i < NUM_WAITS; i++) {
+      err = wall_time();
+      pawait_event(timeout, &ws_id, &class, &in_num);
+      err = wall_time() - err - timeout;
+      if (err < 0.0) err = -err;
+      if (err > max_err) max_err = err;
+      if (class != PIN_NONE) {
+         printf("Unexpected event class %d, move the pointer away\n", class);
+      }
+   }
+   wall = wall_time() - wall;
+   cpu = cpu_time() - cpu;
+
+   printf("Timeout %6.3f s: wall %7.3f s, cpu %7.4f s (%5.2f %%), "
+          "max error %6.2f ms\n",
+          timeout, wall, cpu, 100.0 * cpu / wall, 1000.0 * max_err);
+
+   /* a waiting application should leave the processor alone */
+   return (cpu < 0.05 * wall && max_err < 0.5 * timeout + 0.02);
+}
+
+int main(void)
+{
+   int ok = 1;
+
+   popen_phigs(NULL, 0);
+   popen_ws(WS_1, NULL, PWST_OUTIN_TRUE_DB);
+   init_locator(WS_1, DEV_LOC, POP_EVENT, PSWITCH_NO_ECHO);
+
+   /* short and long waits */
+   ok &= measure(0.01);
+   ok &= measure(0.05);
+   ok &= measure(1.0);
+
+   pclose_ws(WS_1);
+   pclose_phigs();
+
+   if (!ok) {
+      printf("FAILED\n");
+      return 1;
+   }
+   printf("PASSED\n");
+
+   return 0;
+}
@@ -0,0 +1,212 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <X11/Xlib.h>
+
+#include "phg.h"
+
+/* Stress test of the input event dispatch table with many windows and
+ * devices. Runs without a display, the events are made up.
+ */
+
+#define NUM_DISPLAYS   4
+#define NUM_WINDOWS    100
+#define NUM_DEVICES    6
+#define NUM_ROUNDS     2000
+
+static int event_types[] = {
+   KeyPress, KeyRelease, ButtonPress, ButtonRelease, MotionNotify,
+   EnterNotify, LeaveNotify
+};
+
+#define NUM_TYPES ((int) (sizeof(event_types) / sizeof(event_types[0])))
+
+/* fake connections, only the address is used */
+static char displays[NUM_DISPLAYS];
+
+/* calls per display, window and device */
+static int calls[NUM_DISPLAYS][NUM_WINDOWS][NUM_DEVICES];
+
+static Phg_sin_evt_tbl *tbl;
+
+double wall_time(void)
+{
+   struct timeval tv;
+
+   gettimeofday(&tv, NULL);
+   return (double) tv.tv_sec + (double) tv.tv_usec * 1.0e-6;
+}
+
+#define DISPLAY(_d) ((Display *) &displays[(_d)])
+#define WINDOW(_w)  ((Window) (0x400001 + (_w) * 0x10))
+#define CDATA(_d, _w, _i) \
+   ((caddr_t) &calls[(_d)][(_w)][(_i)])
+
+void count_event(Display *display, Window window, caddr_t cdata, XEvent *event)
+{
+   (*(int *) cdata)++;
+}
+
+/* unregisters itself, its neighbour must still be called */
+void once_event(Display *display, Window window, caddr_t cdata, XEvent *event)
+{
+   (*(int *) cdata)++;
+   phg_sin_evt_unregister(tbl, display, window, event->type, cdata);
+}
+
+void send_event(int d, int w, int type)
+{
+   XEvent event;
+
+   memset(&event, 0, sizeof(XEvent));
+   event.type = type;
+   event.xany.window = WINDOW(w);
+   phg_sin_evt_dispatch(tbl, DISPLAY(d), &event);
+}
+
+void clear_calls(void)
+{
+   memset(calls, 0, sizeof(calls));
+}
+
+/* every device except the first three listens to every event type */
+int expect(int d, int w, int i, int num)
+{
+   if (calls[d][w][i] != num) {
+      printf("Display %d window %d device %d: %d calls, expected %d\n",
+             d, w, i, calls[d][w][i], num);
+      return 0;
+   }
+   return 1;
+}
+
+int main(void)
+{
+   int d, w, i, t, n, ok = 1;
+   double time;
+
+   tbl = phg_sin_evt_tbl_create(PHG_NUM_EVENTS);
+   if (tbl == NULL) {
+      printf("FAILED to create event table\n");
+      return 1;
+   }
+
+   /* register each device twice, the second one only replaces it */
+   for (n = 0; n < 2; n++) {
+      for (d = 0; d < NUM_DISPLAYS; d++) {
+         for (w = 0; w < NUM_WINDOWS; w++) {
+            for (i = 0; i < NUM_DEVICES; i++) {
+               for (t = 0; t < NUM_TYPES; t++) {
+                  if (!phg_sin_evt_register(tbl, DISPLAY(d), WINDOW(w),
+                                            event_types[t], CDATA(d, w, i),
+                                            count_event)) {
+                     printf("FAILED to register\n");
+                     return 1;
+                  }
+               }
+            }
+         }
+      }
+   }
+   printf("Registered %d entries\n", tbl->num_entries);
+   ok &= (tbl->num_entries == NUM_DISPLAYS * NUM_WINDOWS * NUM_DEVICES *
+          NUM_TYPES);
+
+   /* each event reaches the devices of its own window only */
+   clear_calls();
+   time = wall_time();
+   for (n = 0; n < NUM_ROUNDS; n++) {
+      for (d = 0; d < NUM_DISPLAYS; d++) {
+         for (w = 0; w < NUM_WINDOWS; w++) {
+            send_event(d, w, MotionNotify);
+         }
+      }
+   }
+   time = wall_time() - time;
+   printf("Dispatched %d events in %.3f s, %.1f ns per event\n",
+          NUM_ROUNDS * NUM_DISPLAYS * NUM_WINDOWS, time,
+          1.0e9 * time / (NUM_ROUNDS * NUM_DISPLAYS * NUM_WINDOWS));
+   for (d = 0; d < NUM_DISPLAYS; d++) {
+      for (w = 0; w < NUM_WINDOWS; w++) {
+         for (i = 0; i < NUM_DEVICES; i++) {
+            ok &= expect(d, w, i, NUM_ROUNDS);
+         }
+      }
+   }
+
+   /* no registration for this event type or window */
+   clear_calls();
+   send_event(0, 0, Expose);
+   send_event(0, NUM_WINDOWS, MotionNotify);
+   for (i = 0; i < NUM_DEVICES; i++) {
+      ok &= expect(0, 0, i, 0);
+   }
+
+   /* single unregister */
+   phg_sin_evt_unregister(tbl, DISPLAY(1), WINDOW(7), ButtonPress,
+                          CDATA(1, 7, 2));
+   clear_calls();
+   send_event(1, 7, ButtonPress);
+   ok &= expect(1, 7, 1, 1);
+   ok &= expect(1, 7, 2, 0);
+   ok &= expect(1, 7, 3, 1);
+
+   /* callback removing itself while dispatching */
+   phg_sin_evt_register(tbl, DISPLAY(2), WINDOW(3), KeyPress,
+                        CDATA(2, 3, 0), once_event);
+   clear_calls();
+   send_event(2, 3, KeyPress);
+   send_event(2, 3, KeyPress);
+   ok &= expect(2, 3, 0, 1);
+   ok &= expect(2, 3, 1, 2);
+
+   /* unregister window and display */
+   phg_sin_evt_unregister_window(tbl, DISPLAY(0), WINDOW(5));
+   phg_sin_evt_unregister_display(tbl, DISPLAY(3));
+   clear_calls();
+   for (d = 0; d < NUM_DISPLAYS; d++) {
+      for (w = 0; w < NUM_WINDOWS; w++) {
+         send_event(d, w, LeaveNotify);
+      }
+   }
+   for (d = 0; d < NUM_DISPLAYS; d++) {
+      for (w = 0; w < NUM_WINDOWS; w++) {
+         n = (d == 3 || (d == 0 && w == 5)) ? 0 : 1;
+         for (i = 0; i < NUM_DEVICES; i++) {
+            ok &= expect(d, w, i, n);
+         }
+      }
+   }
+   printf("Remaining %d entries\n", tbl->num_entries);
+
+   phg_sin_evt_tbl_destroy(tbl);
+
+   if (!ok) {
+      printf("FAILED\n");
+      return 1;
+   }
+   printf("PASSED\n");
+
+   return 0;
+}
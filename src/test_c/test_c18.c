@@ -0,0 +1,214 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/types.h>
+#include <X11/Xlib.h>
+
+#include "phg.h"
+
+#define NUM_POINTS   1000000
+#define NUM_ELEMENTS 20
+
+int num_points = NUM_POINTS;
+
+double now(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (double) ts.tv_sec + 1.0e-9 * (double) ts.tv_nsec;
+}
+
+void fill_points(Ppoint3 *points)
+{
+   Pint i;
+
+   for (i = 0; i < num_points; i++) {
+      points[i].x = (Pfloat) i;
+      points[i].y = (Pfloat) (i % 1000);
+      points[i].z = 0.5;
+   }
+}
+
+/* polylines copied from a caller buffer, the buffer is filled once */
+double time_copy(void)
+{
+   Pint i;
+   double t0, t;
+   Ppoint_list3 plist;
+
+   plist.num_points = num_points;
+   plist.points = (Ppoint3 *) malloc(num_points * sizeof(Ppoint3));
+   if (plist.points == NULL) {
+      fprintf(stderr, "Out of memory\n");
+      exit(1);
+   }
+   fill_points(plist.points);
+
+   popen_struct(1);
+   t0 = now();
+   for (i = 0; i < NUM_ELEMENTS; i++) {
+      ppolyline3(&plist);
+   }
+   t = now() - t0;
+   pclose_struct();
+   free(plist.points);
+
+   return t;
+}
+
+/* polylines handed over, each buffer allocated and filled in the loop */
+double time_adopt(void)
+{
+   Pint i;
+   double t0, t, t_fill;
+   Ppoint_list3 plist;
+
+   popen_struct(2);
+   t_fill = 0.0;
+   t0 = now();
+   for (i = 0; i < NUM_ELEMENTS; i++) {
+      plist.num_points = num_points;
+      plist.points = pxalloc_points3(num_points);
+      if (plist.points == NULL) {
+         fprintf(stderr, "Out of memory\n");
+         exit(1);
+      }
+      t = now();
+      fill_points(plist.points);
+      t_fill += now() - t;
+      pxadopt_polyline3(&plist);
+   }
+   t = now() - t0 - t_fill;
+   pclose_struct();
+
+   return t;
+}
+
+int check_polyline(Pint struct_id, Pint elem_num, Pstore store)
+{
+   Pint err;
+   Pelem_type type;
+   size_t size;
+   Pelem_data *data;
+   Ppoint3 *points;
+
+   pinq_elem_type_size(struct_id, elem_num, &err, &type, &size);
+   if (err != 0 || type != PELEM_POLYLINE3) {
+      printf("Element %d of structure %d: type %d, error %d\n",
+             elem_num, struct_id, type, err);
+      return 0;
+   }
+   pinq_elem_content(struct_id, elem_num, store, &err, &data);
+   if (err != 0 || data->point_list3.num_points != num_points) {
+      printf("Element %d of structure %d: %d points, error %d\n",
+             elem_num, struct_id, data->point_list3.num_points, err);
+      return 0;
+   }
+   points = data->point_list3.points;
+   if (points[num_points - 1].x != (Pfloat) (num_points - 1) ||
+       points[num_points - 1].z != 0.5) {
+      printf("Element %d of structure %d: wrong points\n",
+             elem_num, struct_id);
+      return 0;
+   }
+
+   return 1;
+}
+
+/* fill area set with data from a packed buffer */
+int check_fasd3(Pstore store)
+{
+   Pint err;
+   Pint *data;
+   Ppoint3 *points;
+   Pelem_data *elem_data;
+
+   data = (Pint *) pxalloc_el_data(6 * sizeof(Pint) + 3 * sizeof(Ppoint3));
+   if (data == NULL) {
+      return 0;
+   }
+   data[0] = PFACET_NONE;
+   data[1] = PEDGE_NONE;
+   data[2] = PVERT_COORD;
+   data[3] = PMODEL_RGB;
+   data[4] = 1;                       /* nfa */
+   data[5] = 3;                       /* num_vertices */
+   points = (Ppoint3 *) &data[6];
+   points[0].x = 0.0; points[0].y = 0.0; points[0].z = 0.0;
+   points[1].x = 1.0; points[1].y = 0.0; points[1].z = 0.0;
+   points[2].x = 0.0; points[2].y = 1.0; points[2].z = 0.0;
+
+   popen_struct(3);
+   pxadopt_fill_area_set3_data(data);
+   pclose_struct();
+
+   pinq_elem_content(3, 1, store, &err, &elem_data);
+   if (err != 0 ||
+       elem_data->fasd3.nfa != 1 ||
+       elem_data->fasd3.vdata->num_vertices != 3 ||
+       elem_data->fasd3.vdata->vertex_data.points[2].y != 1.0) {
+      printf("Fill area set with data: wrong content, error %d\n", err);
+      return 0;
+   }
+
+   return 1;
+}
+
+int main(int argc, char *argv[])
+{
+   Pint err;
+   Pstore store;
+   double t_copy, t_adopt;
+   int ok;
+
+   if (argc > 1) {
+      num_points = atoi(argv[1]);
+      printf("Number of points: %d\n", num_points);
+   }
+
+   popen_phigs(NULL, 0);
+
+   t_copy = time_copy();
+   t_adopt = time_adopt();
+   printf("%d polylines of %d points\n", NUM_ELEMENTS, num_points);
+   printf("copied:  %8.2f ms per element\n", 1.0e3 * t_copy / NUM_ELEMENTS);
+   printf("adopted: %8.2f ms per element\n", 1.0e3 * t_adopt / NUM_ELEMENTS);
+
+   pcreate_store(&err, &store);
+   ok = check_polyline(1, NUM_ELEMENTS, store) &&
+        check_polyline(2, NUM_ELEMENTS, store) &&
+        check_fasd3(store);
+   pdel_store(store);
+
+   pclose_phigs();
+
+   if (!ok) {
+      printf("FAILED\n");
+      return 1;
+   }
+   printf("PASSED\n");
+
+   return 0;
+}
@@ -0,0 +1,188 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/types.h>
+#include <X11/Xlib.h>
+
+#include "phg.h"
+#include "util/pack.h"
+
+#define NUM_POINTS 1000000
+#define NUM_LOOPS  50
+
+int num_points = NUM_POINTS;
+
+double now(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (double) ts.tv_sec + 1.0e-9 * (double) ts.tv_nsec;
+}
+
+/* the loop the Fortran binding used before the interleave kernels */
+void pack_scalar(Ppoint3 *points, Pfloat *x, Pfloat *y, Pfloat *z, Pint n)
+{
+   Pint i;
+
+   for (i = 0; i < n; i++) {
+      points[i].x = x[i];
+      points[i].y = y[i];
+      points[i].z = z[i];
+   }
+}
+
+void pack_scalar2(Ppoint *points, Pfloat *x, Pfloat *y, Pint n)
+{
+   Pint i;
+
+   for (i = 0; i < n; i++) {
+      points[i].x = x[i];
+      points[i].y = y[i];
+   }
+}
+
+/* all counts up to a few vector widths, to cover the scalar tails */
+int check_tails(void)
+{
+   Pint n, i;
+   Pfloat x[64], y[64], z[64];
+   Ppoint3 points3[65];
+   Ppoint points[65];
+
+   for (i = 0; i < 64; i++) {
+      x[i] = (Pfloat) i;
+      y[i] = (Pfloat) (100 + i);
+      z[i] = (Pfloat) (200 + i);
+   }
+   for (n = 0; n < 64; n++) {
+      memset(points3, 0, sizeof(points3));
+      memset(points, 0, sizeof(points));
+      phg_pack_points3(points3, x, y, z, n);
+      phg_pack_points(points, x, y, n);
+      for (i = 0; i < n; i++) {
+         if (points3[i].x != x[i] || points3[i].y != y[i] ||
+             points3[i].z != z[i] ||
+             points[i].x != x[i] || points[i].y != y[i]) {
+            printf("Wrong point %d of %d\n", i, n);
+            return 0;
+         }
+      }
+      if (points3[n].x != 0.0 || points[n].x != 0.0) {
+         printf("Write past %d points\n", n);
+         return 0;
+      }
+   }
+
+   return 1;
+}
+
+int main(int argc, char *argv[])
+{
+   Pint i;
+   Pfloat *x, *y, *z;
+   Ppoint3 *points3, *ref3;
+   Ppoint *points, *ref;
+   double t0, t_scalar, t_pack, t_scalar2, t_pack2;
+   int ok;
+
+   if (argc > 1) {
+      num_points = atoi(argv[1]);
+      printf("Number of points: %d\n", num_points);
+   }
+
+   x = (Pfloat *) malloc(num_points * sizeof(Pfloat));
+   y = (Pfloat *) malloc(num_points * sizeof(Pfloat));
+   z = (Pfloat *) malloc(num_points * sizeof(Pfloat));
+   points3 = (Ppoint3 *) malloc(num_points * sizeof(Ppoint3));
+   ref3 = (Ppoint3 *) malloc(num_points * sizeof(Ppoint3));
+   points = (Ppoint *) malloc(num_points * sizeof(Ppoint));
+   ref = (Ppoint *) malloc(num_points * sizeof(Ppoint));
+   if (x == NULL || y == NULL || z == NULL || points3 == NULL ||
+       ref3 == NULL || points == NULL || ref == NULL) {
+      fprintf(stderr, "Out of memory\n");
+      return 1;
+   }
+   for (i = 0; i < num_points; i++) {
+      x[i] = (Pfloat) i;
+      y[i] = (Pfloat) (i % 1000);
+      z[i] = 0.5;
+   }
+
+   /* warm up caches and select the kernels */
+   pack_scalar(ref3, x, y, z, num_points);
+   phg_pack_points3(points3, x, y, z, num_points);
+   pack_scalar2(ref, x, y, num_points);
+   phg_pack_points(points, x, y, num_points);
+
+   t0 = now();
+   for (i = 0; i < NUM_LOOPS; i++) {
+      pack_scalar(ref3, x, y, z, num_points);
+   }
+   t_scalar = now() - t0;
+
+   t0 = now();
+   for (i = 0; i < NUM_LOOPS; i++) {
+      phg_pack_points3(points3, x, y, z, num_points);
+   }
+   t_pack = now() - t0;
+
+   t0 = now();
+   for (i = 0; i < NUM_LOOPS; i++) {
+      pack_scalar2(ref, x, y, num_points);
+   }
+   t_scalar2 = now() - t0;
+
+   t0 = now();
+   for (i = 0; i < NUM_LOOPS; i++) {
+      phg_pack_points(points, x, y, num_points);
+   }
+   t_pack2 = now() - t0;
+
+   printf("Interleave %d points, Mpoints per second:\n", num_points);
+   printf("3D scalar: %8.1f\n", 1.0e-6 * NUM_LOOPS * num_points / t_scalar);
+   printf("3D packed: %8.1f\n", 1.0e-6 * NUM_LOOPS * num_points / t_pack);
+   printf("2D scalar: %8.1f\n", 1.0e-6 * NUM_LOOPS * num_points / t_scalar2);
+   printf("2D packed: %8.1f\n", 1.0e-6 * NUM_LOOPS * num_points / t_pack2);
+
+   ok = memcmp(points3, ref3, num_points * sizeof(Ppoint3)) == 0 &&
+        memcmp(points, ref, num_points * sizeof(Ppoint)) == 0 &&
+        check_tails();
+
+   free(x);
+   free(y);
+   free(z);
+   free(points3);
+   free(ref3);
+   free(points);
+   free(ref);
+
+   if (!ok) {
+      printf("FAILED\n");
+      return 1;
+   }
+   printf("PASSED\n");
+
+   return 0;
+}
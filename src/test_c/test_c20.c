@@ -0,0 +1,119 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <X11/Xlib.h>
+
+#include "phg.h"
+
+#define NUM_POINTS 1000
+
+Pfloat x[NUM_POINTS], y[NUM_POINTS], z[NUM_POINTS];
+
+/* separate coordinate array elements are inquired as interleaved points */
+int check_points(Pint struct_id, Pint elem_num, Pelem_type type,
+                 Pint num_points, Pstore store)
+{
+   Pint i, err;
+   Pelem_type elem_type;
+   size_t size;
+   Pelem_data *data;
+   Ppoint3 *points;
+
+   pinq_elem_type_size(struct_id, elem_num, &err, &elem_type, &size);
+   if (err != 0 || elem_type != type) {
+      printf("Element %d of structure %d: type %d, error %d\n",
+             elem_num, struct_id, elem_type, err);
+      return 0;
+   }
+   pinq_elem_content(struct_id, elem_num, store, &err, &data);
+   if (err != 0 || data->point_list3.num_points != num_points) {
+      printf("Element %d of structure %d: %d points, error %d\n",
+             elem_num, struct_id, data->point_list3.num_points, err);
+      return 0;
+   }
+   points = data->point_list3.points;
+   for (i = 0; i < num_points; i++) {
+      if (points[i].x != x[i] || points[i].y != y[i] || points[i].z != z[i]) {
+         printf("Element %d of structure %d: wrong point %d\n",
+                elem_num, struct_id, i);
+         return 0;
+      }
+   }
+
+   return 1;
+}
+
+int check_struct(Pstore store)
+{
+   return check_points(1, 1, PELEM_POLYLINE3_SOA, NUM_POINTS, store) &&
+          check_points(1, 2, PELEM_POLYMARKER3_SOA, NUM_POINTS, store) &&
+          check_points(1, 3, PELEM_FILL_AREA3_SOA, 3, store);
+}
+
+int main(int argc, char *argv[])
+{
+   Pint i, err;
+   Pstore store;
+   int ok;
+
+   for (i = 0; i < NUM_POINTS; i++) {
+      x[i] = (Pfloat) i;
+      y[i] = (Pfloat) (i % 100);
+      z[i] = 0.5 * (Pfloat) i;
+   }
+
+   popen_phigs(NULL, 0);
+
+   popen_struct(1);
+   pxpolyline3_soa(NUM_POINTS, x, y, z);
+   pxpolymarker3_soa(NUM_POINTS, x, y, z);
+   pxfill_area3_soa(3, x, y, z);
+   pclose_struct();
+
+   pcreate_store(&err, &store);
+   ok = check_struct(store);
+
+   /* the layout survives an archive round trip */
+   if (ok) {
+      popen_ar_file(0, "test_c20.ar");
+      par_all_structs(0);
+      pclose_ar_file(0);
+      pdel_all_structs();
+      popen_ar_file(0, "test_c20.ar");
+      pret_all_structs(0);
+      pclose_ar_file(0);
+      ok = check_struct(store);
+   }
+   pdel_store(store);
+
+   pclose_phigs();
+
+   if (!ok) {
+      printf("FAILED\n");
+      return 1;
+   }
+   printf("PASSED\n");
+
+   return 0;
+}
@@ -0,0 +1,272 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "phg.h"
+
+#define NUM_GROUPS       1000
+#define PRIMS_PER_GROUP  50
+#define NUM_FRAMES       20
+#define MAX_NAME         2048
+
+/* hidden name near the top of the range and a visible neighbour */
+#define HIDDEN_NAME      (MAX_NAME - 2)
+#define SHOWN_NAME       (MAX_NAME - 3)
+
+#define WS_SVG           1
+#define SVG_FILE         "test_c21.svg"
+
+#define VP_X0    0.0
+#define VP_X1  500.0
+#define VP_Y0    0.0
+#define VP_Y1  500.0
+
+int num_groups = NUM_GROUPS;
+int prims_per_group = PRIMS_PER_GROUP;
+int num_frames = NUM_FRAMES;
+
+/* Each group adds one name, names from 1024 up use the sparse nameset */
+void init_groups(void)
+{
+   Pint i, j, name;
+   Pint_list names;
+   Ppoint pts[2];
+   Ppoint_list plist;
+
+   names.num_ints = 1;
+   names.ints = &name;
+   plist.num_points = 2;
+   plist.points = pts;
+
+   pset_line_colr_ind(1);
+   for (i = 0; i < num_groups; i++) {
+      name = i % MAX_NAME;
+      padd_names_set(&names);
+      for (j = 0; j < prims_per_group; j++) {
+         pts[0].x = (Pfloat) rand() / (Pfloat) RAND_MAX;
+         pts[0].y = (Pfloat) rand() / (Pfloat) RAND_MAX;
+         pts[1].x = pts[0].x + 0.01;
+         pts[1].y = pts[0].y;
+         ppolyline(&plist);
+      }
+      premove_names_set(&names);
+   }
+}
+
+/* Hide every third name and highlight every fourth name */
+void init_filters(Pint ws_id)
+{
+   Pint i, num_invis, num_highl;
+   Pint *invis, *highl;
+   Pfilter invis_filter, highl_filter;
+
+   invis = (Pint *) malloc(sizeof(Pint) * MAX_NAME);
+   highl = (Pint *) malloc(sizeof(Pint) * MAX_NAME);
+   for (i = 0, num_invis = 0, num_highl = 0; i < MAX_NAME; i++) {
+      if (i % 3 == 0) {
+         invis[num_invis++] = i;
+      }
+      if (i % 4 == 0) {
+         highl[num_highl++] = i;
+      }
+   }
+
+   invis_filter.incl_set.num_ints = num_invis;
+   invis_filter.incl_set.ints = invis;
+   invis_filter.excl_set.num_ints = 0;
+   invis_filter.excl_set.ints = NULL;
+   pset_invis_filter(ws_id, &invis_filter);
+
+   highl_filter.incl_set.num_ints = num_highl;
+   highl_filter.incl_set.ints = highl;
+   highl_filter.excl_set.num_ints = 0;
+   highl_filter.excl_set.ints = NULL;
+   pset_highl_filter(ws_id, &highl_filter);
+
+   free(invis);
+   free(highl);
+}
+
+/* One square under a hidden name and one under a visible name */
+void init_check(void)
+{
+   Pint name;
+   Pint_list names;
+   Ppoint pts[4];
+   Ppoint_list plist;
+
+   names.num_ints = 1;
+   names.ints = &name;
+   plist.num_points = 4;
+   plist.points = pts;
+   pts[0].x = 0.1; pts[0].y = 0.1;
+   pts[1].x = 0.4; pts[1].y = 0.1;
+   pts[2].x = 0.4; pts[2].y = 0.4;
+   pts[3].x = 0.1; pts[3].y = 0.4;
+
+   pset_int_style(PSTYLE_SOLID);
+   pset_int_colr_ind(1);
+   name = HIDDEN_NAME;
+   padd_names_set(&names);
+   pfill_area(&plist);
+   premove_names_set(&names);
+   name = SHOWN_NAME;
+   padd_names_set(&names);
+   pfill_area(&plist);
+   premove_names_set(&names);
+}
+
+/* All names are kept in the filter and the top ones still hide primitives */
+int check_filters(void)
+{
+   Phg_args_conn_info conn;
+   Pstore store;
+   Pfilter *filter;
+   Pint i, err, num_invis, found;
+   FILE *fp;
+   char line[1024];
+   int num_prims;
+
+   pcreate_store(&err, &store);
+   pinq_invis_filter(0, store, &err, &filter);
+   if (err != 0) {
+      printf("pinq_invis_filter: error %d\n", err);
+      return 0;
+   }
+   num_invis = (MAX_NAME + 2) / 3;
+   found = 0;
+   for (i = 0; i < filter->incl_set.num_ints; i++) {
+      if (filter->incl_set.ints[i] == HIDDEN_NAME) {
+         found = 1;
+      }
+   }
+   printf("Invisibility filter: %d of %d names, %d %s\n",
+          filter->incl_set.num_ints,
+          num_invis,
+          HIDDEN_NAME,
+          found ? "included" : "missing");
+   if (filter->incl_set.num_ints != num_invis || !found) {
+      pdel_store(store);
+      return 0;
+   }
+   pdel_store(store);
+
+   memset(&conn, 0, sizeof(Phg_args_conn_info));
+   pxset_conf_hcopy_file(WS_SVG, SVG_FILE);
+   popen_ws(WS_SVG, &conn, PWST_HCOPY_TRUE_SVG);
+   init_filters(WS_SVG);
+   ppost_struct(WS_SVG, 1, 0);
+   predraw_all_structs(WS_SVG, PFLAG_ALWAYS);
+   pclose_ws(WS_SVG);
+
+   fp = fopen(SVG_FILE, "r");
+   if (fp == NULL) {
+      perror(SVG_FILE);
+      return 0;
+   }
+   num_prims = 0;
+   while (fgets(line, sizeof(line), fp) != NULL) {
+      if (strncmp(line, "<polygon", 8) == 0 ||
+          strncmp(line, "<polyline", 9) == 0 ||
+          strncmp(line, "<path", 5) == 0) {
+         num_prims++;
+      }
+   }
+   fclose(fp);
+   printf("%s: %d of 2 squares drawn\n", SVG_FILE, num_prims);
+
+   return (num_prims == 1);
+}
+
+void run_benchmark(void)
+{
+   Pint i;
+   struct timespec t0, t1;
+   double msec;
+
+   clock_gettime(CLOCK_MONOTONIC, &t0);
+   for (i = 0; i < num_frames; i++) {
+      predraw_all_structs(0, PFLAG_ALWAYS);
+   }
+   clock_gettime(CLOCK_MONOTONIC, &t1);
+
+   msec = (t1.tv_sec - t0.tv_sec) * 1000.0 +
+      (t1.tv_nsec - t0.tv_nsec) / 1000000.0;
+   printf("%d groups of %d polylines, %d frames: %.3f ms/frame\n",
+          num_groups,
+          prims_per_group,
+          num_frames,
+          msec / (double) num_frames);
+}
+
+int main(int argc, char *argv[])
+{
+   Plimit3 vp;
+   int status;
+
+   if (argc > 1) {
+      num_groups = atoi(argv[1]);
+   }
+   if (argc > 2) {
+      prims_per_group = atoi(argv[2]);
+   }
+   if (argc > 3) {
+      num_frames = atoi(argv[3]);
+   }
+
+   popen_phigs(NULL, 0);
+
+   popen_struct(0);
+   init_groups();
+   pclose_struct();
+
+   popen_struct(1);
+   init_check();
+   pclose_struct();
+
+   popen_ws(0, NULL, PWST_OUTPUT_TRUE_DB);
+   vp.x_min = VP_X0;
+   vp.x_max = VP_X1;
+   vp.y_min = VP_Y0;
+   vp.y_max = VP_Y1;
+   vp.z_min = 0.0;
+   vp.z_max = 1.0;
+   pset_ws_vp3(0, &vp);
+   init_filters(0);
+
+   ppost_struct(0, 0, 0);
+   run_benchmark();
+   status = check_filters();
+
+   pclose_ws(0);
+   pclose_phigs();
+
+   if (!status) {
+      printf("FAILED\n");
+      return 1;
+   }
+   printf("PASSED\n");
+
+   return 0;
+}
@@ -0,0 +1,154 @@
+/******************************************************************************
+*   DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS HEADER
+*
+*   This file is part of Open PHIGS
+*   Copyright (C) 2014 Surplus Users Ham Society
+*
+*   Open PHIGS is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation, either version 2.1 of the License, or
+*   (at your option) any later version.
+*
+*   Open PHIGS is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with Open PHIGS. If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "phg.h"
+
+#define WS_SVG       1
+#define SVG_FILE     "test_c22.svg"
+
+#define VP_SIZE      200.0
+#define NUM_POINTS   6
+
+/* GL_LINES pairs: 0-1, 2-3 and 4-5 are drawn, 1-2 and 3-4 are not */
+Ppoint points[NUM_POINTS] = {
+   {0.1, 0.1}, {0.4, 0.1},
+   {0.6, 0.5}, {0.9, 0.5},
+   {0.2, 0.8}, {0.2, 0.9}
+};
+
+void init_scene(void)
+{
+   Ppoint_list plist;
+
+   plist.num_points = NUM_POINTS;
+   plist.points = points;
+   ppolyline(&plist);
+}
+
+int check_svg(void)
+{
+   FILE *fp;
+   char line[4096];
+   char *d;
+   float height, x[2], y[2];
+   int i, n, num_paths, ok;
+
+   fp = fopen(SVG_FILE, "r");
+   if (fp == NULL) {
+      perror(SVG_FILE);
+      return 0;
+   }
+   height = 0.0;
+   num_paths = 0;
+   ok = 1;
+   while (fgets(line, sizeof(line), fp) != NULL) {
+      if (strncmp(line, "<svg", 4) == 0) {
+         d = strstr(line, "height=\"");
+         if (d != NULL) {
+            height = atof(d + 8);
+         }
+      }
+      else if (strncmp(line, "<polyline", 9) == 0) {
+         printf("%s: segments written as connected polyline\n", SVG_FILE);
+         ok = 0;
+      }
+      else if (strncmp(line, "<path", 5) == 0) {
+         num_paths++;
+         d = strstr(line, " d=\"");
+         for (i = 0; d != NULL && i < NUM_POINTS; i += 2) {
+            d += (i == 0) ? 4 : 1;
+            if (sscanf(d, "M%f,%f L%f,%f%n",
+                       &x[0], &y[0], &x[1], &y[1], &n) != 4) {
+               break;
+            }
+            d += n;
+            /* device y points down in SVG */
+            if (fabs(x[0] - points[i].x * VP_SIZE) > 0.5 ||
+                fabs(height - y[0] - points[i].y * VP_SIZE) > 0.5 ||
+                fabs(x[1] - points[i + 1].x * VP_SIZE) > 0.5 ||
+                fabs(height - y[1] - points[i + 1].y * VP_SIZE) > 0.5) {
+               printf("%s: segment %d does not match points %d and %d\n",
+                      SVG_FILE, i / 2, i, i + 1);
+               ok = 0;
+            }
+         }
+         if (i != NUM_POINTS || (d != NULL && *d != '"')) {
+            printf("%s: expected %d segments\n", SVG_FILE, NUM_POINTS / 2);
+            ok = 0;
+         }
+      }
+   }
+   fclose(fp);
+
+   printf("%s: %d paths\n", SVG_FILE, num_paths);
+
+   return (ok && num_paths == 1);
+}
+
+int main(int argc, char *argv[])
+{
+   Phg_args_conn_info conn;
+   Plimit3 vp;
+   int has_display;
+
+   popen_phigs(NULL, 0);
+
+   popen_struct(0);
+   init_scene();
+   pclose_struct();
+
+   /* without headless rendering hardcopies share the window context */
+   has_display = (getenv("DISPLAY") != NULL);
+   if (has_display) {
+      popen_ws(0, NULL, PWST_OUTPUT_TRUE_DB);
+   }
+
+   memset(&conn, 0, sizeof(Phg_args_conn_info));
+   pxset_conf_hcopy_file(WS_SVG, SVG_FILE);
+   popen_ws(WS_SVG, &conn, PWST_HCOPY_TRUE_SVG);
+   vp.x_min = 0.0;
+   vp.x_max = VP_SIZE;
+   vp.y_min = 0.0;
+   vp.y_max = VP_SIZE;
+   vp.z_min = 0.0;
+   vp.z_max = 1.0;
+   pset_ws_vp3(WS_SVG, &vp);
+   ppost_struct(WS_SVG, 0, 0);
+   predraw_all_structs(WS_SVG, PFLAG_ALWAYS);
+   pclose_ws(WS_SVG);
+
+   if (has_display) {
+      pclose_ws(0);
+   }
+   pclose_phigs();
+
+   if (!check_svg()) {
+      printf("FAILED\n");
+      return 1;
+   }
+   printf("PASSED\n");
+
+   return 0;
+}